@@ -0,0 +1,54 @@
+#include "../../include/mercuryTrade/api/orders/OrderEntryParser.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace mercuryTrade;
+using namespace mercuryTrade::api::orders;
+
+namespace {
+
+const std::string BODY =
+    R"({"symbol":"BTC-USD","side":"buy","type":"limit","quantity":1.25,"price":49999.5})";
+
+// The DOM-based decoding placeOrder used before, kept only as a baseline
+Order legacyParse(const std::string& body) {
+    auto data = nlohmann::json::parse(body);
+    Order order{};
+    order.symbol = data["symbol"].get<std::string>();
+    order.side = data["side"].get<std::string>() == "buy" ? OrderSide::Buy : OrderSide::Sell;
+    order.type = data["type"].get<std::string>() == "market" ? OrderType::Market : OrderType::Limit;
+    order.quantity = data["quantity"].get<double>();
+    if (order.type == OrderType::Limit) {
+        order.price = data["price"].get<double>();
+    }
+    return order;
+}
+
+template <typename Fn>
+void run(const char* name, std::size_t iterations, Fn&& fn) {
+    double sink = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sink += fn();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << elapsed * 1e9 / iterations << " ns/order, "
+              << BODY.size() * iterations / elapsed / (1024 * 1024) << " MB/s (checksum " << sink << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    run("nlohmann dom ", iterations, []() { return legacyParse(BODY).price; });
+    run("order entry  ", iterations, []() {
+        OrderEntry entry;
+        OrderEntryError error;
+        parseOrderEntry(BODY, entry, error);
+        return entry.price;
+    });
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "../../include/mercuryTrade/core/analytics/mercAnalyticsKernels.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mercuryTrade::core::analytics;
+
+namespace {
+
+volatile double g_sink;  // Keeps results alive so no loop is optimised away
+
+// Best of ROUNDS runs, in milliseconds
+template <typename Run>
+double bestMillis(int rounds, Run&& run) {
+    double best = 1e300;
+    for (int round = 0; round < rounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = elapsed < best ? elapsed : best;
+    }
+    return best;
+}
+
+// The loops one would write without the kernels
+double naiveVwap(const std::vector<double>& prices, const std::vector<double>& quantities) {
+    double notional = 0.0;
+    double volume = 0.0;
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        notional += prices[i] * quantities[i];
+        volume += quantities[i];
+    }
+    return notional / volume;
+}
+
+double naiveRange(const std::vector<double>& prices) {
+    double low = prices[0];
+    double high = prices[0];
+    for (double price : prices) {
+        low = std::fmin(low, price);
+        high = std::fmax(high, price);
+    }
+    return high - low;
+}
+
+// Mean and deviation recomputed for every window
+void naiveVolatility(const std::vector<double>& prices, std::size_t window, std::vector<double>& out) {
+    for (std::size_t k = 0; k + window < prices.size(); ++k) {
+        double mean = 0.0;
+        for (std::size_t i = k + 1; i <= k + window; ++i) {
+            mean += prices[i] / prices[i - 1] - 1.0;
+        }
+        mean /= static_cast<double>(window);
+        double squares = 0.0;
+        for (std::size_t i = k + 1; i <= k + window; ++i) {
+            double r = prices[i] / prices[i - 1] - 1.0 - mean;
+            squares += r * r;
+        }
+        out[k] = std::sqrt(squares / static_cast<double>(window - 1));
+    }
+}
+
+void naiveProfile(const std::vector<double>& prices, const std::vector<double>& quantities, double low,
+                  double width, std::vector<double>& volumes) {
+    for (std::size_t i = 0; i < prices.size(); ++i) {
+        double slot = std::floor((prices[i] - low) / width);
+        if (slot >= 0.0 && slot < static_cast<double>(volumes.size())) {
+            volumes[static_cast<std::size_t>(slot)] += quantities[i];
+        }
+    }
+}
+
+void report(const char* kernel, double naive, double scalar, double avx2) {
+    std::cout << kernel << ": naive " << naive << " ms, scalar " << scalar << " ms";
+    if (avx2 > 0.0) {
+        std::cout << ", avx2 " << avx2 << " ms (" << naive / avx2 << "x naive)";
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+// Each analytics kernel against a plain loop over the same price and
+// quantity columns: a day of trades at the default size
+int main(int argc, char** argv) {
+    const std::size_t TRADES = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    const std::size_t WINDOW = argc > 2 ? std::stoull(argv[2]) : 100;
+    const std::size_t BUCKETS = 50;
+    const int ROUNDS = 5;
+
+    std::mt19937_64 random(42);
+    std::vector<double> prices(TRADES);
+    std::vector<double> quantities(TRADES);
+    double price = 50000.0;
+    for (std::size_t i = 0; i < TRADES; ++i) {
+        price += 0.25 * static_cast<double>(static_cast<int>(random() % 21) - 10);
+        prices[i] = price;
+        quantities[i] = static_cast<double>(1 + random() % 5000) / 1000.0;
+    }
+    MinMax range = scalarKernels().minMax(prices.data(), TRADES);
+    const double width = (range.max - range.min) / static_cast<double>(BUCKETS - 1);
+
+    const Kernels& scalar = scalarKernels();
+    const Kernels* avx2 = avx2Kernels();
+    std::cout << TRADES << " trades, volatility window " << WINDOW << ", "
+              << (avx2 ? "AVX2 available" : "no AVX2, scalar only") << std::endl;
+
+    report("VWAP",
+           bestMillis(ROUNDS, [&]() { g_sink = naiveVwap(prices, quantities); }),
+           bestMillis(ROUNDS, [&]() { g_sink = scalar.vwap(prices.data(), quantities.data(), TRADES).vwap; }),
+           avx2 ? bestMillis(ROUNDS, [&]() { g_sink = avx2->vwap(prices.data(), quantities.data(), TRADES).vwap; }) : 0.0);
+
+    report("Min/max",
+           bestMillis(ROUNDS, [&]() { g_sink = naiveRange(prices); }),
+           bestMillis(ROUNDS, [&]() { g_sink = scalar.minMax(prices.data(), TRADES).max; }),
+           avx2 ? bestMillis(ROUNDS, [&]() { g_sink = avx2->minMax(prices.data(), TRADES).max; }) : 0.0);
+
+    std::vector<double> out(TRADES);
+    report("Rolling volatility",
+           bestMillis(1, [&]() { naiveVolatility(prices, WINDOW, out); g_sink = out[0]; }),
+           bestMillis(ROUNDS, [&]() { scalar.rollingVolatility(prices.data(), TRADES, WINDOW, out.data()); g_sink = out[0]; }),
+           avx2 ? bestMillis(ROUNDS, [&]() { avx2->rollingVolatility(prices.data(), TRADES, WINDOW, out.data()); g_sink = out[0]; }) : 0.0);
+
+    std::vector<double> volumes(BUCKETS);
+    report("Volume profile",
+           bestMillis(ROUNDS, [&]() { naiveProfile(prices, quantities, range.min, width, volumes); g_sink = volumes[0]; }),
+           bestMillis(ROUNDS, [&]() {
+               scalar.volumeProfile(prices.data(), quantities.data(), TRADES, range.min, width, BUCKETS, volumes.data());
+               g_sink = volumes[0];
+           }),
+           avx2 ? bestMillis(ROUNDS, [&]() {
+               avx2->volumeProfile(prices.data(), quantities.data(), TRADES, range.min, width, BUCKETS, volumes.data());
+               g_sink = volumes[0];
+           }) : 0.0);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "../../include/mercuryTrade/core/memory/mercLimitOrderBook.hpp"
+#include "../../include/mercuryTrade/core/memory/mercSnapshotFile.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+using namespace mercuryTrade::core::memory;
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// Time to save a deep book to a snapshot file and rebuild it from there,
+// which bounds recovery before the journal tail is replayed
+int main(int argc, char** argv) {
+    const std::size_t ORDERS = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    const std::size_t LEVELS = 2000;
+    const std::string path = "/tmp/mercBookRecoveryBenchmark.bin";
+
+    OrderBookAllocator::Config config{ORDERS, LEVELS * 2, 64, false};
+    OrderBookAllocator allocator(config);
+    LimitOrderBook book("BTC-USD", allocator);
+    for (std::size_t i = 0; i < ORDERS; ++i) {
+        bool bid = i % 2 == 0;
+        double offset = 0.01 * static_cast<double>((i / 2) % LEVELS + 1);
+        book.addOrder("ORD-" + std::to_string(i + 1), bid ? BookSide::BID : BookSide::ASK,
+                      bid ? 50000.0 - offset : 50000.0 + offset, 0.5);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    SnapshotWriter out;
+    out.reserve(ORDERS * 24);
+    book.saveState(out);
+    writeSnapshotFile(path, out.data());
+    double saveSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    std::string payload = readSnapshotFile(path);
+    double readSeconds = secondsSince(start);
+
+    OrderBookAllocator restoredAllocator(config);
+    LimitOrderBook restored("BTC-USD", restoredAllocator);
+    start = std::chrono::steady_clock::now();
+    SnapshotReader in(payload);
+    restored.loadState(in);
+    double loadSeconds = secondsSince(start);
+    std::remove(path.c_str());
+
+    auto stats = restored.getStats();
+    std::cout << "orders=" << stats.resting_orders << " levels=" << stats.bid_levels + stats.ask_levels
+              << " snapshot_mb=" << payload.size() / (1024.0 * 1024.0) << "\n"
+              << "save+write " << saveSeconds * 1000.0 << " ms, read+verify " << readSeconds * 1000.0
+              << " ms, rebuild " << loadSeconds * 1000.0 << " ms, restore total "
+              << (readSeconds + loadSeconds) * 1000.0 << " ms" << std::endl;
+    return stats.resting_orders == ORDERS ? 0 : 1;
+}
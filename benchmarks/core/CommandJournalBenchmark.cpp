@@ -0,0 +1,78 @@
+#include "../../include/mercuryTrade/core/memory/mercCommandJournal.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mercuryTrade::core::memory;
+
+namespace {
+
+// Appends from `threads` request threads, each waiting for its ack, and
+// reports throughput and the acknowledgement latency distribution
+void run(const char* name, const std::string& directory, CommandJournal::SyncPolicy policy,
+         std::size_t threads, std::size_t perThread) {
+    std::filesystem::remove_all(directory);
+    auto config = CommandJournal::Config::getDefaultConfig(directory);
+    config.sync_policy = policy;
+
+    std::vector<std::vector<double>> latencies(threads);
+    double elapsed;
+    std::size_t syncs;
+    {
+        CommandJournal journal(config);
+        std::vector<std::thread> workers;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&journal, &latencies, t, perThread]() {
+                JournalCommand command;
+                command.symbol = "BTC-USD";
+                command.price = 50000.0;
+                command.quantity = 0.25;
+                latencies[t].reserve(perThread);
+                for (std::size_t i = 0; i < perThread; ++i) {
+                    command.order_id = "ORD-" + std::to_string(t * perThread + i + 1);
+                    auto sent = std::chrono::steady_clock::now();
+                    journal.waitDurable(journal.append(command));
+                    latencies[t].push_back(
+                        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sent).count());
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        syncs = journal.getStats().syncs;
+    }
+    std::filesystem::remove_all(directory);
+
+    std::vector<double> all;
+    for (const auto& l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&](double p) { return all[std::min(all.size() - 1, static_cast<std::size_t>(p * all.size()))]; };
+
+    std::cout << name << ": " << all.size() / elapsed << " cmds/s, " << syncs << " syncs, ack p50 "
+              << percentile(0.50) << " us, p99 " << percentile(0.99) << " us, max " << all.back() << " us"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string directory = argc > 1 ? argv[1] : "journal-bench";
+    std::size_t threads = argc > 2 ? std::stoul(argv[2]) : 16;
+    std::size_t perThread = argc > 3 ? std::stoul(argv[3]) : 20000;
+
+    run("none    ", directory, CommandJournal::SyncPolicy::NONE, threads, perThread);
+    run("interval", directory, CommandJournal::SyncPolicy::INTERVAL, threads, perThread);
+    run("group   ", directory, CommandJournal::SyncPolicy::GROUP, threads, perThread);
+
+    return 0;
+}
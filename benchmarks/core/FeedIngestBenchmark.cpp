@@ -0,0 +1,41 @@
+#include "../../include/mercuryTrade/core/memory/mercFeedHandler.hpp"
+#include "../../include/mercuryTrade/core/memory/mercFeedSimulator.hpp"
+#include "../../include/mercuryTrade/core/memory/mercLastValueCache.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mercuryTrade::core::memory;
+
+// Ticks per second through decode, the tick ring and the last value cache,
+// with the packets already in memory so only the handler is measured
+int main(int argc, char** argv) {
+    const std::size_t PACKETS = argc > 1 ? std::stoull(argv[1]) : 100000;
+    const int ROUNDS = 5;
+
+    auto config = FeedSimulator::Config::getDefaultConfig();
+    config.symbols = {"BTC-USD", "ETH-USD", "SOL-USD", "XRP-USD", "ADA-USD", "DOGE-USD", "AVAX-USD", "DOT-USD"};
+    config.messages_per_packet = feed::MAX_MESSAGES;
+    FeedSimulator simulator(config);
+    std::vector<std::string> packets = simulator.packets(PACKETS);
+
+    double best = 0.0;
+    for (int round = 0; round < ROUNDS; ++round) {
+        LastValueCache cache(64);
+        marketDataAllocator allocator;
+        FeedHandler handler(cache, allocator);
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& packet : packets) {
+            handler.onPacket(packet.data(), packet.size());
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double rate = static_cast<double>(handler.ticksWritten()) / elapsed.count();
+        best = rate > best ? rate : best;
+        std::cout << "Round " << round + 1 << ": " << handler.ticksWritten() << " ticks in "
+                  << elapsed.count() * 1000.0 << " ms, " << rate / 1e6 << " M ticks/s" << std::endl;
+    }
+    std::cout << "Best: " << best / 1e6 << " M ticks/s (" << 1e9 / best << " ns per tick)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "../../include/mercuryTrade/core/memory/mercMarketDataBus.hpp"
+#include "../../include/mercuryTrade/core/memory/mercMarketDataBusReader.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace mercuryTrade::core::memory;
+
+namespace {
+
+std::int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+// Publish-to-read latency of a quote through the bus, with the reader
+// spinning on another thread the way a co-located strategy would
+int main(int argc, char** argv) {
+    const std::uint64_t QUOTES = argc > 1 ? std::stoull(argv[1]) : 200000;
+    MarketDataBus bus(MarketDataBus::Config::getDefaultConfig("/mercBusBenchmark-" + std::to_string(::getpid())));
+    bus.publishQuote("BTC-USD", BusQuote{0, 0.0, 0.0, 0.0, 0.0, nowNanos()});
+
+    // With one core the two sides have to take turns, and the figures
+    // measure the scheduler rather than the bus
+    const bool single_core = std::thread::hardware_concurrency() < 2;
+    std::atomic<std::uint64_t> acknowledged{0};
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(QUOTES);
+    std::thread reader([&]() {
+        MarketDataBusReader busReader(bus.name());
+        auto subscription = busReader.subscribe("BTC-USD");
+        BusQuote quote{};
+        std::uint64_t last = 0;
+        while (last < QUOTES) {
+            if (subscription->quote(quote) && quote.seq != last) {
+                latencies.push_back(nowNanos() - quote.timestamp);
+                last = quote.seq;
+                acknowledged.store(last, std::memory_order_release);
+            } else if (single_core) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // One quote in flight at a time, so each measures an idle-to-seen hop
+    for (std::uint64_t i = 1; i <= QUOTES; ++i) {
+        bus.publishQuote("BTC-USD", BusQuote{i, 100.0, 1.0, 101.0, 1.0, nowNanos()});
+        while (acknowledged.load(std::memory_order_acquire) != i) {
+            if (single_core) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    reader.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))];
+    };
+    std::cout << "quotes=" << latencies.size() << " publish-to-read ns: p50=" << percentile(0.50)
+              << " p99=" << percentile(0.99) << " p99.9=" << percentile(0.999) << " max=" << latencies.back()
+              << (single_core ? " (single core)" : "") << std::endl;
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "../../include/mercuryTrade/core/memory/mercRiskEngine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mercuryTrade::core::memory;
+
+namespace {
+
+struct Request {
+    std::uint32_t account;
+    std::uint32_t symbol;
+    bool is_buy;
+    double price;
+    double quantity;
+};
+
+volatile int g_sink;  // Keeps the verdicts alive
+
+} // namespace
+
+// Pre-trade checks as the order path makes them: a check, then a reserve
+// and a fill for the orders that pass, over many accounts and symbols
+// with every limit in force. Reported per order, with and without
+// resolving the account and symbol names first.
+int main(int argc, char** argv) {
+    const std::size_t ORDERS = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    const std::uint32_t ACCOUNTS = 200;
+    const std::uint32_t SYMBOLS = 50;
+
+    auto config = RiskEngine::Config::getDefaultConfig();
+    config.default_limits = RiskEngine::Limits{1000.0, 5e6, 500, 0.05};
+    RiskEngine risk(config);
+    std::vector<std::string> accounts;
+    std::vector<std::string> symbols;
+    for (std::uint32_t i = 0; i < ACCOUNTS; ++i) {
+        accounts.push_back("account-" + std::to_string(i));
+        risk.accountIndex(accounts.back());
+    }
+    for (std::uint32_t i = 0; i < SYMBOLS; ++i) {
+        symbols.push_back("SYM" + std::to_string(i) + "-USD");
+        risk.trade(risk.symbolIndex(symbols.back()), 100.0);
+    }
+
+    std::mt19937_64 random(7);
+    std::vector<Request> requests(ORDERS);
+    for (auto& request : requests) {
+        request = Request{static_cast<std::uint32_t>(random() % ACCOUNTS), static_cast<std::uint32_t>(random() % SYMBOLS),
+                          random() % 2 == 0, 90.0 + static_cast<double>(random() % 2000) / 100.0,
+                          static_cast<double>(1 + random() % 10)};
+    }
+
+    auto run = [&](bool byName) {
+        int passed = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& request : requests) {
+            std::uint32_t account = byName ? risk.accountIndex(accounts[request.account]) : request.account;
+            std::uint32_t symbol = byName ? risk.symbolIndex(symbols[request.symbol]) : request.symbol;
+            if (risk.check(account, symbol, request.is_buy, request.price, request.quantity) == RiskCheck::PASSED) {
+                risk.reserve(account, symbol, request.is_buy, request.price, request.quantity);
+                risk.fill(account, symbol, request.is_buy, request.price, request.quantity, true);
+                ++passed;
+            }
+        }
+        double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        g_sink = passed;
+        std::cout << (byName ? "By name:  " : "By index: ") << nanos / static_cast<double>(ORDERS)
+                  << " ns per order, " << passed << " of " << ORDERS << " passed" << std::endl;
+    };
+    run(false);
+    run(true);
+
+    // The check alone, with each order timed on its own
+    std::vector<double> latencies;
+    latencies.reserve(std::min<std::size_t>(ORDERS, 200000));
+    for (std::size_t i = 0; i < latencies.capacity(); ++i) {
+        const Request& request = requests[i];
+        auto start = std::chrono::steady_clock::now();
+        g_sink = static_cast<int>(risk.check(risk.accountIndex(accounts[request.account]),
+                                             risk.symbolIndex(symbols[request.symbol]), request.is_buy,
+                                             request.price, request.quantity));
+        latencies.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "Check by name, timed singly: p50 " << latencies[latencies.size() / 2] << " ns, p99 "
+              << latencies[latencies.size() * 99 / 100] << " ns, max " << latencies.back() << " ns" << std::endl;
+    return 0;
+}
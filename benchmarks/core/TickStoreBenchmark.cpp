@@ -0,0 +1,93 @@
+#include "../../include/mercuryTrade/core/memory/mercTickStore.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace mercuryTrade::core::memory;
+
+namespace {
+
+constexpr std::int64_t SECOND = 1000000000LL;
+constexpr std::int64_t HOUR = 3600 * SECOND;
+
+double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// Days of BTC-USD trades written through the tick store, then the
+// questions the analytics pages ask of it after a restart: the last hour
+// of trades, the latest few and a day downsampled to one-minute bars
+int main(int argc, char** argv) {
+    const std::int64_t DAYS = argc > 1 ? std::atoll(argv[1]) : 3;
+    const std::int64_t TRADES_PER_HOUR = argc > 2 ? std::atoll(argv[2]) : 200000;
+    const int ROUNDS = 5;
+
+    char pattern[] = "/tmp/mercTickStoreBenchXXXXXX";
+    if (!mkdtemp(pattern)) {
+        std::cerr << "Cannot create temporary directory" << std::endl;
+        return 1;
+    }
+    const std::string directory = pattern;
+    auto config = TickStore::Config::getDefaultConfig(directory);
+
+    // A random walk in whole cents with millisecond timestamps
+    const std::int64_t total = DAYS * 24 * TRADES_PER_HOUR;
+    const std::int64_t spacing = HOUR / TRADES_PER_HOUR / 1000000 * 1000000;
+    const std::int64_t base = 1700000000LL / 3600 * 3600 * SECOND;
+    std::int64_t end = base;
+    {
+        TickStore store(config);
+        std::size_t btc = store.symbolIndex("BTC-USD");
+        std::mt19937_64 random(42);
+        std::int64_t cents = 5000000;
+        auto start = std::chrono::steady_clock::now();
+        for (std::int64_t i = 0; i < total; ++i) {
+            cents += static_cast<std::int64_t>(random() % 21) - 10;
+            end = base + i * spacing;
+            store.appendTrade(btc, TickTrade{end, static_cast<double>(cents) / 100.0,
+                                             static_cast<double>(1 + random() % 5000) / 1000.0,
+                                             static_cast<std::uint8_t>(random() & 1)});
+        }
+        store.flush();
+        double elapsed = millisSince(start);
+        auto stats = store.getStats();
+        std::cout << "Wrote " << total << " trades over " << DAYS << " days in " << elapsed << " ms ("
+                  << static_cast<double>(total) / elapsed / 1000.0 << " M trades/s), "
+                  << static_cast<double>(stats.bytes_used) / static_cast<double>(total) << " bytes per trade in "
+                  << stats.segments << " segments" << std::endl;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    TickStore store(config);
+    std::cout << "Reopened in " << millisSince(start) << " ms" << std::endl;
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        start = std::chrono::steady_clock::now();
+        double volume = 0.0;
+        std::size_t count = store.scanTrades("BTC-USD", end - HOUR, end + 1, [&](const TickTrade& trade) {
+            volume += trade.quantity;
+        });
+        double scan = millisSince(start);
+
+        start = std::chrono::steady_clock::now();
+        auto latest = store.trades("BTC-USD", 0, INT64_MAX, 100);
+        double newest = millisSince(start);
+
+        start = std::chrono::steady_clock::now();
+        auto bars = store.downsampleTrades("BTC-USD", end - 24 * HOUR, end + 1, 60 * SECOND, 5000);
+        double downsample = millisSince(start);
+
+        std::cout << "Round " << round + 1 << ": last hour " << count << " trades (volume " << volume << ") in "
+                  << scan << " ms, latest " << latest.size() << " in " << newest << " ms, last day as "
+                  << bars.size() << " 1m bars in " << downsample << " ms" << std::endl;
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    return 0;
+}
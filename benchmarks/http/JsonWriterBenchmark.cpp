@@ -0,0 +1,85 @@
+#include "../../include/mercuryTrade/http/Server.hpp"
+#include "../../include/mercuryTrade/services/MarketDataService.hpp"
+#include "../../include/mercuryTrade/services/OrderService.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace mercuryTrade;
+
+namespace {
+    std::size_t allocations = 0;
+}
+
+// Counts every heap allocation so each run can report allocations per response.
+// GCC flags free() in the replacement delete once it inlines through
+// std::allocator, even though both replacements go through malloc/free.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+template <typename Fn>
+void run(const char* name, std::size_t iterations, Fn&& fn) {
+    std::size_t bytes = 0;
+    std::size_t start_allocations = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        http::Response res = fn();
+        bytes += res.body.size();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << elapsed * 1e9 / iterations << " ns/response, "
+              << bytes / elapsed / (1024 * 1024) << " MB/s, "
+              << static_cast<double>(allocations - start_allocations) / iterations << " allocs/response" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    Order order{"ORD-1234567", "BTC-USD", OrderSide::Buy, OrderType::Limit, 2.0, 50000.25,
+                OrderStatus::PartiallyFilled, 1700000000123456789L, 0.5, ""};
+    std::vector<Order> orders(100, order);
+
+    MarketData data{"BTC-USD", 49999.5, 50000.5, 50000.0, 1234.5, 1700000000123456789L};
+
+    OrderBook book{"BTC-USD", {}, {}, 1700000000123456789L, 123456, true};
+    double total = 0.0;
+    for (int i = 0; i < 50; ++i) {
+        total += 0.5 + i * 0.01;
+        book.bids.push_back({50000.0 - i * 0.5, 0.5 + i * 0.01, total});
+        book.asks.push_back({50000.5 + i * 0.5, 0.5 + i * 0.01, total});
+    }
+
+    run("order        json     ", iterations, [&]() { return http::Response::json(order.toJson()); });
+    run("order        serialize", iterations, [&]() { return http::Response::serialize(order); });
+    run("market data  json     ", iterations, [&]() { return http::Response::json(data.toJson()); });
+    run("market data  serialize", iterations, [&]() { return http::Response::serialize(data); });
+    run("book x50     json     ", iterations / 10, [&]() { return http::Response::json(book.toJson()); });
+    run("book x50     serialize", iterations / 10, [&]() { return http::Response::serialize(book); });
+    run("orders x100  json     ", iterations / 10, [&]() {
+        nlohmann::json response = nlohmann::json::array();
+        for (const auto& o : orders) response.push_back(o.toJson());
+        return http::Response::json(response);
+    });
+    run("orders x100  serialize", iterations / 10, [&]() { return http::Response::serialize(orders); });
+
+    return 0;
+}
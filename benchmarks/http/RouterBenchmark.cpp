@@ -0,0 +1,75 @@
+#include "../../include/mercuryTrade/http/Server.hpp"
+#include <chrono>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace mercuryTrade::http;
+
+namespace {
+
+const std::vector<std::string> PATTERNS = {
+    "/api/auth/login",
+    "/api/auth/register",
+    "/api/auth/logout",
+    "/api/market-data/{symbol}",
+    "/api/order-book/{symbol}",
+    "/api/orders",
+    "/api/orders/{id}"
+};
+
+const std::vector<std::string> PATHS = {
+    "/api/orders",
+    "/api/orders/ORD-1234567",
+    "/api/order-book/BTC-USD",
+    "/api/market-data/ETH-USD",
+    "/api/auth/login"
+};
+
+// The per-request regex matching this replaced, kept only as a baseline
+std::size_t legacyMatch(const std::string& path) {
+    std::regex param_regex("\\{([^}]+)\\}");
+    for (const auto& route_pattern : PATTERNS) {
+        std::regex pattern("^" + std::regex_replace(route_pattern, param_regex, "([^/]+)") + "$");
+        std::smatch matches;
+        if (std::regex_match(path, matches, pattern)) {
+            return matches.size();
+        }
+    }
+    return 0;
+}
+
+template <typename Fn>
+void run(const char* name, std::size_t iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    std::size_t sink = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sink += fn(PATHS[i % PATHS.size()]);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << elapsed * 1e9 / iterations << " ns/lookup (checksum " << sink << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    Router router;
+    for (const auto& pattern : PATTERNS) {
+        router.add(Method::Get, pattern, [](const Request&) { return Response(); });
+    }
+
+    PathParams params;
+    run("Radix router", iterations, [&](const std::string& path) {
+        auto match = router.match(Method::Get, path, params);
+        return (match.handler ? 1 : 0) + params.size();
+    });
+
+    run("Legacy regex matching", iterations / 100, [&](const std::string& path) {
+        return legacyMatch(path);
+    });
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include "../../include/mercuryTrade/wire/Messages.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <nlohmann/json.hpp>
+
+using namespace mercuryTrade::wire;
+
+namespace {
+
+// Same shapes as MarketData::toJson(), deltaToJson() and Order::toJson()
+nlohmann::json quoteJson(const Quote& quote) {
+    return {
+        {"symbol", std::string(quote.symbol.view())},
+        {"bid", quote.bid},
+        {"ask", quote.ask},
+        {"last", quote.last},
+        {"volume", quote.volume},
+        {"timestamp", quote.timestamp}
+    };
+}
+
+nlohmann::json deltaJson(const BookDelta& delta) {
+    return {
+        {"seq", delta.seq},
+        {"side", delta.side == Side::Buy ? "bid" : "ask"},
+        {"price", delta.price},
+        {"quantity", delta.quantity},
+        {"orders", delta.orders}
+    };
+}
+
+nlohmann::json orderJson(const OrderUpdate& order) {
+    return {
+        {"id", std::string(order.order_id.view())},
+        {"symbol", std::string(order.symbol.view())},
+        {"side", order.side == Side::Buy ? "buy" : "sell"},
+        {"type", order.type == 0 ? "market" : "limit"},
+        {"quantity", order.quantity},
+        {"price", order.price},
+        {"status", order.status},
+        {"filled_quantity", order.filled_quantity},
+        {"timestamp", order.timestamp}
+    };
+}
+
+// Reports time per message and the encoded size of the last one
+template <typename Fn>
+void run(const char* name, std::size_t iterations, Fn&& fn) {
+    std::size_t bytes = 0;
+    std::size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        bytes = fn(i);
+        sink += bytes;
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << elapsed * 1e9 / iterations << " ns/msg, " << bytes
+              << " bytes/msg (checksum " << sink << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    Quote quote;
+    quote.symbol.assign("BTC-USD");
+    quote.bid = 49999.5;
+    quote.ask = 50000.25;
+    quote.last = 50000.0;
+    quote.volume = 1234.5;
+    quote.timestamp = 1700000000123456789LL;
+
+    BookDelta delta;
+    delta.symbol.assign("BTC-USD");
+    delta.seq = 123456;
+    delta.price = 50001.5;
+    delta.quantity = 3.25;
+    delta.orders = 4;
+    delta.side = Side::Sell;
+
+    OrderUpdate order;
+    order.order_id.assign("ORD-1234567");
+    order.symbol.assign("BTC-USD");
+    order.price = 50000.0;
+    order.quantity = 2.0;
+    order.filled_quantity = 0.5;
+    order.timestamp = 1700000000123456789LL;
+    order.side = Side::Buy;
+    order.type = 1;
+    order.status = 1;
+
+    std::string out;
+    run("quote binary encode", iterations, [&](std::size_t i) {
+        quote.last = 50000.0 + static_cast<double>(i & 0xFF);
+        out.clear();
+        encode(quote, out);
+        return out.size();
+    });
+    run("quote json encode  ", iterations, [&](std::size_t i) {
+        quote.last = 50000.0 + static_cast<double>(i & 0xFF);
+        return quoteJson(quote).dump().size();
+    });
+
+    run("delta binary encode", iterations, [&](std::size_t i) {
+        delta.seq = i;
+        out.clear();
+        encode(delta, out);
+        return out.size();
+    });
+    run("delta json encode  ", iterations, [&](std::size_t i) {
+        delta.seq = i;
+        return deltaJson(delta).dump().size();
+    });
+
+    run("order binary encode", iterations, [&](std::size_t i) {
+        order.filled_quantity = static_cast<double>(i & 0xF) * 0.125;
+        out.clear();
+        encode(order, out);
+        return out.size();
+    });
+    run("order json encode  ", iterations, [&](std::size_t i) {
+        order.filled_quantity = static_cast<double>(i & 0xF) * 0.125;
+        return orderJson(order).dump().size();
+    });
+
+    std::string binary;
+    encode(order, binary);
+    std::string text = orderJson(order).dump();
+    run("order binary decode", iterations, [&](std::size_t) {
+        OrderUpdate decoded;
+        std::size_t consumed = 0;
+        decode(binary, decoded, consumed);
+        return consumed + decoded.status;
+    });
+    run("order json decode  ", iterations, [&](std::size_t) {
+        auto decoded = nlohmann::json::parse(text);
+        return text.size() + decoded["status"].get<std::size_t>();
+    });
+
+    return 0;
+}
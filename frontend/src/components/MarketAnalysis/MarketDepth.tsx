@@ -2,6 +2,8 @@ import React, { useMemo } from 'react';
 import { AreaChart, Area, XAxis, YAxis, CartesianGrid, Tooltip, ResponsiveContainer } from 'recharts';
 import { useTradingContext } from '../../contexts/TradingContext';
 
+const DEPTH_LEVELS = 50;
+
 interface DepthData {
   price: number;
   bids: number;
@@ -10,43 +12,29 @@ interface DepthData {
   totalAsks: number;
 }
 
-const MarketDepth = () => {
-  const { marketData } = useTradingContext();
-
-  const depthData = useMemo(() => {
-    if (!marketData?.orderBookSnapshot) return [];
-
-    const data: DepthData[] = [];
-    let totalBids = 0;
-    let totalAsks = 0;
-
-    // Process bids (buy orders)
-    marketData.orderBookSnapshot.bids.forEach(([price, size]) => {
-      totalBids += size;
-      data.push({
-        price,
-        bids: size,
-        asks: 0,
-        totalBids,
-        totalAsks: 0
-      });
-    });
+// Running totals over the best `DEPTH_LEVELS` levels, best price first
+function accumulate(levels: Array<[number, number]>, side: 'bids' | 'asks'): DepthData[] {
+  let total = 0;
+  return levels.slice(0, DEPTH_LEVELS).map(([price, quantity]) => {
+    total += quantity;
+    return side === 'bids'
+      ? { price, bids: quantity, asks: 0, totalBids: total, totalAsks: 0 }
+      : { price, bids: 0, asks: quantity, totalBids: 0, totalAsks: total };
+  });
+}
 
-    // Process asks (sell orders)
-    marketData.orderBookSnapshot.asks.forEach(([price, size]) => {
-      totalAsks += size;
-      data.push({
-        price,
-        bids: 0,
-        asks: size,
-        totalBids: 0,
-        totalAsks
-      });
-    });
+const MarketDepth = () => {
+  const { orderBookSnapshot } = useTradingContext();
 
-    // Sort by price
-    return data.sort((a, b) => a.price - b.price);
-  }, [marketData?.orderBookSnapshot]);
+  // Built from the book the context keeps current with deltas, so a book
+  // change costs a pass over the top levels rather than a REST round trip
+  const depthData = useMemo<DepthData[]>(() => {
+    if (!orderBookSnapshot) return [];
+    return [
+      ...accumulate(orderBookSnapshot.bids, 'bids'),
+      ...accumulate(orderBookSnapshot.asks, 'asks')
+    ].sort((a, b) => a.price - b.price);
+  }, [orderBookSnapshot]);
 
   const CustomTooltip = ({ active, payload }: any) => {
     if (active && payload && payload.length) {
@@ -1,5 +1,45 @@
 import React, { createContext, useContext, useState, useEffect } from 'react';
-import { Order, MarketData, Trade, OrderBookSnapshot } from '../types/trading';
+import { Order, MarketData, Trade, OrderBookSnapshot, OrderBookDelta } from '../types/trading';
+import { tradingApi } from '../services/api';
+
+// Book rebuilt locally from a snapshot plus sequenced level deltas
+interface LocalBook {
+  seq: number;
+  bids: Map<number, number>;
+  asks: Map<number, number>;
+}
+
+interface BookLevelJson {
+  price: number;
+  quantity: number;
+}
+
+function bookFromSnapshot(payload: { seq: number; bids: BookLevelJson[]; asks: BookLevelJson[] }): LocalBook {
+  return {
+    seq: payload.seq,
+    bids: new Map(payload.bids.map(level => [level.price, level.quantity] as [number, number])),
+    asks: new Map(payload.asks.map(level => [level.price, level.quantity] as [number, number]))
+  };
+}
+
+function applyDelta(book: LocalBook, delta: OrderBookDelta) {
+  const levels = delta.side === 'bid' ? book.bids : book.asks;
+  if (delta.quantity > 0) {
+    levels.set(delta.price, delta.quantity);
+  } else {
+    levels.delete(delta.price);
+  }
+  book.seq = delta.seq;
+}
+
+function toSnapshot(book: LocalBook): OrderBookSnapshot {
+  return {
+    bids: Array.from(book.bids.entries()).sort((a, b) => b[0] - a[0]),
+    asks: Array.from(book.asks.entries()).sort((a, b) => a[0] - b[0]),
+    timestamp: new Date(),
+    seq: book.seq
+  };
+}
 
 interface TradingContextType {
   // Market Data
@@ -48,7 +88,58 @@ export function TradingProvider({ children }: { children: React.ReactNode }) {
 
   // WebSocket setup
   useEffect(() => {
-    const ws = new WebSocket('wss://your-trading-api/ws');
+    const ws = new WebSocket('ws://localhost:3001/ws');
+    const book: { current: LocalBook | null } = { current: null };
+    let pending: OrderBookDelta[] = [];
+    let resyncing = false;
+
+    const publishBook = () => {
+      if (book.current) {
+        setOrderBookSnapshot(toSnapshot(book.current));
+      }
+    };
+
+    // Replays the missed deltas, or reloads the snapshot if they are gone
+    const resync = async () => {
+      resyncing = true;
+      try {
+        if (book.current) {
+          try {
+            const replay = await tradingApi.getOrderBookDeltas(selectedSymbol, book.current.seq);
+            replay.deltas.forEach((delta: OrderBookDelta) => applyDelta(book.current!, delta));
+          } catch {
+            book.current = null;
+          }
+        }
+        if (!book.current) {
+          book.current = bookFromSnapshot(await tradingApi.getOrderBook(selectedSymbol));
+        }
+        pending.filter(delta => delta.seq > book.current!.seq).forEach(delta => {
+          if (delta.seq === book.current!.seq + 1) {
+            applyDelta(book.current!, delta);
+          }
+        });
+        pending = [];
+        publishBook();
+      } catch (err) {
+        console.error('Order book resync failed:', err);
+      } finally {
+        resyncing = false;
+      }
+    };
+
+    ws.onopen = () => {
+      ws.send(JSON.stringify({
+        action: 'subscribe',
+        channels: [
+          `MARKET_DATA:${selectedSymbol}`,
+          `TRADE:${selectedSymbol}`,
+          `ORDER_BOOK:${selectedSymbol}`,
+          `ORDER_BOOK_DELTA:${selectedSymbol}`,
+          'ORDER_UPDATE:*'
+        ]
+      }));
+    };
 
     ws.onmessage = (event) => {
       const data = JSON.parse(event.data);
@@ -70,8 +161,23 @@ export function TradingProvider({ children }: { children: React.ReactNode }) {
           break;
           
         case 'ORDER_BOOK':
-          if (data.symbol === selectedSymbol) {
-            setOrderBookSnapshot(data.payload);
+          if (data.symbol === selectedSymbol && !resyncing &&
+              (!book.current || data.payload.seq > book.current.seq)) {
+            book.current = bookFromSnapshot(data.payload);
+            publishBook();
+          }
+          break;
+
+        case 'ORDER_BOOK_DELTA':
+          if (data.symbol !== selectedSymbol) break;
+          if (resyncing) {
+            pending.push(data.payload);
+          } else if (book.current && data.payload.seq === book.current.seq + 1) {
+            applyDelta(book.current, data.payload);
+            publishBook();
+          } else if (!book.current || data.payload.seq > book.current.seq + 1) {
+            pending.push(data.payload);
+            resync();
           }
           break;
           
@@ -32,8 +32,16 @@ export const tradingApi = {
     return response.data;
   },
 
-  getOrderBook: async (symbol: string) => {
-    const response = await axios.get(`${API_BASE_URL}/market-data/${symbol}/order-book`);
+  // depth limits levels (or buckets) per side, tick aggregates into price buckets,
+  // cumulative adds running totals; all computed server-side
+  getOrderBook: async (symbol: string, query?: { depth?: number; tick?: number; cumulative?: boolean }) => {
+    const response = await axios.get(`${API_BASE_URL}/order-book/${symbol}`, { params: query });
+    return response.data;
+  },
+
+  // Level deltas after `since`; rejects with status 410 once they have been discarded
+  getOrderBookDeltas: async (symbol: string, since: number) => {
+    const response = await axios.get(`${API_BASE_URL}/order-book/${symbol}/deltas`, { params: { since } });
     return response.data;
   },
 };
\ No newline at end of file
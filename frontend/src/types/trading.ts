@@ -38,6 +38,15 @@ export interface OrderBookSnapshot {
   bids: Array<[number, number]>; // Array of [price, size] tuples
   asks: Array<[number, number]>; // Array of [price, size] tuples
   timestamp: Date;
+  seq?: number; // Last level delta applied
+}
+
+export interface OrderBookDelta {
+  seq: number;
+  side: 'bid' | 'ask';
+  price: number;
+  quantity: number; // New level size; 0 removes the level
+  orders: number;
 }
 
 export interface MarketDepthLevel {
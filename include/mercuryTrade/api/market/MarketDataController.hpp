@@ -15,8 +15,23 @@ public:
         std::shared_ptr<MarketDataService> marketDataService,
         std::shared_ptr<OrderBookService> orderBookService);
     
-    http::Response getMarketData(const std::string& symbol);
+    // binary selects the wire encoding, e.g. when the client sent
+    // "Accept: application/x-mercury-sbe"
+    http::Response getMarketData(const std::string& symbol, bool binary = false);
     http::Response getOrderBook(const std::string& symbol);
+    // Supports ?depth=N&tick=T&cumulative=true
+    http::Response getOrderBook(const http::Request& req);
+    // Level deltas after `since`; 410 Gone means reload the snapshot
+    http::Response getOrderBookDeltas(const std::string& symbol, const std::string& since, bool binary = false);
+    // OHLCV bars; supports ?interval=1s|1m|5m|1h&from=NS&to=NS&limit=N
+    http::Response getBars(const http::Request& req);
+    // Stored trades, newest kept; supports ?from=NS&to=NS&limit=N
+    http::Response getTrades(const http::Request& req);
+    // Stored trades downsampled to bars; supports ?from=NS&to=NS&bucket=NS&limit=N
+    http::Response getHistory(const http::Request& req);
+    // VWAP, range, rolling volatility and volume profile of the newest stored
+    // trades; supports ?from=NS&to=NS&window=N&buckets=N&limit=N
+    http::Response getAnalysis(const http::Request& req);
 
 private:
     std::shared_ptr<MarketDataService> m_marketDataService;
@@ -10,12 +10,22 @@ namespace orders {
 
 class OrderController {
 public:
+    static constexpr std::size_t MAX_BATCH_ORDERS = 1000;
+
     explicit OrderController(std::shared_ptr<OrderService> orderService);
     
     http::Response placeOrder(const http::Request& req);
     http::Response cancelOrder(const std::string& orderId);
-    http::Response getOrders();
-    http::Response getOrderById(const std::string& orderId);
+    // Body is a JSON array of orders; results line up with the request
+    http::Response placeOrders(const http::Request& req);
+    // Body is a JSON array of order ids
+    http::Response cancelOrders(const http::Request& req);
+    http::Response cancelAllOrders(const std::string& symbol);
+    // One page of orders, filtered by ?symbol= and ?status=, continuing
+    // from ?cursor= for ?limit= orders. binary selects the wire encoding
+    // (concatenated OrderUpdate messages, next cursor in X-Next-Cursor).
+    http::Response getOrders(const http::Request& req, bool binary = false);
+    http::Response getOrderById(const std::string& orderId, bool binary = false);
 
 private:
     std::shared_ptr<OrderService> m_orderService;
@@ -0,0 +1,72 @@
+// include/mercuryTrade/api/orders/OrderEntryParser.hpp
+#pragma once
+#include "../../services/OrderService.hpp"
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace mercuryTrade {
+namespace api {
+namespace orders {
+
+// A decoded order-entry request. Fixed-size, so decoding never touches the
+// heap; symbols are capped at the wire format's symbol width.
+struct OrderEntry {
+    static constexpr std::size_t MAX_SYMBOL_LENGTH = 16;
+    static constexpr std::size_t MAX_ACCOUNT_LENGTH = 32;
+
+    char symbol[MAX_SYMBOL_LENGTH] = {};
+    std::size_t symbol_length = 0;
+    char account[MAX_ACCOUNT_LENGTH] = {};
+    std::size_t account_length = 0;  // Zero for the default account
+    OrderSide side = OrderSide::Buy;
+    OrderType type = OrderType::Limit;
+    double quantity = 0.0;
+    double price = 0.0;  // 0 for market orders
+
+    std::string_view symbolView() const { return std::string_view(symbol, symbol_length); }
+
+    Order toOrder() const {
+        Order order{};
+        order.symbol.assign(symbol, symbol_length);
+        order.account.assign(account, account_length);
+        order.side = side;
+        order.type = type;
+        order.quantity = quantity;
+        order.price = price;
+        return order;
+    }
+};
+
+// Why a request was refused. message has static storage; offset is the
+// byte in the body where the problem was found.
+struct OrderEntryError {
+    std::size_t offset = 0;
+    const char* message = "";
+};
+
+// Decodes {"symbol", "side", "type", "quantity", "price", "account"}
+// directly into an OrderEntry in one pass, without building a JSON tree.
+// side is "buy" or "sell", type is "market" or "limit", quantity must be
+// positive and price is required (and positive) for limit orders only.
+// account is optional; risk limits are kept per account, and orders for an
+// account the risk engine has no limits for are rejected. Unknown members are
+// skipped; duplicate members are refused. Returns false and fills `error`
+// on the first problem.
+bool parseOrderEntry(std::string_view body, OrderEntry& entry, OrderEntryError& error);
+
+// One element of a batch: the decoded entry, or why it was refused
+struct OrderEntryItem {
+    OrderEntry entry;
+    bool ok = false;
+    OrderEntryError error;
+};
+
+// Decodes a JSON array of order objects into `items` (cleared first).
+// An element that is valid JSON but not a valid order only fails itself;
+// the call returns false, filling `error`, when the body as a whole is
+// malformed or holds more than maxItems elements.
+bool parseOrderEntries(std::string_view body, std::vector<OrderEntryItem>& items, OrderEntryError& error,
+                       std::size_t maxItems);
+
+}}} // namespace
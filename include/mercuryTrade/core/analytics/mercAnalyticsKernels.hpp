@@ -0,0 +1,76 @@
+#ifndef MERC_ANALYTICS_KERNELS_HPP
+#define MERC_ANALYTICS_KERNELS_HPP
+
+#include <cstddef>
+
+namespace mercuryTrade {
+namespace core {
+namespace analytics {
+
+struct VwapResult {
+    double notional;  // Sum of price * quantity
+    double volume;    // Sum of quantity
+    double vwap;      // notional / volume, 0 without volume
+};
+
+struct MinMax {
+    double min;  // +infinity and -infinity for no values
+    double max;
+};
+
+// Analytics kernels over contiguous price and quantity columns.
+//
+// Every kernel exists as plain scalar code and, on x86-64 builds, as an
+// AVX2/FMA version compiled in its own translation unit. kernels() picks
+// the AVX2 set once, at first use, when the CPU has AVX2 and FMA, and the
+// scalar set otherwise, so one binary runs everywhere. The sets agree up to
+// floating-point rounding: the vector versions sum in a different order.
+struct Kernels {
+    const char* name;  // "avx2" or "scalar"
+
+    VwapResult (*vwap)(const double* prices, const double* quantities, std::size_t count);
+    MinMax (*minMax)(const double* values, std::size_t count);
+
+    // Sample standard deviation of the trade-to-trade returns
+    // prices[i] / prices[i - 1] - 1 over each run of `window` consecutive
+    // returns, oldest window first. Writes rollingVolatilityCount(count,
+    // window) values to out; window must be at least 2.
+    void (*rollingVolatility)(const double* prices, std::size_t count, std::size_t window, double* out);
+
+    // Adds each quantity to volumes[floor((price - low) / bucket_width)];
+    // prices outside the buckets buckets above low are left out. volumes
+    // is not cleared first.
+    void (*volumeProfile)(const double* prices, const double* quantities, std::size_t count, double low,
+                          double bucket_width, std::size_t buckets, double* volumes);
+};
+
+// The fastest set this CPU supports
+const Kernels& kernels();
+const Kernels& scalarKernels();
+// nullptr when the build or the CPU has no AVX2 and FMA
+const Kernels* avx2Kernels();
+
+inline std::size_t rollingVolatilityCount(std::size_t count, std::size_t window) {
+    return window >= 2 && count > window ? count - window : 0;
+}
+
+inline VwapResult vwap(const double* prices, const double* quantities, std::size_t count) {
+    return kernels().vwap(prices, quantities, count);
+}
+
+inline MinMax minMax(const double* values, std::size_t count) {
+    return kernels().minMax(values, count);
+}
+
+inline void rollingVolatility(const double* prices, std::size_t count, std::size_t window, double* out) {
+    kernels().rollingVolatility(prices, count, window, out);
+}
+
+inline void volumeProfile(const double* prices, const double* quantities, std::size_t count, double low,
+                          double bucket_width, std::size_t buckets, double* volumes) {
+    kernels().volumeProfile(prices, quantities, count, low, bucket_width, buckets, volumes);
+}
+
+}}} // namespaces
+
+#endif // MERC_ANALYTICS_KERNELS_HPP
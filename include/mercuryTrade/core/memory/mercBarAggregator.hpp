@@ -0,0 +1,167 @@
+#ifndef MERC_BAR_AGGREGATOR_HPP
+#define MERC_BAR_AGGREGATOR_HPP
+
+#include "mercMarketDataAllocator.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+enum class BarInterval : std::uint8_t {
+    SECOND_1 = 0,
+    MINUTE_1 = 1,
+    MINUTE_5 = 2,
+    HOUR_1 = 3
+};
+
+struct Bar {
+    std::int64_t start;  // Nanoseconds since the epoch, a multiple of the interval
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume;
+    std::uint64_t trades;
+    bool closed;         // False while the interval is still running
+};
+
+// OHLCV bars built incrementally from trades.
+//
+// Every symbol keeps a fixed-size circular array of bars per interval,
+// claimed the first time the symbol trades. A trade updates the current
+// bar of each interval in place, or closes it and starts the next one, so
+// the cost per trade is constant and nothing is allocated once the symbol
+// exists. Intervals without trades get no bar. Range queries binary-search
+// the stored bars and copy them out; nothing is recomputed.
+//
+// A trade older than an interval's current bar, or inside one already
+// closed, is left out of that interval and counted as late. advance()
+// closes bars whose interval has ended without waiting for the next trade.
+// Each symbol has its own lock, held only to update or copy bars; the
+// close listener runs after it is released.
+class BarAggregator {
+public:
+    static constexpr std::size_t INTERVALS = 4;
+
+    struct Config {
+        std::array<std::size_t, INTERVALS> history;  // Bars kept per interval
+        std::size_t max_symbols;
+
+        static Config getDefaultConfig() {
+            return Config{
+                {3600,   // 1s: one hour
+                 1440,   // 1m: one day
+                 2016,   // 5m: one week
+                 720},   // 1h: thirty days
+                64       // max_symbols
+            };
+        }
+    };
+
+    using CloseListener = std::function<void(const std::string& symbol, BarInterval interval, const Bar& bar)>;
+
+    static constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+    explicit BarAggregator(const Config& config = Config::getDefaultConfig());
+
+    BarAggregator(const BarAggregator&) = delete;
+    BarAggregator& operator=(const BarAggregator&) = delete;
+
+    // Called with each bar as it closes; set before trades arrive
+    void setCloseListener(CloseListener listener) { m_listener = std::move(listener); }
+
+    // Returns the symbol's index, claiming its bars on first use. Throws
+    // std::runtime_error once max_symbols are claimed.
+    std::size_t symbolIndex(const std::string& symbol);
+    std::size_t findSymbol(const std::string& symbol) const;  // NOT_FOUND if never claimed
+
+    // Applies a trade at timestamp (nanoseconds since the epoch)
+    void onTrade(std::size_t symbol, double price, double quantity, std::int64_t timestamp);
+    void onTrade(const std::string& symbol, double price, double quantity, std::int64_t timestamp) {
+        onTrade(symbolIndex(symbol), price, quantity, timestamp);
+    }
+
+    // Closes every bar whose interval ended at or before now
+    void advance(std::int64_t now);
+
+    // Bars starting in [from, to), oldest first; at most limit of them,
+    // keeping the newest. Includes the running bar. An unknown symbol
+    // yields no bars.
+    std::vector<Bar> range(const std::string& symbol, BarInterval interval, std::int64_t from, std::int64_t to,
+                           std::size_t limit) const;
+
+    std::uint64_t lateTrades() const { return m_late_trades.load(std::memory_order_relaxed); }
+    std::vector<std::string> symbols() const;
+
+    static std::int64_t intervalNanos(BarInterval interval);
+    static const char* intervalName(BarInterval interval);  // "1s", "1m", "5m" or "1h"
+    // Throws std::invalid_argument for anything but the names above
+    static BarInterval parseInterval(const std::string& name);
+
+private:
+    struct Series {
+        std::unique_ptr<Bar[]> bars;
+        std::size_t capacity{0};
+        std::size_t newest{0};  // Slot of the newest bar
+        std::size_t count{0};
+    };
+
+    struct SymbolBars {
+        std::string symbol;
+        mutable std::mutex mutex;
+        Series series[INTERVALS];
+    };
+
+    Config m_config;
+    std::unique_ptr<SymbolBars[]> m_symbols;
+    std::atomic<std::size_t> m_symbol_count{0};
+    std::unordered_map<std::string, std::size_t> m_symbol_index;
+    mutable std::mutex m_claim_mutex;
+    std::atomic<std::uint64_t> m_late_trades{0};
+    CloseListener m_listener;
+
+    SymbolBars& entry(std::size_t symbol) const;
+};
+
+// Feeds a BarAggregator from the trade rings of a market data allocator,
+// following each symbol's ring with a cursor from the first trade it still
+// holds. Symbols claimed later are picked up on the next drain; those the
+// aggregator has no room for are counted and skipped. Used from one
+// thread, usually the one ingesting the feed.
+class TradeRingBarFeed {
+public:
+    TradeRingBarFeed(const marketDataAllocator& rings, BarAggregator& bars);
+
+    // Applies every trade written since the last call; returns how many
+    std::size_t drain();
+    // Trades overwritten in a ring before they were drained
+    std::uint64_t missedTrades() const { return m_missed; }
+    // Ring symbols the aggregator could not take
+    std::size_t untrackedSymbols() const { return m_untracked; }
+
+private:
+    struct Follower {
+        marketDataAllocator::Cursor cursor;
+        std::size_t bar_index;          // BarAggregator::NOT_FOUND when untracked
+    };
+
+    const marketDataAllocator& m_rings;
+    BarAggregator& m_bars;
+    std::vector<Follower> m_followers;  // Indexed by ring symbol
+    std::uint64_t m_missed{0};
+    std::size_t m_untracked{0};
+};
+
+}}} // namespaces
+
+#endif // MERC_BAR_AGGREGATOR_HPP
@@ -0,0 +1,72 @@
+#ifndef MERC_BOOK_REGION_HPP
+#define MERC_BOOK_REGION_HPP
+
+#include "mercRelativePtr.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+struct PriceLevel;
+
+// Layout of a file-backed order book region:
+//
+//   BookRegionHeader | BookRoot x MAX_BOOKS | order slots | price-level slots
+//
+// Every link inside the region is a RelativePtr and every free list is a
+// chain of slot numbers, so the file can be mapped at any address: by the
+// same process after a restart, or read-only by a monitor.
+struct BookRegionHeader {
+    static constexpr std::uint32_t MAGIC = 0x4B4F4252;  // "RBOK"
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t MAX_BOOKS = 256;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t size;              // Bytes in the whole region
+    std::uint64_t max_orders;
+    std::uint64_t max_price_levels;
+    std::uint64_t order_stride;      // Bytes per order slot
+    std::uint64_t roots_offset;      // Byte offsets from the start of the region
+    std::uint64_t orders_offset;
+    std::uint64_t levels_offset;
+
+    // Pool state; slot numbers are stored plus one, so zero means none
+    std::uint64_t order_high_water;
+    std::uint64_t level_high_water;
+    std::uint64_t free_orders;
+    std::uint64_t free_levels;
+
+    std::uint64_t book_count;
+    std::uint32_t clean;             // Set by an orderly close, cleared while open for writing
+    std::uint32_t reserved;
+
+    // Header for a new region with this geometry, offsets filled in
+    static BookRegionHeader layout(std::size_t max_orders, std::size_t max_price_levels,
+                                   std::size_t order_stride);
+};
+
+// Where one book's levels start, plus the counters it needs to resume.
+//
+// The writer makes version odd while it changes the book and even again
+// once the book is consistent, so a reader in another process copies what
+// it needs and retries if the version moved underneath it.
+struct BookRoot {
+    static constexpr std::size_t SYMBOL_CAPACITY = 32;  // Including the terminating zero
+
+    std::atomic<std::uint64_t> version;
+    char symbol[SYMBOL_CAPACITY];
+    RelativePtr<PriceLevel> best_bid;  // Levels chain best-to-worst through PriceLevel::next
+    RelativePtr<PriceLevel> best_ask;
+    std::uint64_t sequence;
+    std::uint64_t next_trade_id;
+    std::uint64_t fill_count;
+    std::uint64_t resting_orders;
+};
+
+}}} // namespaces
+
+#endif // MERC_BOOK_REGION_HPP
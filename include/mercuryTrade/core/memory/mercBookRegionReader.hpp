@@ -0,0 +1,50 @@
+#ifndef MERC_BOOK_REGION_READER_HPP
+#define MERC_BOOK_REGION_READER_HPP
+
+#include "mercBookRegion.hpp"
+#include "mercLimitOrderBook.hpp"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Read-only view of a persistent order book region, for a monitor running
+// in another process. The file is mapped without write access and books
+// are read in place; a snapshot is retried whenever the owning process
+// changed the book while it was being copied, so it never takes a lock
+// the writer could wait on.
+class BookRegionReader {
+public:
+    // Throws std::runtime_error if the file cannot be mapped or is not an
+    // order book region
+    explicit BookRegionReader(const std::string& path);
+    ~BookRegionReader() noexcept;
+
+    BookRegionReader(const BookRegionReader&) = delete;
+    BookRegionReader& operator=(const BookRegionReader&) = delete;
+
+    // Symbols with a book in the region
+    std::vector<std::string> symbols() const;
+
+    // Up to depth levels per side of the symbol's book, consistent as of
+    // its sequence; std::nullopt if the region has no such book or it kept
+    // changing for the whole of max_attempts copies
+    std::optional<BookSnapshot> snapshot(const std::string& symbol, std::size_t depth,
+                                         std::size_t max_attempts = 1000) const;
+
+private:
+    const char* m_base{nullptr};
+    std::size_t m_size{0};
+    const BookRegionHeader* m_header{nullptr};
+
+    const BookRoot* findRoot(const std::string& symbol) const;
+    bool copyLevels(const PriceLevel* level, std::size_t depth, std::vector<BookLevel>& out) const;
+};
+
+}}} // namespaces
+
+#endif // MERC_BOOK_REGION_READER_HPP
@@ -0,0 +1,18 @@
+#ifndef MERC_CHECKSUM_HPP
+#define MERC_CHECKSUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// CRC-32 (IEEE 802.3) of `length` bytes, continuing from a previous result
+// so large buffers can be checksummed in pieces. Used to spot torn or
+// corrupt data in the journal and snapshot files.
+std::uint32_t crc32(const void* data, std::size_t length, std::uint32_t previous = 0);
+
+}}} // namespaces
+
+#endif // MERC_CHECKSUM_HPP
@@ -0,0 +1,190 @@
+#ifndef MERC_COMMAND_JOURNAL_HPP
+#define MERC_COMMAND_JOURNAL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// One engine command as it is journaled
+struct JournalCommand {
+    enum class Type : std::uint8_t {
+        NEW_ORDER = 1,
+        CANCEL = 2,
+        MODIFY = 3
+    };
+
+    Type type{Type::NEW_ORDER};
+    std::uint64_t sequence{0};   // Assigned by the journal on append
+    std::string order_id;
+    std::string symbol;
+    double price{0.0};           // 0 for market orders
+    double quantity{0.0};
+    bool is_buy{true};
+    bool is_market{false};
+    std::int64_t timestamp{0};   // Nanoseconds since the epoch
+    std::string account;         // Empty for the default account
+};
+
+// Append-only write-ahead log of engine commands.
+//
+// Records are written into fixed-size segment files that are preallocated
+// and memory-mapped, so an append is a bounds check and a copy into the
+// page cache. Each record carries its sequence and a CRC, which lets a
+// reader find exactly where a crash cut the log short. Durability is
+// decided by the sync policy; under GROUP a background thread syncs
+// whatever has accumulated since its previous sync, so one msync covers
+// every append that arrived meanwhile and the wait for an ack never grows
+// beyond roughly two sync latencies, however high the rate. The next
+// segment is prepared off the appending thread.
+class CommandJournal {
+public:
+    enum class SyncPolicy {
+        NONE,      // Never synced here; survives a process crash, not a machine crash
+        INTERVAL,  // Synced every sync_interval; waitDurable() does not block
+        GROUP      // waitDurable() blocks until a group sync covers the record
+    };
+
+    struct Config {
+        std::string directory;
+        std::size_t segment_size;                 // Bytes per segment file
+        SyncPolicy sync_policy;
+        std::chrono::microseconds sync_interval;  // For INTERVAL
+
+        static Config getDefaultConfig(const std::string& directory) {
+            return Config{
+                directory,
+                64 * 1024 * 1024,  // segment_size
+                SyncPolicy::GROUP,
+                std::chrono::microseconds(1000)
+            };
+        }
+    };
+
+    struct Stats {
+        std::uint64_t last_sequence;
+        std::uint64_t durable_sequence;
+        std::size_t syncs;
+        std::size_t segments;
+        std::size_t bytes_appended;
+    };
+
+    // Opens the journal in config.directory, creating it if needed, and
+    // continues after the last intact record. Throws std::runtime_error on
+    // I/O failure.
+    explicit CommandJournal(const Config& config);
+    ~CommandJournal() noexcept;
+
+    CommandJournal(const CommandJournal&) = delete;
+    CommandJournal& operator=(const CommandJournal&) = delete;
+
+    // Writes the command and returns its sequence. Throws std::length_error
+    // for a record that cannot fit in a segment.
+    std::uint64_t append(const JournalCommand& command);
+
+    // Blocks until the record with this sequence is durable under the sync
+    // policy. Throws std::runtime_error if syncing has failed.
+    void waitDurable(std::uint64_t sequence);
+
+    // Syncs everything appended so far, whatever the policy
+    void sync();
+
+    // Deletes the segment files that hold only records below this sequence,
+    // e.g. once a snapshot covers them. The active segment is always kept.
+    // Returns the number of files removed.
+    std::size_t truncateBefore(std::uint64_t sequence);
+
+    std::uint64_t lastSequence() const;
+    std::uint64_t durableSequence() const;
+    Stats getStats() const;
+    const std::string& directory() const { return m_config.directory; }
+
+    static constexpr std::size_t SEGMENT_HEADER_SIZE = 64;
+
+private:
+    struct Segment;
+    struct Retired {
+        std::shared_ptr<Segment> segment;
+        std::size_t from;
+        std::size_t to;
+    };
+
+    Config m_config;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_work;     // Wakes the sync thread
+    std::condition_variable m_durable;  // Wakes waitDurable()
+    std::shared_ptr<Segment> m_segment;
+    std::shared_ptr<Segment> m_spare;   // Preallocated next segment
+    std::vector<Retired> m_retired;     // Full segments with unsynced tails
+    std::size_t m_offset{0};            // Next write position in m_segment
+    std::size_t m_synced_offset{0};     // m_segment is synced below this
+    std::uint64_t m_next_sequence{1};
+    std::uint64_t m_durable_sequence{0};
+    std::uint32_t m_next_index{1};      // File number of the next segment
+    std::size_t m_syncs{0};
+    std::size_t m_segments{0};
+    std::size_t m_bytes_appended{0};
+    bool m_failed{false};
+    bool m_stopping{false};
+    bool m_sync_idle{false};    // Sync thread is waiting for work
+    bool m_spare_failed{false};
+
+    std::mutex m_sync_mutex;  // One sync at a time; taken before m_mutex
+    std::thread m_sync_thread;
+
+    void recover();
+    std::shared_ptr<Segment> createSegment(std::uint32_t index);
+    void activate(const std::shared_ptr<Segment>& segment, std::uint64_t first_sequence);
+    void roll();
+    void prepareSpare();
+    void flush();
+    void runSync();
+};
+
+// Reads a journal directory in sequence order. Reading stops at the first
+// torn, corrupt or out-of-sequence record, which is where a crash
+// interrupted the writer. Records up to after_sequence are skipped without
+// opening the segments that hold nothing newer, so replaying the tail
+// behind a snapshot does not read the whole log.
+class JournalReader {
+public:
+    explicit JournalReader(const std::string& directory, std::uint64_t after_sequence = 0);
+    ~JournalReader() noexcept;
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    // Reads the next record into command; false at the end of the log
+    bool next(JournalCommand& command);
+
+    // Sequence of the last record read, or of the last one skipped
+    std::uint64_t lastSequence() const { return m_last_sequence; }
+
+private:
+    std::vector<std::pair<std::uint64_t, std::string>> m_segments;  // By first sequence
+    std::uint64_t m_after_sequence;
+    std::size_t m_segment_index{0};
+    const unsigned char* m_base{nullptr};
+    std::size_t m_size{0};
+    std::size_t m_offset{0};
+    std::uint64_t m_last_sequence{0};
+    bool m_done{false};
+
+    bool openNext();
+    void closeCurrent();
+};
+
+}}} // namespaces
+
+#endif // MERC_COMMAND_JOURNAL_HPP
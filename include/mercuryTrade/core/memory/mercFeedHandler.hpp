@@ -0,0 +1,180 @@
+#ifndef MERC_FEED_HANDLER_HPP
+#define MERC_FEED_HANDLER_HPP
+
+#include "mercLastValueCache.hpp"
+#include "mercMarketDataAllocator.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Market-data feed protocol. A packet is a 16-byte header followed by
+// fixed-size messages, all little-endian:
+//
+//   header:  u32 magic | u16 message count | u16 reserved | u64 reserved
+//   message: u8 type | u8 flags | u16 symbol id | u32 reserved |
+//            u64 sequence | i64 timestamp (ns) | f64 a | f64 b | f64 c | f64 d
+//
+// A DEFINITION maps a symbol id to the name stored in a..d (up to 31
+// characters, zero-padded). A QUOTE carries bid, bid size, ask, ask size
+// in a..d; a TRADE carries price and quantity in a and b, with flag bit 0
+// set when the buyer was the aggressor. Sequences run across the whole
+// feed, so a jump means messages were lost.
+namespace feed {
+constexpr std::uint32_t PACKET_MAGIC = 0x4446454D;  // "MEFD"
+constexpr std::size_t HEADER_SIZE = 16;
+constexpr std::size_t MESSAGE_SIZE = 56;
+constexpr std::size_t MAX_PACKET_SIZE = 1472;  // One Ethernet-sized UDP datagram
+constexpr std::size_t MAX_MESSAGES = (MAX_PACKET_SIZE - HEADER_SIZE) / MESSAGE_SIZE;
+constexpr std::size_t SYMBOL_CAPACITY = 32;
+
+enum class MessageType : std::uint8_t {
+    DEFINITION = 1,
+    QUOTE = 2,
+    TRADE = 3
+};
+
+// Builds one packet at a time
+class PacketWriter {
+public:
+    PacketWriter() { clear(); }
+
+    void clear();
+    // Each returns false, leaving the packet as it was, once it is full
+    bool definition(std::uint16_t symbol_id, const std::string& symbol, std::uint64_t sequence);
+    bool quote(std::uint16_t symbol_id, std::uint64_t sequence, std::int64_t timestamp, double bid,
+               double bid_size, double ask, double ask_size);
+    bool trade(std::uint16_t symbol_id, std::uint64_t sequence, std::int64_t timestamp, double price,
+               double quantity, bool buyer_aggressor);
+
+    std::size_t messages() const { return m_count; }
+    const std::string& data() const { return m_data; }
+
+private:
+    std::string m_data;
+    std::size_t m_count{0};
+
+    char* append(MessageType type, std::uint8_t flags, std::uint16_t symbol_id, std::uint64_t sequence,
+                 std::int64_t timestamp);
+};
+} // namespace feed
+
+// Where packets come from. Implementations are polled from the feed
+// thread only.
+class FeedSource {
+public:
+    virtual ~FeedSource() = default;
+    // Copies the next packet into buffer and returns its size, or 0 if
+    // none is waiting. Throws std::runtime_error on a transport failure.
+    virtual std::size_t receive(char* buffer, std::size_t capacity) = 0;
+    // True once nothing more can arrive, e.g. at the end of a capture file
+    virtual bool exhausted() const { return false; }
+};
+
+// Non-blocking UDP socket bound to a local port; port 0 picks a free one
+class UdpFeedSource : public FeedSource {
+public:
+    explicit UdpFeedSource(std::uint16_t port, const std::string& address = "127.0.0.1");
+    ~UdpFeedSource() override;
+
+    UdpFeedSource(const UdpFeedSource&) = delete;
+    UdpFeedSource& operator=(const UdpFeedSource&) = delete;
+
+    std::size_t receive(char* buffer, std::size_t capacity) override;
+    std::uint16_t port() const { return m_port; }
+
+private:
+    int m_socket{-1};
+    std::uint16_t m_port{0};
+};
+
+// Replays a capture file: each packet preceded by its u32 length
+class FileFeedSource : public FeedSource {
+public:
+    explicit FileFeedSource(const std::string& path);
+
+    std::size_t receive(char* buffer, std::size_t capacity) override;
+    bool exhausted() const override { return m_exhausted; }
+
+    // Appends packets to a capture file in the format read above
+    static void writeCapture(const std::string& path, const std::vector<std::string>& packets);
+
+private:
+    std::ifstream m_file;
+    bool m_exhausted{false};
+};
+
+// Ingestion stage for one feed. Decodes each packet straight into the
+// symbol's quote or trade ring in the market data allocator, then applies
+// it to the last value cache. Steady-state ingestion does not allocate:
+// symbol ids resolve through a table filled in by DEFINITION messages,
+// which is also when a symbol's rings are claimed.
+//
+// One thread feeds the handler; consumers on other threads follow a
+// symbol's rings with allocator cursors.
+class FeedHandler {
+public:
+    struct Stats {
+        std::uint64_t packets;
+        std::uint64_t quotes;
+        std::uint64_t trades;
+        std::uint64_t definitions;
+        std::uint64_t malformed;        // Packets or messages that failed to decode
+        std::uint64_t unknown_symbols;  // Messages for ids that were never defined
+        std::uint64_t rejected_definitions;  // Past the cache's or the rings' symbol capacity
+        std::uint64_t gaps;             // Sequence jumps
+        std::uint64_t lost_messages;    // Messages skipped over by those jumps
+    };
+
+    FeedHandler(LastValueCache& cache, marketDataAllocator& allocator);
+
+    FeedHandler(const FeedHandler&) = delete;
+    FeedHandler& operator=(const FeedHandler&) = delete;
+
+    // Decodes one packet; returns the number of quotes and trades in it
+    std::size_t onPacket(const char* data, std::size_t size);
+    // Handles up to max_packets waiting in the source; returns how many
+    std::size_t poll(FeedSource& source, std::size_t max_packets = 64);
+    // Polls until stop is set or the source is exhausted
+    void run(FeedSource& source, const std::atomic<bool>& stop);
+
+    // Quotes and trades published so far
+    std::uint64_t ticksWritten() const;
+
+    Stats getStats() const;
+
+private:
+    struct Route {
+        std::uint32_t cache_index;  // LastValueCache index + 1; zero until defined
+        std::uint32_t ring_index;   // marketDataAllocator symbol index
+    };
+
+    LastValueCache& m_cache;
+    marketDataAllocator& m_allocator;
+
+    std::vector<Route> m_symbols;          // Indexed by feed symbol id
+    std::uint64_t m_expected_sequence{0};  // 0 until the first message
+    std::vector<char> m_receive_buffer;
+
+    std::atomic<std::uint64_t> m_packets{0};
+    std::atomic<std::uint64_t> m_quotes{0};
+    std::atomic<std::uint64_t> m_trades{0};
+    std::atomic<std::uint64_t> m_definitions{0};
+    std::atomic<std::uint64_t> m_malformed{0};
+    std::atomic<std::uint64_t> m_unknown_symbols{0};
+    std::atomic<std::uint64_t> m_rejected_definitions{0};
+    std::atomic<std::uint64_t> m_gaps{0};
+    std::atomic<std::uint64_t> m_lost_messages{0};
+
+    void checkSequence(std::uint64_t sequence);
+};
+
+}}} // namespaces
+
+#endif // MERC_FEED_HANDLER_HPP
@@ -0,0 +1,73 @@
+#ifndef MERC_FEED_SIMULATOR_HPP
+#define MERC_FEED_SIMULATOR_HPP
+
+#include "mercFeedHandler.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Local stand-in for an exchange feed. Produces packets in the feed
+// protocol: first a definition for every symbol, then quotes and trades
+// from a random walk around each symbol's starting price. The packets can
+// go straight into a FeedHandler, into a capture file for FileFeedSource,
+// or over UDP to a UdpFeedSource.
+class FeedSimulator {
+public:
+    struct Config {
+        std::vector<std::string> symbols;
+        double start_price;
+        double tick_size;                 // Smallest price move
+        double trade_ratio;               // Share of messages that are trades
+        std::size_t messages_per_packet;  // Capped at feed::MAX_MESSAGES
+        std::uint64_t seed;
+
+        static Config getDefaultConfig() {
+            return Config{
+                {"BTC-USD", "ETH-USD", "SOL-USD"},
+                50000.0,  // start_price
+                0.5,      // tick_size
+                0.2,      // trade_ratio
+                20,       // messages_per_packet
+                42        // seed
+            };
+        }
+    };
+
+    explicit FeedSimulator(const Config& config = Config::getDefaultConfig());
+
+    // The next packet; valid until the following call
+    const std::string& nextPacket();
+    std::vector<std::string> packets(std::size_t count);
+
+    // Sends count packets to address:port, paced to messages_per_second
+    // when it is non-zero. Throws std::runtime_error if sending fails.
+    void sendUdp(const std::string& address, std::uint16_t port, std::size_t count,
+                 std::size_t messages_per_second = 0);
+
+    std::uint64_t messagesSent() const { return m_sequence - 1; }
+
+private:
+    struct SymbolState {
+        double mid;
+        double spread;  // In ticks
+    };
+
+    Config m_config;
+    std::vector<SymbolState> m_state;
+    std::mt19937_64 m_random;
+    feed::PacketWriter m_writer;
+    std::uint64_t m_sequence{1};
+    std::size_t m_defined{0};  // Symbols defined so far
+
+    void addTick(std::int64_t timestamp);
+};
+
+}}} // namespaces
+
+#endif // MERC_FEED_SIMULATOR_HPP
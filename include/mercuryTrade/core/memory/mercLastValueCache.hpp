@@ -0,0 +1,87 @@
+#ifndef MERC_LAST_VALUE_CACHE_HPP
+#define MERC_LAST_VALUE_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Latest quote and trade for each symbol, for readers on any thread.
+//
+// Every symbol has a cache-line-aligned entry guarded by its own seqlock,
+// so a reader copies the values and retries only if the writer was in the
+// middle of an update; reads never lock or allocate. Symbols are claimed
+// once and never removed, and the symbol index is an open-addressed table
+// readers probe without locking. Each symbol must be updated from one
+// thread at a time, e.g. the feed handler thread.
+class LastValueCache {
+public:
+    struct Values {
+        double bid;
+        double bid_size;
+        double ask;
+        double ask_size;
+        double last;           // Price of the latest trade
+        double last_size;
+        double volume;         // Quantity traded since the symbol was claimed
+        std::uint64_t trades;
+        std::int64_t timestamp;  // Nanoseconds since the epoch of the latest update
+        std::uint64_t sequence;  // Feed sequence of the latest update
+    };
+
+    static constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+    explicit LastValueCache(std::size_t max_symbols = 1024);
+
+    LastValueCache(const LastValueCache&) = delete;
+    LastValueCache& operator=(const LastValueCache&) = delete;
+
+    // Writer side. index() claims the symbol on first use; throws
+    // std::runtime_error once max_symbols are taken and
+    // std::invalid_argument for an empty symbol.
+    std::size_t index(const std::string& symbol);
+    void updateQuote(std::size_t index, double bid, double bid_size, double ask, double ask_size,
+                     std::int64_t timestamp, std::uint64_t sequence);
+    void updateTrade(std::size_t index, double price, double quantity, std::int64_t timestamp,
+                     std::uint64_t sequence);
+    // Replaces every value, e.g. from a consolidated snapshot
+    void set(std::size_t index, const Values& values);
+
+    // Reader side, lock-free
+    std::size_t find(const std::string& symbol) const;  // NOT_FOUND if never claimed
+    bool read(std::size_t index, Values& out) const;    // False until the first update
+    bool read(const std::string& symbol, Values& out) const;
+    std::vector<std::string> symbols() const;           // In the order they were claimed
+    std::size_t size() const { return m_count.load(std::memory_order_acquire); }
+    std::size_t capacity() const { return m_max_symbols; }
+
+private:
+    struct alignas(64) Entry {
+        std::atomic<std::uint64_t> version{0};  // Odd while being written
+        Values values{};
+        std::string symbol;                       // Set before the entry is published
+    };
+
+    std::size_t m_max_symbols;
+    std::unique_ptr<Entry[]> m_entries;
+    std::size_t m_table_mask;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_table;  // Entry index + 1; zero is empty
+    std::atomic<std::size_t> m_count{0};
+    std::mutex m_claim_mutex;
+
+    std::size_t slotFor(const std::string& symbol) const;
+    template <typename Update>
+    void write(std::size_t index, Update&& update);
+};
+
+}}} // namespaces
+
+#endif // MERC_LAST_VALUE_CACHE_HPP
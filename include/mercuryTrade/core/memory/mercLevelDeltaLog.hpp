@@ -0,0 +1,42 @@
+#ifndef MERC_LEVEL_DELTA_LOG_HPP
+#define MERC_LEVEL_DELTA_LOG_HPP
+
+#include "mercLimitOrderBook.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Bounded history of a book's most recent level deltas. A client that
+// detects a sequence gap asks for everything after the last sequence it
+// applied; if that has already been overwritten it must start again from
+// a snapshot.
+class LevelDeltaLog {
+public:
+    explicit LevelDeltaLog(std::size_t capacity);
+
+    // Deltas must be appended in sequence order
+    void append(const LevelDelta& delta);
+
+    // Appends every retained delta with seq > after_seq to `out`. Returns
+    // false when deltas after `after_seq` have already been discarded.
+    bool since(std::uint64_t after_seq, std::vector<LevelDelta>& out) const;
+
+    std::uint64_t lastSequence() const;
+    std::size_t size() const;
+    std::size_t capacity() const { return m_ring.size(); }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<LevelDelta> m_ring;
+    std::size_t m_head{0};   // Slot the next delta is written to
+    std::size_t m_count{0};
+};
+
+}}} // namespaces
+
+#endif // MERC_LEVEL_DELTA_LOG_HPP
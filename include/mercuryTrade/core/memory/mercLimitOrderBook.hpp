@@ -0,0 +1,224 @@
+#ifndef MERC_LIMIT_ORDER_BOOK_HPP
+#define MERC_LIMIT_ORDER_BOOK_HPP
+
+#include "mercOrderBookAllocator.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+class SnapshotWriter;
+class SnapshotReader;
+
+enum class BookSide {
+    BID,
+    ASK
+};
+
+// One change to the aggregated book: the level at (side, price) now holds
+// `size` across `order_count` orders. A size of zero removes the level.
+// Sequence numbers are per book and increase by exactly one per delta, so a
+// consumer that sees a jump knows it missed something.
+struct LevelDelta {
+    std::uint64_t seq;
+    BookSide side;
+    double price;
+    double size;
+    std::size_t order_count;
+};
+
+struct BookFill {
+    std::uint64_t trade_id;
+    std::string maker_order_id;
+    std::string taker_order_id;
+    BookSide taker_side;
+    double price;
+    double quantity;
+};
+
+// Best price and size on each side as of `seq`; a price and size of zero
+// mean that side is empty
+struct BookTop {
+    std::uint64_t seq;
+    double bid;
+    double bid_size;
+    double ask;
+    double ask_size;
+};
+
+struct BookLevel {
+    double price;
+    double size;
+    std::size_t order_count;
+};
+
+// Aggregated view of a book taken atomically at sequence `seq`; applying
+// every delta with a higher sequence brings it up to date.
+struct BookSnapshot {
+    std::string symbol;
+    std::uint64_t seq;
+    std::vector<BookLevel> bids;  // Best (highest) first
+    std::vector<BookLevel> asks;  // Best (lowest) first
+};
+
+// Price-time priority book for one symbol, built on the OrderNode and
+// PriceLevel pools of an OrderBookAllocator. Every time a PriceLevel's
+// aggregate changes the book emits a LevelDelta, so downstream consumers
+// never have to diff whole books.
+//
+// On persistent pools the book keeps its root in the region up to date
+// after every change and, when constructed over a region that already
+// holds it, resumes from there with its levels, queues and counters.
+class LimitOrderBook {
+public:
+    using DeltaListener = std::function<void(const LevelDelta&)>;
+    using FillListener = std::function<void(const BookFill&)>;
+    using TopListener = std::function<void(const BookTop&)>;
+
+    struct Result {
+        bool accepted;
+        double filled_quantity;
+        double resting_quantity;
+    };
+
+    // One entry of a batch submission
+    struct BatchOrder {
+        std::string order_id;
+        BookSide side;
+        double price;
+        double quantity;
+        bool market;
+    };
+
+    struct Stats {
+        std::size_t bid_levels;
+        std::size_t ask_levels;
+        std::size_t resting_orders;
+        std::uint64_t deltas;
+        std::uint64_t fills;
+    };
+
+    LimitOrderBook(std::string symbol, OrderBookAllocator& allocator);
+    // Releases the book's levels and orders, unless the pools are
+    // persistent, in which case they stay for the next process
+    ~LimitOrderBook();
+
+    LimitOrderBook(const LimitOrderBook&) = delete;
+    LimitOrderBook& operator=(const LimitOrderBook&) = delete;
+
+    // Matches against the opposite side, then rests any remainder. Market
+    // orders never rest; whatever cannot be filled is dropped.
+    Result addOrder(const std::string& order_id, BookSide side, double price, double quantity,
+                    bool market = false);
+    bool cancelOrder(const std::string& order_id);
+    // Reduces a resting order in place, keeping its time priority
+    bool reduceOrder(const std::string& order_id, double new_quantity);
+
+    // Batch forms of the above: the book is locked once for the whole batch,
+    // entries are applied in order and results line up with the input
+    std::vector<Result> addOrders(const std::vector<BatchOrder>& orders);
+    std::vector<bool> cancelOrders(const std::vector<std::string>& order_ids);
+    // Removes every resting order, emitting one delta per cleared level;
+    // returns the ids of the orders removed
+    std::vector<std::string> cancelAll();
+
+    // Best `depth` levels per side. With a positive bucket, levels are
+    // summed into price buckets (bids rounded down, asks up to a multiple
+    // of it) and `depth` counts buckets. Only the levels that make up the
+    // returned buckets are visited.
+    BookSnapshot snapshot(std::size_t depth = std::numeric_limits<std::size_t>::max(),
+                          double bucket = 0.0) const;
+    std::uint64_t sequence() const { return m_sequence.load(std::memory_order_acquire); }
+    const std::string& symbol() const { return m_symbol; }
+    double bestBid() const;
+    double bestAsk() const;
+    Stats getStats() const;
+
+    // Listeners run on the writing thread while the book is locked, in
+    // sequence order; they must be quick and must not call back into the book.
+    void setDeltaListener(DeltaListener listener);
+    void setFillListener(FillListener listener);
+    // Called once per operation (or batch) that moved the best price or
+    // size on either side, after the whole operation has been applied. It
+    // must not throw.
+    void setTopListener(TopListener listener);
+
+    // Appends every resting order, level by level from the best price and in
+    // time priority within a level, along with the sequence and trade-id
+    // counters. Takes no lock: call it from the only writing thread, or in a
+    // process forked from it, where another thread may have died holding the
+    // lock.
+    void saveState(SnapshotWriter& out) const;
+    // Rebuilds an empty book from saveState() output without matching or
+    // emitting deltas. Throws std::logic_error if the book is not empty and
+    // std::runtime_error if the data is truncated or the pools run out.
+    void loadState(SnapshotReader& in);
+
+private:
+    std::string m_symbol;
+    OrderBookAllocator& m_allocator;
+    BookRoot* m_root{nullptr};  // Only with persistent pools
+    mutable std::mutex m_mutex;
+
+    // Price index for each side; the levels themselves are also chained
+    // best-to-worst through PriceLevel::next for cheap traversal.
+    std::map<double, PriceLevel*, std::greater<double>> m_bids;
+    std::map<double, PriceLevel*> m_asks;
+
+    std::atomic<std::uint64_t> m_sequence{0};
+    std::uint64_t m_next_trade_id{1};
+    std::size_t m_resting_orders{0};
+    std::uint64_t m_fill_count{0};
+
+    DeltaListener m_delta_listener;
+    FillListener m_fill_listener;
+    TopListener m_top_listener;
+    BookTop m_top{};  // As last reported to m_top_listener
+
+    // Brackets a change to the book: once it is complete, publishes the
+    // persistent root for its readers and reports a new top of book
+    class WriteScope {
+    public:
+        explicit WriteScope(LimitOrderBook& book);
+        ~WriteScope();
+    private:
+        LimitOrderBook& m_book;
+    };
+
+    void resumeFromRoot();
+
+    template <typename Levels>
+    double matchAgainst(Levels& levels, BookSide maker_side, const std::string& taker_id,
+                        BookSide taker_side, double limit, double quantity, bool market);
+    template <typename Levels>
+    bool rest(Levels& levels, BookSide side, const std::string& order_id, double price, double quantity,
+              bool emit = true);
+    template <typename Levels>
+    void saveSide(const Levels& levels, SnapshotWriter& out) const;
+    template <typename Levels>
+    void loadSide(Levels& levels, BookSide side, SnapshotReader& in);
+    template <typename Levels>
+    void removeLevel(Levels& levels, PriceLevel* level);
+
+    Result addLocked(const std::string& order_id, BookSide side, double price, double quantity, bool market);
+    bool cancelLocked(const std::string& order_id);
+    template <typename Levels>
+    void clearSide(Levels& levels, BookSide side, std::vector<std::string>& cancelled);
+    bool findSide(const PriceLevel* level, BookSide& side) const;
+    void emitDelta(BookSide side, const PriceLevel& level);
+    static void collectLevels(const PriceLevel* level, std::size_t depth, double bucket, bool round_down,
+                              std::vector<BookLevel>& out);
+};
+
+}}} // namespaces
+
+#endif // MERC_LIMIT_ORDER_BOOK_HPP
@@ -1,13 +1,50 @@
 #ifndef MERC_MARKET_DATA_ALLOCATOR_HPP
 #define MERC_MARKET_DATA_ALLOCATOR_HPP
 
-#include "mercAllocatorManager.hpp"
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 
 namespace mercuryTrade{
     namespace core{
         namespace memory{
+            // Records the default slot sizes are chosen for
+            struct MarketQuote{
+                std::uint64_t sequence;
+                std::int64_t timestamp;   // Nanoseconds since the epoch
+                double bid;
+                double bid_size;
+                double ask;
+                double ask_size;
+            };
+
+            struct MarketTrade{
+                std::uint64_t sequence;
+                std::int64_t timestamp;   // Nanoseconds since the epoch
+                double price;
+                double quantity;
+                std::uint8_t buyer_aggressor;
+            };
+
+            // Per-symbol ring buffers for market data.
+            //
+            // Each symbol claims a quote, a trade and a snapshot ring of
+            // buffer_capacity slots, all carved from one allocation made
+            // when the symbol is first seen. From then on publishing only
+            // copies into the next slot, overwriting the oldest record once
+            // the ring is full, so steady-state ingest never allocates.
+            //
+            // One thread at a time publishes to a given ring. Readers on
+            // any thread follow it with a cursor and never block the
+            // writer; a reader that falls a whole ring behind skips ahead
+            // and is told how many records it missed. Rings are never
+            // released before the allocator is destroyed.
             class marketDataAllocator{
                 public:
                     struct bufferConfig{
@@ -15,42 +52,132 @@ namespace mercuryTrade{
                         std::size_t trade_size; // size for trade messages
                         std::size_t snapshot_size; // size for market snapshot
                         std::size_t buffer_capacity; // Number of messages per buffer
+                        std::size_t max_symbols = 64; // Symbols that can claim rings
+                    };
+
+                    enum class Channel : std::uint8_t{
+                        QUOTE = 0,
+                        TRADE = 1,
+                        SNAPSHOT = 2
+                    };
+
+                    static constexpr std::size_t CHANNELS = 3;
+                    static constexpr std::size_t MAX_READERS = 8; // Cursors per ring
+                    static constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+                private:
+                    static constexpr std::uint64_t FREE_READER = UINT64_MAX;
+
+                    struct Ring{
+                        char* slots{nullptr};
+                        std::size_t stride{0};    // Slot header plus payload, cache-line rounded
+                        std::size_t payload{0};   // Largest record the ring takes
+                        alignas(64) std::atomic<std::uint64_t> written{0};
+                        alignas(64) std::atomic<std::uint64_t> readers[MAX_READERS]; // Next record per cursor
+                    };
+
+                    struct SymbolRings{
+                        std::string symbol;
+                        Ring rings[CHANNELS];
+                        char* memory{nullptr};
+                    };
+
+                public:
+                    // Reads one ring in order. Registered with the ring while it
+                    // lives, so occupancy() and hasCapacity() account for it.
+                    class Cursor{
+                        public:
+                            Cursor() = default;
+                            ~Cursor();
+                            Cursor(Cursor&& other) noexcept;
+                            Cursor& operator = (Cursor&& other) noexcept;
+                            Cursor(const Cursor&) = delete;
+                            Cursor& operator = (const Cursor&) = delete;
+
+                            explicit operator bool() const { return m_ring != nullptr; }
+                            // Number of the next record to read, counting from 0
+                            std::uint64_t position() const { return m_next; }
+
+                        private:
+                            friend class marketDataAllocator;
+                            const Ring* m_ring{nullptr};
+                            std::atomic<std::uint64_t>* m_registration{nullptr};
+                            std::uint64_t m_next{0};
+
+                            void release();
+                    };
+
+                    struct allocationStats{
+                        std::size_t symbols;           // Symbols holding rings
+                        std::uint64_t quotes_written;
+                        std::uint64_t trades_written;
+                        std::uint64_t snapshots_written;
+                        std::size_t total_memory_used; // Bytes held by the rings
                     };
+
                 private:
-                    AllocatorManager m_allocator;
                     bufferConfig m_config;
-                    std::atomic<std::size_t> m_quotes_allocated{0};
-                    std::atomic<std::size_t> m_trades_allocated{0};
-                    std::atomic<std::size_t> m_snapshots_allocated{0};
+                    std::size_t m_strides[CHANNELS];
+                    std::size_t m_payloads[CHANNELS];
+                    std::unique_ptr<SymbolRings[]> m_symbols;
+                    std::atomic<std::size_t> m_symbol_count{0};
+                    std::unordered_map<std::string, std::size_t> m_symbol_index;
+                    mutable std::mutex m_claim_mutex;
+
+                    Ring& ring(std::size_t symbol, Channel channel) const;
+                    void publishBytes(std::size_t symbol, Channel channel, const void* record, std::size_t size);
+                    bool readBytes(Cursor& cursor, void* out, std::size_t size, std::uint64_t* missed) const;
+
                 public:
                     // initialize with specific buffer sizes
                     explicit marketDataAllocator(const bufferConfig& config = getDefaultConfig());
+                    ~marketDataAllocator();
 
-                    // Prevent copying
+                    // Prevent copying; cursors point into the rings, so no moving either
                     marketDataAllocator(const marketDataAllocator&) = delete;
                     marketDataAllocator& operator = (const marketDataAllocator&) = delete;
 
-                    // Allow moving
-                    marketDataAllocator(marketDataAllocator&&) noexcept = default;
-                    marketDataAllocator& operator = (marketDataAllocator&&) noexcept = default;
+                    // Returns the symbol's index, claiming its rings on first use.
+                    // Throws std::runtime_error once max_symbols are claimed.
+                    std::size_t symbolIndex(const std::string& symbol);
+                    std::size_t findSymbol(const std::string& symbol) const; // NOT_FOUND if never claimed
+                    // Symbols claimed so far take indexes 0 to symbolCount() - 1
+                    std::size_t symbolCount() const { return m_symbol_count.load(std::memory_order_acquire); }
+                    const std::string& symbolName(std::size_t symbol) const;
 
-                    // Allocation methods for different market data types
-                    void* allocateQuoteBuffer();
-                    void* allocateTradeBuffer();
-                    void* allocateSnapshotBuffer();
+                    // Copies record into the channel's next slot. T must be
+                    // trivially copyable and fit the channel's slot size.
+                    template <typename T>
+                    void publish(std::size_t symbol, Channel channel, const T& record){
+                        static_assert(std::is_trivially_copyable<T>::value, "Ring records are copied bytewise");
+                        publishBytes(symbol, channel, &record, sizeof(T));
+                    }
 
-                    void deallocateBuffer(void* ptr, std::size_t size);
+                    // A cursor at the next record to be written, or with from_oldest
+                    // at the oldest one the ring still holds. Throws
+                    // std::runtime_error when MAX_READERS cursors are open.
+                    Cursor subscribe(std::size_t symbol, Channel channel, bool from_oldest = false) const;
 
-                    // statistics and monitoring
-                    struct allocationStats{
-                        std::size_t quotes_allocated;
-                        std::size_t trades_allocated;
-                        std::size_t snapshots_allocated;
-                        std::size_t total_memory_used;
-                    };
+                    // Copies the cursor's next record into out and advances it;
+                    // false if nothing new was written. Records overwritten before
+                    // they were read are skipped and added to *missed if given.
+                    template <typename T>
+                    bool read(Cursor& cursor, T& out, std::uint64_t* missed = nullptr) const{
+                        static_assert(std::is_trivially_copyable<T>::value, "Ring records are copied bytewise");
+                        return readBytes(cursor, &out, sizeof(T), missed);
+                    }
 
+                    // Records written to the ring so far
+                    std::uint64_t written(std::size_t symbol, Channel channel) const;
+                    // Records the slowest open cursor has yet to read, at most
+                    // buffer_capacity; 0 when no cursor is open
+                    std::size_t occupancy(std::size_t symbol, Channel channel) const;
+
+                    // statistics and monitoring
                     allocationStats getStats() const;
 
+                    // False while some open cursor is a whole ring behind, i.e. the
+                    // next publish there would overwrite a record it has not read
                     bool hasCapacity() const noexcept;
 
                     bufferConfig getConfig() const {
@@ -64,7 +191,8 @@ namespace mercuryTrade{
                             64, // quote size
                             48, // trade size
                             1024, // snapshot size
-                            1000 // buffer capacity
+                            1000, // buffer capacity
+                            64 // max symbols
                         };
                     }
 
@@ -73,4 +201,4 @@ namespace mercuryTrade{
     }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,141 @@
+#ifndef MERC_MARKET_DATA_BUS_HPP
+#define MERC_MARKET_DATA_BUS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Top of book for one symbol; a price and size of zero mean that side is empty
+struct BusQuote {
+    std::uint64_t seq;        // Book sequence the quote reflects
+    double bid;
+    double bid_size;
+    double ask;
+    double ask_size;
+    std::int64_t timestamp;   // Nanoseconds since the epoch, set by the producer
+};
+
+struct BusTrade {
+    std::uint64_t trade_id;
+    double price;
+    double quantity;
+    std::int64_t timestamp;
+    std::uint8_t buyer_aggressor;  // 1 if the taker bought
+};
+
+// Layout of a market-data bus segment:
+//
+//   MarketDataBusHeader | channel x max_symbols
+//
+// where each channel is a BusChannel followed by its ring of
+// trade_capacity BusTradeSlots. The quote is a seqlock: its version is odd
+// while the producer writes it. Each trade slot carries the number of the
+// trade it holds, zero while it is being overwritten, so a reader can tell
+// both a torn read and a slot that has moved on to a later trade.
+struct MarketDataBusHeader {
+    static constexpr std::uint32_t MAGIC = 0x5355424D;  // "MBUS"
+    static constexpr std::uint32_t VERSION = 1;
+
+    std::atomic<std::uint32_t> magic;  // Stored last, once the segment is laid out
+    std::uint32_t version;
+    std::uint64_t size;
+    std::uint64_t channels_offset;
+    std::uint64_t channel_stride;
+    std::uint32_t max_symbols;
+    std::uint32_t trade_capacity;
+    std::atomic<std::uint32_t> symbol_count;  // Channels below this are claimed
+    std::atomic<std::uint32_t> live;          // Cleared when the producer closes the bus
+};
+
+struct BusTradeSlot {
+    std::atomic<std::uint64_t> number;  // 1-based trade number held, 0 while writing
+    BusTrade trade;
+};
+
+struct BusChannel {
+    static constexpr std::size_t SYMBOL_CAPACITY = 32;  // Including the terminating zero
+
+    char symbol[SYMBOL_CAPACITY];
+    alignas(64) std::atomic<std::uint64_t> quote_version;
+    BusQuote quote;
+    alignas(64) std::atomic<std::uint64_t> trades_written;
+
+    BusTradeSlot* slots() { return reinterpret_cast<BusTradeSlot*>(this + 1); }
+    const BusTradeSlot* slots() const { return reinterpret_cast<const BusTradeSlot*>(this + 1); }
+};
+
+// Producer side of a shared-memory market-data bus, for strategy processes
+// on the same host. Each symbol gets a channel holding its latest quote
+// and a ring of its recent trades; publishing is a few stores into the
+// mapped segment and readers never take a lock or make a system call, so
+// a reader sees an update as soon as its cache line arrives.
+//
+// There is one producer per bus, and each symbol must be published from
+// one thread at a time, e.g. under its book's lock. A reader that falls
+// more than trade_capacity trades behind loses the oldest ones and is told
+// how many.
+class MarketDataBus {
+public:
+    struct Config {
+        std::string name;             // POSIX shared-memory name, e.g. "/mercury-md"
+        std::size_t max_symbols;
+        std::size_t trade_capacity;   // Trades kept per symbol; rounded up to a power of two
+
+        static Config getDefaultConfig(const std::string& name) {
+            return Config{
+                name,
+                256,   // max_symbols
+                4096   // trade_capacity
+            };
+        }
+    };
+
+    // Creates the segment, replacing any left behind by an earlier producer.
+    // Throws std::runtime_error if it cannot be created or mapped.
+    explicit MarketDataBus(const Config& config);
+    // Marks the bus closed for readers and removes the name
+    ~MarketDataBus() noexcept;
+
+    MarketDataBus(const MarketDataBus&) = delete;
+    MarketDataBus& operator=(const MarketDataBus&) = delete;
+
+    // Channel for `symbol`, claimed on first use and valid for the bus's
+    // lifetime. Resolve it once per book and publish through it: this call
+    // takes a lock and hashes the symbol. Throws std::runtime_error once
+    // every channel is taken and std::invalid_argument for a symbol that
+    // does not fit.
+    BusChannel* channel(const std::string& symbol);
+
+    // Publish to a channel from channel(); no lock and no lookup
+    void publishQuote(BusChannel* channel, const BusQuote& quote);
+    void publishTrade(BusChannel* channel, const BusTrade& trade);
+    // Look the channel up on every call, throwing as channel() does
+    void publishQuote(const std::string& symbol, const BusQuote& quote) { publishQuote(channel(symbol), quote); }
+    void publishTrade(const std::string& symbol, const BusTrade& trade) { publishTrade(channel(symbol), trade); }
+
+    const std::string& name() const { return m_config.name; }
+
+    // Bytes for a segment with this many symbols and trades per symbol
+    static std::size_t segmentSize(std::size_t max_symbols, std::size_t trade_capacity);
+    static std::size_t channelStride(std::size_t trade_capacity);
+
+private:
+    Config m_config;
+    void* m_base{nullptr};
+    std::size_t m_size{0};
+    MarketDataBusHeader* m_header{nullptr};
+
+    std::mutex m_channels_mutex;
+    std::unordered_map<std::string, BusChannel*> m_channels;
+};
+
+}}} // namespaces
+
+#endif // MERC_MARKET_DATA_BUS_HPP
@@ -0,0 +1,70 @@
+#ifndef MERC_MARKET_DATA_BUS_READER_HPP
+#define MERC_MARKET_DATA_BUS_READER_HPP
+
+#include "mercMarketDataBus.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Consumer side of a MarketDataBus. Maps the segment read-only; every read
+// is a handful of loads from shared memory with no locks or system calls.
+// Any number of readers, in any number of processes, can follow a bus.
+class MarketDataBusReader {
+public:
+    // One symbol's channel. Valid for as long as the reader it came from.
+    // Not thread-safe: each consuming thread should subscribe for itself.
+    class Subscription {
+    public:
+        // Latest quote; false if none has been published yet
+        bool quote(BusQuote& out) const;
+        // The next trade after the last one returned; false if there is
+        // none yet. Trades the producer overwrote before they were read are
+        // skipped and added to missedTrades().
+        bool nextTrade(BusTrade& out);
+        std::uint64_t missedTrades() const { return m_missed; }
+
+    private:
+        friend class MarketDataBusReader;
+        Subscription(const BusChannel* channel, std::uint64_t capacity, std::uint64_t next)
+            : m_channel(channel), m_capacity(capacity), m_next(next) {}
+
+        const BusChannel* m_channel;
+        std::uint64_t m_capacity;
+        std::uint64_t m_next;        // Number of the next trade to read, 0-based
+        std::uint64_t m_missed{0};
+    };
+
+    // Throws std::runtime_error if the bus does not exist or is not ready
+    explicit MarketDataBusReader(const std::string& name);
+    ~MarketDataBusReader() noexcept;
+
+    MarketDataBusReader(const MarketDataBusReader&) = delete;
+    MarketDataBusReader& operator=(const MarketDataBusReader&) = delete;
+
+    // False once the producer has closed the bus; a new one has to be
+    // opened by name to follow its successor
+    bool live() const;
+    std::vector<std::string> symbols() const;
+
+    // The symbol's channel, starting with the next trade published, or with
+    // the oldest one still held if fromOldest is set; std::nullopt if the
+    // symbol has not been published yet
+    std::optional<Subscription> subscribe(const std::string& symbol, bool fromOldest = false) const;
+
+private:
+    const char* m_base{nullptr};
+    std::size_t m_size{0};
+    const MarketDataBusHeader* m_header{nullptr};
+
+    const BusChannel* channelAt(std::size_t index) const;
+};
+
+}}} // namespaces
+
+#endif // MERC_MARKET_DATA_BUS_READER_HPP
@@ -2,12 +2,15 @@
 #define MERC_ORDER_BOOK_ALLOCATOR_HPP
 
 #include "mercAllocatorManager.hpp"
+#include "mercBookRegion.hpp"
+#include "mercRelativePtr.hpp"
 #include <atomic>
 #include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <mutex>
 #include <unordered_set>
+#include <vector>
 
 namespace mercuryTrade {
 namespace core {
@@ -25,6 +28,10 @@ public:
         std::size_t max_price_levels;  // Maximum number of price levels
         std::size_t order_data_size;   // Size of additional order data
         bool track_modifications;       // Whether to track order modifications
+        // When set, the pools live in this memory-mapped file instead of on
+        // the heap and survive the process: reopening the file resumes with
+        // every book and order that was in it
+        std::string backing_file{};
 
         // Default configuration
         static Config getDefaultConfig() {
@@ -52,7 +59,10 @@ public:
     std::unordered_set<PriceLevel*> m_allocated_price_levels;
     std::mutex m_tracking_mutex;
 
-    // Constructor with configuration
+    // Constructor with configuration. With a backing file, an existing
+    // region is reopened and its live orders re-registered; throws
+    // std::runtime_error if the file cannot be mapped or was created with a
+    // different geometry.
     explicit OrderBookAllocator(const Config& config = Config::getDefaultConfig());
     
     // Prevent copying
@@ -78,6 +88,21 @@ public:
     OrderNode* findOrder(const std::string& order_id);
     void registerOrder(const std::string& order_id, OrderNode* order);
     void unregisterOrder(const std::string& order_id);
+    // Sizes the id index for this many more orders, e.g. before a bulk restore
+    void reserveOrders(std::size_t count);
+
+    // Persistent pools
+    bool isPersistent() const { return m_region != nullptr; }
+    // True if the backing file was last closed by an orderly shutdown. After
+    // a crash the region holds whatever the last writes left, which is only
+    // consistent if the process did not die in the middle of a book change.
+    bool wasCleanlyClosed() const { return m_clean_close; }
+    // Longest order id the pools can hold; ids are unlimited on the heap
+    std::size_t maxOrderIdLength() const;
+    // The region's root for symbol, claimed on first use; nullptr on the
+    // heap. Throws std::runtime_error when every root is taken and
+    // std::invalid_argument for a symbol that does not fit.
+    BookRoot* bookRoot(const std::string& symbol);
     
     // Utility methods
     void reset();  // Clear all allocations
@@ -105,18 +130,45 @@ private:
     std::unordered_map<std::string, OrderNode*> m_order_map;
     std::mutex m_order_map_mutex; //Add mutex for protecting m_order_map
 
-    // Helper method for memory calculation
-   
+    // Slot management for both pools. Released slots are chained through
+    // their own storage by slot number; slots past the high-water mark have
+    // never been used. The chain heads and high-water marks live in
+    // m_header, which is inside the mapped file for persistent pools.
+    std::mutex m_pool_mutex;
+    std::size_t m_order_stride;
+    BookRegionHeader m_heap_header{};
+    BookRegionHeader* m_header{&m_heap_header};
+    std::vector<bool> m_order_in_use;
+
+    // Mapped file backing persistent pools
+    void* m_region{nullptr};
+    std::size_t m_region_size{0};
+    bool m_clean_close{false};
+
+    // Helper methods for slot management
+    std::size_t orderSlot(const OrderNode* order) const;
+    bool ownsOrder(const OrderNode* order) const;
+    bool ownsPriceLevel(const PriceLevel* level) const;
+    void releaseOrderSlot(OrderNode* order);
+    void releasePriceLevelSlot(PriceLevel* level);
+    OrderNode* orderAt(std::size_t slot) const;
+    std::size_t levelSlot(const PriceLevel* level) const;
+    void openRegion();
+    void attachRegion();
+    void closeRegion();
 };
 
 // Order book data structures
+// Links are relative so the pools can be mapped at any address. In
+// persistent pools order_id is rebuilt when the file is reopened, from a
+// copy kept at the start of additional_data.
 struct OrderNode {
     double price;
     double quantity;
     std::string order_id;
-    OrderNode* next;
-    OrderNode* prev;
-    PriceLevel* parent_level;
+    RelativePtr<OrderNode> next;
+    RelativePtr<OrderNode> prev;
+    RelativePtr<PriceLevel> parent_level;
     char additional_data[];  // Flexible array member for extra data
 };
 
@@ -124,10 +176,10 @@ struct PriceLevel {
     double price;
     double total_quantity;
     std::size_t order_count;
-    OrderNode* first_order;
-    OrderNode* last_order;
-    PriceLevel* next;
-    PriceLevel* prev;
+    RelativePtr<OrderNode> first_order;
+    RelativePtr<OrderNode> last_order;
+    RelativePtr<PriceLevel> next;
+    RelativePtr<PriceLevel> prev;
 };
 
 }}} // namespaces
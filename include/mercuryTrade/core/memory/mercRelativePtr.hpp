@@ -0,0 +1,49 @@
+#ifndef MERC_RELATIVE_PTR_HPP
+#define MERC_RELATIVE_PTR_HPP
+
+#include <cstdint>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Pointer stored as the distance from itself to its target, so a structure
+// linked with these stays valid wherever its memory is mapped, as long as
+// both ends live in the same mapping. Zero is null. Reads and writes like
+// a raw pointer; copying re-targets the copy rather than copying the
+// distance.
+template <typename T>
+class RelativePtr {
+public:
+    RelativePtr() = default;
+    RelativePtr(T* target) { set(target); }
+    RelativePtr(const RelativePtr& other) { set(other.get()); }
+
+    RelativePtr& operator=(T* target) {
+        set(target);
+        return *this;
+    }
+    RelativePtr& operator=(const RelativePtr& other) {
+        set(other.get());
+        return *this;
+    }
+
+    T* get() const {
+        return m_offset == 0 ? nullptr
+                             : reinterpret_cast<T*>(reinterpret_cast<std::intptr_t>(this) + m_offset);
+    }
+    operator T*() const { return get(); }
+    T* operator->() const { return get(); }
+    T& operator*() const { return *get(); }
+
+private:
+    std::intptr_t m_offset{0};
+
+    void set(T* target) {
+        m_offset = target ? reinterpret_cast<std::intptr_t>(target) - reinterpret_cast<std::intptr_t>(this) : 0;
+    }
+};
+
+}}} // namespaces
+
+#endif // MERC_RELATIVE_PTR_HPP
@@ -0,0 +1,158 @@
+#ifndef MERC_RISK_ENGINE_HPP
+#define MERC_RISK_ENGINE_HPP
+
+#include "mercSnapshotFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Outcome of a pre-trade check
+enum class RiskCheck : std::uint8_t {
+    PASSED,
+    POSITION_LIMIT,    // Could take the symbol's position past max_position
+    NOTIONAL_LIMIT,    // Open orders would be worth more than max_notional
+    OPEN_ORDER_LIMIT,  // Already max_open_orders resting
+    PRICE_BAND,        // Limit price too far from the symbol's last trade
+    UNKNOWN_ACCOUNT,   // Named account that was never given limits
+    CAPACITY           // No slot left to track the account or symbol
+};
+
+// Pre-trade limits per account, checked before an order reaches a book.
+//
+// Accounts and symbols are numbered once, on first sight; after that every
+// check and update is arithmetic on fixed slots. Each account's limits and
+// open-order totals share one cache line, its per-symbol exposures sit in
+// one contiguous run, and last trade prices are a flat array, so a check is
+// a few loads from three lines that the previous order for the same account
+// most likely left in cache.
+//
+// Open exposure is what resting limit orders could still add: their count,
+// their notional at the limit price and, per symbol, the quantity on each
+// side. Market orders never rest, so they are checked against the last
+// trade price but reserve nothing. The engine keeps no per-order state; the
+// caller reports each order's reserve, fills and release. Not thread-safe:
+// it belongs to whichever thread admits orders.
+class RiskEngine {
+public:
+    struct Limits {
+        double max_position;            // Absolute net quantity per symbol, open orders included
+        double max_notional;            // Price times quantity over all resting orders
+        std::uint32_t max_open_orders;
+        double price_band;              // Largest |price / last - 1| for a limit order
+
+        static Limits unlimited() {
+            const double none = std::numeric_limits<double>::infinity();
+            return Limits{none, none, std::numeric_limits<std::uint32_t>::max(), none};
+        }
+    };
+
+    struct Config {
+        std::size_t max_accounts;
+        std::size_t max_symbols;
+        Limits default_limits;          // For accounts without limits of their own
+
+        static Config getDefaultConfig() {
+            return Config{
+                256,                    // max_accounts
+                256,                    // max_symbols
+                Limits::unlimited()     // default_limits
+            };
+        }
+    };
+
+    // An account's exposure in one symbol
+    struct Exposure {
+        double position;                // Filled quantity, negative when short
+        double open_buys;               // Quantity still resting on each side
+        double open_sells;
+    };
+
+    struct Usage {
+        std::uint32_t open_orders;
+        double open_notional;
+    };
+
+    explicit RiskEngine(const Config& config = Config::getDefaultConfig());
+
+    RiskEngine(const RiskEngine&) = delete;
+    RiskEngine& operator=(const RiskEngine&) = delete;
+
+    static constexpr std::uint32_t NOT_FOUND = std::numeric_limits<std::uint32_t>::max();
+
+    // Number the account or symbol on first use. Throw std::length_error
+    // once max_accounts or max_symbols are taken.
+    std::uint32_t accountIndex(const std::string& account);
+    std::uint32_t symbolIndex(const std::string& symbol);
+    // NOT_FOUND if the account was never numbered
+    std::uint32_t findAccount(const std::string& account) const;
+
+    void setLimits(const std::string& account, const Limits& limits);
+    Limits limits(const std::string& account);
+
+    // Whether an order for quantity at price, zero for a market order, is
+    // within the account's limits. Changes nothing.
+    RiskCheck check(std::uint32_t account, std::uint32_t symbol, bool is_buy, double price, double quantity) const;
+
+    // A limit order starts resting / stops resting with quantity unfilled
+    void reserve(std::uint32_t account, std::uint32_t symbol, bool is_buy, double price, double quantity);
+    void release(std::uint32_t account, std::uint32_t symbol, bool is_buy, double price, double quantity);
+
+    // quantity of an order executed. price is the order's limit price, zero
+    // for a market order; done when nothing of it is left to fill.
+    void fill(std::uint32_t account, std::uint32_t symbol, bool is_buy, double price, double quantity, bool done);
+
+    // The symbol traded at price; the reference for price bands
+    void trade(std::uint32_t symbol, double price) { m_last_prices[symbol] = price; }
+
+    Exposure exposure(std::uint32_t account, std::uint32_t symbol) const;
+    Usage usage(std::uint32_t account) const;
+
+    // Positions and last prices, by name. Limits are configuration and open
+    // orders are reserved again as the orders are restored, so neither is
+    // saved. loadState() expects an engine with no positions yet.
+    void saveState(SnapshotWriter& out) const;
+    void loadState(SnapshotReader& in);
+
+    static const char* checkName(RiskCheck check);
+
+private:
+    struct alignas(64) Account {
+        Limits limits;
+        std::uint32_t open_orders;
+        double open_notional;
+    };
+    static_assert(sizeof(Account) == 64, "Account should fill exactly one cache line");
+
+    struct alignas(32) Slot {
+        double position;
+        double open_buys;
+        double open_sells;
+    };
+
+    Config m_config;
+    std::vector<Account> m_accounts;
+    std::vector<Slot> m_slots;          // max_symbols per account, account-major
+    std::vector<double> m_last_prices;  // Zero until the symbol trades
+    std::vector<std::string> m_account_names;
+    std::vector<std::string> m_symbol_names;
+    std::unordered_map<std::string, std::uint32_t> m_account_index;
+    std::unordered_map<std::string, std::uint32_t> m_symbol_index;
+
+    Slot& slot(std::uint32_t account, std::uint32_t symbol) {
+        return m_slots[static_cast<std::size_t>(account) * m_config.max_symbols + symbol];
+    }
+    const Slot& slot(std::uint32_t account, std::uint32_t symbol) const {
+        return m_slots[static_cast<std::size_t>(account) * m_config.max_symbols + symbol];
+    }
+};
+
+}}} // namespaces
+
+#endif // MERC_RISK_ENGINE_HPP
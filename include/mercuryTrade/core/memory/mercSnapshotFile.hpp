@@ -0,0 +1,90 @@
+#ifndef MERC_SNAPSHOT_FILE_HPP
+#define MERC_SNAPSHOT_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Builds a snapshot payload from fixed-width fields in host byte order.
+// Snapshots are only read back on the machine that wrote them.
+class SnapshotWriter {
+public:
+    void reserve(std::size_t bytes) { m_data.reserve(bytes); }
+
+    void putU8(std::uint8_t value) { put(value); }
+    void putU32(std::uint32_t value) { put(value); }
+    void putU64(std::uint64_t value) { put(value); }
+    void putDouble(double value) { put(value); }
+    // Length-prefixed
+    void putString(const std::string& value);
+
+    const std::string& data() const { return m_data; }
+    std::string release() { return std::move(m_data); }
+
+private:
+    std::string m_data;
+
+    template <typename T>
+    void put(T value) { m_data.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+};
+
+// Reads back what a SnapshotWriter produced. Every getter throws
+// std::runtime_error when the payload is shorter than the field.
+class SnapshotReader {
+public:
+    SnapshotReader(const char* data, std::size_t size) : m_data(data), m_size(size) {}
+    explicit SnapshotReader(const std::string& data) : SnapshotReader(data.data(), data.size()) {}
+    explicit SnapshotReader(std::string&&) = delete;  // Would dangle
+
+    std::uint8_t getU8() { return get<std::uint8_t>(); }
+    std::uint32_t getU32() { return get<std::uint32_t>(); }
+    std::uint64_t getU64() { return get<std::uint64_t>(); }
+    double getDouble() { return get<double>(); }
+    std::string getString();
+
+    bool atEnd() const { return m_offset == m_size; }
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+    std::size_t m_offset{0};
+
+    void require(std::size_t bytes) const;
+
+    template <typename T>
+    T get() {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return value;
+    }
+};
+
+// Writes payload to path behind a header with a magic number, the payload
+// length and its CRC. The file is written under a temporary name, synced
+// and then renamed into place, so a crash leaves either the old file or
+// the complete new one. Throws std::runtime_error on I/O failure.
+void writeSnapshotFile(const std::string& path, const std::string& payload);
+
+// The two halves of writeSnapshotFile(), for callers that must make
+// something else durable before the snapshot becomes visible: the first
+// writes and syncs path + ".tmp", the second renames it into place and
+// syncs the directory. Both throw std::runtime_error on I/O failure.
+void writeSnapshotTemporary(const std::string& path, const std::string& payload);
+void commitSnapshotFile(const std::string& path);
+
+// Payload of a file written by writeSnapshotFile(). Throws
+// std::runtime_error if the file cannot be read, is truncated or fails
+// its checksum.
+std::string readSnapshotFile(const std::string& path);
+
+}}} // namespaces
+
+#endif // MERC_SNAPSHOT_FILE_HPP
@@ -0,0 +1,266 @@
+#ifndef MERC_TICK_STORE_HPP
+#define MERC_TICK_STORE_HPP
+
+#include "mercBarAggregator.hpp"
+#include "mercMarketDataAllocator.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+struct TickTrade {
+    std::int64_t timestamp;  // Nanoseconds since the epoch
+    double price;
+    double quantity;
+    std::uint8_t buyer_aggressor;
+};
+
+struct TickQuote {
+    std::int64_t timestamp;  // Nanoseconds since the epoch
+    double bid;
+    double bid_size;
+    double ask;
+    double ask_size;
+};
+
+// Trades as separate contiguous columns, for kernels that run down one
+struct TradeColumns {
+    std::vector<std::int64_t> timestamps;
+    std::vector<double> prices;
+    std::vector<double> quantities;
+};
+
+// Append-only trade and quote history per symbol, kept on disk.
+//
+// Rows collect in an open block of up to block_rows. A full block is
+// written column by column - timestamps, then each price and quantity
+// column - with every value stored as a varint delta from the one before,
+// scaled down by the column's common divisor and with prices and
+// quantities as fixed-point integers. Blocks go into
+// preallocated, memory-mapped segment files under
+// directory/SYMBOL/, one partition_nanos wide time partition per file (a
+// busy partition rolls over into further files), and each block's time
+// range is kept in a small in-memory index. A range scan skips to the
+// first partition and block that can hold `from` and decodes only blocks
+// overlapping the range, so its cost follows the rows returned rather
+// than the history kept.
+//
+// Timestamps must not go backwards within a symbol's trades or quotes;
+// older rows are refused and counted. Rows still in the open block are
+// seen by scans but reach the segment only when the block fills or on
+// flush(). Segments are read back, CRC-checked block by block, when the
+// store is opened; appends then continue in new segment files. Every
+// call may come from any thread; each symbol's trades and quotes have
+// their own reader-writer lock.
+class TickStore {
+public:
+    enum class Kind : std::uint8_t {
+        TRADES = 0,
+        QUOTES = 1
+    };
+
+    struct Config {
+        std::string directory;
+        std::int64_t partition_nanos;  // Time covered by one segment file
+        std::size_t segment_size;      // Bytes reserved per segment file
+        std::size_t block_rows;        // Rows per block, the granularity of the time index
+        std::int64_t price_scale;      // Fixed-point units per 1.0 of price
+        std::int64_t quantity_scale;   // Fixed-point units per 1.0 of quantity
+        std::size_t max_symbols;
+
+        static Config getDefaultConfig(const std::string& directory) {
+            return Config{
+                directory,
+                3600LL * 1000000000LL,  // partition_nanos: one hour
+                4 * 1024 * 1024,        // segment_size
+                1024,                   // block_rows
+                100000000,              // price_scale: 1e-8
+                100000000,              // quantity_scale: 1e-8
+                64                      // max_symbols
+            };
+        }
+    };
+
+    struct Stats {
+        std::size_t symbols;
+        std::size_t segments;
+        std::uint64_t trades;        // Rows stored, including open blocks
+        std::uint64_t quotes;
+        std::uint64_t out_of_order;  // Rows refused for going back in time
+        std::size_t bytes_used;      // Segment bytes holding blocks
+    };
+
+    using TradeVisitor = std::function<void(const TickTrade&)>;
+    using QuoteVisitor = std::function<void(const TickQuote&)>;
+
+    static constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+    // Opens or creates the store, loading every segment already there.
+    // Throws std::invalid_argument for a bad config and
+    // std::runtime_error when the directory or a segment cannot be used.
+    explicit TickStore(const Config& config);
+    ~TickStore();  // Flushes open blocks
+
+    TickStore(const TickStore&) = delete;
+    TickStore& operator=(const TickStore&) = delete;
+
+    // Returns the symbol's index, claiming it on first use. Symbols name
+    // directories, so "/" and leading dots are refused with
+    // std::invalid_argument; std::runtime_error once max_symbols are claimed.
+    std::size_t symbolIndex(const std::string& symbol);
+    std::size_t findSymbol(const std::string& symbol) const;  // NOT_FOUND if never claimed
+
+    // False, and counted, if timestamp is older than the symbol's last row
+    bool appendTrade(std::size_t symbol, const TickTrade& trade);
+    bool appendQuote(std::size_t symbol, const TickQuote& quote);
+    bool appendTrade(const std::string& symbol, const TickTrade& trade) {
+        return appendTrade(symbolIndex(symbol), trade);
+    }
+    bool appendQuote(const std::string& symbol, const TickQuote& quote) {
+        return appendQuote(symbolIndex(symbol), quote);
+    }
+
+    // Writes every open block to its segment and syncs the segments
+    void flush();
+
+    // Visits rows with timestamps in [from, to), oldest first; returns how
+    // many. The symbol's history is read-locked while visiting, so the
+    // visitor must not append to the same symbol.
+    std::size_t scanTrades(const std::string& symbol, std::int64_t from, std::int64_t to,
+                           const TradeVisitor& visitor) const;
+    std::size_t scanQuotes(const std::string& symbol, std::int64_t from, std::int64_t to,
+                           const QuoteVisitor& visitor) const;
+
+    // Trades in [from, to), oldest first; at most limit of them, keeping
+    // the newest. Reads blocks from the end of the range backwards, so a
+    // small limit touches only the last few blocks.
+    std::vector<TickTrade> trades(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                  std::size_t limit) const;
+    // The same trades decoded straight into columns
+    TradeColumns tradeColumns(const std::string& symbol, std::int64_t from, std::int64_t to,
+                              std::size_t limit) const;
+
+    // One OHLCV bar per bucket_nanos bucket in [from, to) that saw trades,
+    // oldest first; at most limit of them, keeping the newest. A bar is
+    // closed once a later trade has been stored.
+    std::vector<Bar> downsampleTrades(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                      std::int64_t bucket_nanos, std::size_t limit) const;
+    // The last quote in each bucket_nanos bucket in [from, to) that saw quotes
+    std::vector<TickQuote> downsampleQuotes(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                            std::int64_t bucket_nanos, std::size_t limit) const;
+
+    std::vector<std::string> symbols() const;
+    Stats getStats() const;
+    const Config& config() const { return m_config; }
+
+    static const char* kindName(Kind kind);  // "trades" or "quotes"
+
+private:
+    static constexpr std::size_t KINDS = 2;
+    static constexpr std::size_t MAX_COLUMNS = 4;  // Value columns besides the timestamp
+
+    // One decoded row, values still fixed-point
+    struct Row {
+        std::int64_t timestamp;
+        std::int64_t values[MAX_COLUMNS];
+    };
+
+    // Time range and place of one block; the sparse time index
+    struct BlockEntry {
+        std::int64_t first;
+        std::int64_t last;
+        std::size_t offset;
+        std::size_t rows;
+    };
+
+    struct Segment;
+
+    struct Series {
+        Kind kind{Kind::TRADES};
+        std::size_t columns{0};
+        mutable std::shared_mutex mutex;
+        std::vector<std::shared_ptr<Segment>> segments;  // Oldest first; only the last can be writable
+        std::vector<Row> open;                           // The block being filled
+        std::int64_t open_partition{0};
+        std::int64_t last_timestamp{INT64_MIN};
+        std::uint64_t rows{0};
+        std::uint32_t next_file{0};
+    };
+
+    struct SymbolHistory {
+        std::string symbol;
+        std::string directory;
+        Series series[KINDS];
+    };
+
+    Config m_config;
+    std::unique_ptr<SymbolHistory[]> m_symbols;
+    std::atomic<std::size_t> m_symbol_count{0};
+    std::unordered_map<std::string, std::size_t> m_symbol_index;
+    mutable std::mutex m_claim_mutex;
+    std::atomic<std::uint64_t> m_out_of_order{0};
+
+    void loadSegments(SymbolHistory& history);
+    SymbolHistory& entry(std::size_t symbol) const;
+    const Series* find(const std::string& symbol, Kind kind) const;
+
+    bool append(SymbolHistory& history, Series& series, const Row& row);
+    void writeBlock(SymbolHistory& history, Series& series);
+    std::shared_ptr<Segment> createSegment(const SymbolHistory& history, Series& series, std::int64_t partition);
+    void decodeBlock(const Segment& segment, const BlockEntry& block, std::size_t columns, Row* rows) const;
+    std::int64_t partitionOf(std::int64_t timestamp) const;
+
+    // Calls visit(rows, count) for each block overlapping [from, to),
+    // oldest first, or newest first when backwards; stops when it
+    // returns false. Rows outside the range are left for the caller.
+    template <typename Visit>
+    void forEachBlock(const Series& series, std::int64_t from, std::int64_t to, bool backwards,
+                      Visit&& visit) const;
+
+    TickTrade toTrade(const Row& row) const;
+    TickQuote toQuote(const Row& row) const;
+};
+
+// Records a market data allocator's quote and trade rings in a TickStore,
+// following each ring with a cursor from the oldest record it still holds.
+// Symbols claimed later are picked up on the next drain; those the store
+// cannot take are counted and skipped. Used from one thread, usually the
+// one ingesting the feed.
+class TickRingRecorder {
+public:
+    TickRingRecorder(const marketDataAllocator& rings, TickStore& store);
+
+    // Stores every record written since the last call; returns how many
+    std::size_t drain();
+    // Records overwritten in a ring before they were drained
+    std::uint64_t missed() const { return m_missed; }
+    // Ring symbols the store is full for or cannot name on disk
+    std::size_t untrackedSymbols() const { return m_untracked; }
+
+private:
+    struct Follower {
+        marketDataAllocator::Cursor quotes;
+        marketDataAllocator::Cursor trades;
+        std::size_t store_index;        // TickStore::NOT_FOUND when untracked
+    };
+
+    const marketDataAllocator& m_rings;
+    TickStore& m_store;
+    std::vector<Follower> m_followers;  // Indexed by ring symbol
+    std::uint64_t m_missed{0};
+    std::size_t m_untracked{0};
+};
+
+}}} // namespaces
+
+#endif // MERC_TICK_STORE_HPP
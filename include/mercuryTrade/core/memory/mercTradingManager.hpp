@@ -4,6 +4,7 @@
 #include "mercOrderBookAllocator.hpp"
 #include "mercTransactionAllocator.hpp"
 #include "mercMarketDataAllocator.hpp"
+#include "mercLastValueCache.hpp"
 #include <string>
 #include <unordered_map>
 #include <atomic>
@@ -74,10 +75,22 @@ namespace mercuryTrade{
                     bool submitOrder(const order& ord);
                     bool cancelOrder(const std::string& order_id);
                     bool modifyOrder(const std::string& order_id, const order& new_order);
-
-                    // Market Data Handling
+                    // Applies an executed trade to both orders, releasing any
+                    // that are now fully filled
+                    bool recordTrade(const trade& t);
+                    // Re-admits an order that was open when a snapshot was
+                    // taken, with its remaining quantity; no transaction or
+                    // latency metrics are recorded
+                    bool restoreOrder(const order& ord);
+
+                    // Market Data Handling. Updates are kept in a last
+                    // value cache sized for max_symbols, which other threads
+                    // may read without locking, and each is appended to the
+                    // symbol's quote ring for readers that need every update.
                     void handleMarketData(const marketData& data);
                     void updateOrderBook(const std::string& symbol);
+                    const LastValueCache& lastValues() const { return m_last_values; }
+                    const marketDataAllocator& marketDataRings() const { return m_market_data_allocator; }
 
                     // Transaction management
                     bool beginTransaction();
@@ -107,6 +120,7 @@ namespace mercuryTrade{
                     OrderBookAllocator m_order_allocator{};
                     marketDataAllocator m_market_data_allocator{};
                     transactionAllocator m_transaction_allocator{};
+                    LastValueCache m_last_values;
 
                     // Transaction tracking
                     void* m_current_transaction{nullptr};
@@ -0,0 +1,59 @@
+// include/mercuryTrade/http/Compression.hpp
+#pragma once
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace mercuryTrade {
+namespace http {
+
+enum class ContentEncoding {
+    Identity,
+    Gzip,
+    Deflate
+};
+
+// Picks the best coding the client accepts from an Accept-Encoding value,
+// honouring q-values ("gzip;q=0.5, deflate", "*;q=0.1", "gzip;q=0").
+// gzip wins ties since every browser supports it.
+ContentEncoding negotiateEncoding(std::string_view accept_encoding);
+
+// Token used in the Content-Encoding header, or nullptr for identity
+const char* encodingName(ContentEncoding encoding);
+
+// Compresses input into output, replacing its contents. The input is fed to
+// zlib in fixed-size slices so large bodies never need a second full-size
+// scratch buffer; output capacity is kept so a reused string stops
+// allocating once it has grown. Throws std::runtime_error on zlib failure.
+void compress(std::string_view input, ContentEncoding encoding, std::string& output,
+              int level = 6);
+
+// An immutable response body shared between responses.
+//
+// Cached snapshots hand the same Payload to every poll; its compressed
+// representations are produced on first request for each coding and then
+// reused, so a hot snapshot is compressed once rather than once per client.
+class Payload {
+public:
+    explicit Payload(std::string data, int level = 6);
+
+    const std::shared_ptr<const std::string>& identity() const { return identity_; }
+    std::size_t size() const { return identity_->size(); }
+
+    // Body for the given coding, compressing and memoising it on first use
+    std::shared_ptr<const std::string> encoded(ContentEncoding encoding) const;
+
+    static std::shared_ptr<const Payload> make(std::string data, int level = 6) {
+        return std::make_shared<const Payload>(std::move(data), level);
+    }
+
+private:
+    std::shared_ptr<const std::string> identity_;
+    int level_;
+    mutable std::mutex mutex_;
+    mutable std::array<std::shared_ptr<const std::string>, 3> encoded_;
+};
+
+}} // namespace
@@ -0,0 +1,83 @@
+// include/mercuryTrade/http/Headers.hpp
+#pragma once
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <string_view>
+
+namespace mercuryTrade {
+namespace http {
+
+inline bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True if a comma-separated header value such as Connection lists token
+inline bool hasToken(std::string_view value, std::string_view token) {
+    while (!value.empty()) {
+        std::size_t comma = value.find(',');
+        std::string_view item = value.substr(0, comma);
+        while (!item.empty() && (item.front() == ' ' || item.front() == '\t')) item.remove_prefix(1);
+        while (!item.empty() && (item.back() == ' ' || item.back() == '\t')) item.remove_suffix(1);
+        if (iequals(item, token)) {
+            return true;
+        }
+        value = comma == std::string_view::npos ? std::string_view() : value.substr(comma + 1);
+    }
+    return false;
+}
+
+struct Header {
+    std::string_view name;
+    std::string_view value;
+};
+
+// Fixed-capacity header table. Entries are views into the connection buffer,
+// so filling it never allocates; lookups are case-insensitive per RFC 9110.
+class HeaderList {
+public:
+    static constexpr std::size_t MAX_HEADERS = 64;
+    using const_iterator = const Header*;
+
+    bool add(std::string_view name, std::string_view value) {
+        if (count_ == MAX_HEADERS) {
+            return false;
+        }
+        headers_[count_++] = Header{name, value};
+        return true;
+    }
+
+    const_iterator find(std::string_view name) const {
+        for (auto it = begin(); it != end(); ++it) {
+            if (iequals(it->name, name)) {
+                return it;
+            }
+        }
+        return end();
+    }
+
+    std::string_view get(std::string_view name, std::string_view defaultValue = {}) const {
+        auto it = find(name);
+        return it != end() ? it->value : defaultValue;
+    }
+
+    void clear() { count_ = 0; }
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    const_iterator begin() const { return headers_.data(); }
+    const_iterator end() const { return headers_.data() + count_; }
+
+private:
+    std::array<Header, MAX_HEADERS> headers_{};
+    std::size_t count_ = 0;
+};
+
+}} // namespace
@@ -0,0 +1,102 @@
+// include/mercuryTrade/http/JsonWriter.hpp
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace mercuryTrade {
+namespace http {
+
+class JsonWriter;
+
+// Specialize for a type to make it writable with JsonWriter::value(). The
+// specialization provides
+//   static void write(JsonWriter& out, const T& value);
+template <typename T>
+struct JsonSerializer;
+
+// Streams JSON text straight into a string, without building a DOM.
+//
+// Commas and colons are inserted automatically, so serializers only list
+// their keys and values:
+//
+//   out.beginObject().field("id", order.id).field("price", order.price).endObject();
+//
+// Numbers are formatted with std::to_chars (shortest round-trip form for
+// doubles), integral doubles keep a trailing ".0" and non-finite doubles
+// are written as null, matching nlohmann::json::dump(). Strings are escaped
+// but otherwise copied as-is, so they must already be valid UTF-8.
+class JsonWriter {
+public:
+    static constexpr std::size_t MAX_DEPTH = 64;
+
+    // Appends to `out`; existing contents are kept
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    JsonWriter& beginObject() { return open('{'); }
+    JsonWriter& endObject() { return close('}'); }
+    JsonWriter& beginArray() { return open('['); }
+    JsonWriter& endArray() { return close(']'); }
+
+    JsonWriter& key(std::string_view name);
+    JsonWriter& null();
+
+    // Strings, numbers, bools, or any type with a JsonSerializer
+    template <typename T>
+    JsonWriter& value(const T& v) {
+        if constexpr (std::is_same_v<T, bool>) {
+            write_bool(v);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            write_int(static_cast<std::int64_t>(v));
+        } else if constexpr (std::is_integral_v<T>) {
+            write_uint(static_cast<std::uint64_t>(v));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            write_double(static_cast<double>(v));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            write_string(std::string_view(v));
+        } else {
+            JsonSerializer<T>::write(*this, v);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    JsonWriter& field(std::string_view name, const T& v) {
+        key(name);
+        return value(v);
+    }
+
+    // Appends already-serialized JSON as the next value
+    JsonWriter& raw(std::string_view json);
+
+private:
+    std::string& out_;
+    std::size_t depth_ = 0;
+    std::uint64_t has_items_ = 0;  // Bit n: the container at depth n+1 already has a member
+    bool after_key_ = false;
+
+    JsonWriter& open(char bracket);
+    JsonWriter& close(char bracket);
+    void separate();
+
+    void write_bool(bool v);
+    void write_int(std::int64_t v);
+    void write_uint(std::uint64_t v);
+    void write_double(double v);
+    void write_string(std::string_view v);
+};
+
+template <typename T>
+struct JsonSerializer<std::vector<T>> {
+    static void write(JsonWriter& out, const std::vector<T>& values) {
+        out.beginArray();
+        for (const auto& v : values) {
+            out.value(v);
+        }
+        out.endArray();
+    }
+};
+
+}} // namespace
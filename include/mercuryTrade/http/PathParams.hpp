@@ -0,0 +1,56 @@
+// include/mercuryTrade/http/PathParams.hpp
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace mercuryTrade {
+namespace http {
+
+// Fixed-capacity table of captured path parameters. Names point at the
+// router's registered patterns and values into the request path, so
+// matching a route never allocates.
+class PathParams {
+public:
+    static constexpr std::size_t MAX_PARAMS = 8;
+
+    struct Param {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    bool add(std::string_view name, std::string_view value) {
+        if (count_ == MAX_PARAMS) {
+            return false;
+        }
+        params_[count_++] = Param{name, value};
+        return true;
+    }
+
+    void pop() {
+        if (count_ > 0) {
+            --count_;
+        }
+    }
+
+    const Param* find(std::string_view name) const {
+        for (std::size_t i = 0; i < count_; ++i) {
+            if (params_[i].name == name) {
+                return &params_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void clear() { count_ = 0; }
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    const Param* begin() const { return params_.data(); }
+    const Param* end() const { return params_.data() + count_; }
+
+private:
+    std::array<Param, MAX_PARAMS> params_{};
+    std::size_t count_ = 0;
+};
+
+}} // namespace
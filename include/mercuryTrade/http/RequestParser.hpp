@@ -0,0 +1,79 @@
+// include/mercuryTrade/http/RequestParser.hpp
+#pragma once
+#include "Server.hpp"
+#include <array>
+#include <cstddef>
+
+namespace mercuryTrade {
+namespace http {
+
+// Streaming HTTP/1.1 request parser.
+//
+// The parser works on a caller-owned byte buffer and keeps its progress as
+// offsets, so it can be fed the same buffer again after more bytes were
+// appended (even if the buffer was reallocated or compacted, as long as the
+// unconsumed bytes keep their relative position). A completed Request only
+// holds views into that buffer; chunked bodies are de-chunked in place.
+class RequestParser {
+public:
+    enum class Result {
+        Complete,    // A full request is available, see consumed()
+        Incomplete,  // Feed more bytes and call parse() again
+        Error        // Malformed or oversized request, see errorStatus()
+    };
+
+    explicit RequestParser(std::size_t max_header_bytes = 64 * 1024,
+                           std::size_t max_body_bytes = 8 * 1024 * 1024);
+
+    // Parses the request starting at data[0]. On Complete, req refers into data
+    // and the parser is ready for the next request at data[consumed()].
+    Result parse(char* data, std::size_t size, Request& req);
+
+    std::size_t consumed() const { return consumed_; }
+    int errorStatus() const { return error_status_; }
+    const char* error() const { return error_; }
+    void reset();
+
+private:
+    enum class State {
+        RequestLine,
+        Headers,
+        Body,
+        ChunkSize,
+        ChunkData,
+        Trailers
+    };
+
+    struct Span {
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    std::size_t max_header_bytes_;
+    std::size_t max_body_bytes_;
+
+    State state_ = State::RequestLine;
+    std::size_t pos_ = 0;           // Next unparsed byte
+    std::size_t consumed_ = 0;
+    int error_status_ = 0;
+    const char* error_ = nullptr;
+
+    Span method_{}, target_{}, version_{};
+    std::array<Span, HeaderList::MAX_HEADERS * 2> header_spans_{};
+    std::size_t header_count_ = 0;
+
+    std::size_t content_length_ = 0;
+    bool chunked_ = false;
+    std::size_t chunk_remaining_ = 0;
+    std::size_t body_start_ = 0;
+    std::size_t body_end_ = 0;
+    std::size_t trailers_start_ = 0;
+
+    bool next_line(const char* data, std::size_t size, Span& line);
+    bool parse_request_line(const char* data, const Span& line);
+    bool parse_header(const char* data, const Span& line);
+    void finish(const char* data, Request& req);
+    Result fail(int status, const char* message);
+};
+
+}} // namespace
@@ -0,0 +1,43 @@
+// include/mercuryTrade/http/ResponseWriter.hpp
+#pragma once
+#include <string>
+#include <string_view>
+
+struct iovec;
+
+namespace mercuryTrade {
+namespace http {
+
+class Response;
+
+// Writes responses to one connection.
+//
+// The status line and headers are serialised into a buffer that is reused
+// for every response on the connection; common header lines (CORS, JSON
+// content type, connection handling) are copied from preformatted blocks.
+// Head and body go out in a single sendmsg() without being concatenated,
+// and short writes are retried until done. On a non-blocking socket EAGAIN
+// waits up to send_timeout_ms for room; a blocking socket is expected to
+// carry its own SO_SNDTIMEO, and EAGAIN there means that timeout ran out.
+class ResponseWriter {
+public:
+    ResponseWriter(int fd, std::string_view keep_alive_block, int send_timeout_ms = 5000);
+
+    // Returns false if the peer went away or the socket stayed unwritable
+    bool write(const Response& res, bool keep_alive);
+
+    static const char* statusText(int status);
+    static std::string keepAliveBlock(int idle_timeout_ms);
+
+private:
+    int fd_;
+    std::string_view keep_alive_block_;
+    int send_timeout_ms_;
+    bool nonblocking_;
+    std::string head_;
+
+    void serialize_head(const Response& res, bool keep_alive);
+    bool send_all(struct iovec* iov, int count);
+};
+
+}} // namespace
@@ -0,0 +1,80 @@
+// include/mercuryTrade/http/Router.hpp
+#pragma once
+#include "PathParams.hpp"
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mercuryTrade {
+namespace http {
+
+class Request;
+class Response;
+using RequestHandler = std::function<Response(const Request&)>;
+
+enum class Method {
+    Get,
+    Post,
+    Put,
+    Delete,
+    Patch,
+    Head,
+    Options,
+    Unknown
+};
+
+Method parseMethod(std::string_view method);
+const char* methodName(Method method);
+
+// Radix tree of routes, built once at registration time.
+//
+// Patterns are static text plus whole-segment parameters, either untyped
+// ("/api/orders/{id}") or typed ("/api/bars/{interval:int}"). Matching walks
+// the tree byte by byte, preferring static edges over parameters, so lookup
+// is O(path length) and captures parameters without allocating.
+class Router {
+public:
+    struct Match {
+        const RequestHandler* handler = nullptr;  // Null if nothing is registered for the method
+        const char* allow = nullptr;              // Methods registered for the path, null on 404
+    };
+
+    Router();
+    ~Router();
+
+    Router(const Router&) = delete;
+    Router& operator=(const Router&) = delete;
+
+    // Throws std::invalid_argument for malformed or conflicting patterns
+    void add(Method method, const std::string& pattern, RequestHandler handler);
+
+    Match match(Method method, std::string_view path, PathParams& params) const;
+
+private:
+    enum class ParamType {
+        String,
+        Int
+    };
+
+    struct Node {
+        std::string label;                            // Static bytes consumed on entry
+        std::vector<std::unique_ptr<Node>> children;  // Static children, distinct first bytes
+        std::unique_ptr<Node> int_param;
+        std::unique_ptr<Node> string_param;
+        std::string param_name;                       // Set on parameter nodes
+        std::array<RequestHandler, static_cast<std::size_t>(Method::Unknown)> handlers;
+        std::string allow;
+        bool has_handlers = false;
+    };
+
+    std::unique_ptr<Node> root_;
+
+    Node* insert_static(Node* node, std::string_view text);
+    Node* insert_param(Node* node, std::string_view spec, const std::string& pattern);
+    const Node* find(const Node* node, std::string_view path, std::size_t pos, PathParams& params) const;
+};
+
+}} // namespace
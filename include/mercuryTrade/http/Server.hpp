@@ -1,46 +1,124 @@
 #pragma once
+#include "Compression.hpp"
+#include "Headers.hpp"
+#include "JsonWriter.hpp"
+#include "PathParams.hpp"
+#include "Router.hpp"
 #include <string>
+#include <string_view>
 #include <functional>
 #include <map>
+#include <memory>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 namespace mercuryTrade {
 namespace http {
 
+// A parsed request. Method, path, headers and body are views into the
+// connection buffer and are only valid while the handler runs.
 class Request {
 public:
-    std::string method;
-    std::string path;
-    std::string body;
-    std::map<std::string, std::string> headers;
-    std::map<std::string, std::string> params;
+    std::string_view method;
+    std::string_view path;
+    std::string_view query;
+    std::string_view version;
+    std::string_view body;
+    HeaderList headers;
+    PathParams params;
+
+    std::string getParam(std::string_view name, const std::string& defaultValue = "") const {
+        auto param = params.find(name);
+        return param ? std::string(param->value) : defaultValue;
+    }
 
-    std::string getParam(const std::string& name, const std::string& defaultValue = "") const {
-        auto it = params.find(name);
-        return it != params.end() ? it->second : defaultValue;
+    // Value of `name` in the query string; no percent-decoding is applied
+    std::string getQuery(std::string_view name, const std::string& defaultValue = "") const {
+        std::string_view rest = query;
+        while (!rest.empty()) {
+            std::size_t amp = rest.find('&');
+            std::string_view pair = rest.substr(0, amp);
+            std::size_t eq = pair.find('=');
+            if (pair.substr(0, eq) == name) {
+                return eq == std::string_view::npos ? std::string() : std::string(pair.substr(eq + 1));
+            }
+            if (amp == std::string_view::npos) break;
+            rest.remove_prefix(amp + 1);
+        }
+        return defaultValue;
     }
 };
 
 class Response {
 public:
+    static constexpr std::size_t SERIALIZE_RESERVE = 256;  // Fits a typical single-object body
+
     int status = 200;
     std::string body;
     std::map<std::string, std::string> headers;
+    const char* content_type = "application/json";  // Must have static storage; a Content-Type header overrides it
+    std::shared_ptr<const Payload> payload;          // Shared immutable body; takes precedence over body
+    std::shared_ptr<const std::string> shared_body;  // Representation of payload actually sent
+    ContentEncoding content_encoding = ContentEncoding::Identity;
+    bool vary_encoding = false;                      // Representation depends on Accept-Encoding
+
+    std::string_view bodyView() const {
+        return shared_body ? std::string_view(*shared_body) : std::string_view(body);
+    }
     
     static Response json(const nlohmann::json& data, int status = 200) {
         Response res;
         res.status = status;
         res.body = data.dump();
-        res.headers["Content-Type"] = "application/json";
+        return res;
+    }
+
+    // Streams value straight into the body through its JsonSerializer,
+    // skipping the nlohmann::json tree that json() needs
+    template <typename T>
+    static Response serialize(const T& value, int status = 200) {
+        Response res;
+        res.status = status;
+        res.body.reserve(SERIALIZE_RESERVE);
+        JsonWriter writer(res.body);
+        writer.value(value);
+        return res;
+    }
+
+    // Raw body of the given media type; content_type must have static storage
+    static Response bytes(std::string data, const char* content_type, int status = 200) {
+        Response res;
+        res.status = status;
+        res.body = std::move(data);
+        res.content_type = content_type;
+        return res;
+    }
+
+    static Response shared(std::shared_ptr<const Payload> payload, int status = 200) {
+        Response res;
+        res.status = status;
+        res.shared_body = payload->identity();
+        res.payload = std::move(payload);
         return res;
     }
 };
 
 using RequestHandler = std::function<Response(const Request&)>;
 
+struct ServerOptions {
+    int idle_timeout_ms = 5000;                  // Close keep-alive connections idle for this long
+    int send_timeout_ms = 5000;                  // Drop clients that stop reading a response for this long
+    std::size_t max_requests_per_connection = 1000; // Requests served before the server asks to close
+    std::size_t max_header_bytes = 64 * 1024;    // Reject requests whose head never terminates
+    std::size_t max_body_bytes = 8 * 1024 * 1024; // Reject larger Content-Length or chunked bodies
+    bool compression = true;                     // Negotiate gzip/deflate via Accept-Encoding
+    std::size_t compression_min_bytes = 1024;    // Smaller bodies are cheaper to send as-is
+    int compression_level = 6;                   // zlib level for per-response compression
+};
+
 class Server {
 public:
-    Server(int port = 3000);
+    Server(int port = 3000, const ServerOptions& options = ServerOptions());
     void start();
     
     void get(const std::string& path, RequestHandler handler);
@@ -48,18 +126,21 @@ public:
     void put(const std::string& path, RequestHandler handler);
     void del(const std::string& path, RequestHandler handler);
 
+    // Serves one accepted connection until it closes, then closes
+    // client_fd. start() runs it on a thread per accepted socket.
+    void handle_connection(int client_fd);
+
 private:
     int port_;
     int server_fd_;
-    std::map<std::string, RequestHandler> route_handlers_;
+    ServerOptions options_;
+    std::string keep_alive_block_;
+    Router router_;
     
-    void handle_connection(int client_fd);
-    Request parse_request(const std::string& raw_request);
-    void send_response(int client_fd, const Response& res);
-    std::string route_pattern_to_regex(const std::string& pattern);
-    std::vector<std::string> extract_param_names(const std::string& pattern);
-    std::string get_status_text(int status);
-    void register_route(const std::string& method, const std::string& path, RequestHandler handler);
+    Response dispatch(Request& req);
+    void compress_response(const Request& req, Response& res, std::string& scratch) const;
+    bool wants_keep_alive(const Request& req) const;
+    void register_route(Method method, const std::string& path, RequestHandler handler);
 };
 
-}} // namespace
\ No newline at end of file
+}} // namespace
@@ -0,0 +1,73 @@
+// include/mercuryTrade/http/SnapshotCache.hpp
+#pragma once
+#include "Compression.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mercuryTrade {
+namespace http {
+
+// Serialized snapshots keyed by name and validated by a version number.
+//
+// get() returns the cached Payload while the caller's version matches the
+// one it was built at. Otherwise one caller rebuilds it and concurrent
+// callers for the same key wait for that result instead of serializing it
+// themselves. With a rebuild limit, an entry rebuilt less than 1/N seconds
+// ago keeps serving its previous payload even if it is out of date. Keys
+// beyond max_entries are built on every call and never stored, so
+// caller-chosen keys cannot grow the cache without bound.
+class SnapshotCache {
+public:
+    using Builder = std::function<std::string()>;
+
+    struct Stats {
+        std::uint64_t hits;
+        std::uint64_t rebuilds;
+        std::uint64_t throttled;  // Stale payloads served because of the rate limit
+    };
+
+    explicit SnapshotCache(unsigned max_rebuilds_per_second = 0, int compression_level = 6,
+                           std::size_t max_entries = 1024);
+
+    std::shared_ptr<const Payload> get(const std::string& key, std::uint64_t version, const Builder& build);
+
+    // Drops the entry so the next get() rebuilds regardless of version
+    void invalidate(const std::string& key);
+
+    Stats stats() const;
+
+private:
+    struct Snapshot {
+        std::uint64_t version;
+        std::chrono::steady_clock::time_point built_at;
+        std::shared_ptr<const Payload> payload;
+    };
+
+    struct Entry {
+        std::mutex build_mutex;                  // Serializes rebuilds of this key
+        std::shared_ptr<const Snapshot> current; // Accessed with std::atomic_load/store
+    };
+
+    std::chrono::steady_clock::duration min_interval_;
+    int compression_level_;
+    std::size_t max_entries_;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<Entry>> entries_;
+
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> rebuilds_{0};
+    std::atomic<std::uint64_t> throttled_{0};
+
+    Entry* entry(const std::string& key);
+    bool usable(const Snapshot* snapshot, std::uint64_t version, std::chrono::steady_clock::time_point now);
+};
+
+}} // namespace
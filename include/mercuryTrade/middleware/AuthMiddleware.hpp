@@ -16,7 +16,7 @@ public:
 
         try {
             // Extract token from "Bearer <token>"
-            std::string token = authHeader->second.substr(7);
+            std::string token(authHeader->value.substr(7));
             auto decoded = jwt::decode(token);
             
             // Verify token
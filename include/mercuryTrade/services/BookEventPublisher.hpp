@@ -0,0 +1,65 @@
+// include/mercuryTrade/services/BookEventPublisher.hpp
+#pragma once
+#include "OrderBookService.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace mercuryTrade {
+
+// Moves book listeners that encode or fan out off the matching thread.
+//
+// OrderBookService runs its listeners with the book locked, so anything
+// slow there holds up matching. start() registers listeners on the books
+// that only copy the delta, fill or top into a queue; one publisher
+// thread then hands them to the listeners added here, in the order the
+// books produced them. Nothing is dropped, so lossless streams such as
+// ORDER_BOOK_DELTA stay gap free.
+class BookEventPublisher {
+public:
+    BookEventPublisher() = default;
+    // Publishes everything already queued, then stops the thread
+    ~BookEventPublisher();
+
+    BookEventPublisher(const BookEventPublisher&) = delete;
+    BookEventPublisher& operator=(const BookEventPublisher&) = delete;
+
+    // Listeners must be added before start(); they run on the publisher thread
+    void addDeltaListener(OrderBookService::DeltaListener listener) { deltaListeners_.push_back(std::move(listener)); }
+    void addFillListener(OrderBookService::FillListener listener) { fillListeners_.push_back(std::move(listener)); }
+    void addTopListener(OrderBookService::TopListener listener) { topListeners_.push_back(std::move(listener)); }
+
+    // Follows every book in `books`, which must not outlive this publisher's
+    // last event. Like any book listener, call it before orders flow.
+    void start(OrderBookService& books);
+
+    // Events queued and not yet published
+    std::size_t backlog() const;
+
+private:
+    struct Event {
+        std::string symbol;
+        std::variant<core::memory::LevelDelta, core::memory::BookFill, core::memory::BookTop> data;
+    };
+
+    std::vector<OrderBookService::DeltaListener> deltaListeners_;
+    std::vector<OrderBookService::FillListener> fillListeners_;
+    std::vector<OrderBookService::TopListener> topListeners_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::vector<Event> pending_;
+    bool stopping_ = false;
+    std::thread thread_;
+
+    template <typename T>
+    void enqueue(const std::string& symbol, const T& data);
+    void run();
+};
+
+} // namespace mercuryTrade
@@ -1,6 +1,13 @@
 // include/mercuryTrade/services/MarketDataService.hpp
 #pragma once
+#include "../http/JsonWriter.hpp"
+#include "../wire/Messages.hpp"
+#include "../core/memory/mercBarAggregator.hpp"
+#include "../core/memory/mercLastValueCache.hpp"
+#include "../core/memory/mercTickStore.hpp"
+#include <memory>
 #include <string>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 namespace mercuryTrade {
@@ -23,14 +30,201 @@ struct MarketData {
             {"timestamp", timestamp}
         };
     }
+
+    std::string toBinary() const {
+        wire::Quote message;
+        message.symbol.assign(symbol);
+        message.bid = bid;
+        message.ask = ask;
+        message.last = last;
+        message.volume = volume;
+        message.timestamp = timestamp;
+
+        std::string out;
+        wire::encode(message, out);
+        return out;
+    }
+};
+
+// A range of bars for one symbol and interval
+struct BarSeries {
+    std::string symbol;
+    core::memory::BarInterval interval;
+    std::vector<core::memory::Bar> bars;
+};
+
+// Stored trades for one symbol, oldest first
+struct TradeHistory {
+    std::string symbol;
+    std::vector<core::memory::TickTrade> trades;
+};
+
+// Stored trades downsampled to bars of bucket nanoseconds
+struct HistoryBars {
+    std::string symbol;
+    std::int64_t bucket;
+    std::vector<core::memory::Bar> bars;
+};
+
+// Statistics over a range of stored trades
+struct MarketAnalysis {
+    std::string symbol;
+    std::size_t trades;
+    std::int64_t first;               // Timestamps of the first and last trade analysed
+    std::int64_t last;
+    double vwap;
+    double volume;
+    double low;
+    double high;
+    std::size_t volatility_window;    // Trades per rolling volatility window
+    double volatility;                // Latest window's deviation of trade-to-trade returns
+    double profile_low;
+    double bucket_width;
+    std::vector<double> profile;      // Volume traded per price bucket from profile_low up
+    const char* kernels;              // Kernel set that did the work
+};
+
+namespace http {
+template <>
+struct JsonSerializer<core::memory::Bar> {
+    static void write(JsonWriter& out, const core::memory::Bar& bar) {
+        out.beginObject()
+           .field("timestamp", bar.start)
+           .field("open", bar.open)
+           .field("high", bar.high)
+           .field("low", bar.low)
+           .field("close", bar.close)
+           .field("volume", bar.volume)
+           .field("trades", bar.trades)
+           .field("closed", bar.closed)
+           .endObject();
+    }
+};
+
+template <>
+struct JsonSerializer<BarSeries> {
+    static void write(JsonWriter& out, const BarSeries& series) {
+        out.beginObject()
+           .field("symbol", series.symbol)
+           .field("interval", core::memory::BarAggregator::intervalName(series.interval))
+           .field("bars", series.bars)
+           .endObject();
+    }
+};
+
+template <>
+struct JsonSerializer<core::memory::TickTrade> {
+    static void write(JsonWriter& out, const core::memory::TickTrade& trade) {
+        out.beginObject()
+           .field("timestamp", trade.timestamp)
+           .field("price", trade.price)
+           .field("quantity", trade.quantity)
+           .field("side", trade.buyer_aggressor ? "buy" : "sell")
+           .endObject();
+    }
 };
 
+template <>
+struct JsonSerializer<TradeHistory> {
+    static void write(JsonWriter& out, const TradeHistory& history) {
+        out.beginObject()
+           .field("symbol", history.symbol)
+           .field("trades", history.trades)
+           .endObject();
+    }
+};
+
+template <>
+struct JsonSerializer<HistoryBars> {
+    static void write(JsonWriter& out, const HistoryBars& history) {
+        out.beginObject()
+           .field("symbol", history.symbol)
+           .field("bucket", history.bucket)
+           .field("bars", history.bars)
+           .endObject();
+    }
+};
+
+template <>
+struct JsonSerializer<MarketAnalysis> {
+    static void write(JsonWriter& out, const MarketAnalysis& analysis) {
+        out.beginObject()
+           .field("symbol", analysis.symbol)
+           .field("trades", analysis.trades)
+           .field("from", analysis.first)
+           .field("to", analysis.last)
+           .field("vwap", analysis.vwap)
+           .field("volume", analysis.volume)
+           .field("low", analysis.low)
+           .field("high", analysis.high);
+        out.key("volatility").beginObject()
+           .field("window", analysis.volatility_window)
+           .field("latest", analysis.volatility)
+           .endObject();
+        out.key("volumeProfile").beginObject()
+           .field("low", analysis.profile_low)
+           .field("bucketWidth", analysis.bucket_width)
+           .field("volumes", analysis.profile)
+           .endObject();
+        out.field("kernels", analysis.kernels)
+           .endObject();
+    }
+};
+
+template <>
+struct JsonSerializer<MarketData> {
+    static void write(JsonWriter& out, const MarketData& data) {
+        out.beginObject()
+           .field("symbol", data.symbol)
+           .field("bid", data.bid)
+           .field("ask", data.ask)
+           .field("last", data.last)
+           .field("volume", data.volume)
+           .field("timestamp", data.timestamp)
+           .endObject();
+    }
+};
+} // namespace http
+
 class MarketDataService {
 public:
+    // Quotes come from the last value cache the feed handler keeps up to
+    // date; without one the service answers with fixed mock values
+    explicit MarketDataService(std::shared_ptr<const core::memory::LastValueCache> cache = nullptr,
+                               std::shared_ptr<const core::memory::BarAggregator> bars = nullptr,
+                               std::shared_ptr<const core::memory::TickStore> ticks = nullptr);
+
+    // Throws std::invalid_argument for a symbol the cache has not seen
     MarketData getMarketData(const std::string& symbol);
     std::vector<std::string> getAvailableSymbols() const;
+
+    // Bars starting in [from, to) nanoseconds, at most limit of the newest.
+    // Throws std::invalid_argument for an unknown interval name and
+    // std::runtime_error when no bars are being built.
+    BarSeries getBars(const std::string& symbol, const std::string& interval, std::int64_t from,
+                      std::int64_t to, std::size_t limit) const;
+
+    // Stored trades in [from, to) nanoseconds, at most limit of the newest,
+    // and the same trades downsampled to bars of bucket nanoseconds. Both
+    // throw std::runtime_error when no tick history is kept.
+    TradeHistory getTrades(const std::string& symbol, std::int64_t from, std::int64_t to, std::size_t limit) const;
+    HistoryBars getHistory(const std::string& symbol, std::int64_t from, std::int64_t to, std::int64_t bucket,
+                           std::size_t limit) const;
+
+    // VWAP, range, rolling volatility over window trades and a volume
+    // profile of buckets price buckets, for the newest max_trades stored
+    // trades in [from, to). Throws std::runtime_error when no tick history
+    // is kept; an empty range gives zero trades and zero statistics.
+    MarketAnalysis getAnalysis(const std::string& symbol, std::int64_t from, std::int64_t to, std::size_t window,
+                               std::size_t buckets, std::size_t max_trades) const;
+
+    // {"symbol", "interval", "bar"} as pushed when a bar closes
+    static std::string barToJson(const std::string& symbol, core::memory::BarInterval interval,
+                                 const core::memory::Bar& bar);
 private:
-    // In a real implementation, this would maintain connections to market data feeds
+    std::shared_ptr<const core::memory::LastValueCache> cache_;
+    std::shared_ptr<const core::memory::BarAggregator> bars_;
+    std::shared_ptr<const core::memory::TickStore> ticks_;
 };
 
 } // namespace mercuryTrade
\ No newline at end of file
@@ -0,0 +1,93 @@
+// include/mercuryTrade/services/Order.hpp
+#pragma once
+#include "../http/JsonWriter.hpp"
+#include "../wire/Messages.hpp"
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace mercuryTrade {
+
+enum class OrderSide {
+    Buy,
+    Sell
+};
+
+enum class OrderType {
+    Market,
+    Limit
+};
+
+enum class OrderStatus {
+    New,
+    PartiallyFilled,
+    Filled,
+    Cancelled,
+    Rejected
+};
+
+struct Order {
+    std::string id;
+    std::string symbol;
+    OrderSide side;
+    OrderType type;
+    double quantity;
+    double price;  // Only used for limit orders
+    OrderStatus status;
+    long timestamp;
+    double filled_quantity = 0.0;
+    std::string account;  // Whose risk limits apply; empty for the default account
+
+    nlohmann::json toJson() const {
+        return {
+            {"id", id},
+            {"symbol", symbol},
+            {"side", side == OrderSide::Buy ? "buy" : "sell"},
+            {"type", type == OrderType::Market ? "market" : "limit"},
+            {"quantity", quantity},
+            {"price", price},
+            {"status", static_cast<int>(status)},
+            {"filled_quantity", filled_quantity},
+            {"timestamp", timestamp},
+            {"account", account}
+        };
+    }
+
+    std::string toBinary() const {
+        wire::OrderUpdate message;
+        message.order_id.assign(id);
+        message.symbol.assign(symbol);
+        message.price = price;
+        message.quantity = quantity;
+        message.filled_quantity = filled_quantity;
+        message.timestamp = timestamp;
+        message.side = side == OrderSide::Buy ? wire::Side::Buy : wire::Side::Sell;
+        message.type = static_cast<std::uint8_t>(type);
+        message.status = static_cast<std::uint8_t>(status);
+
+        std::string out;
+        wire::encode(message, out);
+        return out;
+    }
+};
+
+namespace http {
+template <>
+struct JsonSerializer<Order> {
+    static void write(JsonWriter& out, const Order& order) {
+        out.beginObject()
+           .field("id", order.id)
+           .field("symbol", order.symbol)
+           .field("side", order.side == OrderSide::Buy ? "buy" : "sell")
+           .field("type", order.type == OrderType::Market ? "market" : "limit")
+           .field("quantity", order.quantity)
+           .field("price", order.price)
+           .field("status", static_cast<int>(order.status))
+           .field("filled_quantity", order.filled_quantity)
+           .field("timestamp", order.timestamp)
+           .field("account", order.account)
+           .endObject();
+    }
+};
+} // namespace http
+
+} // namespace mercuryTrade
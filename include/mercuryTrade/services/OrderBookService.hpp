@@ -1,6 +1,20 @@
 // include/mercuryTrade/services/OrderBookService.hpp
 #pragma once
+#include "../core/memory/mercLevelDeltaLog.hpp"
+#include "../core/memory/mercLimitOrderBook.hpp"
+#include "../core/memory/mercMarketDataBus.hpp"
+#include "../core/memory/mercOrderBookAllocator.hpp"
+#include "../http/JsonWriter.hpp"
+#include "../http/SnapshotCache.hpp"
+#include "../wire/Messages.hpp"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <nlohmann/json.hpp>
 
@@ -9,12 +23,15 @@ namespace mercuryTrade {
 struct OrderBookLevel {
     double price;
     double quantity;
-    
-    nlohmann::json toJson() const {
-        return {
+    double total = 0.0;  // Running size from the top of book, if requested
+
+    nlohmann::json toJson(bool withTotal = false) const {
+        nlohmann::json j = {
             {"price", price},
             {"quantity", quantity}
         };
+        if (withTotal) j["total"] = total;
+        return j;
     }
 };
 
@@ -23,28 +40,140 @@ struct OrderBook {
     std::vector<OrderBookLevel> bids;
     std::vector<OrderBookLevel> asks;
     long timestamp;
+    std::uint64_t seq = 0;  // Last level delta reflected in this book
+    bool cumulative = false;
 
     nlohmann::json toJson() const {
         nlohmann::json j;
         j["symbol"] = symbol;
         j["timestamp"] = timestamp;
+        j["seq"] = seq;
 
         auto& bidsJson = j["bids"] = nlohmann::json::array();
         auto& asksJson = j["asks"] = nlohmann::json::array();
 
-        for (const auto& bid : bids) bidsJson.push_back(bid.toJson());
-        for (const auto& ask : asks) asksJson.push_back(ask.toJson());
+        for (const auto& bid : bids) bidsJson.push_back(bid.toJson(cumulative));
+        for (const auto& ask : asks) asksJson.push_back(ask.toJson(cumulative));
 
         return j;
     }
 };
 
+namespace http {
+template <>
+struct JsonSerializer<OrderBook> {
+    static void write(JsonWriter& out, const OrderBook& book) {
+        out.beginObject()
+           .field("symbol", book.symbol)
+           .field("timestamp", book.timestamp)
+           .field("seq", book.seq);
+        out.key("bids");
+        writeLevels(out, book.bids, book.cumulative);
+        out.key("asks");
+        writeLevels(out, book.asks, book.cumulative);
+        out.endObject();
+    }
+
+    static void writeLevels(JsonWriter& out, const std::vector<OrderBookLevel>& levels, bool withTotal) {
+        out.beginArray();
+        for (const auto& level : levels) {
+            out.beginObject().field("price", level.price).field("quantity", level.quantity);
+            if (withTotal) out.field("total", level.total);
+            out.endObject();
+        }
+        out.endArray();
+    }
+};
+
+// Same shape as OrderBookService::deltaToJson()
+template <>
+struct JsonSerializer<core::memory::LevelDelta> {
+    static void write(JsonWriter& out, const core::memory::LevelDelta& delta) {
+        out.beginObject()
+           .field("seq", delta.seq)
+           .field("side", delta.side == core::memory::BookSide::BID ? "bid" : "ask")
+           .field("price", delta.price)
+           .field("quantity", delta.size)
+           .field("orders", delta.order_count)
+           .endObject();
+    }
+};
+} // namespace http
+
+// Shape of an order-book response
+struct OrderBookQuery {
+    std::size_t depth = std::numeric_limits<std::size_t>::max();  // Levels (or buckets) per side
+    double tick = 0.0;        // Bucket width; 0 returns individual price levels
+    bool cumulative = false;  // Add running totals to each level
+
+    bool isDefault() const {
+        return depth == std::numeric_limits<std::size_t>::max() && tick == 0.0 && !cumulative;
+    }
+};
+
+// Owns the live engine book for each symbol and the recent level-delta
+// history used to resynchronise clients.
+//
+// Clients apply ORDER_BOOK_DELTA messages on top of a snapshot. If they
+// see a sequence gap they fetch the deltas after the last sequence they
+// applied; if those are no longer retained, they reload the snapshot.
 class OrderBookService {
 public:
-    OrderBook getOrderBook(const std::string& symbol);
-    void updateOrderBook(const std::string& symbol, const OrderBook& book);
+    using DeltaListener = std::function<void(const std::string& symbol, const core::memory::LevelDelta&)>;
+    using FillListener = std::function<void(const std::string& symbol, const core::memory::BookFill&)>;
+    using TopListener = std::function<void(const std::string& symbol, const core::memory::BookTop&)>;
+
+    // snapshotRebuildsPerSecond caps how often a cached snapshot is
+    // re-serialized for a busy book; 0 rebuilds on every change
+    explicit OrderBookService(std::size_t deltaHistory = 4096, unsigned snapshotRebuildsPerSecond = 0,
+        const core::memory::OrderBookAllocator::Config& config =
+            core::memory::OrderBookAllocator::Config::getDefaultConfig());
+
+    OrderBook getOrderBook(const std::string& symbol, const OrderBookQuery& query = OrderBookQuery());
+    // Serialized getOrderBook(), shared by every reader until the book changes
+    std::shared_ptr<const http::Payload> getOrderBookPayload(const std::string& symbol,
+                                                             const OrderBookQuery& query = OrderBookQuery());
+    // Deltas after `afterSeq`, or nullopt if some have already been discarded
+    std::optional<std::vector<core::memory::LevelDelta>> getDeltasSince(const std::string& symbol,
+                                                                        std::uint64_t afterSeq);
+
+    // Engine book for `symbol`, created on first use
+    core::memory::LimitOrderBook& book(const std::string& symbol);
+    std::vector<std::string> symbols() const;
+    // Every engine book; the pointers stay valid for the service's lifetime
+    std::vector<core::memory::LimitOrderBook*> books() const;
+
+    // Listeners must be registered before orders start flowing. They run
+    // while the book is locked, in sequence order.
+    void addDeltaListener(DeltaListener listener) { deltaListeners_.push_back(std::move(listener)); }
+    void addFillListener(FillListener listener) { fillListeners_.push_back(std::move(listener)); }
+    void addTopListener(TopListener listener) { topListeners_.push_back(std::move(listener)); }
+    // Publishes each book's top and fills to `bus` through a channel
+    // resolved once, when the book is created. Set it before the first
+    // book; `bus` must stay alive while orders flow.
+    void setMarketDataBus(core::memory::MarketDataBus* bus) { marketDataBus_ = bus; }
+
+    static nlohmann::json deltaToJson(const core::memory::LevelDelta& delta);
+    // Appends the wire::BookDelta encoding of `delta` to `out`
+    static void deltaToBinary(const std::string& symbol, const core::memory::LevelDelta& delta, std::string& out);
+
 private:
-    // Would maintain real-time order book state
+    struct SymbolBook {
+        std::unique_ptr<core::memory::LimitOrderBook> book;
+        std::unique_ptr<core::memory::LevelDeltaLog> history;
+    };
+
+    std::size_t deltaHistory_;
+    core::memory::OrderBookAllocator allocator_;  // Declared first so it outlives the books
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, SymbolBook> books_;
+    std::vector<DeltaListener> deltaListeners_;
+    std::vector<FillListener> fillListeners_;
+    std::vector<TopListener> topListeners_;
+    core::memory::MarketDataBus* marketDataBus_ = nullptr;
+    http::SnapshotCache snapshotCache_;
+
+    SymbolBook& symbolBook(const std::string& symbol);
 };
 
-} // namespace mercuryTrade
\ No newline at end of file
+} // namespace mercuryTrade
@@ -0,0 +1,68 @@
+// include/mercuryTrade/services/OrderEngine.hpp
+#pragma once
+#include "../core/memory/mercTradingManager.hpp"
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mercuryTrade {
+
+// Command queue in front of the core trading manager.
+//
+// One engine thread owns the manager and runs commands one at a time, in
+// the order they were posted. Callers only take the queue lock long enough
+// to append a command and then wait on its future, so request threads never
+// contend on the manager's pools, transactions or the order books, and a
+// request waits for nothing but its own acknowledgement. Commands posted
+// from the engine thread itself, e.g. from a fill callback, run inline.
+class OrderEngine {
+public:
+    using Manager = core::memory::tradingManager;
+
+    explicit OrderEngine(const Manager::Config& config = Manager::Config::getDefautltConfig());
+    // Runs every command already posted, then stops the manager
+    ~OrderEngine();
+
+    OrderEngine(const OrderEngine&) = delete;
+    OrderEngine& operator=(const OrderEngine&) = delete;
+
+    // Queues fn(Manager&) and returns a future for its result; anything fn
+    // throws is rethrown by future::get(). Throws std::runtime_error once
+    // the engine is shutting down.
+    template <typename Fn>
+    auto post(Fn&& fn) -> std::future<std::invoke_result_t<Fn&, Manager&>> {
+        using Result = std::invoke_result_t<Fn&, Manager&>;
+        auto task = std::make_shared<std::packaged_task<Result(Manager&)>>(std::forward<Fn>(fn));
+        auto result = task->get_future();
+        if (onEngineThread()) {
+            (*task)(manager_);
+        } else {
+            enqueue([task](Manager& manager) { (*task)(manager); });
+        }
+        return result;
+    }
+
+    bool onEngineThread() const { return std::this_thread::get_id() == thread_.get_id(); }
+
+    Manager::Stats stats();
+
+private:
+    using Command = std::function<void(Manager&)>;
+
+    Manager manager_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::vector<Command> pending_;
+    bool stopping_ = false;
+    std::thread thread_;
+
+    void enqueue(Command command);
+    void run();
+};
+
+} // namespace mercuryTrade
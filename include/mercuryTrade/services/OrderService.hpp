@@ -1,64 +1,176 @@
 // include/mercuryTrade/services/OrderService.hpp
 #pragma once
+#include "../core/memory/mercCommandJournal.hpp"
+#include "../core/memory/mercRiskEngine.hpp"
+#include "Order.hpp"
+#include "OrderBookService.hpp"
+#include "OrderEngine.hpp"
+#include "OrderStore.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <vector>
-#include <optional>
 #include <nlohmann/json.hpp>
 
 namespace mercuryTrade {
 
-enum class OrderSide {
-    Buy,
-    Sell
-};
-
-enum class OrderType {
-    Market,
-    Limit
-};
-
-enum class OrderStatus {
-    New,
-    PartiallyFilled,
-    Filled,
-    Cancelled,
-    Rejected
-};
-
-struct Order {
-    std::string id;
-    std::string symbol;
-    OrderSide side;
-    OrderType type;
-    double quantity;
-    double price;  // Only used for limit orders
-    OrderStatus status;
-    long timestamp;
-
-    nlohmann::json toJson() const {
-        return {
-            {"id", id},
-            {"symbol", symbol},
-            {"side", side == OrderSide::Buy ? "buy" : "sell"},
-            {"type", type == OrderType::Market ? "market" : "limit"},
-            {"quantity", quantity},
-            {"price", price},
-            {"status", static_cast<int>(status)},
-            {"timestamp", timestamp}
-        };
-    }
-};
-
+// Order entry and lifecycle. Lookups and listings read the store directly;
+// everything that changes an order runs as a command on the engine thread,
+// which admits it through the core trading manager and then matches it, so
+// the calling thread only waits for the acknowledgement. With a journal,
+// accepted orders and cancels are logged on the engine thread and the
+// caller additionally waits for its records to be durable, which lets
+// later commands run while earlier ones are being synced.
+//
+// A snapshot captures the orders and books as of one journal sequence.
+// The engine thread only pauses to fork(); the child serializes its
+// copy-on-write image of the state while the engine carries on. Recovery
+// loads the newest snapshot and replays just the journal records after it.
+//
+// Before an order reaches the manager it is checked against its account's
+// pre-trade limits, and a rejected order never reaches a book. The risk
+// engine lives on the engine thread with the orders, and fills, cancels
+// and rejections keep its exposures current. Replayed orders were checked
+// when first placed, so recovery only reserves for them.
 class OrderService {
 public:
+    using OrderListener = std::function<void(const Order&)>;
+
+    // Without an order book service orders are only recorded, never matched
+    explicit OrderService(std::shared_ptr<OrderBookService> orderBooks = nullptr,
+                          std::shared_ptr<core::memory::CommandJournal> journal = nullptr,
+                          const core::memory::RiskEngine::Config& risk =
+                              core::memory::RiskEngine::Config::getDefaultConfig());
+
     Order placeOrder(const Order& order);
     void cancelOrder(const std::string& orderId);
-    std::vector<Order> getOrders(const std::string& symbol = "");
+
+    // Batch entry: each symbol's book is locked once for all of its orders.
+    // Results are in request order.
+    std::vector<Order> placeOrders(const std::vector<Order>& orders);
+    // Cancels the open orders among orderIds; nullopt for unknown ids.
+    // Orders that were no longer open come back unchanged.
+    std::vector<std::optional<Order>> cancelOrders(const std::vector<std::string>& orderIds);
+    // Cancels every open order for symbol and returns them
+    std::vector<Order> cancelAllOrders(const std::string& symbol);
+    // One page of orders, oldest first; see OrderQuery
+    OrderPage getOrders(const OrderQuery& query = OrderQuery());
     std::optional<Order> getOrderById(const std::string& orderId);
 
+    core::memory::tradingManager::Stats engineStats() { return engine_.stats(); }
+
+    // Replaces the account's limits for orders placed from now on. Orders
+    // for a named account are rejected until it has limits; orders without
+    // one use the default limits. Throws std::invalid_argument for negative
+    // limits and std::length_error once max_accounts have limits.
+    void setRiskLimits(const std::string& account, const core::memory::RiskEngine::Limits& limits);
+    // The account's position in symbol, with its resting quantity per side;
+    // all zero for an account the engine does not know
+    core::memory::RiskEngine::Exposure riskExposure(const std::string& account, const std::string& symbol);
+
+    // Writes a snapshot into directory and returns its path, then deletes
+    // older snapshots there and the journal segments the new one covers.
+    // Blocks the caller, not the engine, until the file is durable; it is
+    // only renamed into place once the journal it covers is durable too.
+    // Throws std::runtime_error if the snapshot could not be written.
+    std::string snapshot(const std::string& directory);
+    // Restores a fresh service from the newest snapshot in directory, if
+    // any, and replays the journal after it; returns the number of commands
+    // replayed. Call before orders start flowing. Throws std::runtime_error
+    // if the snapshot is corrupt or the journal does not continue it.
+    std::size_t recover(const std::string& directory);
+
+    // Called after every order state change, e.g. to push ORDER_UPDATE
+    // messages, once the command that made it is durable in the journal.
+    // Runs on one publisher thread, in journal order, and before the call
+    // that issued the command returns. It must not place or cancel orders.
+    // Set before orders start flowing.
+    void setOrderListener(OrderListener listener) { listener_ = std::move(listener); }
+
 private:
-    // Would maintain order state and connect to exchange
-    std::vector<Order> orders_;
+    // Hands each command's updates to the listener in the order the engine
+    // ran the commands, waiting for every batch to be durable first. Request
+    // threads wait for their own batch rather than publishing it, so two
+    // commands finishing their syncs out of order cannot reorder updates.
+    class UpdatePublisher {
+    public:
+        explicit UpdatePublisher(OrderService& service);
+        // Publishes everything already queued, then stops
+        ~UpdatePublisher();
+
+        // Engine thread only, so batches queue in journal order. Returns a
+        // ticket for waitPublished().
+        std::uint64_t push(std::uint64_t sequence, std::vector<Order> updates);
+        void waitPublished(std::uint64_t ticket);
+
+    private:
+        struct Batch {
+            std::uint64_t sequence;
+            std::vector<Order> updates;
+        };
+
+        OrderService& service_;
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::condition_variable done_;
+        std::vector<Batch> pending_;
+        std::uint64_t queued_ = 0;
+        std::uint64_t published_ = 0;
+        bool stopping_ = false;
+        std::thread thread_;
+
+        void run();
+    };
+
+    std::shared_ptr<OrderBookService> orderBooks_;
+    OrderStore store_;
+    OrderListener listener_;
+    std::shared_ptr<core::memory::CommandJournal> journal_;
+    core::memory::RiskEngine risk_;  // Engine thread only
+    std::uint64_t journaled_ = 0;  // Last journal sequence; engine thread only
+    bool replaying_ = false;       // Recovering; journal nothing. Engine thread only
+    std::vector<Order> pending_;   // Updates for the listener once the command is durable; engine thread only
+    std::mutex snapshotMutex_;     // One snapshot at a time
+    // After the listener and journal it reads, before the engine that feeds it
+    UpdatePublisher publisher_;
+    // Last, so the engine drains before the state its commands touch goes away
+    OrderEngine engine_;
+
+    // Runs fn(manager) on the engine thread and returns its result once the
+    // records it journaled are durable
+    template <typename Fn>
+    auto execute(Fn fn) -> std::invoke_result_t<Fn&, core::memory::tradingManager&>;
+
+    // The rest run on the engine thread
+    std::vector<Order> admitOrders(std::vector<Order> placed, core::memory::tradingManager& manager);
+    bool cancelOpen(const std::string& orderId, core::memory::tradingManager& manager);
+    // Runs in the forked child, where only this thread exists
+    std::string encodeSnapshot(std::uint64_t sequence,
+                               const std::vector<core::memory::LimitOrderBook*>& books) const;
+    std::uint64_t loadSnapshot(const std::string& path, core::memory::tradingManager& manager);
+    void replay(const core::memory::JournalCommand& command, core::memory::tradingManager& manager);
+    // Queues order for the listener; execute() hands the queue to publisher_
+    void notify(const Order& order);
+    void journalNew(const Order& order);
+    void journalCancel(const std::string& orderId, const std::string& symbol);
+    void matchOrders(std::vector<Order>& orders, core::memory::tradingManager& manager);
+    void applyFill(const std::string& orderId, double quantity);
+    // Checks the order against its account's limits (unless replaying) and
+    // reserves what it could add if it rests
+    core::memory::RiskCheck reserveRisk(const Order& order);
+    // A limit order stopped resting with remaining quantity unfilled
+    void releaseRisk(const Order& order, double remaining);
+    // Marks an open order Cancelled and releases it from the manager;
+    // returns it if this call changed it
+    std::optional<Order> markCancelled(const std::string& orderId, core::memory::tradingManager& manager);
+    void settlePlacement(Order& placed, const core::memory::LimitOrderBook::Result& result,
+                         core::memory::tradingManager& manager);
 };
 
 } // namespace mercuryTrade
\ No newline at end of file
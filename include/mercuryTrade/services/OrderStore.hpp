@@ -0,0 +1,130 @@
+// include/mercuryTrade/services/OrderStore.hpp
+#pragma once
+#include "Order.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mercuryTrade {
+
+// Filter and position for OrderStore::list()
+struct OrderQuery {
+    std::string symbol;                 // Empty matches every symbol
+    std::optional<OrderStatus> status;  // Unset matches every status
+    std::uint64_t after = 0;            // Cursor from a previous page; 0 starts at the oldest order
+    std::size_t limit = 100;
+};
+
+struct OrderPage {
+    std::vector<Order> orders;   // Oldest first
+    std::uint64_t next_cursor = 0;  // Pass as `after` for the next page; 0 when this was the last
+};
+
+// Thread-safe order storage.
+//
+// Ids are "ORD-<sequence>" with a process-wide monotonic sequence, so they
+// never collide and sort by submission time. Orders live in shards keyed by
+// sequence, each behind its own shared_mutex, so lookups and updates of
+// unrelated orders do not contend. Per-symbol and per-status indexes of
+// sequences, kept in step on every status change, serve filtered listings
+// and cursor pagination without scanning the whole store.
+class OrderStore {
+public:
+    static constexpr std::size_t SHARD_COUNT = 64;
+    static constexpr std::size_t MAX_PAGE_SIZE = 1000;
+
+    // Reserves the next order id
+    std::string nextId();
+
+    // Stores an order whose id came from nextId(). Throws
+    // std::invalid_argument for foreign or duplicate ids.
+    void insert(const Order& order);
+
+    std::optional<Order> get(const std::string& orderId) const;
+
+    // Runs fn(Order&) on the stored order while holding its shard lock and
+    // returns the updated copy, or nullopt if the id is unknown. fn must not
+    // change the id or symbol, and must not call back into the store.
+    template <typename Fn>
+    std::optional<Order> update(const std::string& orderId, Fn&& fn) {
+        std::uint64_t seq;
+        if (!parseSequence(orderId, seq)) {
+            return std::nullopt;
+        }
+        Shard& s = shard(seq);
+        std::unique_lock<std::shared_mutex> lock(s.mutex);
+        auto it = s.orders.find(seq);
+        if (it == s.orders.end()) {
+            return std::nullopt;
+        }
+        OrderStatus before = it->second.status;
+        fn(it->second);
+        if (it->second.status != before) {
+            reindex(seq, it->second.symbol, before, it->second.status);
+        }
+        return it->second;
+    }
+
+    OrderPage list(const OrderQuery& query) const;
+
+    // Ids of New and PartiallyFilled orders for symbol, oldest first
+    std::vector<std::string> openOrderIds(const std::string& symbol) const;
+
+    std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    // Sequence the next id will use
+    std::uint64_t nextSequence() const { return nextSequence_.load(std::memory_order_relaxed); }
+    // Makes sure no id up to orderId is issued again, so an order recorded
+    // elsewhere, e.g. in a journal, can be inserted under its original id
+    void reserveThrough(const std::string& orderId);
+
+    // Replaces the contents of an empty store with orders from a snapshot.
+    // Throws std::logic_error if the store is not empty and
+    // std::invalid_argument for malformed or duplicate ids.
+    void restore(std::vector<Order> orders, std::uint64_t nextSequence);
+
+    // Calls fn(const Order&) for every order, in no particular order,
+    // without taking any lock. Only for a process forked for a snapshot,
+    // where a lock may have been copied while held and nothing else runs.
+    template <typename Fn>
+    void forEachUnlocked(Fn&& fn) const {
+        for (const Shard& s : shards_) {
+            for (const auto& entry : s.orders) {
+                fn(entry.second);
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t STATUS_COUNT = 5;
+    using StatusIndex = std::array<std::set<std::uint64_t>, STATUS_COUNT>;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::uint64_t, Order> orders;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards_;
+    std::atomic<std::uint64_t> nextSequence_{1};
+    std::atomic<std::size_t> size_{0};
+
+    // Taken after a shard lock, never before one
+    mutable std::shared_mutex indexMutex_;
+    std::unordered_map<std::string, StatusIndex> bySymbol_;
+    StatusIndex byStatus_;
+
+    static bool parseSequence(std::string_view orderId, std::uint64_t& seq);
+    Shard& shard(std::uint64_t seq) { return shards_[seq % SHARD_COUNT]; }
+    const Shard& shard(std::uint64_t seq) const { return shards_[seq % SHARD_COUNT]; }
+    void reindex(std::uint64_t seq, const std::string& symbol, OrderStatus from, OrderStatus to);
+};
+
+} // namespace mercuryTrade
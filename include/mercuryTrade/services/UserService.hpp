@@ -1,5 +1,6 @@
 // include/mercuryTrade/services/UserService.hpp
 #pragma once
+#include "../http/JsonWriter.hpp"
 #include <string>
 #include <memory>
 #include <nlohmann/json.hpp>
@@ -11,9 +12,9 @@ public:
     User(const std::string& id, const std::string& email, const std::string& username)
         : m_id(id), m_email(email), m_username(username) {}
     
-    std::string getId() const { return m_id; }
-    std::string getEmail() const { return m_email; }
-    std::string getUsername() const { return m_username; }
+    const std::string& getId() const { return m_id; }
+    const std::string& getEmail() const { return m_email; }
+    const std::string& getUsername() const { return m_username; }
 
     nlohmann::json toJson() const {
         return {
@@ -29,6 +30,19 @@ private:
     std::string m_username;
 };
 
+namespace http {
+template <>
+struct JsonSerializer<User> {
+    static void write(JsonWriter& out, const User& user) {
+        out.beginObject()
+           .field("id", user.getId())
+           .field("email", user.getEmail())
+           .field("username", user.getUsername())
+           .endObject();
+    }
+};
+} // namespace http
+
 class UserService {
 public:
     std::shared_ptr<User> authenticate(const std::string& email, const std::string& password);
@@ -0,0 +1,50 @@
+// include/mercuryTrade/websocket/Frame.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace mercuryTrade {
+namespace websocket {
+
+enum class Opcode : std::uint8_t {
+    Continuation = 0x0,
+    Text = 0x1,
+    Binary = 0x2,
+    Close = 0x8,
+    Ping = 0x9,
+    Pong = 0xA
+};
+
+// An encoded server frame. Frames are immutable once built so a broadcast
+// can hand the same buffer to every subscriber's send queue.
+using Frame = std::shared_ptr<const std::string>;
+
+// Encodes an unmasked server-to-client frame with FIN set
+std::string encodeFrame(Opcode opcode, std::string_view payload);
+
+inline Frame makeFrame(Opcode opcode, std::string_view payload) {
+    return std::make_shared<const std::string>(encodeFrame(opcode, payload));
+}
+
+struct DecodedFrame {
+    bool fin = false;
+    Opcode opcode = Opcode::Continuation;
+    std::string_view payload;   // Unmasked in place inside the caller's buffer
+    std::size_t consumed = 0;   // Header plus payload bytes
+};
+
+enum class DecodeResult {
+    Complete,
+    Incomplete,
+    Error
+};
+
+// Decodes one client-to-server frame from data. Client frames must be masked
+// (RFC 6455 5.1); control frames must be final and at most 125 bytes.
+// Payloads larger than max_payload are rejected.
+DecodeResult decodeFrame(char* data, std::size_t size, std::size_t max_payload, DecodedFrame& frame);
+
+}} // namespace
@@ -0,0 +1,21 @@
+// include/mercuryTrade/websocket/Handshake.hpp
+#pragma once
+#include "../http/Server.hpp"
+#include <string>
+#include <string_view>
+
+namespace mercuryTrade {
+namespace websocket {
+
+// Sec-WebSocket-Accept value for a client's Sec-WebSocket-Key:
+// base64(SHA-1(key + RFC 6455 GUID))
+std::string acceptKey(std::string_view client_key);
+
+// Checks that a parsed request is a version 13 WebSocket upgrade. Returns
+// nullptr on success or a short reason suitable for a 400 response.
+const char* validateUpgrade(const http::Request& req);
+
+// Full 101 Switching Protocols response for an accepted upgrade
+std::string upgradeResponse(std::string_view client_key);
+
+}} // namespace
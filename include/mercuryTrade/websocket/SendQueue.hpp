@@ -0,0 +1,66 @@
+// include/mercuryTrade/websocket/SendQueue.hpp
+#pragma once
+#include "Frame.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mercuryTrade {
+namespace websocket {
+
+// Outbound frames for one connection.
+//
+// Producers never block on the socket: they only append a shared frame
+// pointer under a short lock. Lossless frames (trades, order updates) are
+// bounded by capacity and report Overflow when a consumer falls that far
+// behind. Conflated frames (quotes, book snapshots) carry a key; while a
+// keyed frame is still waiting, a newer one for the same key replaces it in
+// place, so a slow reader skips stale values instead of growing the queue.
+class SendQueue {
+public:
+    enum class PushResult {
+        Queued,
+        Conflated,   // Replaced a pending frame with the same key
+        Overflow,    // Lossless capacity exhausted; the consumer is too slow
+        Closed
+    };
+
+    struct Stats {
+        std::size_t queued = 0;
+        std::size_t conflated = 0;
+    };
+
+    explicit SendQueue(std::size_t capacity);
+
+    PushResult push(Frame frame);
+    PushResult pushLatest(const std::string& key, Frame frame);
+
+    // Blocks until frames are pending, then moves up to max_frames of them
+    // into batch in queue order. Returns false once closed and drained.
+    bool pop(std::vector<Frame>& batch, std::size_t max_frames);
+
+    void close();
+    bool closed() const;
+    std::size_t size() const;
+    Stats stats() const;
+
+private:
+    struct Entry {
+        const std::string* key;  // Points into latest_, or nullptr for lossless frames
+        Frame frame;
+    };
+
+    std::size_t capacity_;
+    std::size_t lossless_count_ = 0;
+    bool closed_ = false;
+    Stats stats_;
+    std::deque<Entry> entries_;
+    std::unordered_map<std::string, Entry*> latest_;  // Pending keyed entries; deque ends keep references stable
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+};
+
+}} // namespace
@@ -1,28 +1,111 @@
 // include/mercuryTrade/websocket/WebSocketServer.hpp
 #pragma once
+#include "Frame.hpp"
+#include "SendQueue.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
-#include <functional>
-#include <map>
-#include <websocketpp/server.hpp>
-#include <websocketpp/config/asio_no_tls.hpp>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <nlohmann/json.hpp>
 
 namespace mercuryTrade {
 namespace websocket {
 
+enum class Delivery {
+    Conflate,  // Slow subscribers only get the latest message per channel
+    Lossless   // Every message is delivered; a subscriber that falls too far behind is dropped
+};
+
+struct WebSocketOptions {
+    std::size_t max_queued_frames = 1024;       // Lossless frames buffered per connection
+    std::size_t max_message_bytes = 64 * 1024;  // Largest client message, after reassembly
+    std::size_t max_batch_frames = 64;          // Frames written per sendmsg()
+    int handshake_timeout_ms = 5000;
+    int send_timeout_ms = 5000;                 // A socket blocked this long is dropped
+};
+
+// Push server for the trading frontend.
+//
+// Clients subscribe to channels named "<TYPE>:<SYMBOL>" (for example
+// "ORDER_BOOK:BTC-USD"), "<TYPE>:*" for every symbol, or "*" for
+// everything, by sending
+//   {"action": "subscribe", "channels": [...]}
+// and receive {"type", "symbol", "payload"} messages. Clients that connect
+// to "/ws?format=binary" instead receive the binary encoding of messages
+// that have one (see wire/Messages.hpp) as binary frames, and JSON text
+// frames for the rest.
+//
+// broadcast() encodes a message into one immutable frame and hands a
+// pointer to it to each subscriber's SendQueue; it never touches a socket.
+// Every connection has its own writer thread that drains its queue in
+// batches, so a slow browser only ever delays itself.
 class WebSocketServer {
 public:
-    WebSocketServer(int port);
+    explicit WebSocketServer(int port, const WebSocketOptions& options = WebSocketOptions());
+    ~WebSocketServer();
+
+    // Accepts connections until stop() is called
     void start();
-    void broadcast(const std::string& channel, const std::string& message);
+    void stop();
+
+    // Port actually bound, useful when constructed with port 0
+    int port() const { return port_; }
+
+    void broadcast(const std::string& channel, const std::string& message,
+                   Delivery delivery = Delivery::Conflate);
+    // As above, sending `binary` to binary-format subscribers when non-empty
+    void broadcast(const std::string& channel, const std::string& message, std::string_view binary,
+                   Delivery delivery);
+
+    // Sends {"type", "symbol", "payload"} on channel "<type>:<symbol>"
+    void publish(std::string_view type, const std::string& symbol, const nlohmann::json& payload,
+                 Delivery delivery = Delivery::Conflate);
+
+    // Same message shape, with a payload that is already serialized JSON
+    void publishSerialized(std::string_view type, const std::string& symbol, std::string_view payload_json,
+                           Delivery delivery = Delivery::Conflate);
+
+    // publish() plus a pre-encoded binary message for binary-format subscribers
+    void publishEncoded(std::string_view type, const std::string& symbol, const nlohmann::json& payload,
+                        std::string_view binary, Delivery delivery = Delivery::Conflate);
+
+    std::size_t connectionCount() const;
 
 private:
-    using WsServer = websocketpp::server<websocketpp::config::asio>;
-    WsServer server_;
-    std::map<std::string, std::vector<websocketpp::connection_hdl>> subscriptions_;
+    struct Connection;
+    using ConnectionPtr = std::shared_ptr<Connection>;
+
+    int port_;
+    int server_fd_;
+    WebSocketOptions options_;
+    std::atomic<bool> running_{true};
+
+    // Guards both tables; broadcasts take it shared, (un)subscribes exclusive
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, std::vector<ConnectionPtr>> subscriptions_;
+    std::unordered_set<ConnectionPtr> connections_;
+
+    // Connection threads still running; the destructor waits for zero
+    std::mutex threads_mutex_;
+    std::condition_variable threads_done_;
+    std::size_t live_threads_ = 0;
+
+    void handle_connection(const ConnectionPtr& conn);
+    bool handshake(Connection& conn, std::vector<char>& buffer, std::size_t& end);
+    void read_frames(const ConnectionPtr& conn, std::vector<char>& buffer, std::size_t end);
+    void write_frames(const ConnectionPtr& conn);
+    void handle_message(const ConnectionPtr& conn, std::string_view message);
 
-    void on_open(websocketpp::connection_hdl hdl);
-    void on_close(websocketpp::connection_hdl hdl);
-    void on_message(websocketpp::connection_hdl hdl, WsServer::message_ptr msg);
+    void subscribe(const ConnectionPtr& conn, const std::string& channel);
+    void unsubscribe(const ConnectionPtr& conn, const std::string& channel);
+    void remove_connection(const ConnectionPtr& conn);
+    void disconnect(Connection& conn);
 };
 
 }} // namespace
@@ -0,0 +1,140 @@
+// include/mercuryTrade/wire/Messages.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace mercuryTrade {
+namespace wire {
+
+// Compact binary encoding for market data and order updates.
+//
+// Every message is an 8-byte header followed by a fixed-layout block of
+// little-endian fields:
+//
+//   uint16 block_length   bytes in the block that follows
+//   uint16 template_id    which message this is
+//   uint16 schema_id      always SCHEMA_ID
+//   uint16 version        schema version the sender was built with
+//
+// Later versions may only append fields to a block. A decoder skips any
+// trailing bytes it does not know, so older readers keep working, and it
+// rejects blocks shorter than the layout it expects. Text fields are
+// fixed-width and NUL-padded.
+
+constexpr std::uint16_t SCHEMA_ID = 0x4D54;  // "MT"
+constexpr std::uint16_t SCHEMA_VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 8;
+
+// Media type for REST content negotiation
+constexpr const char* CONTENT_TYPE = "application/x-mercury-sbe";
+
+enum class TemplateId : std::uint16_t {
+    Quote = 1,
+    Trade = 2,
+    BookDelta = 3,
+    OrderUpdate = 4
+};
+
+enum class Side : std::uint8_t {
+    Buy = 0,   // Also the bid side of a book delta
+    Sell = 1   // Also the ask side of a book delta
+};
+
+template <std::size_t N>
+struct FixedString {
+    char data[N] = {};
+
+    // Returns false if value had to be truncated to fit
+    bool assign(std::string_view value) {
+        std::size_t length = value.size() < N ? value.size() : N;
+        std::memset(data, 0, N);
+        std::memcpy(data, value.data(), length);
+        return length == value.size();
+    }
+
+    std::string_view view() const {
+        std::size_t length = 0;
+        while (length < N && data[length] != '\0') ++length;
+        return std::string_view(data, length);
+    }
+};
+
+using Symbol = FixedString<16>;
+using OrderId = FixedString<24>;
+
+struct Quote {
+    Symbol symbol;
+    double bid;
+    double ask;
+    double last;
+    double volume;
+    std::int64_t timestamp;
+};
+
+struct Trade {
+    Symbol symbol;
+    std::uint64_t trade_id;
+    double price;
+    double quantity;
+    std::int64_t timestamp;
+    Side aggressor;
+};
+
+struct BookDelta {
+    Symbol symbol;
+    std::uint64_t seq;
+    double price;
+    double quantity;  // New level size; 0 removes the level
+    std::uint32_t orders;
+    Side side;
+};
+
+struct OrderUpdate {
+    OrderId order_id;
+    Symbol symbol;
+    double price;
+    double quantity;
+    double filled_quantity;
+    std::int64_t timestamp;
+    Side side;
+    std::uint8_t type;    // OrderType value
+    std::uint8_t status;  // OrderStatus value
+};
+
+// Block sizes of the current schema version
+constexpr std::size_t QUOTE_BLOCK = 56;
+constexpr std::size_t TRADE_BLOCK = 56;
+constexpr std::size_t BOOK_DELTA_BLOCK = 48;
+constexpr std::size_t ORDER_UPDATE_BLOCK = 80;
+
+enum class DecodeResult {
+    Ok,
+    Incomplete,      // Fewer bytes than the header announces
+    WrongSchema,
+    WrongTemplate,
+    BlockTooShort    // Sender's layout is older than this decoder supports
+};
+
+// Encoders append one complete message to `out`
+void encode(const Quote& message, std::string& out);
+void encode(const Trade& message, std::string& out);
+void encode(const BookDelta& message, std::string& out);
+void encode(const OrderUpdate& message, std::string& out);
+
+// Decoders read the message at the start of `in`; on success `consumed`
+// is the full message length, so concatenated messages can be walked.
+DecodeResult decode(std::string_view in, Quote& message, std::size_t& consumed);
+DecodeResult decode(std::string_view in, Trade& message, std::size_t& consumed);
+DecodeResult decode(std::string_view in, BookDelta& message, std::size_t& consumed);
+DecodeResult decode(std::string_view in, OrderUpdate& message, std::size_t& consumed);
+
+// Template of the message at the start of `in`, if it has a full header
+bool peekTemplate(std::string_view in, TemplateId& id);
+
+// True if an Accept header value lists CONTENT_TYPE
+bool acceptsBinary(std::string_view accept);
+
+}} // namespace
@@ -21,7 +21,7 @@ http::Response AuthController::login(const http::Request& req) {
             return http::Response::json({{"error", "Invalid credentials"}}, 401);
         }
 
-        return http::Response::json(user->toJson());
+        return http::Response::serialize(*user);
     } catch (const std::exception& e) {
         return http::Response::json({{"error", e.what()}}, 400);
     }
@@ -36,7 +36,7 @@ http::Response AuthController::registerUser(const http::Request& req) {
             data["password"].get<std::string>()
         );
         
-        return http::Response::json(user.toJson(), 201);
+        return http::Response::serialize(user, 201);
     } catch (const std::exception& e) {
         return http::Response::json({{"error", e.what()}}, 400);
     }
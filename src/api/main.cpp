@@ -2,13 +2,310 @@
 #include "mercuryTrade/api/auth/AuthController.hpp"
 #include "mercuryTrade/api/market/MarketDataController.hpp"
 #include "mercuryTrade/api/orders/OrderController.hpp"
+#include "mercuryTrade/core/memory/mercBarAggregator.hpp"
+#include "mercuryTrade/core/memory/mercFeedSimulator.hpp"
+#include "mercuryTrade/core/memory/mercMarketDataBus.hpp"
+#include "mercuryTrade/core/memory/mercTickStore.hpp"
+#include "mercuryTrade/services/BookEventPublisher.hpp"
+#include "mercuryTrade/websocket/WebSocketServer.hpp"
+#include "mercuryTrade/wire/Messages.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
 #include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 int main() {
     auto userService = std::make_shared<mercuryTrade::UserService>();
-    auto marketDataService = std::make_shared<mercuryTrade::MarketDataService>();
+    auto lastValues = std::make_shared<mercuryTrade::core::memory::LastValueCache>();
+    // Bars, tick history and the feed's rings all hold as many symbols as the cache
+    auto barConfig = mercuryTrade::core::memory::BarAggregator::Config::getDefaultConfig();
+    barConfig.max_symbols = lastValues->capacity();
+    auto bars = std::make_shared<mercuryTrade::core::memory::BarAggregator>(barConfig);
+    // MERCURY_TICK_DIR keeps every trade and quote on disk for history queries
+    std::shared_ptr<mercuryTrade::core::memory::TickStore> ticks;
+    if (const char* tickDir = std::getenv("MERCURY_TICK_DIR")) {
+        auto tickConfig = mercuryTrade::core::memory::TickStore::Config::getDefaultConfig(tickDir);
+        tickConfig.max_symbols = lastValues->capacity();
+        ticks = std::make_shared<mercuryTrade::core::memory::TickStore>(tickConfig);
+    }
+    auto marketDataService = std::make_shared<mercuryTrade::MarketDataService>(lastValues, bars, ticks);
     auto orderBookService = std::make_shared<mercuryTrade::OrderBookService>();
-    auto orderService = std::make_shared<mercuryTrade::OrderService>();
+
+    mercuryTrade::http::Server server(3000);
+    mercuryTrade::websocket::WebSocketServer wsServer(3001);
+
+    // Every bar is pushed once, when its interval closes
+    bars->setCloseListener([&wsServer](const std::string& symbol, mercuryTrade::core::memory::BarInterval interval,
+                                       const mercuryTrade::core::memory::Bar& bar) {
+        wsServer.publishSerialized("BAR", symbol, mercuryTrade::MarketDataService::barToJson(symbol, interval, bar),
+                                   mercuryTrade::websocket::Delivery::Lossless);
+    });
+
+    // Quotes are conflated: a client only ever needs the latest top of book
+    auto publishMarketData = [&wsServer, marketDataService](const std::string& symbol) {
+        try {
+            std::string json;
+            mercuryTrade::http::JsonWriter(json).value(marketDataService->getMarketData(symbol));
+            wsServer.publishSerialized("MARKET_DATA", symbol, json, mercuryTrade::websocket::Delivery::Conflate);
+        } catch (const std::exception& e) {
+            std::cerr << "Market data push: " << e.what() << std::endl;
+        }
+    };
+
+    // Encoding and fan-out of book events runs here, not on the matching
+    // thread that holds the book lock
+    mercuryTrade::BookEventPublisher bookEvents;
+
+    // MERCURY_FEED selects where quotes come from: udp:PORT listens for the
+    // feed protocol, file:PATH replays a capture and sim runs the simulator
+    // in-process at MERCURY_FEED_RATE messages per second. Without it the
+    // cache follows this venue's own books.
+    std::atomic<bool> feedStop{false};
+    std::thread feedThread;
+    // Without a feed, ticks from this venue's books pass through these rings
+    // to the tick thread, since storing one can sync a segment to disk
+    std::shared_ptr<mercuryTrade::core::memory::marketDataAllocator> tickRings;
+    std::string feedSpec = std::getenv("MERCURY_FEED") ? std::getenv("MERCURY_FEED") : "";
+    if (!feedSpec.empty()) {
+        feedThread = std::thread([feedSpec, lastValues, bars, ticks, publishMarketData, &feedStop]() {
+            namespace memory = mercuryTrade::core::memory;
+            try {
+                auto ringConfig = memory::marketDataAllocator::getDefaultConfig();
+                ringConfig.max_symbols = lastValues->capacity();
+                memory::marketDataAllocator allocator(ringConfig);
+                memory::FeedHandler handler(*lastValues, allocator);
+                // Bars follow the trade rings the handler fills
+                memory::TradeRingBarFeed barFeed(allocator, *bars);
+                // And so does the tick history, when kept
+                std::unique_ptr<memory::TickRingRecorder> recorder;
+                if (ticks) {
+                    recorder = std::make_unique<memory::TickRingRecorder>(allocator, *ticks);
+                }
+                // One MARKET_DATA push per symbol whose quote moved since the last drain
+                std::vector<memory::marketDataAllocator::Cursor> quoteCursors;
+                auto drain = [&]() {
+                    barFeed.drain();
+                    if (recorder) {
+                        recorder->drain();
+                    }
+                    for (std::size_t symbol = quoteCursors.size(); symbol < allocator.symbolCount(); ++symbol) {
+                        quoteCursors.push_back(
+                            allocator.subscribe(symbol, memory::marketDataAllocator::Channel::QUOTE, true));
+                    }
+                    memory::MarketQuote quote;
+                    for (std::size_t symbol = 0; symbol < quoteCursors.size(); ++symbol) {
+                        bool moved = false;
+                        while (allocator.read(quoteCursors[symbol], quote)) {
+                            moved = true;
+                        }
+                        if (moved) {
+                            publishMarketData(allocator.symbolName(symbol));
+                        }
+                    }
+                };
+                auto follow = [&](memory::FeedSource& source) {
+                    while (!feedStop.load(std::memory_order_relaxed) && !source.exhausted()) {
+                        if (handler.poll(source) == 0) {
+                            std::this_thread::yield();
+                        }
+                        drain();
+                    }
+                };
+
+                if (feedSpec.rfind("udp:", 0) == 0) {
+                    memory::UdpFeedSource source(static_cast<std::uint16_t>(std::atoi(feedSpec.c_str() + 4)), "0.0.0.0");
+                    std::cout << "Listening for market data on UDP port " << source.port() << std::endl;
+                    follow(source);
+                } else if (feedSpec.rfind("file:", 0) == 0) {
+                    memory::FileFeedSource source(feedSpec.substr(5));
+                    follow(source);
+                } else if (feedSpec == "sim") {
+                    long rate = std::getenv("MERCURY_FEED_RATE") ? std::atol(std::getenv("MERCURY_FEED_RATE")) : 1000;
+                    memory::FeedSimulator simulator;
+                    auto start = std::chrono::steady_clock::now();
+                    while (!feedStop.load(std::memory_order_relaxed)) {
+                        const std::string& packet = simulator.nextPacket();
+                        handler.onPacket(packet.data(), packet.size());
+                        drain();
+                        if (rate > 0) {
+                            std::this_thread::sleep_until(start + std::chrono::nanoseconds(
+                                simulator.messagesSent() * 1000000000ULL / static_cast<unsigned long>(rate)));
+                        }
+                    }
+                } else {
+                    std::cerr << "Unknown MERCURY_FEED " << feedSpec << std::endl;
+                    return;
+                }
+                auto stats = handler.getStats();
+                std::cout << "Feed finished after " << stats.packets << " packets, " << stats.gaps
+                          << " gaps, " << stats.rejected_definitions + barFeed.untrackedSymbols() +
+                                 (recorder ? recorder->untrackedSymbols() : 0)
+                          << " untracked symbols" << std::endl;
+            } catch (const std::exception& e) {
+                std::cerr << "Market data feed: " << e.what() << std::endl;
+            }
+        });
+    } else {
+        namespace memory = mercuryTrade::core::memory;
+        auto now = []() {
+            return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        };
+        if (ticks) {
+            auto ringConfig = memory::marketDataAllocator::getDefaultConfig();
+            ringConfig.max_symbols = lastValues->capacity();
+            tickRings = std::make_shared<memory::marketDataAllocator>(ringConfig);
+        }
+        orderBookService->addTopListener([lastValues, tickRings, now](const std::string& symbol,
+                                                                      const memory::BookTop& top) {
+            try {
+                std::int64_t timestamp = now();
+                lastValues->updateQuote(lastValues->index(symbol), top.bid, top.bid_size, top.ask,
+                                        top.ask_size, timestamp, top.seq);
+                if (tickRings) {
+                    tickRings->publish(tickRings->symbolIndex(symbol), memory::marketDataAllocator::Channel::QUOTE,
+                                       memory::MarketQuote{top.seq, timestamp, top.bid, top.bid_size, top.ask,
+                                                           top.ask_size});
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Last value cache: " << e.what() << std::endl;
+            }
+        });
+        bookEvents.addTopListener([publishMarketData](const std::string& symbol, const memory::BookTop&) {
+            publishMarketData(symbol);
+        });
+        orderBookService->addFillListener([lastValues, bars, tickRings, now](const std::string& symbol,
+                                                                             const memory::BookFill& fill) {
+            try {
+                std::int64_t timestamp = now();
+                lastValues->updateTrade(lastValues->index(symbol), fill.price, fill.quantity, timestamp,
+                                        fill.trade_id);
+                bars->onTrade(symbol, fill.price, fill.quantity, timestamp);
+                if (tickRings) {
+                    tickRings->publish(tickRings->symbolIndex(symbol), memory::marketDataAllocator::Channel::TRADE,
+                                       memory::MarketTrade{fill.trade_id, timestamp, fill.price, fill.quantity,
+                                                           fill.taker_side == memory::BookSide::BID});
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Last value cache: " << e.what() << std::endl;
+            }
+        });
+    }
+
+    // MERCURY_MD_BUS (a shared-memory name such as /mercury-md) publishes
+    // top of book and trades for strategy processes on this host. Set up
+    // before recovery so the recovered books are published too.
+    std::unique_ptr<mercuryTrade::core::memory::MarketDataBus> marketDataBus;
+    if (const char* busName = std::getenv("MERCURY_MD_BUS")) {
+        marketDataBus = std::make_unique<mercuryTrade::core::memory::MarketDataBus>(
+            mercuryTrade::core::memory::MarketDataBus::Config::getDefaultConfig(busName));
+        orderBookService->setMarketDataBus(marketDataBus.get());
+    }
+
+    // Deltas must never be conflated: clients rebuild the book from them
+    bookEvents.addDeltaListener([&](const std::string& symbol, const mercuryTrade::core::memory::LevelDelta& delta) {
+        std::string binary;
+        mercuryTrade::OrderBookService::deltaToBinary(symbol, delta, binary);
+        wsServer.publishEncoded("ORDER_BOOK_DELTA", symbol, mercuryTrade::OrderBookService::deltaToJson(delta),
+                                binary, mercuryTrade::websocket::Delivery::Lossless);
+    });
+    bookEvents.addFillListener([&](const std::string& symbol, const mercuryTrade::core::memory::BookFill& fill) {
+        auto timestamp = static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        mercuryTrade::wire::Trade trade;
+        trade.symbol.assign(symbol);
+        trade.trade_id = fill.trade_id;
+        trade.price = fill.price;
+        trade.quantity = fill.quantity;
+        trade.timestamp = timestamp;
+        trade.aggressor = fill.taker_side == mercuryTrade::core::memory::BookSide::BID
+            ? mercuryTrade::wire::Side::Buy : mercuryTrade::wire::Side::Sell;
+        std::string binary;
+        mercuryTrade::wire::encode(trade, binary);
+
+        wsServer.publishEncoded("TRADE", symbol, {
+            {"id", std::to_string(fill.trade_id)},
+            {"symbol", symbol},
+            {"price", fill.price},
+            {"quantity", fill.quantity},
+            {"side", fill.taker_side == mercuryTrade::core::memory::BookSide::BID ? "buy" : "sell"},
+            {"timestamp", timestamp}
+        }, binary, mercuryTrade::websocket::Delivery::Lossless);
+    });
+    bookEvents.start(*orderBookService);
+
+    // MERCURY_JOURNAL_DIR turns on the command journal; MERCURY_JOURNAL_SYNC
+    // picks the sync policy (group, interval or none)
+    std::shared_ptr<mercuryTrade::core::memory::CommandJournal> journal;
+    if (const char* journalDir = std::getenv("MERCURY_JOURNAL_DIR")) {
+        auto config = mercuryTrade::core::memory::CommandJournal::Config::getDefaultConfig(journalDir);
+        std::string sync = std::getenv("MERCURY_JOURNAL_SYNC") ? std::getenv("MERCURY_JOURNAL_SYNC") : "group";
+        if (sync == "none") {
+            config.sync_policy = mercuryTrade::core::memory::CommandJournal::SyncPolicy::NONE;
+        } else if (sync == "interval") {
+            config.sync_policy = mercuryTrade::core::memory::CommandJournal::SyncPolicy::INTERVAL;
+        }
+        journal = std::make_shared<mercuryTrade::core::memory::CommandJournal>(config);
+    }
+
+    // Pre-trade limits every account starts with; unset ones are unlimited.
+    // MERCURY_RISK_PRICE_BAND is a fraction of the last trade, e.g. 0.05.
+    // Orders may name only the accounts in MERCURY_RISK_ACCOUNTS, a comma
+    // separated list; orders without an account use the default account.
+    auto risk = mercuryTrade::core::memory::RiskEngine::Config::getDefaultConfig();
+    if (const char* position = std::getenv("MERCURY_RISK_MAX_POSITION")) {
+        risk.default_limits.max_position = std::atof(position);
+    }
+    if (const char* notional = std::getenv("MERCURY_RISK_MAX_NOTIONAL")) {
+        risk.default_limits.max_notional = std::atof(notional);
+    }
+    if (const char* orders = std::getenv("MERCURY_RISK_MAX_OPEN_ORDERS")) {
+        risk.default_limits.max_open_orders = static_cast<std::uint32_t>(std::atol(orders));
+    }
+    if (const char* band = std::getenv("MERCURY_RISK_PRICE_BAND")) {
+        risk.default_limits.price_band = std::atof(band);
+    }
+    auto orderService = std::make_shared<mercuryTrade::OrderService>(orderBookService, journal, risk);
+    if (const char* accounts = std::getenv("MERCURY_RISK_ACCOUNTS")) {
+        std::string list = accounts;
+        for (std::size_t start = 0; start <= list.size();) {
+            std::size_t end = std::min(list.find(',', start), list.size());
+            if (end > start) {
+                orderService->setRiskLimits(list.substr(start, end - start), risk.default_limits);
+            }
+            start = end + 1;
+        }
+    }
+
+    // Snapshots share the journal directory. Restart from the newest one
+    // plus the journal after it, and with MERCURY_SNAPSHOT_INTERVAL
+    // (seconds) take a new one periodically so the replayed tail stays short.
+    std::thread checkpointThread;
+    if (journal) {
+        std::size_t replayed = orderService->recover(journal->directory());
+        std::cout << "Recovered " << replayed << " journaled commands" << std::endl;
+
+        long interval = std::getenv("MERCURY_SNAPSHOT_INTERVAL") ? std::atol(std::getenv("MERCURY_SNAPSHOT_INTERVAL")) : 0;
+        if (interval > 0) {
+            checkpointThread = std::thread([orderService, journal, interval]() {
+                while (true) {
+                    std::this_thread::sleep_for(std::chrono::seconds(interval));
+                    try {
+                        orderService->snapshot(journal->directory());
+                    } catch (const std::exception& e) {
+                        std::cerr << "Snapshot failed: " << e.what() << std::endl;
+                    }
+                }
+            });
+        }
+    }
 
 
     auto authController = std::make_shared<mercuryTrade::api::auth::AuthController>(userService);
@@ -16,8 +313,10 @@ int main() {
         marketDataService, orderBookService);
     auto orderController = std::make_shared<mercuryTrade::api::orders::OrderController>(orderService);
 
-    mercuryTrade::http::Server server(3000);
-
+    orderService->setOrderListener([&](const mercuryTrade::Order& order) {
+        wsServer.publishEncoded("ORDER_UPDATE", order.symbol, order.toJson(), order.toBinary(),
+                                mercuryTrade::websocket::Delivery::Lossless);
+    });
 
     server.post("/api/auth/login", [&](const mercuryTrade::http::Request& req) { 
         return authController->login(req); 
@@ -31,26 +330,134 @@ int main() {
 
 
     server.get("/api/market-data/{symbol}", [&](const mercuryTrade::http::Request& req) { 
-        return marketDataController->getMarketData(req.getParam("symbol")); 
+        return marketDataController->getMarketData(req.getParam("symbol"),
+            mercuryTrade::wire::acceptsBinary(req.headers.get("Accept")));
     });
     
+    server.get("/api/market-data/{symbol}/bars", [&](const mercuryTrade::http::Request& req) {
+        return marketDataController->getBars(req);
+    });
+
+    server.get("/api/market-data/{symbol}/trades", [&](const mercuryTrade::http::Request& req) {
+        return marketDataController->getTrades(req);
+    });
+
+    server.get("/api/market-data/{symbol}/history", [&](const mercuryTrade::http::Request& req) {
+        return marketDataController->getHistory(req);
+    });
+
+    server.get("/api/market-analysis/{symbol}", [&](const mercuryTrade::http::Request& req) {
+        return marketDataController->getAnalysis(req);
+    });
+
     server.get("/api/order-book/{symbol}", [&](const mercuryTrade::http::Request& req) { 
-        return marketDataController->getOrderBook(req.getParam("symbol")); 
+        return marketDataController->getOrderBook(req); 
+    });
+
+    server.get("/api/order-book/{symbol}/deltas", [&](const mercuryTrade::http::Request& req) {
+        return marketDataController->getOrderBookDeltas(req.getParam("symbol"), req.getQuery("since", "0"),
+            mercuryTrade::wire::acceptsBinary(req.headers.get("Accept")));
     });
 
 
     server.get("/api/orders", [&](const mercuryTrade::http::Request& req) { 
-        return orderController->getOrders(); 
+        return orderController->getOrders(req, mercuryTrade::wire::acceptsBinary(req.headers.get("Accept")));
     });
     
     server.get("/api/orders/{id}", [&](const mercuryTrade::http::Request& req) { 
-        return orderController->getOrderById(req.getParam("id")); 
+        return orderController->getOrderById(req.getParam("id"),
+            mercuryTrade::wire::acceptsBinary(req.headers.get("Accept"))); 
     });
     
     server.post("/api/orders", [&](const mercuryTrade::http::Request& req) { 
         return orderController->placeOrder(req); 
     });
 
+    // Cancels every open order for ?symbol=
+    server.del("/api/orders", [&](const mercuryTrade::http::Request& req) {
+        return orderController->cancelAllOrders(req.getQuery("symbol"));
+    });
+
+    server.del("/api/orders/{id}", [&](const mercuryTrade::http::Request& req) {
+        return orderController->cancelOrder(req.getParam("id"));
+    });
+
+    server.post("/api/orders/batch", [&](const mercuryTrade::http::Request& req) {
+        return orderController->placeOrders(req);
+    });
+
+    server.del("/api/orders/batch", [&](const mercuryTrade::http::Request& req) {
+        return orderController->cancelOrders(req);
+    });
+
+    // Periodic full snapshots let subscribers that joined late, or lost
+    // deltas to a reconnect, resynchronise without a REST round trip
+    std::thread snapshotThread([&]() {
+        std::unordered_map<std::string, std::uint64_t> published;
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            for (const auto& symbol : orderBookService->symbols()) {
+                auto& last = published[symbol];
+                std::uint64_t seq = orderBookService->book(symbol).sequence();
+                if (seq != last) {
+                    last = seq;
+                    auto payload = orderBookService->getOrderBookPayload(symbol);
+                    wsServer.publishSerialized("ORDER_BOOK", symbol, *payload->identity());
+                }
+            }
+        }
+    });
+
+    // Closes bars on time, so quiet symbols still push them
+    std::thread barClockThread([&]() {
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            bars->advance(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        }
+    });
+
+    // Stores the ticks the books put in tickRings, and writes the open tick
+    // blocks out so a crash loses at most a second
+    std::thread tickFlushThread;
+    if (ticks) {
+        tickFlushThread = std::thread([ticks, tickRings]() {
+            std::unique_ptr<mercuryTrade::core::memory::TickRingRecorder> recorder;
+            if (tickRings) {
+                recorder = std::make_unique<mercuryTrade::core::memory::TickRingRecorder>(*tickRings, *ticks);
+            }
+            auto flushed = std::chrono::steady_clock::now();
+            while (true) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(recorder ? 10 : 1000));
+                try {
+                    if (recorder) {
+                        recorder->drain();
+                    }
+                    if (std::chrono::steady_clock::now() - flushed >= std::chrono::seconds(1)) {
+                        flushed = std::chrono::steady_clock::now();
+                        ticks->flush();
+                    }
+                } catch (const std::exception& e) {
+                    std::cerr << "Tick store flush failed: " << e.what() << std::endl;
+                }
+            }
+        });
+    }
+
+    std::thread wsThread([&]() { wsServer.start(); });
     server.start();
+    wsThread.join();
+    snapshotThread.join();
+    barClockThread.join();
+    if (tickFlushThread.joinable()) {
+        tickFlushThread.join();
+    }
+    if (checkpointThread.joinable()) {
+        checkpointThread.join();
+    }
+    feedStop = true;
+    if (feedThread.joinable()) {
+        feedThread.join();
+    }
     return 0;
 }
\ No newline at end of file
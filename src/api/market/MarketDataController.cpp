@@ -1,20 +1,73 @@
 // src/api/market/MarketDataController.cpp
 #include "../../../include/mercuryTrade/api/market/MarketDataController.hpp"
+#include <cmath>
 
 namespace mercuryTrade {
 namespace api {
 namespace market {
 
+namespace {
+    constexpr long MAX_BOOK_DEPTH = 1000;
+    constexpr long DEFAULT_BARS = 500;
+    constexpr long MAX_BARS = 5000;
+    constexpr long DEFAULT_TRADES = 500;
+    constexpr long MAX_TRADES = 5000;
+    constexpr std::int64_t DEFAULT_BUCKET = 60LL * 1000000000LL;
+    constexpr long DEFAULT_ANALYSIS_TRADES = 100000;
+    constexpr long MAX_ANALYSIS_TRADES = 5000000;
+    constexpr long DEFAULT_WINDOW = 100;
+    constexpr long MAX_WINDOW = 100000;
+    constexpr long DEFAULT_BUCKETS = 20;
+    constexpr long MAX_BUCKETS = 1000;
+
+    // Nanoseconds since the epoch from the query, or fallback when absent
+    std::int64_t parseNanos(const http::Request& req, const char* name, std::int64_t fallback) {
+        std::string text = req.getQuery(name);
+        if (text.empty()) {
+            return fallback;
+        }
+        std::size_t parsed = 0;
+        long long value = std::stoll(text, &parsed);
+        if (parsed != text.size()) {
+            throw std::invalid_argument(std::string(name) + " must be nanoseconds since the epoch");
+        }
+        return static_cast<std::int64_t>(value);
+    }
+
+    // A count between least and most from the query, or fallback when absent
+    std::size_t parseCount(const http::Request& req, const char* name, long fallback, long least, long most) {
+        std::string text = req.getQuery(name);
+        if (text.empty()) {
+            return static_cast<std::size_t>(fallback);
+        }
+        std::size_t parsed = 0;
+        long count = std::stol(text, &parsed);
+        if (parsed != text.size() || count < least || count > most) {
+            throw std::invalid_argument(std::string(name) + " must be between " + std::to_string(least) + " and " +
+                                        std::to_string(most));
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    // ?limit= between 1 and most, or fallback when absent
+    std::size_t parseLimit(const http::Request& req, long fallback, long most) {
+        return parseCount(req, "limit", fallback, 1, most);
+    }
+}
+
 MarketDataController::MarketDataController(
     std::shared_ptr<MarketDataService> marketDataService,
     std::shared_ptr<OrderBookService> orderBookService)
     : m_marketDataService(marketDataService)
     , m_orderBookService(orderBookService) {}
 
-http::Response MarketDataController::getMarketData(const std::string& symbol) {
+http::Response MarketDataController::getMarketData(const std::string& symbol, bool binary) {
     try {
         auto marketData = m_marketDataService->getMarketData(symbol);
-        return http::Response::json(marketData.toJson());
+        if (binary) {
+            return http::Response::bytes(marketData.toBinary(), wire::CONTENT_TYPE);
+        }
+        return http::Response::serialize(marketData);
     } catch (const std::exception& e) {
         return http::Response::json({{"error", e.what()}}, 400);
     }
@@ -22,11 +75,128 @@ http::Response MarketDataController::getMarketData(const std::string& symbol) {
 
 http::Response MarketDataController::getOrderBook(const std::string& symbol) {
     try {
-        auto orderBook = m_orderBookService->getOrderBook(symbol);
-        return http::Response::json(orderBook.toJson());
+        return http::Response::shared(m_orderBookService->getOrderBookPayload(symbol));
+    } catch (const std::exception& e) {
+        return http::Response::json({{"error", e.what()}}, 400);
+    }
+}
+
+http::Response MarketDataController::getOrderBook(const http::Request& req) {
+    try {
+        OrderBookQuery query;
+
+        std::string depth = req.getQuery("depth");
+        if (!depth.empty()) {
+            std::size_t parsed = 0;
+            long value = std::stol(depth, &parsed);
+            if (parsed != depth.size() || value < 1 || value > MAX_BOOK_DEPTH) {
+                return http::Response::json({{"error", "depth must be between 1 and " + std::to_string(MAX_BOOK_DEPTH)}}, 400);
+            }
+            query.depth = static_cast<std::size_t>(value);
+        }
+
+        std::string tick = req.getQuery("tick");
+        if (!tick.empty()) {
+            std::size_t parsed = 0;
+            query.tick = std::stod(tick, &parsed);
+            if (parsed != tick.size() || !std::isfinite(query.tick) || query.tick <= 0.0) {
+                return http::Response::json({{"error", "tick must be a positive number"}}, 400);
+            }
+        }
+
+        std::string cumulative = req.getQuery("cumulative");
+        query.cumulative = cumulative == "true" || cumulative == "1";
+
+        return http::Response::shared(m_orderBookService->getOrderBookPayload(req.getParam("symbol"), query));
+    } catch (const std::exception& e) {
+        return http::Response::json({{"error", e.what()}}, 400);
+    }
+}
+
+http::Response MarketDataController::getOrderBookDeltas(const std::string& symbol, const std::string& since,
+                                                        bool binary) {
+    try {
+        std::uint64_t afterSeq = std::stoull(since);
+        auto deltas = m_orderBookService->getDeltasSince(symbol, afterSeq);
+        if (!deltas) {
+            return http::Response::json({{"error", "Deltas no longer available, reload the snapshot"}}, 410);
+        }
+
+        if (binary) {
+            // Concatenated BookDelta messages, oldest first
+            std::string body;
+            body.reserve(deltas->size() * (wire::HEADER_SIZE + wire::BOOK_DELTA_BLOCK));
+            for (const auto& delta : *deltas) {
+                OrderBookService::deltaToBinary(symbol, delta, body);
+            }
+            return http::Response::bytes(std::move(body), wire::CONTENT_TYPE);
+        }
+
+        http::Response res;
+        http::JsonWriter writer(res.body);
+        writer.beginObject()
+              .field("symbol", symbol)
+              .field("since", afterSeq)
+              .field("deltas", *deltas)
+              .endObject();
+        return res;
+    } catch (const std::exception& e) {
+        return http::Response::json({{"error", e.what()}}, 400);
+    }
+}
+
+http::Response MarketDataController::getBars(const http::Request& req) {
+    try {
+        std::string interval = req.getQuery("interval", "1m");
+        std::int64_t from = parseNanos(req, "from", 0);
+        std::int64_t to = parseNanos(req, "to", INT64_MAX);
+        std::size_t limit = parseLimit(req, DEFAULT_BARS, MAX_BARS);
+        return http::Response::serialize(m_marketDataService->getBars(req.getParam("symbol"), interval, from, to,
+                                                                      limit));
+    } catch (const std::exception& e) {
+        return http::Response::json({{"error", e.what()}}, 400);
+    }
+}
+
+http::Response MarketDataController::getTrades(const http::Request& req) {
+    try {
+        std::int64_t from = parseNanos(req, "from", 0);
+        std::int64_t to = parseNanos(req, "to", INT64_MAX);
+        std::size_t limit = parseLimit(req, DEFAULT_TRADES, MAX_TRADES);
+        return http::Response::serialize(m_marketDataService->getTrades(req.getParam("symbol"), from, to, limit));
+    } catch (const std::exception& e) {
+        return http::Response::json({{"error", e.what()}}, 400);
+    }
+}
+
+http::Response MarketDataController::getHistory(const http::Request& req) {
+    try {
+        std::int64_t from = parseNanos(req, "from", 0);
+        std::int64_t to = parseNanos(req, "to", INT64_MAX);
+        std::int64_t bucket = parseNanos(req, "bucket", DEFAULT_BUCKET);
+        if (bucket <= 0) {
+            return http::Response::json({{"error", "bucket must be a positive number of nanoseconds"}}, 400);
+        }
+        std::size_t limit = parseLimit(req, DEFAULT_BARS, MAX_BARS);
+        return http::Response::serialize(m_marketDataService->getHistory(req.getParam("symbol"), from, to, bucket,
+                                                                         limit));
+    } catch (const std::exception& e) {
+        return http::Response::json({{"error", e.what()}}, 400);
+    }
+}
+
+http::Response MarketDataController::getAnalysis(const http::Request& req) {
+    try {
+        std::int64_t from = parseNanos(req, "from", 0);
+        std::int64_t to = parseNanos(req, "to", INT64_MAX);
+        std::size_t window = parseCount(req, "window", DEFAULT_WINDOW, 2, MAX_WINDOW);
+        std::size_t buckets = parseCount(req, "buckets", DEFAULT_BUCKETS, 1, MAX_BUCKETS);
+        std::size_t limit = parseLimit(req, DEFAULT_ANALYSIS_TRADES, MAX_ANALYSIS_TRADES);
+        return http::Response::serialize(m_marketDataService->getAnalysis(req.getParam("symbol"), from, to, window,
+                                                                          buckets, limit));
     } catch (const std::exception& e) {
         return http::Response::json({{"error", e.what()}}, 400);
     }
 }
 
-}}} // namespace
\ No newline at end of file
+}}} // namespace
@@ -1,5 +1,6 @@
 // src/api/orders/OrderController.cpp
 #include "../../../include/mercuryTrade/api/orders/OrderController.hpp"
+#include "../../../include/mercuryTrade/api/orders/OrderEntryParser.hpp"
 
 namespace mercuryTrade {
 namespace api {
@@ -10,20 +11,14 @@ OrderController::OrderController(std::shared_ptr<OrderService> orderService)
 
 http::Response OrderController::placeOrder(const http::Request& req) {
     try {
-        auto data = nlohmann::json::parse(req.body);
-        
-        Order order;
-        order.symbol = data["symbol"].get<std::string>();
-        order.side = data["side"].get<std::string>() == "buy" ? OrderSide::Buy : OrderSide::Sell;
-        order.type = data["type"].get<std::string>() == "market" ? OrderType::Market : OrderType::Limit;
-        order.quantity = data["quantity"].get<double>();
-        
-        if (order.type == OrderType::Limit) {
-            order.price = data["price"].get<double>();
+        OrderEntry entry;
+        OrderEntryError error;
+        if (!parseOrderEntry(req.body, entry, error)) {
+            return http::Response::json({{"error", error.message}, {"offset", error.offset}}, 400);
         }
 
-        auto placedOrder = m_orderService->placeOrder(order);
-        return http::Response::json(placedOrder.toJson(), 201);
+        auto placedOrder = m_orderService->placeOrder(entry.toOrder());
+        return http::Response::serialize(placedOrder, 201);
     } catch (const std::exception& e) {
         return http::Response::json({{"error", e.what()}}, 400);
     }
@@ -38,26 +33,171 @@ http::Response OrderController::cancelOrder(const std::string& orderId) {
     }
 }
 
-http::Response OrderController::getOrders() {
+http::Response OrderController::placeOrders(const http::Request& req) {
     try {
-        auto orders = m_orderService->getOrders();
-        nlohmann::json response = nlohmann::json::array();
-        for (const auto& order : orders) {
-            response.push_back(order.toJson());
+        std::vector<OrderEntryItem> items;
+        items.reserve(64);
+        OrderEntryError error;
+        if (!parseOrderEntries(req.body, items, error, MAX_BATCH_ORDERS)) {
+            return http::Response::json({{"error", error.message}, {"offset", error.offset}}, 400);
+        }
+
+        std::vector<Order> orders;
+        orders.reserve(items.size());
+        for (const auto& item : items) {
+            if (item.ok) {
+                orders.push_back(item.entry.toOrder());
+            }
         }
-        return http::Response::json(response);
+        auto placed = m_orderService->placeOrders(orders);
+
+        http::Response res;
+        http::JsonWriter writer(res.body);
+        writer.beginObject().key("results").beginArray();
+        std::size_t next = 0;
+        for (const auto& item : items) {
+            if (item.ok) {
+                writer.beginObject().field("ok", true).field("order", placed[next++]).endObject();
+            } else {
+                writer.beginObject()
+                      .field("ok", false)
+                      .field("error", item.error.message)
+                      .field("offset", item.error.offset)
+                      .endObject();
+            }
+        }
+        writer.endArray()
+              .field("submitted", placed.size())
+              .field("invalid", items.size() - placed.size())
+              .endObject();
+        return res;
     } catch (const std::exception& e) {
         return http::Response::json({{"error", e.what()}}, 400);
     }
 }
 
-http::Response OrderController::getOrderById(const std::string& orderId) {
+http::Response OrderController::cancelOrders(const http::Request& req) {
+    try {
+        auto data = nlohmann::json::parse(req.body);
+        if (!data.is_array()) {
+            return http::Response::json({{"error", "Expected an array of order ids"}}, 400);
+        }
+        if (data.size() > MAX_BATCH_ORDERS) {
+            return http::Response::json({{"error", "Too many orders in batch"}}, 400);
+        }
+        auto ids = data.get<std::vector<std::string>>();
+        auto results = m_orderService->cancelOrders(ids);
+
+        http::Response res;
+        http::JsonWriter writer(res.body);
+        writer.beginObject().key("results").beginArray();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (results[i]) {
+                writer.beginObject().field("ok", true).field("order", *results[i]).endObject();
+            } else {
+                writer.beginObject().field("ok", false).field("id", ids[i]).field("error", "Order not found").endObject();
+            }
+        }
+        writer.endArray().endObject();
+        return res;
+    } catch (const std::exception& e) {
+        return http::Response::json({{"error", e.what()}}, 400);
+    }
+}
+
+http::Response OrderController::cancelAllOrders(const std::string& symbol) {
+    try {
+        if (symbol.empty()) {
+            return http::Response::json({{"error", "symbol is required"}}, 400);
+        }
+        auto cancelled = m_orderService->cancelAllOrders(symbol);
+
+        http::Response res;
+        http::JsonWriter writer(res.body);
+        writer.beginObject().field("symbol", symbol).field("cancelled", cancelled).endObject();
+        return res;
+    } catch (const std::exception& e) {
+        return http::Response::json({{"error", e.what()}}, 400);
+    }
+}
+
+http::Response OrderController::getOrders(const http::Request& req, bool binary) {
+    try {
+        OrderQuery query;
+        query.symbol = req.getQuery("symbol");
+
+        std::string status = req.getQuery("status");
+        if (!status.empty()) {
+            if (status == "new") query.status = OrderStatus::New;
+            else if (status == "partially_filled") query.status = OrderStatus::PartiallyFilled;
+            else if (status == "filled") query.status = OrderStatus::Filled;
+            else if (status == "cancelled") query.status = OrderStatus::Cancelled;
+            else if (status == "rejected") query.status = OrderStatus::Rejected;
+            else {
+                return http::Response::json(
+                    {{"error", "status must be one of new, partially_filled, filled, cancelled, rejected"}}, 400);
+            }
+        }
+
+        std::string cursor = req.getQuery("cursor");
+        if (!cursor.empty()) {
+            std::size_t parsed = 0;
+            query.after = std::stoull(cursor, &parsed);
+            if (parsed != cursor.size()) {
+                return http::Response::json({{"error", "Invalid cursor"}}, 400);
+            }
+        }
+
+        std::string limit = req.getQuery("limit");
+        if (!limit.empty()) {
+            std::size_t parsed = 0;
+            long value = std::stol(limit, &parsed);
+            if (parsed != limit.size() || value < 1 || value > static_cast<long>(OrderStore::MAX_PAGE_SIZE)) {
+                return http::Response::json(
+                    {{"error", "limit must be between 1 and " + std::to_string(OrderStore::MAX_PAGE_SIZE)}}, 400);
+            }
+            query.limit = static_cast<std::size_t>(value);
+        }
+
+        auto page = m_orderService->getOrders(query);
+        if (binary) {
+            std::string body;
+            body.reserve(page.orders.size() * (wire::HEADER_SIZE + wire::ORDER_UPDATE_BLOCK));
+            for (const auto& order : page.orders) {
+                body += order.toBinary();
+            }
+            auto res = http::Response::bytes(std::move(body), wire::CONTENT_TYPE);
+            if (page.next_cursor) {
+                res.headers["X-Next-Cursor"] = std::to_string(page.next_cursor);
+            }
+            return res;
+        }
+
+        http::Response res;
+        http::JsonWriter writer(res.body);
+        writer.beginObject().field("orders", page.orders).key("next_cursor");
+        if (page.next_cursor) {
+            writer.value(page.next_cursor);
+        } else {
+            writer.null();
+        }
+        writer.endObject();
+        return res;
+    } catch (const std::exception& e) {
+        return http::Response::json({{"error", e.what()}}, 400);
+    }
+}
+
+http::Response OrderController::getOrderById(const std::string& orderId, bool binary) {
     try {
         auto order = m_orderService->getOrderById(orderId);
         if (!order) {
             return http::Response::json({{"error", "Order not found"}}, 404);
         }
-        return http::Response::json(order->toJson());
+        if (binary) {
+            return http::Response::bytes(order->toBinary(), wire::CONTENT_TYPE);
+        }
+        return http::Response::serialize(*order);
     } catch (const std::exception& e) {
         return http::Response::json({{"error", e.what()}}, 400);
     }
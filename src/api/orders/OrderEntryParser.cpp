@@ -0,0 +1,436 @@
+// src/api/orders/OrderEntryParser.cpp
+#include "../../../include/mercuryTrade/api/orders/OrderEntryParser.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+
+namespace mercuryTrade {
+namespace api {
+namespace orders {
+
+namespace {
+    constexpr int MAX_SKIP_DEPTH = 32;  // Nesting allowed inside ignored members
+    constexpr std::size_t MAX_KEY_LENGTH = 16;
+
+    enum Field : unsigned {
+        NONE = 0,
+        SYMBOL = 1 << 0,
+        SIDE = 1 << 1,
+        TYPE = 1 << 2,
+        QUANTITY = 1 << 3,
+        PRICE = 1 << 4,
+        ACCOUNT = 1 << 5
+    };
+
+    // Forward-only reader over the request body. Every failure records the
+    // offset it happened at, so errors point at the offending byte.
+    class Cursor {
+    public:
+        Cursor(std::string_view in, OrderEntryError& error) : in_(in), error_(error) {}
+
+        bool fail(const char* message) {
+            error_.offset = pos_;
+            error_.message = message;
+            return false;
+        }
+
+        void skipWhitespace() {
+            while (pos_ < in_.size() &&
+                   (in_[pos_] == ' ' || in_[pos_] == '\t' || in_[pos_] == '\n' || in_[pos_] == '\r')) {
+                ++pos_;
+            }
+        }
+
+        bool atEnd() const { return pos_ >= in_.size(); }
+        char peek() const { return pos_ < in_.size() ? in_[pos_] : '\0'; }
+        std::size_t position() const { return pos_; }
+        void seek(std::size_t pos) { pos_ = pos; }
+
+        bool consume(char c) {
+            skipWhitespace();
+            if (peek() != c) {
+                return false;
+            }
+            ++pos_;
+            return true;
+        }
+
+        // Decodes a JSON string into out[0..capacity). Returns false on
+        // malformed input; `length` is the decoded length even if it did
+        // not fit, so callers can tell truncation apart.
+        bool string(char* out, std::size_t capacity, std::size_t& length) {
+            skipWhitespace();
+            if (peek() != '"') {
+                return fail("Expected a string");
+            }
+            ++pos_;
+            length = 0;
+
+            while (true) {
+                if (atEnd()) {
+                    return fail("Unterminated string");
+                }
+                unsigned char c = static_cast<unsigned char>(in_[pos_]);
+                if (c == '"') {
+                    ++pos_;
+                    return true;
+                }
+                if (c < 0x20) {
+                    return fail("Control character in string");
+                }
+                if (c != '\\') {
+                    put(out, capacity, length, static_cast<char>(c));
+                    ++pos_;
+                    continue;
+                }
+
+                ++pos_;
+                char escape = peek();
+                ++pos_;
+                switch (escape) {
+                    case '"': put(out, capacity, length, '"'); break;
+                    case '\\': put(out, capacity, length, '\\'); break;
+                    case '/': put(out, capacity, length, '/'); break;
+                    case 'b': put(out, capacity, length, '\b'); break;
+                    case 'f': put(out, capacity, length, '\f'); break;
+                    case 'n': put(out, capacity, length, '\n'); break;
+                    case 'r': put(out, capacity, length, '\r'); break;
+                    case 't': put(out, capacity, length, '\t'); break;
+                    case 'u': {
+                        std::uint32_t code;
+                        if (!unicodeEscape(code)) {
+                            return false;
+                        }
+                        putUtf8(out, capacity, length, code);
+                        break;
+                    }
+                    default:
+                        --pos_;
+                        return fail("Invalid escape sequence");
+                }
+            }
+        }
+
+        // Strict JSON number grammar, converted with from_chars
+        bool number(double& value) {
+            skipWhitespace();
+            std::size_t start = pos_;
+            if (peek() == '-') ++pos_;
+            if (peek() == '0') {
+                ++pos_;
+            } else if (isDigit(peek())) {
+                while (isDigit(peek())) ++pos_;
+            } else {
+                pos_ = start;
+                return fail("Expected a number");
+            }
+            if (peek() == '.') {
+                ++pos_;
+                if (!isDigit(peek())) return fail("Expected a digit after the decimal point");
+                while (isDigit(peek())) ++pos_;
+            }
+            if (peek() == 'e' || peek() == 'E') {
+                ++pos_;
+                if (peek() == '+' || peek() == '-') ++pos_;
+                if (!isDigit(peek())) return fail("Expected a digit in the exponent");
+                while (isDigit(peek())) ++pos_;
+            }
+
+            auto result = std::from_chars(in_.data() + start, in_.data() + pos_, value);
+            if (result.ec != std::errc() || !std::isfinite(value)) {
+                pos_ = start;
+                return fail("Number out of range");
+            }
+            return true;
+        }
+
+        // Skips one value of any type, for members the schema does not use
+        bool skipValue(int depth = 0) {
+            skipWhitespace();
+            if (depth > MAX_SKIP_DEPTH) {
+                return fail("Nesting too deep");
+            }
+
+            char c = peek();
+            if (c == '"') {
+                std::size_t length;
+                return string(nullptr, 0, length);
+            }
+            if (c == '-' || isDigit(c)) {
+                double ignored;
+                return number(ignored);
+            }
+            if (c == '{' || c == '[') {
+                char close = c == '{' ? '}' : ']';
+                ++pos_;
+                if (consume(close)) {
+                    return true;
+                }
+                do {
+                    if (c == '{') {
+                        std::size_t length;
+                        if (!string(nullptr, 0, length)) return false;
+                        if (!consume(':')) return fail("Expected ':'");
+                    }
+                    if (!skipValue(depth + 1)) return false;
+                } while (consume(','));
+                return consume(close) || fail(c == '{' ? "Expected ',' or '}'" : "Expected ',' or ']'");
+            }
+            if (literal("true") || literal("false") || literal("null")) {
+                return true;
+            }
+            return fail("Unexpected character");
+        }
+
+    private:
+        std::string_view in_;
+        OrderEntryError& error_;
+        std::size_t pos_ = 0;
+
+        static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+        static void put(char* out, std::size_t capacity, std::size_t& length, char c) {
+            if (length < capacity) {
+                out[length] = c;
+            }
+            ++length;
+        }
+
+        static void putUtf8(char* out, std::size_t capacity, std::size_t& length, std::uint32_t code) {
+            if (code < 0x80) {
+                put(out, capacity, length, static_cast<char>(code));
+            } else if (code < 0x800) {
+                put(out, capacity, length, static_cast<char>(0xC0 | (code >> 6)));
+                put(out, capacity, length, static_cast<char>(0x80 | (code & 0x3F)));
+            } else if (code < 0x10000) {
+                put(out, capacity, length, static_cast<char>(0xE0 | (code >> 12)));
+                put(out, capacity, length, static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                put(out, capacity, length, static_cast<char>(0x80 | (code & 0x3F)));
+            } else {
+                put(out, capacity, length, static_cast<char>(0xF0 | (code >> 18)));
+                put(out, capacity, length, static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                put(out, capacity, length, static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                put(out, capacity, length, static_cast<char>(0x80 | (code & 0x3F)));
+            }
+        }
+
+        bool hex4(std::uint32_t& value) {
+            value = 0;
+            for (int i = 0; i < 4; ++i, ++pos_) {
+                char c = peek();
+                value <<= 4;
+                if (c >= '0' && c <= '9') value |= c - '0';
+                else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+                else return fail("Invalid \\u escape");
+            }
+            return true;
+        }
+
+        // Reads the XXXX of a \uXXXX escape, joining surrogate pairs
+        bool unicodeEscape(std::uint32_t& code) {
+            if (!hex4(code)) return false;
+            if (code >= 0xDC00 && code <= 0xDFFF) {
+                return fail("Unpaired surrogate in \\u escape");
+            }
+            if (code >= 0xD800 && code <= 0xDBFF) {
+                std::uint32_t low;
+                if (in_.substr(pos_, 2) != "\\u") return fail("Unpaired surrogate in \\u escape");
+                pos_ += 2;
+                if (!hex4(low)) return false;
+                if (low < 0xDC00 || low > 0xDFFF) return fail("Unpaired surrogate in \\u escape");
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+            return true;
+        }
+
+        bool literal(std::string_view word) {
+            if (in_.substr(pos_, word.size()) != word) {
+                return false;
+            }
+            pos_ += word.size();
+            return true;
+        }
+    };
+
+    bool enumValue(Cursor& cursor, std::string_view first, std::string_view second, bool& isSecond,
+                   const char* message) {
+        cursor.skipWhitespace();
+        std::size_t start = cursor.position();
+        if (cursor.peek() != '"') {
+            return cursor.fail(message);
+        }
+        char value[8];
+        std::size_t length;
+        if (!cursor.string(value, sizeof(value), length)) {
+            return false;
+        }
+        std::string_view text(value, length <= sizeof(value) ? length : 0);
+        if (text == first || text == second) {
+            isSecond = text == second;
+            return true;
+        }
+        cursor.seek(start);
+        return cursor.fail(message);
+    }
+
+    bool member(Cursor& cursor, std::string_view key, OrderEntry& entry, unsigned& seen) {
+        Field field = key == "symbol" ? SYMBOL
+                       : key == "side" ? SIDE
+                       : key == "type" ? TYPE
+                       : key == "quantity" ? QUANTITY
+                       : key == "price" ? PRICE
+                       : key == "account" ? ACCOUNT
+                       : NONE;
+        if (field == NONE) {
+            return cursor.skipValue();
+        }
+        if (seen & field) {
+            return cursor.fail("Duplicate member");
+        }
+        seen |= field;
+
+        cursor.skipWhitespace();
+        std::size_t start = cursor.position();
+        bool second = false;
+        switch (field) {
+            case SYMBOL:
+                if (cursor.peek() != '"') return cursor.fail("symbol must be a string");
+                if (!cursor.string(entry.symbol, OrderEntry::MAX_SYMBOL_LENGTH, entry.symbol_length)) return false;
+                if (entry.symbol_length == 0 || entry.symbol_length > OrderEntry::MAX_SYMBOL_LENGTH) {
+                    cursor.seek(start);
+                    return cursor.fail("symbol must be 1 to 16 characters");
+                }
+                return true;
+            case ACCOUNT:
+                if (cursor.peek() != '"') return cursor.fail("account must be a string");
+                if (!cursor.string(entry.account, OrderEntry::MAX_ACCOUNT_LENGTH, entry.account_length)) return false;
+                if (entry.account_length == 0 || entry.account_length > OrderEntry::MAX_ACCOUNT_LENGTH) {
+                    cursor.seek(start);
+                    return cursor.fail("account must be 1 to 32 characters");
+                }
+                return true;
+            case SIDE:
+                if (!enumValue(cursor, "buy", "sell", second, "side must be \"buy\" or \"sell\"")) return false;
+                entry.side = second ? OrderSide::Sell : OrderSide::Buy;
+                return true;
+            case TYPE:
+                if (!enumValue(cursor, "limit", "market", second, "type must be \"limit\" or \"market\"")) return false;
+                entry.type = second ? OrderType::Market : OrderType::Limit;
+                return true;
+            case QUANTITY:
+                if (cursor.peek() != '-' && (cursor.peek() < '0' || cursor.peek() > '9')) {
+                    return cursor.fail("quantity must be a number");
+                }
+                if (!cursor.number(entry.quantity)) return false;
+                if (entry.quantity <= 0.0) {
+                    cursor.seek(start);
+                    return cursor.fail("quantity must be positive");
+                }
+                return true;
+            default:
+                if (cursor.peek() != '-' && (cursor.peek() < '0' || cursor.peek() > '9')) {
+                    return cursor.fail("price must be a number");
+                }
+                return cursor.number(entry.price);
+        }
+    }
+
+    bool orderObject(Cursor& cursor, OrderEntry& entry) {
+        entry = OrderEntry{};
+        if (!cursor.consume('{')) {
+            return cursor.fail("Expected an order object");
+        }
+        std::size_t object_start = cursor.position() - 1;
+
+        unsigned seen = 0;
+        if (!cursor.consume('}')) {
+            do {
+                char key[MAX_KEY_LENGTH];
+                std::size_t length;
+                if (!cursor.string(key, sizeof(key), length)) return false;
+                if (!cursor.consume(':')) return cursor.fail("Expected ':'");
+                // Over-long keys cannot be ours; an empty view skips them
+                std::string_view name(key, length <= sizeof(key) ? length : 0);
+                if (!member(cursor, name, entry, seen)) return false;
+            } while (cursor.consume(','));
+
+            if (!cursor.consume('}')) {
+                return cursor.fail("Expected ',' or '}'");
+            }
+        }
+
+        std::size_t end = cursor.position();
+        cursor.seek(object_start);
+        if (!(seen & SYMBOL)) return cursor.fail("Missing symbol");
+        if (!(seen & SIDE)) return cursor.fail("Missing side");
+        if (!(seen & TYPE)) return cursor.fail("Missing type");
+        if (!(seen & QUANTITY)) return cursor.fail("Missing quantity");
+        if (entry.type == OrderType::Limit) {
+            if (!(seen & PRICE)) return cursor.fail("Missing price for limit order");
+            if (entry.price <= 0.0) return cursor.fail("price must be positive for limit orders");
+        } else {
+            entry.price = 0.0;
+        }
+        cursor.seek(end);
+        return true;
+    }
+}
+
+bool parseOrderEntry(std::string_view body, OrderEntry& entry, OrderEntryError& error) {
+    Cursor cursor(body, error);
+    if (!orderObject(cursor, entry)) {
+        return false;
+    }
+    cursor.skipWhitespace();
+    if (!cursor.atEnd()) {
+        return cursor.fail("Unexpected data after the order");
+    }
+    return true;
+}
+
+bool parseOrderEntries(std::string_view body, std::vector<OrderEntryItem>& items, OrderEntryError& error,
+                       std::size_t maxItems) {
+    items.clear();
+    Cursor cursor(body, error);
+    if (!cursor.consume('[')) {
+        return cursor.fail("Expected an array of orders");
+    }
+
+    if (!cursor.consume(']')) {
+        do {
+            cursor.skipWhitespace();
+            if (items.size() == maxItems) {
+                return cursor.fail("Too many orders in batch");
+            }
+            items.emplace_back();
+            OrderEntryItem& item = items.back();
+
+            std::size_t start = cursor.position();
+            Cursor element(body, item.error);
+            element.seek(start);
+            item.ok = orderObject(element, item.entry);
+            if (!item.ok) {
+                // Skip the refused element as plain JSON; if even that
+                // fails the array itself is broken
+                if (!cursor.skipValue()) {
+                    return false;
+                }
+            } else {
+                cursor.seek(element.position());
+            }
+        } while (cursor.consume(','));
+
+        if (!cursor.consume(']')) {
+            return cursor.fail("Expected ',' or ']'");
+        }
+    }
+
+    cursor.skipWhitespace();
+    if (!cursor.atEnd()) {
+        return cursor.fail("Unexpected data after the orders");
+    }
+    return true;
+}
+
+}}} // namespace
@@ -0,0 +1,105 @@
+#include "../../../include/mercuryTrade/core/analytics/mercAnalyticsKernels.hpp"
+#include <cmath>
+#include <limits>
+
+namespace mercuryTrade {
+namespace core {
+namespace analytics {
+
+#ifdef MERC_ANALYTICS_AVX2
+// Defined in mercAnalyticsKernelsAvx2.cpp, the one file built with -mavx2 -mfma
+const Kernels& avx2KernelSet();
+#endif
+
+namespace {
+
+VwapResult vwapScalar(const double* prices, const double* quantities, std::size_t count) {
+    double notional = 0.0;
+    double volume = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        notional += prices[i] * quantities[i];
+        volume += quantities[i];
+    }
+    return VwapResult{notional, volume, volume != 0.0 ? notional / volume : 0.0};
+}
+
+MinMax minMaxScalar(const double* values, std::size_t count) {
+    MinMax result{std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    for (std::size_t i = 0; i < count; ++i) {
+        result.min = values[i] < result.min ? values[i] : result.min;
+        result.max = values[i] > result.max ? values[i] : result.max;
+    }
+    return result;
+}
+
+double deviation(double sum, double squares, double window) {
+    double variance = (squares - sum * sum / window) / (window - 1.0);
+    return variance > 0.0 ? std::sqrt(variance) : 0.0;
+}
+
+// Keeps running sums of the returns and their squares, adding the return
+// entering the window and taking out the one leaving it
+void rollingVolatilityScalar(const double* prices, std::size_t count, std::size_t window, double* out) {
+    std::size_t outputs = rollingVolatilityCount(count, window);
+    if (outputs == 0) {
+        return;
+    }
+    const double size = static_cast<double>(window);
+    double sum = 0.0;
+    double squares = 0.0;
+    for (std::size_t i = 1; i <= window; ++i) {
+        double r = prices[i] / prices[i - 1] - 1.0;
+        sum += r;
+        squares += r * r;
+    }
+    out[0] = deviation(sum, squares, size);
+    for (std::size_t k = 1; k < outputs; ++k) {
+        double entering = prices[k + window] / prices[k + window - 1] - 1.0;
+        double leaving = prices[k] / prices[k - 1] - 1.0;
+        sum += entering - leaving;
+        squares += entering * entering - leaving * leaving;
+        out[k] = deviation(sum, squares, size);
+    }
+}
+
+void volumeProfileScalar(const double* prices, const double* quantities, std::size_t count, double low,
+                         double bucket_width, std::size_t buckets, double* volumes) {
+    const double scale = 1.0 / bucket_width;
+    const double limit = static_cast<double>(buckets);
+    for (std::size_t i = 0; i < count; ++i) {
+        double slot = std::floor((prices[i] - low) * scale);
+        if (slot >= 0.0 && slot < limit) {
+            volumes[static_cast<std::size_t>(slot)] += quantities[i];
+        }
+    }
+}
+
+const Kernels SCALAR{"scalar", vwapScalar, minMaxScalar, rollingVolatilityScalar, volumeProfileScalar};
+
+const Kernels* detectAvx2() {
+#ifdef MERC_ANALYTICS_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return &avx2KernelSet();
+    }
+#endif
+    return nullptr;
+}
+
+} // namespace
+
+const Kernels& scalarKernels() {
+    return SCALAR;
+}
+
+const Kernels* avx2Kernels() {
+    static const Kernels* detected = detectAvx2();
+    return detected;
+}
+
+const Kernels& kernels() {
+    static const Kernels& selected = avx2Kernels() ? *avx2Kernels() : SCALAR;
+    return selected;
+}
+
+}}} // namespaces
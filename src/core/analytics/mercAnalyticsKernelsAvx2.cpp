@@ -0,0 +1,187 @@
+// Built with -mavx2 -mfma and only called once kernels() has checked the
+// CPU, so nothing here may be shared with code that runs unchecked: no
+// standard library templates and none of the header's inline functions,
+// whose out-of-line copy the linker could take from this file.
+#include "../../../include/mercuryTrade/core/analytics/mercAnalyticsKernels.hpp"
+#include <immintrin.h>
+#include <cmath>
+#include <cstdint>
+
+namespace mercuryTrade {
+namespace core {
+namespace analytics {
+
+namespace {
+
+double horizontalSum(__m256d v) {
+    __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+// Running sums within the vector: lane i holds v[0] + ... + v[i]
+__m256d prefixSum(__m256d v) {
+    const __m256d zero = _mm256_setzero_pd();
+    v = _mm256_add_pd(v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x1));
+    v = _mm256_add_pd(v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x3));
+    return v;
+}
+
+__m256d lastLane(__m256d v) {
+    return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+VwapResult vwapAvx2(const double* prices, const double* quantities, std::size_t count) {
+    // Two accumulators each, to keep two FMAs in flight
+    __m256d notional0 = _mm256_setzero_pd();
+    __m256d notional1 = _mm256_setzero_pd();
+    __m256d volume0 = _mm256_setzero_pd();
+    __m256d volume1 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256d q0 = _mm256_loadu_pd(quantities + i);
+        __m256d q1 = _mm256_loadu_pd(quantities + i + 4);
+        notional0 = _mm256_fmadd_pd(_mm256_loadu_pd(prices + i), q0, notional0);
+        notional1 = _mm256_fmadd_pd(_mm256_loadu_pd(prices + i + 4), q1, notional1);
+        volume0 = _mm256_add_pd(volume0, q0);
+        volume1 = _mm256_add_pd(volume1, q1);
+    }
+    double notional = horizontalSum(_mm256_add_pd(notional0, notional1));
+    double volume = horizontalSum(_mm256_add_pd(volume0, volume1));
+    for (; i < count; ++i) {
+        notional += prices[i] * quantities[i];
+        volume += quantities[i];
+    }
+    return VwapResult{notional, volume, volume != 0.0 ? notional / volume : 0.0};
+}
+
+MinMax minMaxAvx2(const double* values, std::size_t count) {
+    const double infinity = __builtin_inf();
+    __m256d low = _mm256_set1_pd(infinity);
+    __m256d high = _mm256_set1_pd(-infinity);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d v = _mm256_loadu_pd(values + i);
+        low = _mm256_min_pd(low, v);
+        high = _mm256_max_pd(high, v);
+    }
+    alignas(32) double lows[4];
+    alignas(32) double highs[4];
+    _mm256_store_pd(lows, low);
+    _mm256_store_pd(highs, high);
+    MinMax result{infinity, -infinity};
+    for (int lane = 0; lane < 4; ++lane) {
+        result.min = lows[lane] < result.min ? lows[lane] : result.min;
+        result.max = highs[lane] > result.max ? highs[lane] : result.max;
+    }
+    for (; i < count; ++i) {
+        result.min = values[i] < result.min ? values[i] : result.min;
+        result.max = values[i] > result.max ? values[i] : result.max;
+    }
+    return result;
+}
+
+double deviation(double sum, double squares, double window) {
+    double variance = (squares - sum * sum / window) / (window - 1.0);
+    return variance > 0.0 ? std::sqrt(variance) : 0.0;
+}
+
+// Four windows per step: the changes each window makes to the running
+// sums are prefix-summed across the lanes and added to the previous
+// window's sums
+void rollingVolatilityAvx2(const double* prices, std::size_t count, std::size_t window, double* out) {
+    std::size_t outputs = window >= 2 && count > window ? count - window : 0;  // rollingVolatilityCount
+    if (outputs == 0) {
+        return;
+    }
+    const double size = static_cast<double>(window);
+    double sum = 0.0;
+    double squares = 0.0;
+    for (std::size_t i = 1; i <= window; ++i) {
+        double r = prices[i] / prices[i - 1] - 1.0;
+        sum += r;
+        squares += r * r;
+    }
+    out[0] = deviation(sum, squares, size);
+
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d inverseSize = _mm256_set1_pd(1.0 / size);
+    const __m256d inverseDegrees = _mm256_set1_pd(1.0 / (size - 1.0));
+    __m256d sums = _mm256_set1_pd(sum);
+    __m256d squareSums = _mm256_set1_pd(squares);
+    std::size_t k = 1;
+    for (; k + 4 <= outputs; k += 4) {
+        __m256d entering = _mm256_sub_pd(_mm256_div_pd(_mm256_loadu_pd(prices + k + window),
+                                                       _mm256_loadu_pd(prices + k + window - 1)), one);
+        __m256d leaving = _mm256_sub_pd(_mm256_div_pd(_mm256_loadu_pd(prices + k), _mm256_loadu_pd(prices + k - 1)),
+                                        one);
+        __m256d change = _mm256_sub_pd(entering, leaving);
+        __m256d squareChange = _mm256_fmsub_pd(entering, entering, _mm256_mul_pd(leaving, leaving));
+        sums = _mm256_add_pd(lastLane(sums), prefixSum(change));
+        squareSums = _mm256_add_pd(lastLane(squareSums), prefixSum(squareChange));
+
+        __m256d variance = _mm256_mul_pd(_mm256_fnmadd_pd(_mm256_mul_pd(sums, sums), inverseSize, squareSums),
+                                         inverseDegrees);
+        _mm256_storeu_pd(out + k, _mm256_sqrt_pd(_mm256_max_pd(variance, zero)));
+    }
+
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, sums);
+    sum = lanes[3];
+    _mm256_store_pd(lanes, squareSums);
+    squares = lanes[3];
+    for (; k < outputs; ++k) {
+        double entering = prices[k + window] / prices[k + window - 1] - 1.0;
+        double leaving = prices[k] / prices[k - 1] - 1.0;
+        sum += entering - leaving;
+        squares += entering * entering - leaving * leaving;
+        out[k] = deviation(sum, squares, size);
+    }
+}
+
+// Bucket numbers are worked out four at a time; the adds stay scalar since
+// AVX2 has no scatter and neighbouring trades often share a bucket
+void volumeProfileAvx2(const double* prices, const double* quantities, std::size_t count, double low,
+                       double bucket_width, std::size_t buckets, double* volumes) {
+    const double scale = 1.0 / bucket_width;
+    const double limit = static_cast<double>(buckets);
+    std::size_t i = 0;
+    if (buckets <= static_cast<std::size_t>(INT32_MAX)) {
+        const __m256d lows = _mm256_set1_pd(low);
+        const __m256d scales = _mm256_set1_pd(scale);
+        const __m256d limits = _mm256_set1_pd(limit);
+        const __m256d zero = _mm256_setzero_pd();
+        alignas(16) std::int32_t slots[4];
+        for (; i + 4 <= count; i += 4) {
+            __m256d slot = _mm256_floor_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(prices + i), lows), scales));
+            __m256d inside = _mm256_and_pd(_mm256_cmp_pd(slot, zero, _CMP_GE_OQ),
+                                           _mm256_cmp_pd(slot, limits, _CMP_LT_OQ));
+            int mask = _mm256_movemask_pd(inside);
+            if (mask == 0) {
+                continue;
+            }
+            _mm_store_si128(reinterpret_cast<__m128i*>(slots), _mm256_cvttpd_epi32(slot));
+            for (int lane = 0; lane < 4; ++lane) {
+                if (mask & (1 << lane)) {
+                    volumes[slots[lane]] += quantities[i + lane];
+                }
+            }
+        }
+    }
+    for (; i < count; ++i) {
+        double slot = std::floor((prices[i] - low) * scale);
+        if (slot >= 0.0 && slot < limit) {
+            volumes[static_cast<std::size_t>(slot)] += quantities[i];
+        }
+    }
+}
+
+const Kernels AVX2{"avx2", vwapAvx2, minMaxAvx2, rollingVolatilityAvx2, volumeProfileAvx2};
+
+} // namespace
+
+const Kernels& avx2KernelSet() {
+    return AVX2;
+}
+
+}}} // namespaces
@@ -0,0 +1,253 @@
+#include "../../../include/mercuryTrade/core/memory/mercBarAggregator.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+namespace {
+
+constexpr std::int64_t SECOND = 1000000000LL;
+constexpr std::int64_t INTERVAL_NANOS[BarAggregator::INTERVALS] = {SECOND, 60 * SECOND, 300 * SECOND,
+                                                                   3600 * SECOND};
+
+// Start of the interval holding timestamp, rounding down for negative ones
+std::int64_t bucketStart(std::int64_t timestamp, std::int64_t interval) {
+    std::int64_t remainder = timestamp % interval;
+    return remainder < 0 ? timestamp - remainder - interval : timestamp - remainder;
+}
+
+struct ClosedBar {
+    BarInterval interval;
+    Bar bar;
+};
+
+} // namespace
+
+BarAggregator::BarAggregator(const Config& config)
+    : m_config(config) {
+    if (config.max_symbols == 0) {
+        throw std::invalid_argument("Invalid bar aggregator configuration");
+    }
+    for (std::size_t history : config.history) {
+        if (history == 0) {
+            throw std::invalid_argument("Invalid bar aggregator configuration");
+        }
+    }
+    m_symbols = std::make_unique<SymbolBars[]>(config.max_symbols);
+}
+
+std::int64_t BarAggregator::intervalNanos(BarInterval interval) {
+    return INTERVAL_NANOS[static_cast<std::size_t>(interval)];
+}
+
+const char* BarAggregator::intervalName(BarInterval interval) {
+    switch (interval) {
+        case BarInterval::SECOND_1: return "1s";
+        case BarInterval::MINUTE_1: return "1m";
+        case BarInterval::MINUTE_5: return "5m";
+        case BarInterval::HOUR_1: return "1h";
+    }
+    return "";
+}
+
+BarInterval BarAggregator::parseInterval(const std::string& name) {
+    for (std::size_t i = 0; i < INTERVALS; ++i) {
+        if (name == intervalName(static_cast<BarInterval>(i))) {
+            return static_cast<BarInterval>(i);
+        }
+    }
+    throw std::invalid_argument("interval must be one of 1s, 1m, 5m, 1h");
+}
+
+std::size_t BarAggregator::symbolIndex(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(m_claim_mutex);
+    auto found = m_symbol_index.find(symbol);
+    if (found != m_symbol_index.end()) {
+        return found->second;
+    }
+    std::size_t claimed = m_symbol_count.load(std::memory_order_relaxed);
+    if (claimed == m_config.max_symbols) {
+        throw std::runtime_error("Bar aggregator is full, cannot add " + symbol);
+    }
+    SymbolBars& bars = m_symbols[claimed];
+    bars.symbol = symbol;
+    for (std::size_t i = 0; i < INTERVALS; ++i) {
+        bars.series[i].bars = std::make_unique<Bar[]>(m_config.history[i]);
+        bars.series[i].capacity = m_config.history[i];
+    }
+    m_symbol_index.emplace(symbol, claimed);
+    m_symbol_count.store(claimed + 1, std::memory_order_release);
+    return claimed;
+}
+
+std::size_t BarAggregator::findSymbol(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(m_claim_mutex);
+    auto found = m_symbol_index.find(symbol);
+    return found == m_symbol_index.end() ? NOT_FOUND : found->second;
+}
+
+BarAggregator::SymbolBars& BarAggregator::entry(std::size_t symbol) const {
+    if (symbol >= m_symbol_count.load(std::memory_order_acquire)) {
+        throw std::out_of_range("Unknown bar symbol index");
+    }
+    return m_symbols[symbol];
+}
+
+void BarAggregator::onTrade(std::size_t symbol, double price, double quantity, std::int64_t timestamp) {
+    SymbolBars& bars = entry(symbol);
+    ClosedBar closed[INTERVALS];
+    std::size_t closedCount = 0;
+    bool late = false;
+    {
+        std::lock_guard<std::mutex> lock(bars.mutex);
+        for (std::size_t i = 0; i < INTERVALS; ++i) {
+            Series& series = bars.series[i];
+            std::int64_t start = bucketStart(timestamp, INTERVAL_NANOS[i]);
+            if (series.count > 0) {
+                Bar& current = series.bars[series.newest];
+                if (start == current.start && !current.closed) {
+                    current.high = std::max(current.high, price);
+                    current.low = std::min(current.low, price);
+                    current.close = price;
+                    current.volume += quantity;
+                    ++current.trades;
+                    continue;
+                }
+                if (start <= current.start) {
+                    late = true;  // Its bar has closed or been superseded
+                    continue;
+                }
+                if (!current.closed) {
+                    current.closed = true;
+                    closed[closedCount++] = ClosedBar{static_cast<BarInterval>(i), current};
+                }
+                series.newest = (series.newest + 1) % series.capacity;
+            }
+            series.bars[series.newest] = Bar{start, price, price, price, price, quantity, 1, false};
+            series.count = std::min(series.count + 1, series.capacity);
+        }
+    }
+    if (late) {
+        m_late_trades.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (m_listener) {
+        for (std::size_t i = 0; i < closedCount; ++i) {
+            m_listener(bars.symbol, closed[i].interval, closed[i].bar);
+        }
+    }
+}
+
+void BarAggregator::advance(std::int64_t now) {
+    std::size_t count = m_symbol_count.load(std::memory_order_acquire);
+    for (std::size_t symbol = 0; symbol < count; ++symbol) {
+        SymbolBars& bars = m_symbols[symbol];
+        ClosedBar closed[INTERVALS];
+        std::size_t closedCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(bars.mutex);
+            for (std::size_t i = 0; i < INTERVALS; ++i) {
+                Series& series = bars.series[i];
+                if (series.count == 0) {
+                    continue;
+                }
+                Bar& current = series.bars[series.newest];
+                if (!current.closed && current.start + INTERVAL_NANOS[i] <= now) {
+                    current.closed = true;
+                    closed[closedCount++] = ClosedBar{static_cast<BarInterval>(i), current};
+                }
+            }
+        }
+        if (m_listener) {
+            for (std::size_t i = 0; i < closedCount; ++i) {
+                m_listener(bars.symbol, closed[i].interval, closed[i].bar);
+            }
+        }
+    }
+}
+
+std::vector<Bar> BarAggregator::range(const std::string& symbol, BarInterval interval, std::int64_t from,
+                                      std::int64_t to, std::size_t limit) const {
+    std::vector<Bar> result;
+    std::size_t index = findSymbol(symbol);
+    if (index == NOT_FOUND || from >= to || limit == 0) {
+        return result;
+    }
+    const SymbolBars& bars = m_symbols[index];
+    std::lock_guard<std::mutex> lock(bars.mutex);
+    const Series& series = bars.series[static_cast<std::size_t>(interval)];
+
+    // Logical position 0 is the oldest bar held; starts increase with position
+    std::size_t oldest = (series.newest + series.capacity + 1 - series.count) % series.capacity;
+    auto at = [&](std::size_t position) -> const Bar& {
+        return series.bars[(oldest + position) % series.capacity];
+    };
+    auto firstAtOrAfter = [&](std::int64_t timestamp) {
+        std::size_t low = 0;
+        std::size_t high = series.count;
+        while (low < high) {
+            std::size_t middle = low + (high - low) / 2;
+            if (at(middle).start < timestamp) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    };
+
+    std::size_t begin = firstAtOrAfter(from);
+    std::size_t end = firstAtOrAfter(to);
+    if (end - begin > limit) {
+        begin = end - limit;
+    }
+    result.reserve(end - begin);
+    for (std::size_t position = begin; position < end; ++position) {
+        result.push_back(at(position));
+    }
+    return result;
+}
+
+std::vector<std::string> BarAggregator::symbols() const {
+    std::lock_guard<std::mutex> lock(m_claim_mutex);
+    std::vector<std::string> result;
+    std::size_t count = m_symbol_count.load(std::memory_order_relaxed);
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(m_symbols[i].symbol);
+    }
+    return result;
+}
+
+TradeRingBarFeed::TradeRingBarFeed(const marketDataAllocator& rings, BarAggregator& bars)
+    : m_rings(rings)
+    , m_bars(bars) {}
+
+std::size_t TradeRingBarFeed::drain() {
+    for (std::size_t symbol = m_followers.size(); symbol < m_rings.symbolCount(); ++symbol) {
+        Follower follower{marketDataAllocator::Cursor(), BarAggregator::NOT_FOUND};
+        try {
+            follower.bar_index = m_bars.symbolIndex(m_rings.symbolName(symbol));
+            follower.cursor = m_rings.subscribe(symbol, marketDataAllocator::Channel::TRADE, true);
+        } catch (const std::runtime_error&) {
+            follower.bar_index = BarAggregator::NOT_FOUND;
+            ++m_untracked;
+        }
+        m_followers.push_back(std::move(follower));
+    }
+    std::size_t applied = 0;
+    MarketTrade trade;
+    for (auto& follower : m_followers) {
+        if (follower.bar_index == BarAggregator::NOT_FOUND) {
+            continue;
+        }
+        while (m_rings.read(follower.cursor, trade, &m_missed)) {
+            m_bars.onTrade(follower.bar_index, trade.price, trade.quantity, trade.timestamp);
+            ++applied;
+        }
+    }
+    return applied;
+}
+
+}}} // namespaces
@@ -0,0 +1,119 @@
+#include "../../../include/mercuryTrade/core/memory/mercBookRegionReader.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+BookRegionReader::BookRegionReader(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open order book region " + path + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(BookRegionHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not an order book region: " + path);
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    void* base = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Cannot map order book region " + path + ": " + std::strerror(errno));
+    }
+    m_base = static_cast<const char*>(base);
+    m_header = reinterpret_cast<const BookRegionHeader*>(m_base);
+
+    BookRegionHeader expected = BookRegionHeader::layout(m_header->max_orders, m_header->max_price_levels,
+                                                         m_header->order_stride);
+    if (m_header->magic != BookRegionHeader::MAGIC || m_header->version != BookRegionHeader::VERSION ||
+        m_header->size != m_size || expected.size != m_size ||
+        m_header->roots_offset != expected.roots_offset || m_header->levels_offset != expected.levels_offset) {
+        ::munmap(base, m_size);
+        throw std::runtime_error("Not an order book region: " + path);
+    }
+}
+
+BookRegionReader::~BookRegionReader() noexcept {
+    ::munmap(const_cast<char*>(m_base), m_size);
+}
+
+std::vector<std::string> BookRegionReader::symbols() const {
+    std::vector<std::string> result;
+    auto* roots = reinterpret_cast<const BookRoot*>(m_base + m_header->roots_offset);
+    std::size_t count = std::min<std::uint64_t>(m_header->book_count, BookRegionHeader::MAX_BOOKS);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.emplace_back(roots[i].symbol, strnlen(roots[i].symbol, BookRoot::SYMBOL_CAPACITY));
+    }
+    return result;
+}
+
+const BookRoot* BookRegionReader::findRoot(const std::string& symbol) const {
+    auto* roots = reinterpret_cast<const BookRoot*>(m_base + m_header->roots_offset);
+    std::size_t count = std::min<std::uint64_t>(m_header->book_count, BookRegionHeader::MAX_BOOKS);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (symbol.compare(0, std::string::npos, roots[i].symbol,
+                           strnlen(roots[i].symbol, BookRoot::SYMBOL_CAPACITY)) == 0) {
+            return &roots[i];
+        }
+    }
+    return nullptr;
+}
+
+bool BookRegionReader::copyLevels(const PriceLevel* level, std::size_t depth, std::vector<BookLevel>& out) const {
+    // Links may be mid-update, so every hop is checked against the level
+    // pool and the walk is bounded; a bad hop just means retry
+    auto first = reinterpret_cast<std::uintptr_t>(m_base + m_header->levels_offset);
+    auto end = first + sizeof(PriceLevel) * m_header->max_price_levels;
+    for (std::size_t hops = 0; level && out.size() < depth; ++hops) {
+        auto address = reinterpret_cast<std::uintptr_t>(level);
+        if (address < first || address >= end || (address - first) % sizeof(PriceLevel) != 0 ||
+            hops >= m_header->max_price_levels) {
+            return false;
+        }
+        out.push_back(BookLevel{level->price, level->total_quantity, level->order_count});
+        level = level->next;
+    }
+    return true;
+}
+
+std::optional<BookSnapshot> BookRegionReader::snapshot(const std::string& symbol, std::size_t depth,
+                                                       std::size_t max_attempts) const {
+    const BookRoot* root = findRoot(symbol);
+    if (!root) {
+        return std::nullopt;
+    }
+
+    BookSnapshot result{symbol, 0, {}, {}};
+    for (std::size_t attempt = 0; attempt < max_attempts; ++attempt) {
+        std::uint64_t before = root->version.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        result.seq = root->sequence;
+        result.bids.clear();
+        result.asks.clear();
+        bool walked = copyLevels(root->best_bid, depth, result.bids) &&
+                      copyLevels(root->best_ask, depth, result.asks);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (walked && root->version.load(std::memory_order_relaxed) == before) {
+            return result;
+        }
+    }
+    return std::nullopt;
+}
+
+}}} // namespaces
@@ -0,0 +1,31 @@
+#include "../../../include/mercuryTrade/core/memory/mercChecksum.hpp"
+#include <array>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+namespace {
+    const std::array<std::uint32_t, 256> CRC_TABLE = []() {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return table;
+    }();
+}
+
+std::uint32_t crc32(const void* data, std::size_t length, std::uint32_t previous) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint32_t crc = ~previous;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc = CRC_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+}}} // namespaces
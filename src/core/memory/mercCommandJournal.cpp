@@ -0,0 +1,626 @@
+#include "../../../include/mercuryTrade/core/memory/mercCommandJournal.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercChecksum.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr std::uint32_t SEGMENT_MAGIC = 0x4C4E4A4D;  // "MJNL"
+constexpr std::uint32_t SEGMENT_VERSION = 1;
+
+// Record layout, all fields little-endian as on every platform we run on:
+//   0  u32 length (whole record, multiple of 8)
+//   4  u32 crc32 of bytes [8, length)
+//   8  u64 sequence
+//  16  u8 type, u8 flags, u16 id length, u16 symbol length, u16 account length
+//  24  f64 price, f64 quantity, i64 timestamp
+//  48  order id, symbol, account, zero padding
+// The account length was reserved, and zero, before accounts were added.
+constexpr std::size_t RECORD_FIXED_SIZE = 48;
+constexpr std::uint8_t FLAG_BUY = 0x01;
+constexpr std::uint8_t FLAG_MARKET = 0x02;
+
+template <typename T>
+void store(unsigned char* at, T value) {
+    std::memcpy(at, &value, sizeof(T));
+}
+
+template <typename T>
+T load(const unsigned char* at) {
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
+}
+
+std::size_t recordSize(const JournalCommand& command) {
+    if (command.order_id.size() > 0xFFFF || command.symbol.size() > 0xFFFF || command.account.size() > 0xFFFF) {
+        throw std::length_error("Journal record field too long");
+    }
+    std::size_t size = RECORD_FIXED_SIZE + command.order_id.size() + command.symbol.size() + command.account.size();
+    return (size + 7) & ~std::size_t{7};
+}
+
+void encodeRecord(unsigned char* at, std::size_t size, const JournalCommand& command, std::uint64_t sequence) {
+    std::uint8_t flags = (command.is_buy ? FLAG_BUY : 0) | (command.is_market ? FLAG_MARKET : 0);
+
+    store<std::uint32_t>(at, static_cast<std::uint32_t>(size));
+    store<std::uint64_t>(at + 8, sequence);
+    at[16] = static_cast<std::uint8_t>(command.type);
+    at[17] = flags;
+    store<std::uint16_t>(at + 18, static_cast<std::uint16_t>(command.order_id.size()));
+    store<std::uint16_t>(at + 20, static_cast<std::uint16_t>(command.symbol.size()));
+    store<std::uint16_t>(at + 22, static_cast<std::uint16_t>(command.account.size()));
+    store<double>(at + 24, command.price);
+    store<double>(at + 32, command.quantity);
+    store<std::int64_t>(at + 40, command.timestamp);
+
+    unsigned char* text = at + RECORD_FIXED_SIZE;
+    std::memcpy(text, command.order_id.data(), command.order_id.size());
+    text += command.order_id.size();
+    std::memcpy(text, command.symbol.data(), command.symbol.size());
+    text += command.symbol.size();
+    std::memcpy(text, command.account.data(), command.account.size());
+    text += command.account.size();
+    std::memset(text, 0, at + size - text);
+
+    store<std::uint32_t>(at + 4, crc32(at + 8, size - 8));
+}
+
+// Length of the intact record at offset with the expected sequence, or 0
+std::size_t decodeRecord(const unsigned char* base, std::size_t size, std::size_t offset,
+                         std::uint64_t sequence, JournalCommand* command) {
+    if (offset + RECORD_FIXED_SIZE > size) {
+        return 0;
+    }
+    const unsigned char* at = base + offset;
+    std::size_t length = load<std::uint32_t>(at);
+    if (length < RECORD_FIXED_SIZE || length % 8 != 0 || length > size - offset) {
+        return 0;
+    }
+    std::size_t id_length = load<std::uint16_t>(at + 18);
+    std::size_t symbol_length = load<std::uint16_t>(at + 20);
+    std::size_t account_length = load<std::uint16_t>(at + 22);
+    std::uint8_t type = at[16];
+    if (load<std::uint64_t>(at + 8) != sequence ||
+        RECORD_FIXED_SIZE + id_length + symbol_length + account_length > length ||
+        type < static_cast<std::uint8_t>(JournalCommand::Type::NEW_ORDER) ||
+        type > static_cast<std::uint8_t>(JournalCommand::Type::MODIFY) ||
+        load<std::uint32_t>(at + 4) != crc32(at + 8, length - 8)) {
+        return 0;
+    }
+
+    if (command) {
+        const char* text = reinterpret_cast<const char*>(at + RECORD_FIXED_SIZE);
+        command->type = static_cast<JournalCommand::Type>(type);
+        command->sequence = sequence;
+        command->is_buy = (at[17] & FLAG_BUY) != 0;
+        command->is_market = (at[17] & FLAG_MARKET) != 0;
+        command->price = load<double>(at + 24);
+        command->quantity = load<double>(at + 32);
+        command->timestamp = load<std::int64_t>(at + 40);
+        command->order_id.assign(text, id_length);
+        command->symbol.assign(text + id_length, symbol_length);
+        command->account.assign(text + id_length + symbol_length, account_length);
+    }
+    return length;
+}
+
+// First sequence from a segment header, or 0 if the header is not valid
+std::uint64_t segmentFirstSequence(const unsigned char* header) {
+    if (load<std::uint32_t>(header) != SEGMENT_MAGIC || load<std::uint32_t>(header + 4) != SEGMENT_VERSION) {
+        return 0;
+    }
+    return load<std::uint64_t>(header + 8);
+}
+
+std::uint64_t readFirstSequence(const std::string& path) {
+    unsigned char header[CommandJournal::SEGMENT_HEADER_SIZE] = {};
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+    ssize_t n = ::pread(fd, header, sizeof(header), 0);
+    ::close(fd);
+    return n == static_cast<ssize_t>(sizeof(header)) ? segmentFirstSequence(header) : 0;
+}
+
+bool isSegmentFile(const fs::path& path) {
+    std::string name = path.filename().string();
+    return name.size() > 12 && name.compare(0, 8, "journal-") == 0 &&
+           name.compare(name.size() - 4, 4, ".log") == 0;
+}
+
+std::string segmentPath(const std::string& directory, std::uint32_t index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "journal-%010u.log", index);
+    return (fs::path(directory) / name).string();
+}
+
+std::uint32_t segmentIndex(const fs::path& path) {
+    std::string name = path.filename().string();
+    return static_cast<std::uint32_t>(std::strtoul(name.c_str() + 8, nullptr, 10));
+}
+
+std::runtime_error ioError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+struct CommandJournal::Segment {
+    std::string path;
+    int fd{-1};
+    unsigned char* base{nullptr};
+    std::size_t size{0};
+
+    ~Segment() {
+        if (base) {
+            ::munmap(base, size);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+
+CommandJournal::CommandJournal(const Config& config)
+    : m_config(config) {
+    m_config.segment_size &= ~std::size_t{7};
+    if (m_config.directory.empty() || m_config.segment_size < SEGMENT_HEADER_SIZE + 4096) {
+        throw std::invalid_argument("Invalid journal configuration");
+    }
+
+    std::error_code error;
+    fs::create_directories(m_config.directory, error);
+    if (error) {
+        throw std::runtime_error("Cannot create journal directory " + m_config.directory + ": " + error.message());
+    }
+
+    recover();
+    if (m_config.sync_policy != SyncPolicy::NONE) {
+        m_sync_thread = std::thread([this]() { runSync(); });
+    }
+}
+
+CommandJournal::~CommandJournal() noexcept {
+    try {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_work.notify_all();
+        if (m_sync_thread.joinable()) {
+            m_sync_thread.join();  // Syncs what is left on the way out
+        } else {
+            flush();
+        }
+        m_durable.notify_all();
+
+        if (m_spare) {
+            ::unlink(m_spare->path.c_str());
+        }
+    } catch (...) {
+        // Ensure no exceptions escape
+    }
+}
+
+void CommandJournal::recover() {
+    std::vector<std::pair<std::uint64_t, fs::path>> segments;
+    for (const auto& entry : fs::directory_iterator(m_config.directory)) {
+        if (!entry.is_regular_file() || !isSegmentFile(entry.path())) {
+            continue;
+        }
+        m_next_index = std::max(m_next_index, segmentIndex(entry.path()) + 1);
+        std::uint64_t first = readFirstSequence(entry.path().string());
+        if (first == 0) {
+            // A spare that was never put into use
+            fs::remove(entry.path());
+            continue;
+        }
+        segments.emplace_back(first, entry.path());
+    }
+
+    if (segments.empty()) {
+        activate(createSegment(m_next_index++), 1);
+        return;
+    }
+    std::sort(segments.begin(), segments.end());
+    m_segments = segments.size();
+
+    // Continue in the newest segment, after its last intact record
+    auto segment = std::make_shared<Segment>();
+    segment->path = segments.back().second.string();
+    segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CLOEXEC);
+    if (segment->fd < 0) {
+        throw ioError("Cannot open journal segment", segment->path);
+    }
+    struct stat info;
+    if (::fstat(segment->fd, &info) != 0) {
+        throw ioError("Cannot stat journal segment", segment->path);
+    }
+    segment->size = static_cast<std::size_t>(info.st_size) & ~std::size_t{7};
+    void* base = ::mmap(nullptr, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+    if (base == MAP_FAILED) {
+        throw ioError("Cannot map journal segment", segment->path);
+    }
+    segment->base = static_cast<unsigned char*>(base);
+
+    std::uint64_t sequence = segments.back().first;
+    std::size_t offset = SEGMENT_HEADER_SIZE;
+    while (std::size_t length = decodeRecord(segment->base, segment->size, offset, sequence, nullptr)) {
+        offset += length;
+        ++sequence;
+    }
+
+    // Clear a torn tail so stale bytes can never follow a new record
+    if (offset + 8 <= segment->size && load<std::uint64_t>(segment->base + offset) != 0) {
+        std::memset(segment->base + offset, 0, segment->size - offset);
+    }
+
+    m_segment = segment;
+    m_offset = offset;
+    m_synced_offset = offset;
+    m_next_sequence = sequence;
+    m_durable_sequence = sequence - 1;
+}
+
+std::shared_ptr<CommandJournal::Segment> CommandJournal::createSegment(std::uint32_t index) {
+    auto segment = std::make_shared<Segment>();
+    segment->path = segmentPath(m_config.directory, index);
+    segment->size = m_config.segment_size;
+    segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (segment->fd < 0) {
+        throw ioError("Cannot create journal segment", segment->path);
+    }
+
+    // Reserve the blocks now so appends never wait on the filesystem
+    int error = ::posix_fallocate(segment->fd, 0, static_cast<off_t>(segment->size));
+    if (error != 0) {
+        errno = error;
+        ::unlink(segment->path.c_str());
+        throw ioError("Cannot preallocate journal segment", segment->path);
+    }
+
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;  // Fault the pages in here rather than on the append path
+#endif
+    void* base = ::mmap(nullptr, segment->size, PROT_READ | PROT_WRITE, flags, segment->fd, 0);
+    if (base == MAP_FAILED) {
+        ::unlink(segment->path.c_str());
+        throw ioError("Cannot map journal segment", segment->path);
+    }
+    segment->base = static_cast<unsigned char*>(base);
+
+    if (m_config.sync_policy != SyncPolicy::NONE) {
+        ::fsync(segment->fd);
+        int dir = ::open(m_config.directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dir >= 0) {
+            ::fsync(dir);
+            ::close(dir);
+        }
+    }
+    return segment;
+}
+
+void CommandJournal::activate(const std::shared_ptr<Segment>& segment, std::uint64_t first_sequence) {
+    store<std::uint32_t>(segment->base, SEGMENT_MAGIC);
+    store<std::uint32_t>(segment->base + 4, SEGMENT_VERSION);
+    store<std::uint64_t>(segment->base + 8, first_sequence);
+    store<std::uint64_t>(segment->base + 16, segment->size);
+
+    m_segment = segment;
+    m_offset = SEGMENT_HEADER_SIZE;
+    m_synced_offset = 0;  // The header needs syncing too
+    ++m_segments;
+}
+
+void CommandJournal::roll() {
+    if (m_config.sync_policy != SyncPolicy::NONE) {
+        m_retired.push_back(Retired{m_segment, m_synced_offset, m_offset});
+    }
+
+    std::shared_ptr<Segment> next = std::move(m_spare);
+    if (!next) {
+        next = createSegment(m_next_index++);  // The sync thread fell behind; create it here
+    }
+    activate(next, m_next_sequence);
+    m_work.notify_one();  // Ask for a new spare
+}
+
+std::uint64_t CommandJournal::append(const JournalCommand& command) {
+    std::size_t size = recordSize(command);
+    if (size > m_config.segment_size - SEGMENT_HEADER_SIZE) {
+        throw std::length_error("Journal record larger than a segment");
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_failed) {
+        throw std::runtime_error("Journal is unusable after a sync failure");
+    }
+    if (m_offset + size > m_segment->size) {
+        roll();
+    }
+
+    std::uint64_t sequence = m_next_sequence++;
+    encodeRecord(m_segment->base + m_offset, size, command, sequence);
+    m_offset += size;
+    m_bytes_appended += size;
+
+    if (m_config.sync_policy == SyncPolicy::NONE) {
+        m_durable_sequence = sequence;
+    } else if (m_config.sync_policy == SyncPolicy::GROUP && m_sync_idle) {
+        m_sync_idle = false;
+        lock.unlock();
+        m_work.notify_one();
+    }
+    return sequence;
+}
+
+void CommandJournal::waitDurable(std::uint64_t sequence) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_config.sync_policy == SyncPolicy::GROUP) {
+        m_durable.wait(lock, [&]() { return m_durable_sequence >= sequence || m_failed || m_stopping; });
+        if (m_durable_sequence >= sequence) {
+            return;
+        }
+    }
+    if (m_failed) {
+        throw std::runtime_error("Journal sync failed");
+    }
+}
+
+void CommandJournal::sync() {
+    flush();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_failed) {
+        throw std::runtime_error("Journal sync failed");
+    }
+}
+
+void CommandJournal::flush() {
+    std::lock_guard<std::mutex> syncing(m_sync_mutex);
+
+    std::vector<Retired> retired;
+    std::shared_ptr<Segment> segment;
+    std::size_t from;
+    std::size_t to;
+    std::uint64_t target;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        retired.swap(m_retired);
+        segment = m_segment;
+        from = m_synced_offset;
+        to = m_offset;
+        target = m_next_sequence - 1;
+        m_synced_offset = to;
+    }
+    if (retired.empty() && from >= to) {
+        return;
+    }
+
+    // msync wants a page-aligned start
+    static const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto syncRange = [&](const Segment& s, std::size_t begin, std::size_t end) {
+        if (begin >= end) {
+            return true;
+        }
+        std::size_t start = begin & ~(page_size - 1);
+        return ::msync(s.base + start, end - start, MS_SYNC) == 0;
+    };
+
+    bool ok = true;
+    for (const auto& r : retired) {
+        ok = syncRange(*r.segment, r.from, r.to) && ok;
+    }
+    ok = syncRange(*segment, from, to) && ok;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (ok) {
+            m_durable_sequence = std::max(m_durable_sequence, target);
+            ++m_syncs;
+        } else {
+            m_failed = true;
+        }
+    }
+    m_durable.notify_all();
+}
+
+void CommandJournal::prepareSpare() {
+    std::uint32_t index;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_spare || m_spare_failed || m_stopping) {
+            return;
+        }
+        index = m_next_index++;
+    }
+
+    try {
+        auto spare = createSegment(index);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_spare = std::move(spare);
+    } catch (const std::exception&) {
+        // roll() will try again inline when it needs a segment
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_spare_failed = true;
+    }
+}
+
+void CommandJournal::runSync() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        if (m_config.sync_policy == SyncPolicy::GROUP) {
+            m_sync_idle = true;
+            m_work.wait(lock, [this]() {
+                return m_stopping || (!m_failed && (m_next_sequence - 1 > m_durable_sequence ||
+                       !m_retired.empty() || (!m_spare && !m_spare_failed)));
+            });
+            m_sync_idle = false;
+        } else {
+            m_work.wait_for(lock, m_config.sync_interval, [this]() {
+                return m_stopping || (!m_spare && !m_spare_failed);
+            });
+        }
+
+        lock.unlock();
+        flush();
+        prepareSpare();
+        lock.lock();
+    }
+    lock.unlock();
+    flush();
+}
+
+std::size_t CommandJournal::truncateBefore(std::uint64_t sequence) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<std::pair<std::uint64_t, fs::path>> segments;
+    for (const auto& entry : fs::directory_iterator(m_config.directory)) {
+        if (!entry.is_regular_file() || !isSegmentFile(entry.path()) || entry.path() == m_segment->path) {
+            continue;
+        }
+        std::uint64_t first = readFirstSequence(entry.path().string());
+        if (first != 0) {
+            segments.emplace_back(first, entry.path());
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+
+    // A segment ends where the next one begins; the newest is bounded by the active one
+    std::size_t removed = 0;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        std::uint64_t end = i + 1 < segments.size() ? segments[i + 1].first : readFirstSequence(m_segment->path);
+        if (end > sequence) {
+            break;
+        }
+        std::error_code error;
+        if (fs::remove(segments[i].second, error)) {
+            ++removed;
+        }
+    }
+    return removed;
+}
+
+std::uint64_t CommandJournal::lastSequence() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_next_sequence - 1;
+}
+
+std::uint64_t CommandJournal::durableSequence() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_durable_sequence;
+}
+
+CommandJournal::Stats CommandJournal::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return Stats{
+        m_next_sequence - 1,
+        m_durable_sequence,
+        m_syncs,
+        m_segments,
+        m_bytes_appended
+    };
+}
+
+JournalReader::JournalReader(const std::string& directory, std::uint64_t after_sequence)
+    : m_after_sequence(after_sequence) {
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        if (!entry.is_regular_file() || !isSegmentFile(entry.path())) {
+            continue;
+        }
+        std::uint64_t first = readFirstSequence(entry.path().string());
+        if (first != 0) {
+            m_segments.emplace_back(first, entry.path().string());
+        }
+    }
+    std::sort(m_segments.begin(), m_segments.end());
+
+    // Segments that end at or before after_sequence need not be opened
+    std::size_t skip = 0;
+    while (skip + 1 < m_segments.size() && m_segments[skip + 1].first <= after_sequence + 1) {
+        ++skip;
+    }
+    m_segments.erase(m_segments.begin(), m_segments.begin() + skip);
+    if (!m_segments.empty()) {
+        m_last_sequence = m_segments.front().first - 1;
+    }
+}
+
+JournalReader::~JournalReader() noexcept {
+    closeCurrent();
+}
+
+bool JournalReader::next(JournalCommand& command) {
+    while (!m_done) {
+        if (!m_base && !openNext()) {
+            m_done = true;
+            break;
+        }
+        std::size_t length = decodeRecord(m_base, m_size, m_offset, m_last_sequence + 1, &command);
+        if (length) {
+            m_offset += length;
+            m_last_sequence = command.sequence;
+            if (command.sequence <= m_after_sequence) {
+                continue;
+            }
+            return true;
+        }
+        closeCurrent();  // End of this segment; the next must pick up where it stopped
+    }
+    return false;
+}
+
+bool JournalReader::openNext() {
+    if (m_segment_index == m_segments.size() || m_segments[m_segment_index].first != m_last_sequence + 1) {
+        return false;
+    }
+    const std::string& path = m_segments[m_segment_index++].second;
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    void* base = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= CommandJournal::SEGMENT_HEADER_SIZE) {
+        base = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    m_base = static_cast<const unsigned char*>(base);
+    m_size = static_cast<std::size_t>(info.st_size);
+    m_offset = CommandJournal::SEGMENT_HEADER_SIZE;
+#ifdef MADV_SEQUENTIAL
+    ::madvise(const_cast<unsigned char*>(m_base), m_size, MADV_SEQUENTIAL);
+#endif
+    return true;
+}
+
+void JournalReader::closeCurrent() {
+    if (m_base) {
+        ::munmap(const_cast<unsigned char*>(m_base), m_size);
+        m_base = nullptr;
+    }
+}
+
+}}} // namespaces
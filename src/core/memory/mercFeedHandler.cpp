@@ -0,0 +1,311 @@
+#include "../../../include/mercuryTrade/core/memory/mercFeedHandler.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+// Fields are copied in host order; every supported target is little-endian
+namespace {
+
+template <typename T>
+void put(char* at, T value) {
+    std::memcpy(at, &value, sizeof(T));
+}
+
+template <typename T>
+T get(const char* at) {
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
+}
+
+// Counters have a single writer, so a plain load and store is enough
+void bump(std::atomic<std::uint64_t>& counter, std::uint64_t by = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+} // namespace
+
+namespace feed {
+
+void PacketWriter::clear() {
+    m_data.assign(HEADER_SIZE, '\0');
+    put<std::uint32_t>(&m_data[0], PACKET_MAGIC);
+    m_count = 0;
+}
+
+char* PacketWriter::append(MessageType type, std::uint8_t flags, std::uint16_t symbol_id, std::uint64_t sequence,
+                           std::int64_t timestamp) {
+    if (m_count == MAX_MESSAGES) {
+        return nullptr;
+    }
+    std::size_t offset = m_data.size();
+    m_data.resize(offset + MESSAGE_SIZE, '\0');
+    char* message = &m_data[offset];
+    put<std::uint8_t>(message, static_cast<std::uint8_t>(type));
+    put<std::uint8_t>(message + 1, flags);
+    put<std::uint16_t>(message + 2, symbol_id);
+    put<std::uint64_t>(message + 8, sequence);
+    put<std::int64_t>(message + 16, timestamp);
+    put<std::uint16_t>(&m_data[4], static_cast<std::uint16_t>(++m_count));
+    return message + 24;
+}
+
+bool PacketWriter::definition(std::uint16_t symbol_id, const std::string& symbol, std::uint64_t sequence) {
+    if (symbol.empty() || symbol.size() >= SYMBOL_CAPACITY) {
+        throw std::invalid_argument("Feed symbols must be 1 to 31 characters: " + symbol);
+    }
+    char* body = append(MessageType::DEFINITION, 0, symbol_id, sequence, 0);
+    if (!body) {
+        return false;
+    }
+    std::memcpy(body, symbol.data(), symbol.size());
+    return true;
+}
+
+bool PacketWriter::quote(std::uint16_t symbol_id, std::uint64_t sequence, std::int64_t timestamp, double bid,
+                         double bid_size, double ask, double ask_size) {
+    char* body = append(MessageType::QUOTE, 0, symbol_id, sequence, timestamp);
+    if (!body) {
+        return false;
+    }
+    put(body, bid);
+    put(body + 8, bid_size);
+    put(body + 16, ask);
+    put(body + 24, ask_size);
+    return true;
+}
+
+bool PacketWriter::trade(std::uint16_t symbol_id, std::uint64_t sequence, std::int64_t timestamp, double price,
+                         double quantity, bool buyer_aggressor) {
+    char* body = append(MessageType::TRADE, buyer_aggressor ? 1 : 0, symbol_id, sequence, timestamp);
+    if (!body) {
+        return false;
+    }
+    put(body, price);
+    put(body + 8, quantity);
+    return true;
+}
+
+} // namespace feed
+
+UdpFeedSource::UdpFeedSource(std::uint16_t port, const std::string& address) {
+    m_socket = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_socket < 0) {
+        throw std::runtime_error(std::string("Cannot create feed socket: ") + std::strerror(errno));
+    }
+    // Room for bursts while the feed thread is busy decoding
+    int buffer = 8 * 1024 * 1024;
+    ::setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &local.sin_addr) != 1 ||
+        ::bind(m_socket, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+        int error = errno;
+        ::close(m_socket);
+        throw std::runtime_error("Cannot bind feed socket to " + address + ":" + std::to_string(port) + ": " +
+                                 std::strerror(error));
+    }
+    socklen_t length = sizeof(local);
+    ::getsockname(m_socket, reinterpret_cast<sockaddr*>(&local), &length);
+    m_port = ntohs(local.sin_port);
+}
+
+UdpFeedSource::~UdpFeedSource() {
+    if (m_socket >= 0) {
+        ::close(m_socket);
+    }
+}
+
+std::size_t UdpFeedSource::receive(char* buffer, std::size_t capacity) {
+    ssize_t received = ::recv(m_socket, buffer, capacity, 0);
+    if (received < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return 0;
+        }
+        throw std::runtime_error(std::string("Feed socket failed: ") + std::strerror(errno));
+    }
+    return static_cast<std::size_t>(received);
+}
+
+FileFeedSource::FileFeedSource(const std::string& path)
+    : m_file(path, std::ios::binary) {
+    if (!m_file) {
+        throw std::runtime_error("Cannot open feed capture " + path);
+    }
+}
+
+std::size_t FileFeedSource::receive(char* buffer, std::size_t capacity) {
+    if (m_exhausted) {
+        return 0;
+    }
+    char prefix[4];
+    if (!m_file.read(prefix, sizeof(prefix))) {
+        m_exhausted = true;
+        return 0;
+    }
+    std::uint32_t length = get<std::uint32_t>(prefix);
+    if (length > capacity || !m_file.read(buffer, length)) {
+        m_exhausted = true;  // Truncated or corrupt; nothing after it can be trusted
+        throw std::runtime_error("Truncated or corrupt feed capture");
+    }
+    return length;
+}
+
+void FileFeedSource::writeCapture(const std::string& path, const std::vector<std::string>& packets) {
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    for (const auto& packet : packets) {
+        char prefix[4];
+        put<std::uint32_t>(prefix, static_cast<std::uint32_t>(packet.size()));
+        file.write(prefix, sizeof(prefix));
+        file.write(packet.data(), static_cast<std::streamsize>(packet.size()));
+    }
+    if (!file) {
+        throw std::runtime_error("Cannot write feed capture " + path);
+    }
+}
+
+FeedHandler::FeedHandler(LastValueCache& cache, marketDataAllocator& allocator)
+    : m_cache(cache)
+    , m_allocator(allocator)
+    , m_receive_buffer(feed::MAX_PACKET_SIZE) {
+    auto config = m_allocator.getConfig();
+    if (config.quote_size < sizeof(MarketQuote) || config.trade_size < sizeof(MarketTrade)) {
+        throw std::invalid_argument("Market data slots are too small for feed records");
+    }
+}
+
+void FeedHandler::checkSequence(std::uint64_t sequence) {
+    if (m_expected_sequence != 0 && sequence > m_expected_sequence) {
+        bump(m_gaps);
+        bump(m_lost_messages, sequence - m_expected_sequence);
+    }
+    if (sequence >= m_expected_sequence) {
+        m_expected_sequence = sequence + 1;
+    }
+}
+
+std::size_t FeedHandler::onPacket(const char* data, std::size_t size) {
+    bump(m_packets);
+    if (size < feed::HEADER_SIZE || get<std::uint32_t>(data) != feed::PACKET_MAGIC) {
+        bump(m_malformed);
+        return 0;
+    }
+    std::size_t count = get<std::uint16_t>(data + 4);
+    if (count > (size - feed::HEADER_SIZE) / feed::MESSAGE_SIZE) {
+        bump(m_malformed);
+        return 0;
+    }
+
+    std::size_t ticks = 0;
+    const char* message = data + feed::HEADER_SIZE;
+    for (std::size_t i = 0; i < count; ++i, message += feed::MESSAGE_SIZE) {
+        auto type = static_cast<feed::MessageType>(get<std::uint8_t>(message));
+        std::uint16_t symbol_id = get<std::uint16_t>(message + 2);
+        std::uint64_t sequence = get<std::uint64_t>(message + 8);
+        const char* body = message + 24;
+        checkSequence(sequence);
+
+        if (type == feed::MessageType::DEFINITION) {
+            std::size_t length = strnlen(body, feed::SYMBOL_CAPACITY - 1);
+            if (length == 0) {
+                bump(m_malformed);
+                continue;
+            }
+            if (symbol_id >= m_symbols.size()) {
+                m_symbols.resize(static_cast<std::size_t>(symbol_id) + 1, Route{0, 0});
+            }
+            std::string symbol(body, length);
+            try {
+                m_symbols[symbol_id] = Route{static_cast<std::uint32_t>(m_cache.index(symbol) + 1),
+                                             static_cast<std::uint32_t>(m_allocator.symbolIndex(symbol))};
+            } catch (const std::runtime_error&) {
+                // No room for another symbol; its ticks count as unknown
+                m_symbols[symbol_id] = Route{0, 0};
+                bump(m_rejected_definitions);
+                continue;
+            }
+            bump(m_definitions);
+            continue;
+        }
+        if (type != feed::MessageType::QUOTE && type != feed::MessageType::TRADE) {
+            bump(m_malformed);
+            continue;
+        }
+        if (symbol_id >= m_symbols.size() || m_symbols[symbol_id].cache_index == 0) {
+            bump(m_unknown_symbols);
+            continue;
+        }
+
+        const Route& route = m_symbols[symbol_id];
+        std::int64_t timestamp = get<std::int64_t>(message + 16);
+        if (type == feed::MessageType::QUOTE) {
+            MarketQuote quote{sequence, timestamp, get<double>(body), get<double>(body + 8),
+                              get<double>(body + 16), get<double>(body + 24)};
+            m_allocator.publish(route.ring_index, marketDataAllocator::Channel::QUOTE, quote);
+            m_cache.updateQuote(route.cache_index - 1, quote.bid, quote.bid_size, quote.ask, quote.ask_size,
+                                timestamp, sequence);
+            bump(m_quotes);
+        } else {
+            MarketTrade trade{sequence, timestamp, get<double>(body), get<double>(body + 8),
+                              static_cast<std::uint8_t>(get<std::uint8_t>(message + 1) & 1)};
+            m_allocator.publish(route.ring_index, marketDataAllocator::Channel::TRADE, trade);
+            m_cache.updateTrade(route.cache_index - 1, trade.price, trade.quantity, timestamp, sequence);
+            bump(m_trades);
+        }
+        ++ticks;
+    }
+    return ticks;
+}
+
+std::size_t FeedHandler::poll(FeedSource& source, std::size_t max_packets) {
+    std::size_t handled = 0;
+    while (handled < max_packets) {
+        std::size_t size = source.receive(m_receive_buffer.data(), m_receive_buffer.size());
+        if (size == 0) {
+            break;
+        }
+        onPacket(m_receive_buffer.data(), size);
+        ++handled;
+    }
+    return handled;
+}
+
+void FeedHandler::run(FeedSource& source, const std::atomic<bool>& stop) {
+    while (!stop.load(std::memory_order_relaxed) && !source.exhausted()) {
+        if (poll(source) == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+std::uint64_t FeedHandler::ticksWritten() const {
+    return m_quotes.load(std::memory_order_relaxed) + m_trades.load(std::memory_order_relaxed);
+}
+
+FeedHandler::Stats FeedHandler::getStats() const {
+    return Stats{
+        m_packets.load(std::memory_order_relaxed),
+        m_quotes.load(std::memory_order_relaxed),
+        m_trades.load(std::memory_order_relaxed),
+        m_definitions.load(std::memory_order_relaxed),
+        m_malformed.load(std::memory_order_relaxed),
+        m_unknown_symbols.load(std::memory_order_relaxed),
+        m_rejected_definitions.load(std::memory_order_relaxed),
+        m_gaps.load(std::memory_order_relaxed),
+        m_lost_messages.load(std::memory_order_relaxed)
+    };
+}
+
+}}} // namespaces
@@ -0,0 +1,115 @@
+#include "../../../include/mercuryTrade/core/memory/mercFeedSimulator.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+FeedSimulator::FeedSimulator(const Config& config)
+    : m_config(config)
+    , m_random(config.seed) {
+    if (m_config.symbols.empty() || m_config.symbols.size() > UINT16_MAX || m_config.start_price <= 0.0 ||
+        m_config.tick_size <= 0.0 || m_config.messages_per_packet == 0) {
+        throw std::invalid_argument("Invalid feed simulator configuration");
+    }
+    m_config.messages_per_packet = std::min(m_config.messages_per_packet, feed::MAX_MESSAGES);
+    for (std::size_t i = 0; i < m_config.symbols.size(); ++i) {
+        // Spread the symbols out so their prices are told apart easily
+        m_state.push_back(SymbolState{m_config.start_price / static_cast<double>(i + 1), 2.0});
+    }
+}
+
+void FeedSimulator::addTick(std::int64_t timestamp) {
+    std::uint64_t draw = m_random();
+    auto id = static_cast<std::uint16_t>(draw % m_state.size());
+    SymbolState& state = m_state[id];
+    double tick = m_config.tick_size;
+
+    bool trade = static_cast<double>((draw >> 16) % 10000) < m_config.trade_ratio * 10000.0;
+    if (trade) {
+        bool buyer = (draw >> 32) & 1;
+        double price = state.mid + (buyer ? 1.0 : -1.0) * state.spread * tick / 2.0;
+        double quantity = 0.01 * static_cast<double>((draw >> 40) % 100 + 1);
+        m_writer.trade(id, m_sequence++, timestamp, price, quantity, buyer);
+        return;
+    }
+
+    // Walk the mid a tick at a time, never below a few ticks
+    switch ((draw >> 32) % 3) {
+        case 0: state.mid = std::max(state.mid - tick, 10.0 * tick); break;
+        case 1: state.mid += tick; break;
+        default: break;
+    }
+    state.spread = static_cast<double>((draw >> 36) % 4 + 1);
+    double half = state.spread * tick / 2.0;
+    double bid_size = 0.1 * static_cast<double>((draw >> 40) % 50 + 1);
+    double ask_size = 0.1 * static_cast<double>((draw >> 48) % 50 + 1);
+    m_writer.quote(id, m_sequence++, timestamp, state.mid - half, bid_size, state.mid + half, ask_size);
+}
+
+const std::string& FeedSimulator::nextPacket() {
+    m_writer.clear();
+    while (m_defined < m_config.symbols.size() && m_writer.messages() < m_config.messages_per_packet) {
+        m_writer.definition(static_cast<std::uint16_t>(m_defined), m_config.symbols[m_defined], m_sequence++);
+        ++m_defined;
+    }
+    auto timestamp = static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    while (m_writer.messages() < m_config.messages_per_packet) {
+        addTick(timestamp);
+    }
+    return m_writer.data();
+}
+
+std::vector<std::string> FeedSimulator::packets(std::size_t count) {
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(nextPacket());
+    }
+    return result;
+}
+
+void FeedSimulator::sendUdp(const std::string& address, std::uint16_t port, std::size_t count,
+                            std::size_t messages_per_second) {
+    int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("Cannot create simulator socket: ") + std::strerror(errno));
+    }
+    sockaddr_in target{};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(port);
+    if (::inet_pton(AF_INET, address.c_str(), &target.sin_addr) != 1) {
+        ::close(fd);
+        throw std::invalid_argument("Invalid simulator address " + address);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t first = m_sequence;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::string& packet = nextPacket();
+        if (::sendto(fd, packet.data(), packet.size(), 0, reinterpret_cast<sockaddr*>(&target),
+                     sizeof(target)) < 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::runtime_error(std::string("Simulator send failed: ") + std::strerror(error));
+        }
+        if (messages_per_second > 0) {
+            auto due = start + std::chrono::nanoseconds(
+                (m_sequence - first) * 1000000000ULL / messages_per_second);
+            std::this_thread::sleep_until(due);
+        }
+    }
+    ::close(fd);
+}
+
+}}} // namespaces
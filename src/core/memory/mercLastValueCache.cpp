@@ -0,0 +1,148 @@
+#include "../../../include/mercuryTrade/core/memory/mercLastValueCache.hpp"
+#include <functional>
+#include <stdexcept>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+LastValueCache::LastValueCache(std::size_t max_symbols)
+    : m_max_symbols(max_symbols) {
+    if (max_symbols == 0 || max_symbols > UINT32_MAX / 2) {
+        throw std::invalid_argument("Invalid last value cache capacity");
+    }
+    // At most half full, so probes stay short
+    std::size_t table_size = 1;
+    while (table_size < max_symbols * 2) {
+        table_size <<= 1;
+    }
+    m_table_mask = table_size - 1;
+    m_entries = std::make_unique<Entry[]>(max_symbols);
+    m_table = std::make_unique<std::atomic<std::uint32_t>[]>(table_size);
+    for (std::size_t i = 0; i < table_size; ++i) {
+        m_table[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+std::size_t LastValueCache::slotFor(const std::string& symbol) const {
+    return std::hash<std::string>{}(symbol) & m_table_mask;
+}
+
+std::size_t LastValueCache::find(const std::string& symbol) const {
+    for (std::size_t slot = slotFor(symbol);; slot = (slot + 1) & m_table_mask) {
+        std::uint32_t entry = m_table[slot].load(std::memory_order_acquire);
+        if (entry == 0) {
+            return NOT_FOUND;
+        }
+        if (m_entries[entry - 1].symbol == symbol) {
+            return entry - 1;
+        }
+    }
+}
+
+std::size_t LastValueCache::index(const std::string& symbol) {
+    std::size_t found = find(symbol);
+    if (found != NOT_FOUND) {
+        return found;
+    }
+    if (symbol.empty()) {
+        throw std::invalid_argument("Last value cache requires a symbol");
+    }
+
+    std::lock_guard<std::mutex> lock(m_claim_mutex);
+    std::size_t slot = slotFor(symbol);
+    for (;; slot = (slot + 1) & m_table_mask) {
+        std::uint32_t entry = m_table[slot].load(std::memory_order_relaxed);
+        if (entry == 0) {
+            break;
+        }
+        if (m_entries[entry - 1].symbol == symbol) {
+            return entry - 1;  // Claimed by another writer meanwhile
+        }
+    }
+    std::size_t claimed = m_count.load(std::memory_order_relaxed);
+    if (claimed == m_max_symbols) {
+        throw std::runtime_error("Last value cache is full");
+    }
+    m_entries[claimed].symbol = symbol;
+    m_table[slot].store(static_cast<std::uint32_t>(claimed + 1), std::memory_order_release);
+    m_count.store(claimed + 1, std::memory_order_release);
+    return claimed;
+}
+
+template <typename Update>
+void LastValueCache::write(std::size_t index, Update&& update) {
+    Entry& entry = m_entries[index];
+    std::uint64_t version = entry.version.load(std::memory_order_relaxed);
+    entry.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    update(entry.values);
+    entry.version.store(version + 2, std::memory_order_release);
+}
+
+void LastValueCache::updateQuote(std::size_t index, double bid, double bid_size, double ask, double ask_size,
+                                 std::int64_t timestamp, std::uint64_t sequence) {
+    write(index, [&](Values& values) {
+        values.bid = bid;
+        values.bid_size = bid_size;
+        values.ask = ask;
+        values.ask_size = ask_size;
+        values.timestamp = timestamp;
+        values.sequence = sequence;
+    });
+}
+
+void LastValueCache::updateTrade(std::size_t index, double price, double quantity, std::int64_t timestamp,
+                                 std::uint64_t sequence) {
+    write(index, [&](Values& values) {
+        values.last = price;
+        values.last_size = quantity;
+        values.volume += quantity;
+        ++values.trades;
+        values.timestamp = timestamp;
+        values.sequence = sequence;
+    });
+}
+
+void LastValueCache::set(std::size_t index, const Values& values) {
+    write(index, [&](Values& current) { current = values; });
+}
+
+bool LastValueCache::read(std::size_t index, Values& out) const {
+    if (index >= m_count.load(std::memory_order_acquire)) {
+        return false;
+    }
+    const Entry& entry = m_entries[index];
+    for (;;) {
+        std::uint64_t before = entry.version.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if (before & 1) {
+            continue;  // The writer holds it for a handful of stores
+        }
+        Values copy = entry.values;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.version.load(std::memory_order_relaxed) == before) {
+            out = copy;
+            return true;
+        }
+    }
+}
+
+bool LastValueCache::read(const std::string& symbol, Values& out) const {
+    std::size_t found = find(symbol);
+    return found != NOT_FOUND && read(found, out);
+}
+
+std::vector<std::string> LastValueCache::symbols() const {
+    std::size_t count = m_count.load(std::memory_order_acquire);
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(m_entries[i].symbol);
+    }
+    return result;
+}
+
+}}} // namespaces
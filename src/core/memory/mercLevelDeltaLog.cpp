@@ -0,0 +1,57 @@
+#include "../../../include/mercuryTrade/core/memory/mercLevelDeltaLog.hpp"
+#include <stdexcept>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+LevelDeltaLog::LevelDeltaLog(std::size_t capacity)
+    : m_ring(capacity)
+{
+    if (capacity == 0) {
+        throw std::invalid_argument("Delta log capacity must be positive");
+    }
+}
+
+void LevelDeltaLog::append(const LevelDelta& delta) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ring[m_head] = delta;
+    m_head = (m_head + 1) % m_ring.size();
+    if (m_count < m_ring.size()) {
+        ++m_count;
+    }
+}
+
+bool LevelDeltaLog::since(std::uint64_t after_seq, std::vector<LevelDelta>& out) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_count == 0) {
+        return after_seq == 0;
+    }
+
+    std::size_t oldest = (m_head + m_ring.size() - m_count) % m_ring.size();
+    std::uint64_t first_seq = m_ring[oldest].seq;
+    std::uint64_t last_seq = m_ring[(m_head + m_ring.size() - 1) % m_ring.size()].seq;
+    if (after_seq + 1 < first_seq || after_seq > last_seq) {
+        return false;
+    }
+
+    // Sequences are contiguous, so the start position is a direct offset
+    std::size_t skip = static_cast<std::size_t>(after_seq + 1 - first_seq);
+    out.reserve(out.size() + m_count - skip);
+    for (std::size_t i = skip; i < m_count; ++i) {
+        out.push_back(m_ring[(oldest + i) % m_ring.size()]);
+    }
+    return true;
+}
+
+std::uint64_t LevelDeltaLog::lastSequence() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_count == 0 ? 0 : m_ring[(m_head + m_ring.size() - 1) % m_ring.size()].seq;
+}
+
+std::size_t LevelDeltaLog::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_count;
+}
+
+}}} // namespaces
@@ -0,0 +1,492 @@
+#include "../../../include/mercuryTrade/core/memory/mercLimitOrderBook.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercSnapshotFile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+namespace {
+    // Quantities below this are treated as fully filled
+    constexpr double QUANTITY_EPSILON = 1e-9;
+}
+
+LimitOrderBook::LimitOrderBook(std::string symbol, OrderBookAllocator& allocator)
+    : m_symbol(std::move(symbol))
+    , m_allocator(allocator)
+{
+    if (m_symbol.empty()) {
+        throw std::invalid_argument("Order book requires a symbol");
+    }
+    m_root = m_allocator.bookRoot(m_symbol);
+    if (m_root) {
+        resumeFromRoot();
+    }
+}
+
+LimitOrderBook::~LimitOrderBook() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_root) {
+        return;
+    }
+    // Releasing a level also releases every order still queued on it
+    for (auto& entry : m_bids) {
+        m_allocator.deallocatePriceLevel(entry.second);
+    }
+    for (auto& entry : m_asks) {
+        m_allocator.deallocatePriceLevel(entry.second);
+    }
+}
+
+void LimitOrderBook::resumeFromRoot() {
+    // The level chains are all that is needed to rebuild the price index
+    for (PriceLevel* level = m_root->best_bid; level; level = level->next) {
+        m_bids.emplace_hint(m_bids.end(), level->price, level);
+    }
+    for (PriceLevel* level = m_root->best_ask; level; level = level->next) {
+        m_asks.emplace_hint(m_asks.end(), level->price, level);
+    }
+    m_sequence.store(m_root->sequence, std::memory_order_release);
+    m_next_trade_id = m_root->next_trade_id;
+    m_fill_count = m_root->fill_count;
+    m_resting_orders = m_root->resting_orders;
+}
+
+LimitOrderBook::WriteScope::WriteScope(LimitOrderBook& book)
+    : m_book(book) {
+    if (m_book.m_root) {
+        m_book.m_root->version.fetch_add(1, std::memory_order_relaxed);  // Odd: changing
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+}
+
+LimitOrderBook::WriteScope::~WriteScope() {
+    LimitOrderBook& book = m_book;
+    PriceLevel* bid = book.m_bids.empty() ? nullptr : book.m_bids.begin()->second;
+    PriceLevel* ask = book.m_asks.empty() ? nullptr : book.m_asks.begin()->second;
+
+    if (BookRoot* root = book.m_root) {
+        root->best_bid = bid;
+        root->best_ask = ask;
+        root->sequence = book.m_sequence.load(std::memory_order_relaxed);
+        root->next_trade_id = book.m_next_trade_id;
+        root->fill_count = book.m_fill_count;
+        root->resting_orders = book.m_resting_orders;
+        root->version.fetch_add(1, std::memory_order_release);  // Even: consistent again
+    }
+
+    if (book.m_top_listener) {
+        BookTop top{book.m_sequence.load(std::memory_order_relaxed),
+                    bid ? bid->price : 0.0, bid ? std::max(bid->total_quantity, 0.0) : 0.0,
+                    ask ? ask->price : 0.0, ask ? std::max(ask->total_quantity, 0.0) : 0.0};
+        if (top.bid != book.m_top.bid || top.bid_size != book.m_top.bid_size ||
+            top.ask != book.m_top.ask || top.ask_size != book.m_top.ask_size) {
+            book.m_top = top;
+            book.m_top_listener(top);
+        }
+    }
+}
+
+LimitOrderBook::Result LimitOrderBook::addOrder(const std::string& order_id, BookSide side, double price,
+                                                double quantity, bool market) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteScope write(*this);
+    return addLocked(order_id, side, price, quantity, market);
+}
+
+std::vector<LimitOrderBook::Result> LimitOrderBook::addOrders(const std::vector<BatchOrder>& orders) {
+    std::vector<Result> results;
+    results.reserve(orders.size());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteScope write(*this);
+    for (const auto& order : orders) {
+        results.push_back(addLocked(order.order_id, order.side, order.price, order.quantity, order.market));
+    }
+    return results;
+}
+
+LimitOrderBook::Result LimitOrderBook::addLocked(const std::string& order_id, BookSide side, double price,
+                                                 double quantity, bool market) {
+    if (order_id.empty() || order_id.size() > m_allocator.maxOrderIdLength() ||
+        quantity <= QUANTITY_EPSILON || (!market && price <= 0.0)) {
+        return Result{false, 0.0, 0.0};
+    }
+    if (m_allocator.findOrder(order_id)) {
+        return Result{false, 0.0, 0.0};  // Duplicate id
+    }
+
+    double filled = side == BookSide::BID
+        ? matchAgainst(m_asks, BookSide::ASK, order_id, side, price, quantity, market)
+        : matchAgainst(m_bids, BookSide::BID, order_id, side, price, quantity, market);
+
+    double remaining = quantity - filled;
+    if (market || remaining <= QUANTITY_EPSILON) {
+        return Result{filled > 0.0, filled, 0.0};
+    }
+
+    bool rested = side == BookSide::BID
+        ? rest(m_bids, side, order_id, price, remaining)
+        : rest(m_asks, side, order_id, price, remaining);
+
+    // Out of pool capacity: keep any fills, drop the remainder
+    return Result{rested || filled > 0.0, filled, rested ? remaining : 0.0};
+}
+
+bool LimitOrderBook::cancelOrder(const std::string& order_id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteScope write(*this);
+    return cancelLocked(order_id);
+}
+
+std::vector<bool> LimitOrderBook::cancelOrders(const std::vector<std::string>& order_ids) {
+    std::vector<bool> results;
+    results.reserve(order_ids.size());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteScope write(*this);
+    for (const auto& order_id : order_ids) {
+        results.push_back(cancelLocked(order_id));
+    }
+    return results;
+}
+
+std::vector<std::string> LimitOrderBook::cancelAll() {
+    std::vector<std::string> cancelled;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteScope write(*this);
+    cancelled.reserve(m_resting_orders);
+    clearSide(m_bids, BookSide::BID, cancelled);
+    clearSide(m_asks, BookSide::ASK, cancelled);
+    return cancelled;
+}
+
+template <typename Levels>
+void LimitOrderBook::clearSide(Levels& levels, BookSide side, std::vector<std::string>& cancelled) {
+    for (auto& entry : levels) {
+        PriceLevel* level = entry.second;
+        while (OrderNode* order = level->first_order) {
+            cancelled.push_back(order->order_id);
+            m_allocator.deallocateOrder(order);
+            --m_resting_orders;
+        }
+        level->total_quantity = 0.0;
+        emitDelta(side, *level);
+        m_allocator.deallocatePriceLevel(level);
+    }
+    levels.clear();
+}
+
+bool LimitOrderBook::reduceOrder(const std::string& order_id, double new_quantity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteScope write(*this);
+    if (new_quantity <= QUANTITY_EPSILON) {
+        return cancelLocked(order_id);
+    }
+
+    OrderNode* order = m_allocator.findOrder(order_id);
+    BookSide side;
+    if (!order || !order->parent_level || !findSide(order->parent_level, side)) {
+        return false;
+    }
+    if (new_quantity >= order->quantity) {
+        return false;  // Increases must re-enter the queue as a new order
+    }
+
+    PriceLevel* level = order->parent_level;
+    level->total_quantity -= order->quantity - new_quantity;
+    order->quantity = new_quantity;
+    emitDelta(side, *level);
+    return true;
+}
+
+bool LimitOrderBook::cancelLocked(const std::string& order_id) {
+    OrderNode* order = m_allocator.findOrder(order_id);
+    BookSide side;
+    if (!order || !order->parent_level || !findSide(order->parent_level, side)) {
+        return false;
+    }
+
+    PriceLevel* level = order->parent_level;
+    m_allocator.deallocateOrder(order);  // Unlinks and adjusts the level totals
+    --m_resting_orders;
+
+    if (level->order_count == 0) {
+        level->total_quantity = 0.0;
+        emitDelta(side, *level);
+        if (side == BookSide::BID) {
+            removeLevel(m_bids, level);
+        } else {
+            removeLevel(m_asks, level);
+        }
+    } else {
+        emitDelta(side, *level);
+    }
+    return true;
+}
+
+template <typename Levels>
+double LimitOrderBook::matchAgainst(Levels& levels, BookSide maker_side, const std::string& taker_id,
+                                    BookSide taker_side, double limit, double quantity, bool market) {
+    double filled = 0.0;
+
+    while (quantity - filled > QUANTITY_EPSILON && !levels.empty()) {
+        PriceLevel* level = levels.begin()->second;
+        // The map orders levels best-first, so its comparator also tells
+        // whether the limit is worse than the best resting price
+        if (!market && levels.key_comp()(limit, level->price)) {
+            break;
+        }
+
+        while (level->first_order && quantity - filled > QUANTITY_EPSILON) {
+            OrderNode* maker = level->first_order;
+            double traded = std::min(maker->quantity, quantity - filled);
+            maker->quantity -= traded;
+            level->total_quantity -= traded;
+            filled += traded;
+
+            ++m_fill_count;
+            std::uint64_t trade_id = m_next_trade_id++;
+            if (m_fill_listener) {
+                m_fill_listener(BookFill{trade_id, maker->order_id, taker_id, taker_side, level->price, traded});
+            }
+
+            if (maker->quantity <= QUANTITY_EPSILON) {
+                maker->quantity = 0.0;
+                m_allocator.deallocateOrder(maker);
+                --m_resting_orders;
+            }
+        }
+
+        if (level->order_count == 0) {
+            level->total_quantity = 0.0;
+            emitDelta(maker_side, *level);
+            removeLevel(levels, level);
+        } else {
+            emitDelta(maker_side, *level);
+        }
+    }
+
+    return filled;
+}
+
+template <typename Levels>
+bool LimitOrderBook::rest(Levels& levels, BookSide side, const std::string& order_id, double price,
+                          double quantity, bool emit) {
+    OrderNode* order = m_allocator.allocateOrder();
+    if (!order) {
+        return false;
+    }
+
+    PriceLevel* level;
+    auto it = levels.find(price);
+    if (it != levels.end()) {
+        level = it->second;
+    } else {
+        level = m_allocator.allocatePriceLevel();
+        if (!level) {
+            m_allocator.deallocateOrder(order);
+            return false;
+        }
+        level->price = price;
+        it = levels.emplace(price, level).first;
+
+        // Splice into the best-to-worst chain next to its map neighbours
+        if (it != levels.begin()) {
+            PriceLevel* better = std::prev(it)->second;
+            level->prev = better;
+            better->next = level;
+        }
+        auto after = std::next(it);
+        if (after != levels.end()) {
+            level->next = after->second;
+            after->second->prev = level;
+        }
+    }
+
+    order->price = price;
+    order->quantity = quantity;
+    order->parent_level = level;
+    order->prev = level->last_order;
+    if (level->last_order) {
+        level->last_order->next = order;
+    } else {
+        level->first_order = order;
+    }
+    level->last_order = order;
+    level->order_count++;
+    level->total_quantity += quantity;
+
+    m_allocator.registerOrder(order_id, order);
+    ++m_resting_orders;
+    if (emit) {
+        emitDelta(side, *level);
+    }
+    return true;
+}
+
+template <typename Levels>
+void LimitOrderBook::removeLevel(Levels& levels, PriceLevel* level) {
+    if (level->prev) {
+        level->prev->next = level->next;
+    }
+    if (level->next) {
+        level->next->prev = level->prev;
+    }
+    levels.erase(level->price);
+    m_allocator.deallocatePriceLevel(level);
+}
+
+bool LimitOrderBook::findSide(const PriceLevel* level, BookSide& side) const {
+    // The allocator may be shared between books, so make sure the level is ours
+    auto bid = m_bids.find(level->price);
+    if (bid != m_bids.end() && bid->second == level) {
+        side = BookSide::BID;
+        return true;
+    }
+    auto ask = m_asks.find(level->price);
+    if (ask != m_asks.end() && ask->second == level) {
+        side = BookSide::ASK;
+        return true;
+    }
+    return false;
+}
+
+void LimitOrderBook::emitDelta(BookSide side, const PriceLevel& level) {
+    std::uint64_t seq = m_sequence.load(std::memory_order_relaxed) + 1;
+    m_sequence.store(seq, std::memory_order_release);
+    if (m_delta_listener) {
+        m_delta_listener(LevelDelta{seq, side, level.price, std::max(level.total_quantity, 0.0), level.order_count});
+    }
+}
+
+BookSnapshot LimitOrderBook::snapshot(std::size_t depth, double bucket) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    BookSnapshot result{m_symbol, m_sequence.load(std::memory_order_relaxed), {}, {}};
+    result.bids.reserve(std::min(depth, m_bids.size()));
+    result.asks.reserve(std::min(depth, m_asks.size()));
+
+    collectLevels(m_bids.empty() ? nullptr : m_bids.begin()->second, depth, bucket, true, result.bids);
+    collectLevels(m_asks.empty() ? nullptr : m_asks.begin()->second, depth, bucket, false, result.asks);
+    return result;
+}
+
+void LimitOrderBook::collectLevels(const PriceLevel* level, std::size_t depth, double bucket, bool round_down,
+                                   std::vector<BookLevel>& out) {
+    for (; level; level = level->next) {
+        double price = level->price;
+        if (bucket > 0.0) {
+            // The epsilon keeps prices that are exact multiples in their own bucket
+            price = round_down ? std::floor(price / bucket + 1e-9) * bucket
+                               : std::ceil(price / bucket - 1e-9) * bucket;
+        }
+
+        if (!out.empty() && out.back().price == price) {
+            out.back().size += level->total_quantity;
+            out.back().order_count += level->order_count;
+            continue;
+        }
+        // Stop at the first level beyond the last bucket, so that bucket is complete
+        if (out.size() == depth) {
+            break;
+        }
+        out.push_back(BookLevel{price, level->total_quantity, level->order_count});
+    }
+}
+
+double LimitOrderBook::bestBid() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bids.empty() ? 0.0 : m_bids.begin()->first;
+}
+
+double LimitOrderBook::bestAsk() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_asks.empty() ? 0.0 : m_asks.begin()->first;
+}
+
+LimitOrderBook::Stats LimitOrderBook::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return Stats{
+        m_bids.size(),
+        m_asks.size(),
+        m_resting_orders,
+        m_sequence.load(std::memory_order_relaxed),
+        m_fill_count
+    };
+}
+
+void LimitOrderBook::saveState(SnapshotWriter& out) const {
+    out.putU64(m_sequence.load(std::memory_order_relaxed));
+    out.putU64(m_next_trade_id);
+    out.putU64(m_fill_count);
+    out.putU64(m_resting_orders);
+    saveSide(m_bids, out);
+    saveSide(m_asks, out);
+}
+
+template <typename Levels>
+void LimitOrderBook::saveSide(const Levels& levels, SnapshotWriter& out) const {
+    out.putU64(levels.size());
+    for (const auto& entry : levels) {
+        const PriceLevel* level = entry.second;
+        out.putDouble(level->price);
+        out.putU64(level->order_count);
+        for (const OrderNode* order = level->first_order; order; order = order->next) {
+            out.putString(order->order_id);
+            out.putDouble(order->quantity);
+        }
+    }
+}
+
+void LimitOrderBook::loadState(SnapshotReader& in) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    WriteScope write(*this);
+    if (m_resting_orders != 0 || !m_bids.empty() || !m_asks.empty()) {
+        throw std::logic_error("Order book state can only be loaded into an empty book");
+    }
+
+    std::uint64_t sequence = in.getU64();
+    m_next_trade_id = in.getU64();
+    m_fill_count = in.getU64();
+    m_allocator.reserveOrders(in.getU64());
+    loadSide(m_bids, BookSide::BID, in);
+    loadSide(m_asks, BookSide::ASK, in);
+    m_sequence.store(sequence, std::memory_order_release);
+}
+
+template <typename Levels>
+void LimitOrderBook::loadSide(Levels& levels, BookSide side, SnapshotReader& in) {
+    std::uint64_t level_count = in.getU64();
+    for (std::uint64_t i = 0; i < level_count; ++i) {
+        double price = in.getDouble();
+        std::uint64_t order_count = in.getU64();
+        for (std::uint64_t k = 0; k < order_count; ++k) {
+            std::string order_id = in.getString();
+            double quantity = in.getDouble();
+            if (!rest(levels, side, order_id, price, quantity, false)) {
+                throw std::runtime_error("Order book pools exhausted while loading " + m_symbol);
+            }
+        }
+    }
+}
+
+void LimitOrderBook::setDeltaListener(DeltaListener listener) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_delta_listener = std::move(listener);
+}
+
+void LimitOrderBook::setFillListener(FillListener listener) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fill_listener = std::move(listener);
+}
+
+void LimitOrderBook::setTopListener(TopListener listener) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_top_listener = std::move(listener);
+}
+
+}}} // namespaces
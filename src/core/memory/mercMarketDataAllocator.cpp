@@ -1,6 +1,6 @@
 #include "../../../include/mercuryTrade/core/memory/mercMarketDataAllocator.hpp"
-#include <stdexcept>
-#include <cstdlib> // For malloc/free as backup if needed
+#include <cstring>
+#include <new>
 
 using namespace std::string_literals;
 
@@ -8,73 +8,263 @@ namespace mercuryTrade {
     namespace core {
         namespace memory {
 
+            namespace {
+                constexpr std::size_t SLOT_HEADER = sizeof(std::atomic<std::uint64_t>);
+                constexpr std::size_t CACHE_LINE = 64;
+
+                // Slots start on a cache line so a reader copying one record
+                // does not share a line with the writer filling the next
+                std::size_t slotStride(std::size_t payload) {
+                    return (SLOT_HEADER + payload + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+                }
+
+                // Holds the 1-based record number stored in the slot, 0 while it is written
+                std::atomic<std::uint64_t>& slotNumber(char* slot) {
+                    return *reinterpret_cast<std::atomic<std::uint64_t>*>(slot);
+                }
+            }
+
             marketDataAllocator::marketDataAllocator(const bufferConfig &config) : m_config(config) {
-                if (config.quote_size == 0 || config.trade_size == 0 || config.snapshot_size == 0 || config.buffer_capacity == 0) {
+                if (config.quote_size == 0 || config.trade_size == 0 || config.snapshot_size == 0 ||
+                    config.buffer_capacity == 0 || config.max_symbols == 0) {
                     throw std::runtime_error("Invalid buffer configuration"s);
                 }
+                m_payloads[static_cast<std::size_t>(Channel::QUOTE)] = config.quote_size;
+                m_payloads[static_cast<std::size_t>(Channel::TRADE)] = config.trade_size;
+                m_payloads[static_cast<std::size_t>(Channel::SNAPSHOT)] = config.snapshot_size;
+                for (std::size_t channel = 0; channel < CHANNELS; ++channel) {
+                    m_strides[channel] = slotStride(m_payloads[channel]);
+                }
+
+                m_symbols = std::make_unique<SymbolRings[]>(config.max_symbols);
+                for (std::size_t symbol = 0; symbol < config.max_symbols; ++symbol) {
+                    for (auto& ring : m_symbols[symbol].rings) {
+                        for (auto& reader : ring.readers) {
+                            reader.store(FREE_READER, std::memory_order_relaxed);
+                        }
+                    }
+                }
             }
 
-            void* marketDataAllocator::allocateQuoteBuffer() {
-                void* buffer = m_allocator.allocate(m_config.quote_size * m_config.buffer_capacity);
-                if (buffer) {
-                    m_quotes_allocated.fetch_add(1, std::memory_order_relaxed);
+            marketDataAllocator::~marketDataAllocator() {
+                std::size_t count = m_symbol_count.load(std::memory_order_acquire);
+                for (std::size_t symbol = 0; symbol < count; ++symbol) {
+                    ::operator delete[](m_symbols[symbol].memory, std::align_val_t(CACHE_LINE));
                 }
-                return buffer;
             }
 
-            void* marketDataAllocator::allocateTradeBuffer() {
-                void* buffer = m_allocator.allocate(m_config.trade_size * m_config.buffer_capacity);
-                if (buffer) {
-                    m_trades_allocated.fetch_add(1, std::memory_order_relaxed);
+            std::size_t marketDataAllocator::symbolIndex(const std::string& symbol) {
+                std::lock_guard<std::mutex> lock(m_claim_mutex);
+                auto found = m_symbol_index.find(symbol);
+                if (found != m_symbol_index.end()) {
+                    return found->second;
+                }
+                std::size_t claimed = m_symbol_count.load(std::memory_order_relaxed);
+                if (claimed == m_config.max_symbols) {
+                    throw std::runtime_error("Market data rings exhausted for "s + symbol);
+                }
+
+                // All three rings share one allocation, zeroed so every slot
+                // starts out holding no record
+                std::size_t bytes = 0;
+                for (std::size_t channel = 0; channel < CHANNELS; ++channel) {
+                    bytes += m_strides[channel] * m_config.buffer_capacity;
                 }
-                return buffer;
+                char* memory = static_cast<char*>(::operator new[](bytes, std::align_val_t(CACHE_LINE)));
+                std::memset(memory, 0, bytes);
+
+                SymbolRings& entry = m_symbols[claimed];
+                entry.symbol = symbol;
+                entry.memory = memory;
+                for (std::size_t channel = 0; channel < CHANNELS; ++channel) {
+                    entry.rings[channel].slots = memory;
+                    entry.rings[channel].stride = m_strides[channel];
+                    entry.rings[channel].payload = m_payloads[channel];
+                    memory += m_strides[channel] * m_config.buffer_capacity;
+                }
+                m_symbol_index.emplace(symbol, claimed);
+                m_symbol_count.store(claimed + 1, std::memory_order_release);
+                return claimed;
+            }
+
+            std::size_t marketDataAllocator::findSymbol(const std::string& symbol) const {
+                std::lock_guard<std::mutex> lock(m_claim_mutex);
+                auto found = m_symbol_index.find(symbol);
+                return found == m_symbol_index.end() ? NOT_FOUND : found->second;
             }
 
-            void* marketDataAllocator::allocateSnapshotBuffer() {
-                void* buffer = m_allocator.allocate(m_config.snapshot_size * m_config.buffer_capacity);
-                if (buffer) {
-                    m_snapshots_allocated.fetch_add(1, std::memory_order_relaxed);
+            const std::string& marketDataAllocator::symbolName(std::size_t symbol) const {
+                if (symbol >= m_symbol_count.load(std::memory_order_acquire)) {
+                    throw std::out_of_range("Unknown market data symbol index"s);
                 }
-                return buffer;
+                return m_symbols[symbol].symbol;
             }
 
-            void marketDataAllocator::deallocateBuffer(void* ptr, std::size_t size) {
-                if (!ptr) return;
+            marketDataAllocator::Ring& marketDataAllocator::ring(std::size_t symbol, Channel channel) const {
+                if (symbol >= m_symbol_count.load(std::memory_order_acquire)) {
+                    throw std::out_of_range("Unknown market data symbol index"s);
+                }
+                return m_symbols[symbol].rings[static_cast<std::size_t>(channel)];
+            }
 
-                if (size == m_config.quote_size * m_config.buffer_capacity) {
-                    m_quotes_allocated.fetch_sub(1, std::memory_order_relaxed);
-                } else if (size == m_config.trade_size * m_config.buffer_capacity) {
-                    m_trades_allocated.fetch_sub(1, std::memory_order_relaxed);
-                } else if (size == m_config.snapshot_size * m_config.buffer_capacity) {
-                    m_snapshots_allocated.fetch_sub(1, std::memory_order_relaxed);
-                } else {
-                    throw std::runtime_error("Invalid buffer size for deallocation"s);
+            void marketDataAllocator::publishBytes(std::size_t symbol, Channel channel, const void* record,
+                                                   std::size_t size) {
+                Ring& target = ring(symbol, channel);
+                if (size > target.payload) {
+                    throw std::invalid_argument("Record larger than the market data slot"s);
                 }
+                std::uint64_t number = target.written.load(std::memory_order_relaxed);
+                char* slot = target.slots + (number % m_config.buffer_capacity) * target.stride;
+                slotNumber(slot).store(0, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                std::memcpy(slot + SLOT_HEADER, record, size);
+                slotNumber(slot).store(number + 1, std::memory_order_release);
+                target.written.store(number + 1, std::memory_order_release);
+            }
 
-                m_allocator.deallocate(ptr, size);
+            marketDataAllocator::Cursor marketDataAllocator::subscribe(std::size_t symbol, Channel channel,
+                                                                       bool from_oldest) const {
+                Ring& target = ring(symbol, channel);
+                std::uint64_t written = target.written.load(std::memory_order_acquire);
+                std::uint64_t start = written;
+                if (from_oldest) {
+                    start = written > m_config.buffer_capacity ? written - m_config.buffer_capacity : 0;
+                }
+                for (auto& reader : target.readers) {
+                    std::uint64_t expected = FREE_READER;
+                    if (reader.compare_exchange_strong(expected, start, std::memory_order_acq_rel)) {
+                        Cursor cursor;
+                        cursor.m_ring = &target;
+                        cursor.m_registration = &reader;
+                        cursor.m_next = start;
+                        return cursor;
+                    }
+                }
+                throw std::runtime_error("Too many market data cursors on one ring"s);
+            }
+
+            bool marketDataAllocator::readBytes(Cursor& cursor, void* out, std::size_t size,
+                                                std::uint64_t* missed) const {
+                if (!cursor.m_ring) {
+                    throw std::invalid_argument("Market data cursor is not subscribed"s);
+                }
+                const Ring& source = *cursor.m_ring;
+                if (size > source.payload) {
+                    throw std::invalid_argument("Record larger than the market data slot"s);
+                }
+                const std::uint64_t capacity = m_config.buffer_capacity;
+                for (;;) {
+                    std::uint64_t written = source.written.load(std::memory_order_acquire);
+                    if (cursor.m_next >= written) {
+                        return false;
+                    }
+                    if (written - cursor.m_next > capacity) {
+                        if (missed) {
+                            *missed += written - capacity - cursor.m_next;
+                        }
+                        cursor.m_next = written - capacity;
+                    }
+
+                    char* slot = source.slots + (cursor.m_next % capacity) * source.stride;
+                    bool copied = false;
+                    if (slotNumber(slot).load(std::memory_order_acquire) == cursor.m_next + 1) {
+                        std::memcpy(out, slot + SLOT_HEADER, size);
+                        std::atomic_thread_fence(std::memory_order_acquire);
+                        copied = slotNumber(slot).load(std::memory_order_relaxed) == cursor.m_next + 1;
+                    }
+                    if (!copied && missed) {
+                        ++*missed;  // Overwritten while we looked
+                    }
+                    ++cursor.m_next;
+                    cursor.m_registration->store(cursor.m_next, std::memory_order_relaxed);
+                    if (copied) {
+                        return true;
+                    }
+                }
+            }
+
+            std::uint64_t marketDataAllocator::written(std::size_t symbol, Channel channel) const {
+                return ring(symbol, channel).written.load(std::memory_order_acquire);
+            }
+
+            std::size_t marketDataAllocator::occupancy(std::size_t symbol, Channel channel) const {
+                const Ring& target = ring(symbol, channel);
+                std::uint64_t written = target.written.load(std::memory_order_acquire);
+                std::uint64_t slowest = FREE_READER;
+                for (const auto& reader : target.readers) {
+                    std::uint64_t position = reader.load(std::memory_order_relaxed);
+                    if (position < slowest) {
+                        slowest = position;
+                    }
+                }
+                if (slowest == FREE_READER || slowest >= written) {
+                    return 0;
+                }
+                std::uint64_t unread = written - slowest;
+                return static_cast<std::size_t>(unread < m_config.buffer_capacity ? unread : m_config.buffer_capacity);
             }
 
             bool marketDataAllocator::hasCapacity() const noexcept {
-                auto stats = getStats();
-                return (stats.quotes_allocated < m_config.buffer_capacity &&
-                        stats.trades_allocated < m_config.buffer_capacity &&
-                        stats.snapshots_allocated < m_config.buffer_capacity);
+                std::size_t count = m_symbol_count.load(std::memory_order_acquire);
+                for (std::size_t symbol = 0; symbol < count; ++symbol) {
+                    for (std::size_t channel = 0; channel < CHANNELS; ++channel) {
+                        if (occupancy(symbol, static_cast<Channel>(channel)) >= m_config.buffer_capacity) {
+                            return false;
+                        }
+                    }
+                }
+                return true;
             }
 
             marketDataAllocator::allocationStats marketDataAllocator::getStats() const {
-                allocationStats stats;
-                stats.quotes_allocated = m_quotes_allocated.load(std::memory_order_relaxed);
-                stats.trades_allocated = m_trades_allocated.load(std::memory_order_relaxed);
-                stats.snapshots_allocated = m_snapshots_allocated.load(std::memory_order_relaxed);
+                allocationStats stats{};
+                stats.symbols = m_symbol_count.load(std::memory_order_acquire);
+                for (std::size_t symbol = 0; symbol < stats.symbols; ++symbol) {
+                    const SymbolRings& entry = m_symbols[symbol];
+                    stats.quotes_written += entry.rings[static_cast<std::size_t>(Channel::QUOTE)].written.load(std::memory_order_relaxed);
+                    stats.trades_written += entry.rings[static_cast<std::size_t>(Channel::TRADE)].written.load(std::memory_order_relaxed);
+                    stats.snapshots_written += entry.rings[static_cast<std::size_t>(Channel::SNAPSHOT)].written.load(std::memory_order_relaxed);
+                }
+                std::size_t bytes_per_symbol = 0;
+                for (std::size_t channel = 0; channel < CHANNELS; ++channel) {
+                    bytes_per_symbol += m_strides[channel] * m_config.buffer_capacity;
+                }
+                stats.total_memory_used = stats.symbols * bytes_per_symbol;
+                return stats;
+            }
 
-                stats.total_memory_used = (stats.quotes_allocated * m_config.quote_size * m_config.buffer_capacity) + 
-                                          (stats.trades_allocated * m_config.trade_size * m_config.buffer_capacity) + 
-                                          (stats.snapshots_allocated * m_config.snapshot_size * m_config.buffer_capacity);
+            marketDataAllocator::Cursor::~Cursor() {
+                release();
+            }
 
-                return stats;
+            marketDataAllocator::Cursor::Cursor(Cursor&& other) noexcept
+                : m_ring(other.m_ring)
+                , m_registration(other.m_registration)
+                , m_next(other.m_next) {
+                other.m_ring = nullptr;
+                other.m_registration = nullptr;
+            }
+
+            marketDataAllocator::Cursor& marketDataAllocator::Cursor::operator = (Cursor&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    m_ring = other.m_ring;
+                    m_registration = other.m_registration;
+                    m_next = other.m_next;
+                    other.m_ring = nullptr;
+                    other.m_registration = nullptr;
+                }
+                return *this;
+            }
+
+            void marketDataAllocator::Cursor::release() {
+                if (m_registration) {
+                    m_registration->store(FREE_READER, std::memory_order_release);
+                }
+                m_ring = nullptr;
+                m_registration = nullptr;
             }
 
         }
     }
 }
-
@@ -0,0 +1,132 @@
+#include "../../../include/mercuryTrade/core/memory/mercMarketDataBus.hpp"
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+namespace {
+
+std::size_t align(std::size_t bytes) {
+    return (bytes + 63) & ~std::size_t{63};
+}
+
+std::size_t roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+std::size_t MarketDataBus::channelStride(std::size_t trade_capacity) {
+    return align(sizeof(BusChannel) + sizeof(BusTradeSlot) * trade_capacity);
+}
+
+std::size_t MarketDataBus::segmentSize(std::size_t max_symbols, std::size_t trade_capacity) {
+    return align(sizeof(MarketDataBusHeader)) + channelStride(trade_capacity) * max_symbols;
+}
+
+MarketDataBus::MarketDataBus(const Config& config)
+    : m_config(config) {
+    if (m_config.name.size() < 2 || m_config.name[0] != '/' || m_config.name.find('/', 1) != std::string::npos) {
+        throw std::invalid_argument("Market data bus name must be a single '/'-prefixed component");
+    }
+    if (m_config.max_symbols == 0 || m_config.trade_capacity == 0 ||
+        m_config.max_symbols > UINT32_MAX || m_config.trade_capacity > (std::size_t{1} << 31)) {
+        throw std::invalid_argument("Invalid market data bus configuration");
+    }
+    m_config.trade_capacity = roundUpToPowerOfTwo(m_config.trade_capacity);
+    m_size = segmentSize(m_config.max_symbols, m_config.trade_capacity);
+
+    // Readers still mapping a stale segment keep it; they see it is not live
+    ::shm_unlink(m_config.name.c_str());
+    int fd = ::shm_open(m_config.name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create market data bus " + m_config.name + ": " + std::strerror(errno));
+    }
+    if (::ftruncate(fd, static_cast<off_t>(m_size)) != 0) {
+        int error = errno;
+        ::close(fd);
+        ::shm_unlink(m_config.name.c_str());
+        throw std::runtime_error("Cannot size market data bus " + m_config.name + ": " + std::strerror(error));
+    }
+    m_base = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (m_base == MAP_FAILED) {
+        m_base = nullptr;
+        ::shm_unlink(m_config.name.c_str());
+        throw std::runtime_error("Cannot map market data bus " + m_config.name + ": " + std::strerror(errno));
+    }
+
+    // The segment starts zeroed, so only the header needs filling in
+    m_header = new (m_base) MarketDataBusHeader();
+    m_header->version = MarketDataBusHeader::VERSION;
+    m_header->size = m_size;
+    m_header->channels_offset = align(sizeof(MarketDataBusHeader));
+    m_header->channel_stride = channelStride(m_config.trade_capacity);
+    m_header->max_symbols = static_cast<std::uint32_t>(m_config.max_symbols);
+    m_header->trade_capacity = static_cast<std::uint32_t>(m_config.trade_capacity);
+    m_header->live.store(1, std::memory_order_relaxed);
+    m_header->magic.store(MarketDataBusHeader::MAGIC, std::memory_order_release);
+}
+
+MarketDataBus::~MarketDataBus() noexcept {
+    if (!m_base) {
+        return;
+    }
+    m_header->live.store(0, std::memory_order_release);
+    ::munmap(m_base, m_size);
+    ::shm_unlink(m_config.name.c_str());
+}
+
+BusChannel* MarketDataBus::channel(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(m_channels_mutex);
+    auto it = m_channels.find(symbol);
+    if (it != m_channels.end()) {
+        return it->second;
+    }
+    if (symbol.empty() || symbol.size() >= BusChannel::SYMBOL_CAPACITY) {
+        throw std::invalid_argument("Symbol does not fit a market data bus channel: " + symbol);
+    }
+
+    std::uint32_t index = m_header->symbol_count.load(std::memory_order_relaxed);
+    if (index == m_header->max_symbols) {
+        throw std::runtime_error("Every market data bus channel is taken");
+    }
+    auto* channel = new (static_cast<char*>(m_base) + m_header->channels_offset +
+                         index * m_header->channel_stride) BusChannel();
+    std::memcpy(channel->symbol, symbol.c_str(), symbol.size() + 1);
+    m_header->symbol_count.store(index + 1, std::memory_order_release);  // Readers may now find it
+    m_channels.emplace(symbol, channel);
+    return channel;
+}
+
+void MarketDataBus::publishQuote(BusChannel* target, const BusQuote& quote) {
+    std::uint64_t version = target->quote_version.load(std::memory_order_relaxed);
+    target->quote_version.store(version + 1, std::memory_order_relaxed);  // Odd: changing
+    std::atomic_thread_fence(std::memory_order_release);
+    target->quote = quote;
+    target->quote_version.store(version + 2, std::memory_order_release);
+}
+
+void MarketDataBus::publishTrade(BusChannel* target, const BusTrade& trade) {
+    std::uint64_t number = target->trades_written.load(std::memory_order_relaxed);
+    BusTradeSlot& slot = target->slots()[number & (m_config.trade_capacity - 1)];
+    slot.number.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.trade = trade;
+    slot.number.store(number + 1, std::memory_order_release);
+    target->trades_written.store(number + 1, std::memory_order_release);
+}
+
+}}} // namespaces
@@ -0,0 +1,138 @@
+#include "../../../include/mercuryTrade/core/memory/mercMarketDataBusReader.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+MarketDataBusReader::MarketDataBusReader(const std::string& name) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open market data bus " + name + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(MarketDataBusHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Market data bus " + name + " is not ready");
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    void* base = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Cannot map market data bus " + name + ": " + std::strerror(errno));
+    }
+    m_base = static_cast<const char*>(base);
+    m_header = reinterpret_cast<const MarketDataBusHeader*>(m_base);
+
+    std::uint32_t capacity = m_header->trade_capacity;
+    if (m_header->magic.load(std::memory_order_acquire) != MarketDataBusHeader::MAGIC ||
+        m_header->version != MarketDataBusHeader::VERSION || m_header->size != m_size ||
+        capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        m_header->channel_stride != MarketDataBus::channelStride(capacity) ||
+        m_header->size != MarketDataBus::segmentSize(m_header->max_symbols, capacity)) {
+        ::munmap(base, m_size);
+        throw std::runtime_error("Market data bus " + name + " is not ready");
+    }
+}
+
+MarketDataBusReader::~MarketDataBusReader() noexcept {
+    ::munmap(const_cast<char*>(m_base), m_size);
+}
+
+bool MarketDataBusReader::live() const {
+    return m_header->live.load(std::memory_order_acquire) != 0;
+}
+
+const BusChannel* MarketDataBusReader::channelAt(std::size_t index) const {
+    return reinterpret_cast<const BusChannel*>(m_base + m_header->channels_offset +
+                                               index * m_header->channel_stride);
+}
+
+std::vector<std::string> MarketDataBusReader::symbols() const {
+    std::uint32_t count = m_header->symbol_count.load(std::memory_order_acquire);
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (std::uint32_t i = 0; i < count && i < m_header->max_symbols; ++i) {
+        const char* symbol = channelAt(i)->symbol;
+        result.emplace_back(symbol, strnlen(symbol, BusChannel::SYMBOL_CAPACITY));
+    }
+    return result;
+}
+
+std::optional<MarketDataBusReader::Subscription> MarketDataBusReader::subscribe(const std::string& symbol,
+                                                                                bool fromOldest) const {
+    std::uint32_t count = m_header->symbol_count.load(std::memory_order_acquire);
+    for (std::uint32_t i = 0; i < count && i < m_header->max_symbols; ++i) {
+        const BusChannel* channel = channelAt(i);
+        if (symbol.compare(0, std::string::npos, channel->symbol,
+                           strnlen(channel->symbol, BusChannel::SYMBOL_CAPACITY)) != 0) {
+            continue;
+        }
+        std::uint64_t capacity = m_header->trade_capacity;
+        std::uint64_t written = channel->trades_written.load(std::memory_order_acquire);
+        std::uint64_t next = written;
+        if (fromOldest) {
+            next = written > capacity ? written - capacity : 0;
+        }
+        return Subscription(channel, capacity, next);
+    }
+    return std::nullopt;
+}
+
+bool MarketDataBusReader::Subscription::quote(BusQuote& out) const {
+    // The producer holds the version odd for a single struct copy, so this
+    // only spins for long if it died mid-write
+    for (int attempt = 0; attempt < (1 << 20); ++attempt) {
+        std::uint64_t before = m_channel->quote_version.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if (before & 1) {
+            continue;
+        }
+        BusQuote copy = m_channel->quote;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_channel->quote_version.load(std::memory_order_relaxed) == before) {
+            out = copy;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MarketDataBusReader::Subscription::nextTrade(BusTrade& out) {
+    for (;;) {
+        std::uint64_t written = m_channel->trades_written.load(std::memory_order_acquire);
+        if (m_next >= written) {
+            return false;
+        }
+        if (written - m_next > m_capacity) {
+            m_missed += written - m_capacity - m_next;
+            m_next = written - m_capacity;
+        }
+
+        const BusTradeSlot& slot = m_channel->slots()[m_next & (m_capacity - 1)];
+        std::uint64_t number = slot.number.load(std::memory_order_acquire);
+        if (number == m_next + 1) {
+            BusTrade copy = slot.trade;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.number.load(std::memory_order_relaxed) == number) {
+                out = copy;
+                ++m_next;
+                return true;
+            }
+        }
+        // The slot has moved on to a later trade, so this one is gone
+        ++m_missed;
+        ++m_next;
+    }
+}
+
+}}} // namespaces
@@ -1,6 +1,16 @@
 #include "../../../include/mercuryTrade/core/memory/mercOrderBookAllocator.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
 #include <mutex>
+#include <new>
 #include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace mercuryTrade {
 namespace core {
@@ -8,14 +18,27 @@ namespace memory {
 
 OrderBookAllocator::OrderBookAllocator(const Config& config)
     : m_config(config)
+    , m_order_stride(sizeof(OrderNode) + config.order_data_size)
+    , m_order_in_use(config.max_orders, false)
 {
     if (config.max_orders == 0 || config.max_price_levels == 0) {
         throw std::invalid_argument("Invalid order book configuration");
     }
 
+    // Keep every slot aligned for OrderNode
+    m_order_stride = (m_order_stride + alignof(OrderNode) - 1) & ~(alignof(OrderNode) - 1);
+
+    if (!m_config.backing_file.empty()) {
+        // The persisted id needs a length byte and a useful number of characters
+        if (config.order_data_size < 16) {
+            throw std::invalid_argument("Persistent order pools need order_data_size of at least 16");
+        }
+        openRegion();
+        return;
+    }
+
     // Allocate order pool
-    std::size_t order_size = sizeof(OrderNode) + config.order_data_size;
-    m_order_pool = m_allocator.allocate(order_size * config.max_orders);
+    m_order_pool = m_allocator.allocate(m_order_stride * config.max_orders);
 
     // Allocate price level pool
     m_price_level_pool = m_allocator.allocate(
@@ -23,8 +46,196 @@ OrderBookAllocator::OrderBookAllocator(const Config& config)
     );
 }
 
+BookRegionHeader BookRegionHeader::layout(std::size_t max_orders, std::size_t max_price_levels,
+                                          std::size_t order_stride) {
+    auto align = [](std::size_t bytes) { return (bytes + 63) & ~std::size_t{63}; };
+
+    BookRegionHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.max_orders = max_orders;
+    header.max_price_levels = max_price_levels;
+    header.order_stride = order_stride;
+    header.roots_offset = align(sizeof(BookRegionHeader));
+    header.orders_offset = align(header.roots_offset + sizeof(BookRoot) * MAX_BOOKS);
+    header.levels_offset = align(header.orders_offset + order_stride * max_orders);
+    header.size = align(header.levels_offset + sizeof(PriceLevel) * max_price_levels);
+    return header;
+}
+
+void OrderBookAllocator::openRegion() {
+    const std::string& path = m_config.backing_file;
+    BookRegionHeader expected = BookRegionHeader::layout(m_config.max_orders, m_config.max_price_levels,
+                                                         m_order_stride);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open order book region " + path + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat order book region " + path + ": " + std::strerror(errno));
+    }
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    if (size != 0 && size != expected.size) {
+        ::close(fd);
+        throw std::runtime_error("Order book region " + path + " was created with a different configuration");
+    }
+    // A new file is extended sparse; pages are only backed once touched
+    if (size == 0 && ::ftruncate(fd, static_cast<off_t>(expected.size)) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot size order book region " + path + ": " + std::strerror(errno));
+    }
+
+    void* base = ::mmap(nullptr, expected.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Cannot map order book region " + path + ": " + std::strerror(errno));
+    }
+    m_region = base;
+    m_region_size = expected.size;
+
+    auto* header = static_cast<BookRegionHeader*>(base);
+    if (header->magic == BookRegionHeader::MAGIC) {
+        if (header->version != BookRegionHeader::VERSION || header->size != expected.size ||
+            header->order_stride != expected.order_stride || header->max_orders != expected.max_orders ||
+            header->max_price_levels != expected.max_price_levels) {
+            ::munmap(m_region, m_region_size);
+            m_region = nullptr;
+            throw std::runtime_error("Order book region " + path + " was created with a different configuration");
+        }
+    } else {
+        // Never initialized, or the process died before it was
+        std::memset(base, 0, expected.orders_offset);
+        *header = expected;
+    }
+
+    m_header = header;
+    m_order_pool = static_cast<char*>(base) + header->orders_offset;
+    m_price_level_pool = static_cast<char*>(base) + header->levels_offset;
+    try {
+        attachRegion();
+    } catch (...) {
+        ::munmap(m_region, m_region_size);
+        m_region = nullptr;
+        m_header = &m_heap_header;
+        throw;
+    }
+}
+
+void OrderBookAllocator::attachRegion() {
+    m_clean_close = m_header->clean != 0;
+    m_header->clean = 0;
+    if (m_header->order_high_water > m_config.max_orders ||
+        m_header->level_high_water > m_config.max_price_levels) {
+        throw std::runtime_error("Order book region " + m_config.backing_file + " is corrupt");
+    }
+
+    // Whatever is below the high-water mark and not on a free chain is live
+    std::vector<bool> free_orders(m_header->order_high_water, false);
+    for (std::uint64_t next = m_header->free_orders, n = 0; next != 0 && next <= free_orders.size() && n < free_orders.size(); ++n) {
+        free_orders[next - 1] = true;
+        next = *reinterpret_cast<const std::uint64_t*>(orderAt(next - 1));
+    }
+    std::vector<bool> free_levels(m_header->level_high_water, false);
+    auto* levels = static_cast<PriceLevel*>(m_price_level_pool);
+    for (std::uint64_t next = m_header->free_levels, n = 0; next != 0 && next <= free_levels.size() && n < free_levels.size(); ++n) {
+        free_levels[next - 1] = true;
+        next = *reinterpret_cast<const std::uint64_t*>(levels + next - 1);
+    }
+
+    std::size_t active_orders = 0;
+    for (std::size_t slot = 0; slot < free_orders.size(); ++slot) {
+        if (free_orders[slot]) {
+            continue;
+        }
+        // The std::string in the slot belonged to the previous process
+        OrderNode* order = orderAt(slot);
+        const auto* stored = reinterpret_cast<const unsigned char*>(order->additional_data);
+        std::size_t length = std::min<std::size_t>(stored[0], maxOrderIdLength());
+        new (&order->order_id) std::string(reinterpret_cast<const char*>(stored + 1), length);
+        if (!order->order_id.empty()) {
+            m_order_map.emplace(order->order_id, order);
+        }
+        m_order_in_use[slot] = true;
+        ++active_orders;
+    }
+    for (std::size_t slot = 0; slot < free_levels.size(); ++slot) {
+        if (!free_levels[slot]) {
+            m_allocated_price_levels.insert(levels + slot);
+        }
+    }
+
+    m_active_orders.store(active_orders);
+    m_active_price_levels.store(m_allocated_price_levels.size());
+    m_peak_orders.store(active_orders);
+    m_peak_memory.store(calculateTotalMemoryUsed());
+}
+
+void OrderBookAllocator::closeRegion() {
+    // Ids are rebuilt on reopening; release this process's copies
+    for (std::size_t slot = 0; slot < m_header->order_high_water; ++slot) {
+        if (m_order_in_use[slot]) {
+            orderAt(slot)->order_id.~basic_string();
+        }
+    }
+    m_header->clean = 1;
+    ::msync(m_region, m_region_size, MS_SYNC);
+    ::munmap(m_region, m_region_size);
+    m_region = nullptr;
+    m_header = &m_heap_header;
+    m_order_pool = nullptr;
+    m_price_level_pool = nullptr;
+}
+
+OrderNode* OrderBookAllocator::orderAt(std::size_t slot) const {
+    return reinterpret_cast<OrderNode*>(static_cast<char*>(m_order_pool) + slot * m_order_stride);
+}
+
+std::size_t OrderBookAllocator::levelSlot(const PriceLevel* level) const {
+    return static_cast<std::size_t>(level - static_cast<const PriceLevel*>(m_price_level_pool));
+}
+
+std::size_t OrderBookAllocator::maxOrderIdLength() const {
+    if (!isPersistent()) {
+        return std::string::npos;
+    }
+    return std::min<std::size_t>(m_config.order_data_size - 1, 255);
+}
+
+BookRoot* OrderBookAllocator::bookRoot(const std::string& symbol) {
+    if (!isPersistent()) {
+        return nullptr;
+    }
+    if (symbol.size() >= BookRoot::SYMBOL_CAPACITY) {
+        throw std::invalid_argument("Symbol too long for a persistent order book: " + symbol);
+    }
+
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
+    auto* roots = reinterpret_cast<BookRoot*>(static_cast<char*>(m_region) + m_header->roots_offset);
+    for (std::size_t i = 0; i < m_header->book_count; ++i) {
+        if (symbol == roots[i].symbol) {
+            return &roots[i];
+        }
+    }
+    if (m_header->book_count == BookRegionHeader::MAX_BOOKS) {
+        throw std::runtime_error("Every book root in the order book region is taken");
+    }
+
+    BookRoot* root = &roots[m_header->book_count];
+    std::memcpy(root->symbol, symbol.c_str(), symbol.size() + 1);
+    root->next_trade_id = 1;
+    ++m_header->book_count;  // Published last, so a reader never sees a half-made root
+    return root;
+}
+
 OrderBookAllocator::~OrderBookAllocator() noexcept {
  try {
+        if (m_region) {
+            closeRegion();  // Everything stays in the file
+            return;
+        }
          std::cout << "[OrderBookAllocator] Starting cleanup..." << std::endl;
 
         // Ensure all allocated orders and price levels are cleaned up
@@ -32,8 +243,7 @@ OrderBookAllocator::~OrderBookAllocator() noexcept {
 
         // Deallocate the memory pools if not null
         if (m_order_pool) {
-            std::size_t order_size = sizeof(OrderNode) + m_config.order_data_size;
-            m_allocator.deallocate(m_order_pool, order_size * m_config.max_orders);
+            m_allocator.deallocate(m_order_pool, m_order_stride * m_config.max_orders);
             m_order_pool = nullptr;
         }
 
@@ -41,7 +251,6 @@ OrderBookAllocator::~OrderBookAllocator() noexcept {
             m_allocator.deallocate(m_price_level_pool, sizeof(PriceLevel) * m_config.max_price_levels);
             m_price_level_pool = nullptr;
         }
-        cleanup();
 
         std::cout << "[OrderBookAllocator] Cleanup completed successfully" << std::endl;
     } catch (const std::exception& e) {
@@ -51,39 +260,90 @@ OrderBookAllocator::~OrderBookAllocator() noexcept {
     }
 }
 
+std::size_t OrderBookAllocator::orderSlot(const OrderNode* order) const {
+    return static_cast<std::size_t>(
+        reinterpret_cast<const char*>(order) - static_cast<const char*>(m_order_pool)) / m_order_stride;
+}
+
+bool OrderBookAllocator::ownsOrder(const OrderNode* order) const {
+    auto base = reinterpret_cast<std::uintptr_t>(m_order_pool);
+    auto address = reinterpret_cast<std::uintptr_t>(order);
+    return address >= base && address < base + m_order_stride * m_config.max_orders &&
+           (address - base) % m_order_stride == 0;
+}
+
+bool OrderBookAllocator::ownsPriceLevel(const PriceLevel* level) const {
+    auto base = reinterpret_cast<std::uintptr_t>(m_price_level_pool);
+    auto address = reinterpret_cast<std::uintptr_t>(level);
+    return address >= base && address < base + sizeof(PriceLevel) * m_config.max_price_levels &&
+           (address - base) % sizeof(PriceLevel) == 0;
+}
+
 OrderNode* OrderBookAllocator::allocateOrder() {
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
     if (m_active_orders.load(std::memory_order_relaxed) >= m_config.max_orders) {
         return nullptr;
     }
 
-    try {
-        // Use the pre-allocated pool instead of allocating new memory
-        std::size_t order_size = sizeof(OrderNode) + m_config.order_data_size;
-        void* memory = static_cast<char*>(m_order_pool) + 
-                      (m_active_orders.load(std::memory_order_relaxed) * order_size);
-        
-        OrderNode* node = new (memory) OrderNode();
-        node->price = 0.0;
-        node->quantity = 0.0;
-        node->order_id.clear();
-        node->next = nullptr;
-        node->prev = nullptr;
-        node->parent_level = nullptr;
-        
-        m_active_orders.fetch_add(1, std::memory_order_release);
-        return node;
-    } catch (...) {
-        return nullptr;
+    // Reuse a released slot before touching fresh pool memory
+    void* memory;
+    if (m_header->free_orders) {
+        memory = orderAt(m_header->free_orders - 1);
+        m_header->free_orders = *static_cast<std::uint64_t*>(memory);
+    } else {
+        memory = orderAt(m_header->order_high_water++);
+    }
+
+    OrderNode* node = new (memory) OrderNode();
+    if (isPersistent()) {
+        node->additional_data[0] = 0;  // No persisted id yet
     }
+    node->price = 0.0;
+    node->quantity = 0.0;
+    node->next = nullptr;
+    node->prev = nullptr;
+    node->parent_level = nullptr;
+    m_order_in_use[orderSlot(node)] = true;
+
+    std::size_t active = m_active_orders.fetch_add(1, std::memory_order_release) + 1;
+    if (active > m_peak_orders.load(std::memory_order_relaxed)) {
+        m_peak_orders.store(active, std::memory_order_relaxed);
+        std::size_t memory_used = calculateTotalMemoryUsed();
+        if (memory_used > m_peak_memory.load(std::memory_order_relaxed)) {
+            m_peak_memory.store(memory_used, std::memory_order_relaxed);
+        }
+    }
+    return node;
 }
+
+void OrderBookAllocator::releaseOrderSlot(OrderNode* order) {
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
+    std::size_t slot = orderSlot(order);
+    if (!m_order_in_use[slot]) {
+        return;  // Already released
+    }
+    m_order_in_use[slot] = false;
+
+    order->~OrderNode();
+    *reinterpret_cast<std::uint64_t*>(order) = m_header->free_orders;
+    m_header->free_orders = slot + 1;
+
+    if (m_active_orders > 0) {
+        m_active_orders--;
+    }
+}
+
 void OrderBookAllocator::deallocateOrder(OrderNode* order) {
-    if (!order) return;
+    if (!order || !ownsOrder(order)) return;
 
     try {
         // Safely remove from lookup map first
         if (!order->order_id.empty()) {
           std::lock_guard<std::mutex> lock(m_order_map_mutex); //protect access  
-          m_order_map.erase(order->order_id);
+          auto it = m_order_map.find(order->order_id);
+          if (it != m_order_map.end() && it->second == order) {
+              m_order_map.erase(it);
+          }
         }
 
         // Safely unlink from parent level
@@ -113,13 +373,8 @@ void OrderBookAllocator::deallocateOrder(OrderNode* order) {
         order->prev = nullptr;
         order->parent_level = nullptr;
 
-        // Finally deallocate
-        std::size_t order_size = sizeof(OrderNode) + m_config.order_data_size;
-        m_allocator.deallocate(order, order_size);
-        
-        if (m_active_orders > 0) {
-            m_active_orders--;
-        }
+        // Finally return the slot to the pool
+        releaseOrderSlot(order);
     }
     catch (const std::exception& e) {
         std::cerr << "Error in deallocateOrder: " << e.what() << std::endl;
@@ -128,38 +383,62 @@ void OrderBookAllocator::deallocateOrder(OrderNode* order) {
 }
 
 PriceLevel* OrderBookAllocator::allocatePriceLevel() {
-    if (m_active_price_levels.load(std::memory_order_relaxed) >= m_config.max_price_levels) {
-        return nullptr;  // Pool exhausted
-    }
-
-    PriceLevel* level = reinterpret_cast<PriceLevel*>(
-        m_allocator.allocate(sizeof(PriceLevel))
-    );
-    
-    if (level) {
-        // Initialize level
-        level->first_order = nullptr;
-        level->last_order = nullptr;
-        level->next = nullptr;
-        level->prev = nullptr;
-        level->order_count = 0;
-        level->total_quantity = 0.0;
+    PriceLevel* level = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_pool_mutex);
+        if (m_active_price_levels.load(std::memory_order_relaxed) >= m_config.max_price_levels) {
+            return nullptr;  // Pool exhausted
+        }
 
-        {
-            // Track allocated level
-            std::lock_guard<std::mutex> lock(m_tracking_mutex);
-            m_allocated_price_levels.insert(level);
+        if (m_header->free_levels) {
+            level = static_cast<PriceLevel*>(m_price_level_pool) + (m_header->free_levels - 1);
+            m_header->free_levels = *reinterpret_cast<std::uint64_t*>(level);
+        } else {
+            level = static_cast<PriceLevel*>(m_price_level_pool) + m_header->level_high_water++;
         }
-        
+        level = new (level) PriceLevel();
+
         // Update statistics
         m_active_price_levels++;
     }
-    
+
+    // Initialize level
+    level->price = 0.0;
+    level->first_order = nullptr;
+    level->last_order = nullptr;
+    level->next = nullptr;
+    level->prev = nullptr;
+    level->order_count = 0;
+    level->total_quantity = 0.0;
+
+    {
+        // Track allocated level
+        std::lock_guard<std::mutex> lock(m_tracking_mutex);
+        m_allocated_price_levels.insert(level);
+    }
+
     return level;
 }
 
+void OrderBookAllocator::releasePriceLevelSlot(PriceLevel* level) {
+    {
+        std::lock_guard<std::mutex> lock(m_tracking_mutex);
+        if (m_allocated_price_levels.erase(level) == 0) {
+            return;  // Already released
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_pool_mutex);
+    *reinterpret_cast<std::uint64_t*>(level) = m_header->free_levels;
+    m_header->free_levels = levelSlot(level) + 1;
+
+    if (m_active_price_levels > 0) {
+        m_active_price_levels--;
+    }
+}
+
 void OrderBookAllocator::deallocatePriceLevel(PriceLevel* level) {
-    if (!level) return;
+    if (!level || !ownsPriceLevel(level)) return;
 
     try {
         // First safely unlink and deallocate all orders
@@ -169,7 +448,11 @@ void OrderBookAllocator::deallocatePriceLevel(PriceLevel* level) {
             
             // Unregister if necessary
             if (!order->order_id.empty()) {
-                m_order_map.erase(order->order_id);
+                std::lock_guard<std::mutex> lock(m_order_map_mutex);
+                auto it = m_order_map.find(order->order_id);
+                if (it != m_order_map.end() && it->second == order) {
+                    m_order_map.erase(it);
+                }
             }
             
             // Clear order's links
@@ -178,11 +461,7 @@ void OrderBookAllocator::deallocatePriceLevel(PriceLevel* level) {
             order->parent_level = nullptr;
             
             // Deallocate order
-            m_allocator.deallocate(order, sizeof(OrderNode));
-            
-            if (m_active_orders > 0) {
-                m_active_orders--;
-            }
+            releaseOrderSlot(order);
         }
 
         // Clear level's pointers
@@ -193,12 +472,8 @@ void OrderBookAllocator::deallocatePriceLevel(PriceLevel* level) {
         level->order_count = 0;
         level->total_quantity = 0;
  
-        // Finally deallocate the level itself
-        m_allocator.deallocate(level, sizeof(PriceLevel));
-        
-        if (m_active_price_levels > 0) {
-            m_active_price_levels--;
-        }
+        // Finally return the level itself to the pool
+        releasePriceLevelSlot(level);
     }
     catch (const std::exception& e) {
         std::cerr << "Error in deallocatePriceLevel: " << e.what() << std::endl;
@@ -214,12 +489,26 @@ OrderNode* OrderBookAllocator::findOrder(const std::string& order_id) {
 
 void OrderBookAllocator::registerOrder(const std::string& order_id, OrderNode* order) {
     if (order) {
+        if (isPersistent()) {
+            // Kept in the slot so the id survives a restart
+            if (order_id.size() > maxOrderIdLength()) {
+                throw std::length_error("Order id too long for persistent pools: " + order_id);
+            }
+            auto* stored = reinterpret_cast<unsigned char*>(order->additional_data);
+            stored[0] = static_cast<unsigned char>(order_id.size());
+            std::memcpy(stored + 1, order_id.data(), order_id.size());
+        }
         std::lock_guard<std::mutex> lock(m_order_map_mutex); //protect access
         order->order_id = order_id;
         m_order_map[order_id] = order;
     }
 }
 
+void OrderBookAllocator::reserveOrders(std::size_t count) {
+    std::lock_guard<std::mutex> lock(m_order_map_mutex);
+    m_order_map.reserve(m_order_map.size() + count);
+}
+
 void OrderBookAllocator::unregisterOrder(const std::string& order_id) {   
   std::lock_guard<std::mutex> lock(m_order_map_mutex); // protect access
   m_order_map.erase(order_id);
@@ -266,30 +555,34 @@ void OrderBookAllocator::reset() {
 
         {
             std::lock_guard<std::mutex> lock(m_order_map_mutex);
-
-
-            for (auto& pair : m_order_map) {
-                if (pair.second) {
-                
-                    // Clear string data
-                    pair.second->order_id.clear();
-                    pair.second->order_id.shrink_to_fit();
-
-                    // Clear pointers
-                    pair.second->next = nullptr;
-                    pair.second->prev = nullptr;
-                    pair.second->parent_level = nullptr;
-                }
-            }
             m_order_map.clear();
         }
 
-
-        for (PriceLevel* level : m_allocated_price_levels) {
-            deallocatePriceLevel(level);
+        {
+            std::lock_guard<std::mutex> lock(m_tracking_mutex);
+            m_allocated_price_levels.clear();
         }
-        m_allocated_price_levels.clear();
 
+        // Destroy every live order, wherever it is linked, and rewind both pools
+        {
+            std::lock_guard<std::mutex> lock(m_pool_mutex);
+            for (std::size_t slot = 0; slot < m_header->order_high_water; ++slot) {
+                if (m_order_in_use[slot]) {
+                    orderAt(slot)->~OrderNode();
+                    m_order_in_use[slot] = false;
+                }
+            }
+            m_header->free_orders = 0;
+            m_header->free_levels = 0;
+            m_header->order_high_water = 0;
+            m_header->level_high_water = 0;
+            if (isPersistent()) {
+                // The books' roots point into the pools just rewound
+                std::memset(static_cast<char*>(m_region) + m_header->roots_offset, 0,
+                            sizeof(BookRoot) * BookRegionHeader::MAX_BOOKS);
+                m_header->book_count = 0;
+            }
+        }
 
         // Reset statistics
         m_active_orders.store(0, std::memory_order_release);
@@ -306,9 +599,6 @@ void OrderBookAllocator::reset() {
     }
 }
 
-
-
-
 OrderBookAllocator::Stats OrderBookAllocator::getStats() const {
     return Stats{
         m_active_orders.load(),
@@ -323,8 +613,7 @@ OrderBookAllocator::Stats OrderBookAllocator::getStats() const {
 }
 
 std::size_t OrderBookAllocator::calculateTotalMemoryUsed() const {
-    std::size_t order_memory = m_active_orders.load() * 
-        (sizeof(OrderNode) + m_config.order_data_size);
+    std::size_t order_memory = m_active_orders.load() * m_order_stride;
     std::size_t level_memory = m_active_price_levels.load() * sizeof(PriceLevel);
     return order_memory + level_memory;
 }
@@ -335,12 +624,14 @@ bool OrderBookAllocator::hasCapacity() const {
 }
 
 void OrderBookAllocator::cleanup() {
-    std::lock_guard<std::mutex> lock(m_tracking_mutex);
-    for (PriceLevel* level : m_allocated_price_levels) {
-        m_allocator.deallocate(level, sizeof(PriceLevel)); // Deallocate memory
+    std::vector<PriceLevel*> levels;
+    {
+        std::lock_guard<std::mutex> lock(m_tracking_mutex);
+        levels.assign(m_allocated_price_levels.begin(), m_allocated_price_levels.end());
+    }
+    for (PriceLevel* level : levels) {
+        deallocatePriceLevel(level);  // Returns the level and its orders to the pools
     }
-    m_allocated_price_levels.clear(); // Clear the set
-    m_active_price_levels.store(0, std::memory_order_relaxed); // Reset count
 }
 
 
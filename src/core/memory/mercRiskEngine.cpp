@@ -0,0 +1,195 @@
+#include "../../../include/mercuryTrade/core/memory/mercRiskEngine.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+RiskEngine::RiskEngine(const Config& config)
+    : m_config(config) {
+    if (config.max_accounts == 0 || config.max_symbols == 0 || config.max_accounts > UINT32_MAX ||
+        config.max_symbols > UINT32_MAX) {
+        throw std::invalid_argument("Invalid risk engine capacity");
+    }
+    // Everything up front, so nothing on the order path allocates
+    m_accounts.resize(config.max_accounts, Account{config.default_limits, 0, 0.0});
+    m_slots.resize(config.max_accounts * config.max_symbols, Slot{0.0, 0.0, 0.0});
+    m_last_prices.resize(config.max_symbols, 0.0);
+    m_account_names.reserve(config.max_accounts);
+    m_symbol_names.reserve(config.max_symbols);
+}
+
+std::uint32_t RiskEngine::accountIndex(const std::string& account) {
+    auto found = m_account_index.find(account);
+    if (found != m_account_index.end()) {
+        return found->second;
+    }
+    if (m_account_names.size() == m_config.max_accounts) {
+        throw std::length_error("Risk engine is tracking the maximum number of accounts");
+    }
+    auto index = static_cast<std::uint32_t>(m_account_names.size());
+    m_account_names.push_back(account);
+    m_account_index.emplace(account, index);
+    return index;
+}
+
+std::uint32_t RiskEngine::findAccount(const std::string& account) const {
+    auto found = m_account_index.find(account);
+    return found == m_account_index.end() ? NOT_FOUND : found->second;
+}
+
+std::uint32_t RiskEngine::symbolIndex(const std::string& symbol) {
+    auto found = m_symbol_index.find(symbol);
+    if (found != m_symbol_index.end()) {
+        return found->second;
+    }
+    if (m_symbol_names.size() == m_config.max_symbols) {
+        throw std::length_error("Risk engine is tracking the maximum number of symbols");
+    }
+    auto index = static_cast<std::uint32_t>(m_symbol_names.size());
+    m_symbol_names.push_back(symbol);
+    m_symbol_index.emplace(symbol, index);
+    return index;
+}
+
+void RiskEngine::setLimits(const std::string& account, const Limits& limits) {
+    if (!(limits.max_position >= 0.0) || !(limits.max_notional >= 0.0) || !(limits.price_band >= 0.0)) {
+        throw std::invalid_argument("Risk limits cannot be negative");
+    }
+    m_accounts[accountIndex(account)].limits = limits;
+}
+
+RiskEngine::Limits RiskEngine::limits(const std::string& account) {
+    return m_accounts[accountIndex(account)].limits;
+}
+
+RiskCheck RiskEngine::check(std::uint32_t account, std::uint32_t symbol, bool is_buy, double price,
+                            double quantity) const {
+    const Account& state = m_accounts[account];
+    const Slot& exposure = slot(account, symbol);
+    const double last = m_last_prices[symbol];
+
+    if (price > 0.0) {
+        if (state.open_orders >= state.limits.max_open_orders) {
+            return RiskCheck::OPEN_ORDER_LIMIT;
+        }
+        if (last > 0.0 && std::fabs(price - last) > state.limits.price_band * last) {
+            return RiskCheck::PRICE_BAND;
+        }
+    }
+    // Market orders are valued at the last trade, and pass before the first
+    const double reference = price > 0.0 ? price : last;
+    if (state.open_notional + reference * quantity > state.limits.max_notional) {
+        return RiskCheck::NOTIONAL_LIMIT;
+    }
+    // As if every resting order on the same side filled too
+    const double worst = is_buy ? exposure.position + exposure.open_buys + quantity
+                                : exposure.open_sells + quantity - exposure.position;
+    if (worst > state.limits.max_position) {
+        return RiskCheck::POSITION_LIMIT;
+    }
+    return RiskCheck::PASSED;
+}
+
+void RiskEngine::reserve(std::uint32_t account, std::uint32_t symbol, bool is_buy, double price, double quantity) {
+    Account& state = m_accounts[account];
+    Slot& exposure = slot(account, symbol);
+    ++state.open_orders;
+    state.open_notional += price * quantity;
+    (is_buy ? exposure.open_buys : exposure.open_sells) += quantity;
+}
+
+void RiskEngine::release(std::uint32_t account, std::uint32_t symbol, bool is_buy, double price, double quantity) {
+    Account& state = m_accounts[account];
+    Slot& exposure = slot(account, symbol);
+    double& open = is_buy ? exposure.open_buys : exposure.open_sells;
+    open = open > quantity ? open - quantity : 0.0;
+    state.open_orders -= state.open_orders > 0 ? 1 : 0;
+    // Reset once nothing rests, so rounding cannot build up
+    state.open_notional = state.open_orders > 0 ? state.open_notional - price * quantity : 0.0;
+}
+
+void RiskEngine::fill(std::uint32_t account, std::uint32_t symbol, bool is_buy, double price, double quantity,
+                      bool done) {
+    Slot& exposure = slot(account, symbol);
+    exposure.position += is_buy ? quantity : -quantity;
+    if (price <= 0.0) {
+        return;  // Market orders reserved nothing
+    }
+    Account& state = m_accounts[account];
+    double& open = is_buy ? exposure.open_buys : exposure.open_sells;
+    open = open > quantity ? open - quantity : 0.0;
+    state.open_orders -= done && state.open_orders > 0 ? 1 : 0;
+    state.open_notional = state.open_orders > 0 ? state.open_notional - price * quantity : 0.0;
+}
+
+RiskEngine::Exposure RiskEngine::exposure(std::uint32_t account, std::uint32_t symbol) const {
+    const Slot& exposure = slot(account, symbol);
+    return Exposure{exposure.position, exposure.open_buys, exposure.open_sells};
+}
+
+RiskEngine::Usage RiskEngine::usage(std::uint32_t account) const {
+    return Usage{m_accounts[account].open_orders, m_accounts[account].open_notional};
+}
+
+void RiskEngine::saveState(SnapshotWriter& out) const {
+    out.putU64(m_symbol_names.size());
+    for (std::size_t symbol = 0; symbol < m_symbol_names.size(); ++symbol) {
+        out.putString(m_symbol_names[symbol]);
+        out.putDouble(m_last_prices[symbol]);
+    }
+
+    out.putU64(m_account_names.size());
+    for (std::size_t account = 0; account < m_account_names.size(); ++account) {
+        out.putString(m_account_names[account]);
+        std::uint64_t held = 0;
+        for (std::size_t symbol = 0; symbol < m_symbol_names.size(); ++symbol) {
+            held += slot(static_cast<std::uint32_t>(account), static_cast<std::uint32_t>(symbol)).position != 0.0;
+        }
+        out.putU64(held);
+        for (std::size_t symbol = 0; symbol < m_symbol_names.size(); ++symbol) {
+            double position = slot(static_cast<std::uint32_t>(account), static_cast<std::uint32_t>(symbol)).position;
+            if (position != 0.0) {
+                out.putU32(static_cast<std::uint32_t>(symbol));
+                out.putDouble(position);
+            }
+        }
+    }
+}
+
+void RiskEngine::loadState(SnapshotReader& in) {
+    std::vector<std::uint32_t> symbols(in.getU64());
+    for (auto& symbol : symbols) {
+        symbol = symbolIndex(in.getString());
+        m_last_prices[symbol] = in.getDouble();
+    }
+
+    std::uint64_t accounts = in.getU64();
+    for (std::uint64_t i = 0; i < accounts; ++i) {
+        std::uint32_t account = accountIndex(in.getString());
+        std::uint64_t held = in.getU64();
+        for (std::uint64_t k = 0; k < held; ++k) {
+            std::uint32_t saved = in.getU32();
+            if (saved >= symbols.size()) {
+                throw std::runtime_error("Risk state refers to an unknown symbol");
+            }
+            slot(account, symbols[saved]).position = in.getDouble();
+        }
+    }
+}
+
+const char* RiskEngine::checkName(RiskCheck check) {
+    switch (check) {
+        case RiskCheck::PASSED: return "passed";
+        case RiskCheck::POSITION_LIMIT: return "position limit";
+        case RiskCheck::NOTIONAL_LIMIT: return "notional limit";
+        case RiskCheck::OPEN_ORDER_LIMIT: return "open order limit";
+        case RiskCheck::PRICE_BAND: return "price band";
+        case RiskCheck::UNKNOWN_ACCOUNT: return "unknown account";
+        case RiskCheck::CAPACITY: return "capacity";
+    }
+    return "unknown";
+}
+
+}}} // namespaces
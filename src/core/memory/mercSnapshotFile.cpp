@@ -0,0 +1,160 @@
+#include "../../../include/mercuryTrade/core/memory/mercSnapshotFile.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercChecksum.hpp"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// File layout: u32 magic, u32 version, u64 payload length, u32 payload
+// crc32, u32 reserved, then the payload
+constexpr std::uint32_t SNAPSHOT_MAGIC = 0x504E534D;  // "MSNP"
+constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 24;
+
+std::runtime_error ioError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool readAll(int fd, char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::read(fd, data, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+void SnapshotWriter::putString(const std::string& value) {
+    putU32(static_cast<std::uint32_t>(value.size()));
+    m_data.append(value);
+}
+
+void SnapshotReader::require(std::size_t bytes) const {
+    if (m_size - m_offset < bytes) {
+        throw std::runtime_error("Snapshot is truncated");
+    }
+}
+
+std::string SnapshotReader::getString() {
+    std::uint32_t length = getU32();
+    require(length);
+    std::string value(m_data + m_offset, length);
+    m_offset += length;
+    return value;
+}
+
+void writeSnapshotFile(const std::string& path, const std::string& payload) {
+    writeSnapshotTemporary(path, payload);
+    commitSnapshotFile(path);
+}
+
+void writeSnapshotTemporary(const std::string& path, const std::string& payload) {
+    char header[HEADER_SIZE] = {};
+    std::uint64_t length = payload.size();
+    std::uint32_t crc = crc32(payload.data(), payload.size());
+    std::memcpy(header, &SNAPSHOT_MAGIC, 4);
+    std::memcpy(header + 4, &SNAPSHOT_VERSION, 4);
+    std::memcpy(header + 8, &length, 8);
+    std::memcpy(header + 16, &crc, 4);
+
+    std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw ioError("Cannot create snapshot", temporary);
+    }
+    bool ok = writeAll(fd, header, HEADER_SIZE) && writeAll(fd, payload.data(), payload.size()) &&
+              ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok) {
+        auto error = ioError("Cannot write snapshot", temporary);
+        ::unlink(temporary.c_str());
+        throw error;
+    }
+}
+
+void commitSnapshotFile(const std::string& path) {
+    std::string temporary = path + ".tmp";
+    if (::rename(temporary.c_str(), path.c_str()) != 0) {
+        auto error = ioError("Cannot write snapshot", path);
+        ::unlink(temporary.c_str());
+        throw error;
+    }
+
+    // Make the rename itself durable
+    std::string directory = fs::path(path).parent_path().string();
+    int dir = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir >= 0) {
+        ::fsync(dir);
+        ::close(dir);
+    }
+}
+
+std::string readSnapshotFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw ioError("Cannot open snapshot", path);
+    }
+
+    char header[HEADER_SIZE];
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint64_t length = 0;
+    std::uint32_t crc = 0;
+    struct stat info;
+    bool ok = readAll(fd, header, HEADER_SIZE) && ::fstat(fd, &info) == 0;
+    if (ok) {
+        std::memcpy(&magic, header, 4);
+        std::memcpy(&version, header + 4, 4);
+        std::memcpy(&length, header + 8, 8);
+        std::memcpy(&crc, header + 16, 4);
+        ok = magic == SNAPSHOT_MAGIC && version == SNAPSHOT_VERSION &&
+             length == static_cast<std::uint64_t>(info.st_size) - HEADER_SIZE;
+    }
+
+    std::string payload;
+    if (ok) {
+        payload.resize(length);
+        ok = readAll(fd, &payload[0], payload.size());
+    }
+    ::close(fd);
+    if (!ok || crc32(payload.data(), payload.size()) != crc) {
+        throw std::runtime_error("Snapshot is truncated or corrupt: " + path);
+    }
+    return payload;
+}
+
+}}} // namespaces
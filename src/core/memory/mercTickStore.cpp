@@ -0,0 +1,884 @@
+#include "../../../include/mercuryTrade/core/memory/mercTickStore.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercChecksum.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <numeric>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mercuryTrade {
+namespace core {
+namespace memory {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr std::uint32_t SEGMENT_MAGIC = 0x534B544D;  // "MTKS"
+constexpr std::uint32_t SEGMENT_VERSION = 1;
+constexpr std::size_t SEGMENT_HEADER_SIZE = 64;
+
+// Segment header, little-endian:
+//   0  u32 magic, u32 version
+//   8  i64 partition start
+//  16  u32 kind, u32 value columns
+//  24  i64 price scale, i64 quantity scale
+//
+// Block layout, starting on a multiple of 8:
+//   0  u32 magic
+//   4  u32 crc32 of bytes [8, length)
+//   8  u32 length (whole block, multiple of 8), u32 rows
+//  16  i64 first timestamp, i64 last timestamp
+//  32  u32 encoded bytes of the timestamp column and each value column
+//  56  the columns, one after another, then zero padding
+//
+// Every column starts with a varint divisor. Timestamps follow as varint
+// deltas from the previous row (the first row's is 0), values as zigzag
+// varint deltas from the previous row, starting from 0; each delta is
+// divided by its column's divisor, the deltas' greatest common divisor, so
+// millisecond timestamps and whole-tick prices shrink to a byte or two.
+constexpr std::uint32_t BLOCK_MAGIC = 0x424B544D;  // "MTKB"
+constexpr std::size_t BLOCK_HEADER_SIZE = 56;
+constexpr std::size_t MAX_VARINT = 10;
+constexpr std::size_t CHECKED_COLUMNS = 5;  // Timestamp plus TickStore's value columns
+
+constexpr std::size_t TRADE_COLUMNS = 3;  // price, quantity, buyer_aggressor
+constexpr std::size_t QUOTE_COLUMNS = 4;  // bid, bid_size, ask, ask_size
+
+template <typename T>
+void store(unsigned char* at, T value) {
+    std::memcpy(at, &value, sizeof(T));
+}
+
+template <typename T>
+T load(const unsigned char* at) {
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
+}
+
+void putVarint(unsigned char*& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<unsigned char>(value);
+}
+
+std::uint64_t getVarint(const unsigned char*& in) {
+    std::uint64_t value = *in++;
+    if (value < 0x80) {
+        return value;  // Most deltas fit one byte
+    }
+    value &= 0x7F;
+    for (unsigned shift = 7;; shift += 7) {
+        std::uint64_t byte = *in++;
+        value |= (byte & 0x7F) << shift;
+        if (byte < 0x80) {
+            return value;
+        }
+    }
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+// Start of the bucket holding timestamp, rounding down for negative ones
+std::int64_t bucketStart(std::int64_t timestamp, std::int64_t bucket) {
+    std::int64_t remainder = timestamp % bucket;
+    return remainder < 0 ? timestamp - remainder - bucket : timestamp - remainder;
+}
+
+std::int64_t toFixed(double value, std::int64_t scale) {
+    if (!std::isfinite(value)) {
+        throw std::invalid_argument("Tick values must be finite");
+    }
+    return std::llround(value * static_cast<double>(scale));
+}
+
+std::size_t worstBlockSize(std::size_t rows, std::size_t columns) {
+    return BLOCK_HEADER_SIZE + (rows + 1) * MAX_VARINT * (1 + columns) + 8;
+}
+
+bool validSymbol(const std::string& symbol) {
+    return !symbol.empty() && symbol[0] != '.' && symbol.find('/') == std::string::npos &&
+           symbol.find('\0') == std::string::npos;
+}
+
+std::runtime_error ioError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+void syncDirectory(const std::string& directory) {
+    int dir = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir >= 0) {
+        ::fsync(dir);
+        ::close(dir);
+    }
+}
+
+} // namespace
+
+struct TickStore::Segment {
+    std::string path;
+    int fd{-1};
+    unsigned char* base{nullptr};
+    std::size_t size{0};     // Bytes mapped
+    std::size_t used{0};     // Header plus blocks
+    std::size_t synced{0};   // Bytes known to be on disk
+    std::int64_t partition{0};
+    std::uint32_t file{0};
+    bool writable{false};
+    std::vector<BlockEntry> index;
+
+    ~Segment() {
+        if (writable) {
+            seal();
+        }
+        if (base) {
+            ::munmap(base, size);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    void sync() {
+        if (synced >= used) {
+            return;
+        }
+        static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        std::size_t start = synced / page * page;
+        ::msync(base + start, used - start, MS_SYNC);
+        synced = used;
+    }
+
+    // No more blocks; gives back the space reserved past the last one
+    void seal() {
+        sync();
+        if (::ftruncate(fd, static_cast<off_t>(used)) == 0) {
+            ::fsync(fd);
+        }
+        writable = false;
+    }
+};
+
+TickStore::TickStore(const Config& config)
+    : m_config(config) {
+    if (config.directory.empty() || config.partition_nanos <= 0 || config.block_rows == 0 ||
+        config.price_scale <= 0 || config.quantity_scale <= 0 || config.max_symbols == 0 ||
+        config.segment_size < SEGMENT_HEADER_SIZE + worstBlockSize(config.block_rows, MAX_COLUMNS)) {
+        throw std::invalid_argument("Invalid tick store configuration");
+    }
+    m_symbols = std::make_unique<SymbolHistory[]>(config.max_symbols);
+
+    std::error_code error;
+    fs::create_directories(config.directory, error);
+    if (error) {
+        throw std::runtime_error("Cannot create tick store directory " + config.directory + ": " +
+                                 error.message());
+    }
+    std::vector<std::string> existing;
+    for (const auto& item : fs::directory_iterator(config.directory)) {
+        std::string name = item.path().filename().string();
+        if (item.is_directory() && validSymbol(name)) {
+            existing.push_back(name);
+        }
+    }
+    std::sort(existing.begin(), existing.end());
+    for (const auto& symbol : existing) {
+        symbolIndex(symbol);
+    }
+}
+
+TickStore::~TickStore() {
+    try {
+        flush();
+    } catch (...) {
+        // Blocks already written stay readable; nothing more can be done here
+    }
+}
+
+const char* TickStore::kindName(Kind kind) {
+    return kind == Kind::TRADES ? "trades" : "quotes";
+}
+
+std::size_t TickStore::symbolIndex(const std::string& symbol) {
+    if (!validSymbol(symbol)) {
+        throw std::invalid_argument("Invalid tick store symbol " + symbol);
+    }
+    std::lock_guard<std::mutex> lock(m_claim_mutex);
+    auto found = m_symbol_index.find(symbol);
+    if (found != m_symbol_index.end()) {
+        return found->second;
+    }
+    std::size_t claimed = m_symbol_count.load(std::memory_order_relaxed);
+    if (claimed == m_config.max_symbols) {
+        throw std::runtime_error("Tick store is full, cannot add " + symbol);
+    }
+
+    SymbolHistory& history = m_symbols[claimed];
+    history.symbol = symbol;
+    history.directory = (fs::path(m_config.directory) / symbol).string();
+    std::error_code error;
+    fs::create_directories(history.directory, error);
+    if (error) {
+        throw std::runtime_error("Cannot create tick store directory " + history.directory + ": " +
+                                 error.message());
+    }
+    history.series[0].kind = Kind::TRADES;
+    history.series[0].columns = TRADE_COLUMNS;
+    history.series[1].kind = Kind::QUOTES;
+    history.series[1].columns = QUOTE_COLUMNS;
+    for (auto& series : history.series) {
+        series.open.reserve(m_config.block_rows);
+    }
+    loadSegments(history);
+
+    m_symbol_index.emplace(symbol, claimed);
+    m_symbol_count.store(claimed + 1, std::memory_order_release);
+    return claimed;
+}
+
+std::size_t TickStore::findSymbol(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(m_claim_mutex);
+    auto found = m_symbol_index.find(symbol);
+    return found == m_symbol_index.end() ? NOT_FOUND : found->second;
+}
+
+TickStore::SymbolHistory& TickStore::entry(std::size_t symbol) const {
+    if (symbol >= m_symbol_count.load(std::memory_order_acquire)) {
+        throw std::out_of_range("Unknown tick store symbol index");
+    }
+    return m_symbols[symbol];
+}
+
+const TickStore::Series* TickStore::find(const std::string& symbol, Kind kind) const {
+    std::size_t index = findSymbol(symbol);
+    return index == NOT_FOUND ? nullptr : &m_symbols[index].series[static_cast<std::size_t>(kind)];
+}
+
+void TickStore::loadSegments(SymbolHistory& history) {
+    struct Found {
+        std::string name;
+        std::string path;
+        Kind kind;
+    };
+    std::vector<Found> files;
+    for (const auto& item : fs::directory_iterator(history.directory)) {
+        std::string name = item.path().filename().string();
+        if (!item.is_regular_file() || name.size() < 11 || name.compare(name.size() - 4, 4, ".seg") != 0) {
+            continue;
+        }
+        if (name.compare(0, 7, "trades-") == 0) {
+            files.push_back(Found{name, item.path().string(), Kind::TRADES});
+        } else if (name.compare(0, 7, "quotes-") == 0) {
+            files.push_back(Found{name, item.path().string(), Kind::QUOTES});
+        }
+    }
+    // Names carry the partition, then the file number, both zero-padded
+    std::sort(files.begin(), files.end(), [](const Found& a, const Found& b) { return a.name < b.name; });
+
+    for (const auto& found : files) {
+        Series& series = history.series[static_cast<std::size_t>(found.kind)];
+        auto segment = std::make_shared<Segment>();
+        segment->path = found.path;
+        segment->file = static_cast<std::uint32_t>(std::strtoul(found.name.c_str() + found.name.rfind('-') + 1,
+                                                                nullptr, 10));
+        series.next_file = std::max(series.next_file, segment->file + 1);
+
+        segment->fd = ::open(segment->path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (segment->fd < 0) {
+            throw ioError("Cannot open tick segment", segment->path);
+        }
+        struct stat info;
+        if (::fstat(segment->fd, &info) != 0) {
+            throw ioError("Cannot stat tick segment", segment->path);
+        }
+        segment->size = static_cast<std::size_t>(info.st_size);
+        if (segment->size < SEGMENT_HEADER_SIZE) {
+            continue;  // Cut short while being created
+        }
+        void* base = ::mmap(nullptr, segment->size, PROT_READ, MAP_SHARED, segment->fd, 0);
+        if (base == MAP_FAILED) {
+            throw ioError("Cannot map tick segment", segment->path);
+        }
+        segment->base = static_cast<unsigned char*>(base);
+
+        const unsigned char* header = segment->base;
+        if (load<std::uint32_t>(header) != SEGMENT_MAGIC || load<std::uint32_t>(header + 4) != SEGMENT_VERSION ||
+            load<std::uint32_t>(header + 16) != static_cast<std::uint32_t>(found.kind) ||
+            load<std::uint32_t>(header + 20) != series.columns) {
+            continue;
+        }
+        if (load<std::int64_t>(header + 24) != m_config.price_scale ||
+            load<std::int64_t>(header + 32) != m_config.quantity_scale) {
+            throw std::runtime_error("Tick segment " + segment->path + " was written with other scales");
+        }
+        segment->partition = load<std::int64_t>(header + 8);
+
+        // Blocks up to the first one a crash left torn
+        std::size_t offset = SEGMENT_HEADER_SIZE;
+        std::int64_t previous = series.last_timestamp;
+        while (offset + BLOCK_HEADER_SIZE <= segment->size) {
+            const unsigned char* block = segment->base + offset;
+            std::uint32_t length = load<std::uint32_t>(block + 8);
+            std::uint32_t rows = load<std::uint32_t>(block + 12);
+            std::int64_t first = load<std::int64_t>(block + 16);
+            std::int64_t last = load<std::int64_t>(block + 24);
+            std::size_t encoded = 0;
+            for (std::size_t column = 0; column < CHECKED_COLUMNS; ++column) {
+                encoded += load<std::uint32_t>(block + 32 + 4 * column);
+            }
+            if (load<std::uint32_t>(block) != BLOCK_MAGIC || length % 8 != 0 || rows == 0 ||
+                length > segment->size - offset || BLOCK_HEADER_SIZE + encoded > length ||
+                first > last || first < previous ||
+                crc32(block + 8, length - 8) != load<std::uint32_t>(block + 4)) {
+                break;
+            }
+            segment->index.push_back(BlockEntry{first, last, offset, rows});
+            series.rows += rows;
+            previous = last;
+            offset += length;
+        }
+        segment->used = offset;
+        segment->synced = offset;
+        if (!segment->index.empty()) {
+            series.last_timestamp = previous;
+        }
+        series.segments.push_back(segment);
+    }
+}
+
+std::int64_t TickStore::partitionOf(std::int64_t timestamp) const {
+    return bucketStart(timestamp, m_config.partition_nanos);
+}
+
+bool TickStore::appendTrade(std::size_t symbol, const TickTrade& trade) {
+    Row row{trade.timestamp,
+            {toFixed(trade.price, m_config.price_scale), toFixed(trade.quantity, m_config.quantity_scale),
+             trade.buyer_aggressor ? 1 : 0, 0}};
+    SymbolHistory& history = entry(symbol);
+    return append(history, history.series[static_cast<std::size_t>(Kind::TRADES)], row);
+}
+
+bool TickStore::appendQuote(std::size_t symbol, const TickQuote& quote) {
+    Row row{quote.timestamp,
+            {toFixed(quote.bid, m_config.price_scale), toFixed(quote.bid_size, m_config.quantity_scale),
+             toFixed(quote.ask, m_config.price_scale), toFixed(quote.ask_size, m_config.quantity_scale)}};
+    SymbolHistory& history = entry(symbol);
+    return append(history, history.series[static_cast<std::size_t>(Kind::QUOTES)], row);
+}
+
+bool TickStore::append(SymbolHistory& history, Series& series, const Row& row) {
+    std::unique_lock<std::shared_mutex> lock(series.mutex);
+    if (row.timestamp < series.last_timestamp) {
+        m_out_of_order.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // A block never spans two partitions
+    std::int64_t partition = partitionOf(row.timestamp);
+    if (!series.open.empty() && partition != series.open_partition) {
+        writeBlock(history, series);
+    }
+    series.open_partition = partition;
+    series.open.push_back(row);
+    series.last_timestamp = row.timestamp;
+    ++series.rows;
+    if (series.open.size() >= m_config.block_rows) {
+        writeBlock(history, series);
+    }
+    return true;
+}
+
+std::shared_ptr<TickStore::Segment> TickStore::createSegment(const SymbolHistory& history, Series& series,
+                                                            std::int64_t partition) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s-%019lld-%06u.seg", kindName(series.kind),
+                  static_cast<long long>(partition), series.next_file);
+
+    auto segment = std::make_shared<Segment>();
+    segment->path = (fs::path(history.directory) / name).string();
+    segment->size = m_config.segment_size;
+    segment->partition = partition;
+    segment->file = series.next_file++;
+    segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (segment->fd < 0) {
+        throw ioError("Cannot create tick segment", segment->path);
+    }
+    int error = ::posix_fallocate(segment->fd, 0, static_cast<off_t>(segment->size));
+    if (error != 0) {
+        errno = error;
+        ::unlink(segment->path.c_str());
+        throw ioError("Cannot preallocate tick segment", segment->path);
+    }
+    // Not populated up front: most symbols fill only a few pages an hour
+    void* base = ::mmap(nullptr, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+    if (base == MAP_FAILED) {
+        ::unlink(segment->path.c_str());
+        throw ioError("Cannot map tick segment", segment->path);
+    }
+    segment->base = static_cast<unsigned char*>(base);
+    segment->writable = true;
+
+    unsigned char* header = segment->base;
+    store<std::uint32_t>(header, SEGMENT_MAGIC);
+    store<std::uint32_t>(header + 4, SEGMENT_VERSION);
+    store<std::int64_t>(header + 8, partition);
+    store<std::uint32_t>(header + 16, static_cast<std::uint32_t>(series.kind));
+    store<std::uint32_t>(header + 20, static_cast<std::uint32_t>(series.columns));
+    store<std::int64_t>(header + 24, m_config.price_scale);
+    store<std::int64_t>(header + 32, m_config.quantity_scale);
+    segment->used = SEGMENT_HEADER_SIZE;
+
+    syncDirectory(history.directory);
+    return segment;
+}
+
+void TickStore::writeBlock(SymbolHistory& history, Series& series) {
+    if (series.open.empty()) {
+        return;
+    }
+    const std::vector<Row>& rows = series.open;
+    std::shared_ptr<Segment> segment = series.segments.empty() ? nullptr : series.segments.back();
+    if (!segment || !segment->writable || segment->partition != series.open_partition ||
+        segment->used + worstBlockSize(rows.size(), series.columns) > segment->size) {
+        if (segment && segment->writable) {
+            segment->seal();
+        }
+        segment = createSegment(history, series, series.open_partition);
+        series.segments.push_back(segment);
+    }
+
+    unsigned char* block = segment->base + segment->used;
+    unsigned char* out = block + BLOCK_HEADER_SIZE;
+    std::uint32_t encoded[CHECKED_COLUMNS] = {};
+
+    // Each column is its deltas' greatest common divisor, then every
+    // delta divided by it
+    unsigned char* column = out;
+    std::uint64_t divisor = 0;
+    for (std::size_t i = 1; i < rows.size(); ++i) {
+        divisor = std::gcd(divisor, static_cast<std::uint64_t>(rows[i].timestamp - rows[i - 1].timestamp));
+    }
+    divisor = divisor == 0 ? 1 : divisor;
+    putVarint(out, divisor);
+    std::int64_t previous = rows.front().timestamp;
+    for (const Row& row : rows) {
+        putVarint(out, static_cast<std::uint64_t>(row.timestamp - previous) / divisor);
+        previous = row.timestamp;
+    }
+    encoded[0] = static_cast<std::uint32_t>(out - column);
+
+    for (std::size_t value = 0; value < series.columns; ++value) {
+        column = out;
+        divisor = 0;
+        previous = 0;
+        for (const Row& row : rows) {
+            std::int64_t delta = row.values[value] - previous;
+            divisor = std::gcd(divisor, static_cast<std::uint64_t>(delta < 0 ? -delta : delta));
+            previous = row.values[value];
+        }
+        divisor = divisor == 0 ? 1 : divisor;
+        putVarint(out, divisor);
+        previous = 0;
+        for (const Row& row : rows) {
+            putVarint(out, zigzag((row.values[value] - previous) / static_cast<std::int64_t>(divisor)));
+            previous = row.values[value];
+        }
+        encoded[1 + value] = static_cast<std::uint32_t>(out - column);
+    }
+
+    std::size_t length = (static_cast<std::size_t>(out - block) + 7) / 8 * 8;
+    std::memset(out, 0, length - static_cast<std::size_t>(out - block));
+    store<std::uint32_t>(block + 8, static_cast<std::uint32_t>(length));
+    store<std::uint32_t>(block + 12, static_cast<std::uint32_t>(rows.size()));
+    store<std::int64_t>(block + 16, rows.front().timestamp);
+    store<std::int64_t>(block + 24, rows.back().timestamp);
+    for (std::size_t i = 0; i < CHECKED_COLUMNS; ++i) {
+        store<std::uint32_t>(block + 32 + 4 * i, encoded[i]);
+    }
+    store<std::uint32_t>(block + 4, crc32(block + 8, length - 8));
+    store<std::uint32_t>(block, BLOCK_MAGIC);
+
+    segment->index.push_back(BlockEntry{rows.front().timestamp, rows.back().timestamp, segment->used, rows.size()});
+    segment->used += length;
+    series.open.clear();
+}
+
+void TickStore::flush() {
+    std::size_t count = m_symbol_count.load(std::memory_order_acquire);
+    for (std::size_t symbol = 0; symbol < count; ++symbol) {
+        SymbolHistory& history = m_symbols[symbol];
+        for (auto& series : history.series) {
+            std::unique_lock<std::shared_mutex> lock(series.mutex);
+            writeBlock(history, series);
+            if (!series.segments.empty() && series.segments.back()->writable) {
+                series.segments.back()->sync();
+            }
+        }
+    }
+}
+
+void TickStore::decodeBlock(const Segment& segment, const BlockEntry& block, std::size_t columns,
+                            Row* rows) const {
+    const unsigned char* in = segment.base + block.offset + BLOCK_HEADER_SIZE;
+    std::int64_t timestamp = block.first;
+    std::uint64_t divisor = getVarint(in);
+    for (std::size_t i = 0; i < block.rows; ++i) {
+        timestamp += static_cast<std::int64_t>(getVarint(in) * divisor);
+        rows[i].timestamp = timestamp;
+    }
+    for (std::size_t value = 0; value < columns; ++value) {
+        std::int64_t current = 0;
+        std::int64_t step = static_cast<std::int64_t>(getVarint(in));
+        for (std::size_t i = 0; i < block.rows; ++i) {
+            current += unzigzag(getVarint(in)) * step;
+            rows[i].values[value] = current;
+        }
+    }
+}
+
+template <typename Visit>
+void TickStore::forEachBlock(const Series& series, std::int64_t from, std::int64_t to, bool backwards,
+                             Visit&& visit) const {
+    if (from >= to) {
+        return;
+    }
+    const auto& segments = series.segments;
+    const std::int64_t width = m_config.partition_nanos;
+    // Segments whose partition overlaps [from, to)
+    auto first = std::partition_point(segments.begin(), segments.end(), [&](const std::shared_ptr<Segment>& segment) {
+        return segment->partition < from && from - segment->partition >= width;
+    });
+    auto end = std::partition_point(first, segments.end(), [&](const std::shared_ptr<Segment>& segment) {
+        return segment->partition < to;
+    });
+    bool open = !series.open.empty() && series.open.back().timestamp >= from && series.open.front().timestamp < to;
+
+    std::vector<Row> rows(m_config.block_rows);
+    auto visitBlock = [&](const Segment& segment, const BlockEntry& block) {
+        if (rows.size() < block.rows) {
+            rows.resize(block.rows);  // Written with a larger block_rows
+        }
+        decodeBlock(segment, block, series.columns, rows.data());
+        return visit(static_cast<const Row*>(rows.data()), block.rows);
+    };
+    auto blockRange = [&](const Segment& segment) {
+        auto begin = std::partition_point(segment.index.begin(), segment.index.end(),
+                                          [&](const BlockEntry& block) { return block.last < from; });
+        auto stop = std::partition_point(begin, segment.index.end(),
+                                         [&](const BlockEntry& block) { return block.first < to; });
+        return std::make_pair(begin, stop);
+    };
+
+    if (!backwards) {
+        for (auto it = first; it != end; ++it) {
+            auto range = blockRange(**it);
+            for (auto block = range.first; block != range.second; ++block) {
+                if (!visitBlock(**it, *block)) {
+                    return;
+                }
+            }
+        }
+        if (open) {
+            visit(series.open.data(), series.open.size());
+        }
+        return;
+    }
+
+    if (open && !visit(series.open.data(), series.open.size())) {
+        return;
+    }
+    for (auto it = end; it != first;) {
+        --it;
+        auto range = blockRange(**it);
+        for (auto block = range.second; block != range.first;) {
+            --block;
+            if (!visitBlock(**it, *block)) {
+                return;
+            }
+        }
+    }
+}
+
+TickTrade TickStore::toTrade(const Row& row) const {
+    const double price = static_cast<double>(m_config.price_scale);
+    const double quantity = static_cast<double>(m_config.quantity_scale);
+    return TickTrade{row.timestamp, static_cast<double>(row.values[0]) / price,
+                     static_cast<double>(row.values[1]) / quantity, static_cast<std::uint8_t>(row.values[2])};
+}
+
+TickQuote TickStore::toQuote(const Row& row) const {
+    const double price = static_cast<double>(m_config.price_scale);
+    const double quantity = static_cast<double>(m_config.quantity_scale);
+    return TickQuote{row.timestamp, static_cast<double>(row.values[0]) / price,
+                     static_cast<double>(row.values[1]) / quantity, static_cast<double>(row.values[2]) / price,
+                     static_cast<double>(row.values[3]) / quantity};
+}
+
+std::size_t TickStore::scanTrades(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                  const TradeVisitor& visitor) const {
+    const Series* series = find(symbol, Kind::TRADES);
+    if (!series) {
+        return 0;
+    }
+    std::shared_lock<std::shared_mutex> lock(series->mutex);
+    std::size_t visited = 0;
+    forEachBlock(*series, from, to, false, [&](const Row* rows, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (rows[i].timestamp >= to) {
+                return false;
+            }
+            if (rows[i].timestamp >= from) {
+                visitor(toTrade(rows[i]));
+                ++visited;
+            }
+        }
+        return true;
+    });
+    return visited;
+}
+
+std::size_t TickStore::scanQuotes(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                  const QuoteVisitor& visitor) const {
+    const Series* series = find(symbol, Kind::QUOTES);
+    if (!series) {
+        return 0;
+    }
+    std::shared_lock<std::shared_mutex> lock(series->mutex);
+    std::size_t visited = 0;
+    forEachBlock(*series, from, to, false, [&](const Row* rows, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (rows[i].timestamp >= to) {
+                return false;
+            }
+            if (rows[i].timestamp >= from) {
+                visitor(toQuote(rows[i]));
+                ++visited;
+            }
+        }
+        return true;
+    });
+    return visited;
+}
+
+std::vector<TickTrade> TickStore::trades(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                         std::size_t limit) const {
+    std::vector<TickTrade> result;
+    const Series* series = find(symbol, Kind::TRADES);
+    if (!series || limit == 0) {
+        return result;
+    }
+    std::shared_lock<std::shared_mutex> lock(series->mutex);
+    forEachBlock(*series, from, to, true, [&](const Row* rows, std::size_t count) {
+        for (std::size_t i = count; i > 0; --i) {
+            const Row& row = rows[i - 1];
+            if (row.timestamp < from) {
+                return false;
+            }
+            if (row.timestamp < to) {
+                result.push_back(toTrade(row));
+                if (result.size() == limit) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+TradeColumns TickStore::tradeColumns(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                     std::size_t limit) const {
+    TradeColumns columns;
+    const Series* series = find(symbol, Kind::TRADES);
+    if (!series || limit == 0) {
+        return columns;
+    }
+    const double price = static_cast<double>(m_config.price_scale);
+    const double quantity = static_cast<double>(m_config.quantity_scale);
+    std::shared_lock<std::shared_mutex> lock(series->mutex);
+    forEachBlock(*series, from, to, true, [&](const Row* rows, std::size_t count) {
+        for (std::size_t i = count; i > 0; --i) {
+            const Row& row = rows[i - 1];
+            if (row.timestamp < from) {
+                return false;
+            }
+            if (row.timestamp < to) {
+                columns.timestamps.push_back(row.timestamp);
+                columns.prices.push_back(static_cast<double>(row.values[0]) / price);
+                columns.quantities.push_back(static_cast<double>(row.values[1]) / quantity);
+                if (columns.timestamps.size() == limit) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+    std::reverse(columns.timestamps.begin(), columns.timestamps.end());
+    std::reverse(columns.prices.begin(), columns.prices.end());
+    std::reverse(columns.quantities.begin(), columns.quantities.end());
+    return columns;
+}
+
+std::vector<Bar> TickStore::downsampleTrades(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                             std::int64_t bucket_nanos, std::size_t limit) const {
+    if (bucket_nanos <= 0) {
+        throw std::invalid_argument("Downsampling bucket must be positive");
+    }
+    std::vector<Bar> bars;
+    const Series* series = find(symbol, Kind::TRADES);
+    if (!series || limit == 0) {
+        return bars;
+    }
+    std::shared_lock<std::shared_mutex> lock(series->mutex);
+    forEachBlock(*series, from, to, false, [&](const Row* rows, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (rows[i].timestamp >= to) {
+                return false;
+            }
+            if (rows[i].timestamp < from) {
+                continue;
+            }
+            TickTrade trade = toTrade(rows[i]);
+            std::int64_t start = bucketStart(trade.timestamp, bucket_nanos);
+            if (bars.empty() || bars.back().start != start) {
+                bars.push_back(Bar{start, trade.price, trade.price, trade.price, trade.price, 0.0, 0, false});
+            }
+            Bar& bar = bars.back();
+            bar.high = std::max(bar.high, trade.price);
+            bar.low = std::min(bar.low, trade.price);
+            bar.close = trade.price;
+            bar.volume += trade.quantity;
+            ++bar.trades;
+        }
+        return true;
+    });
+    for (Bar& bar : bars) {
+        bar.closed = bar.start + bucket_nanos <= series->last_timestamp;
+    }
+    if (bars.size() > limit) {
+        bars.erase(bars.begin(), bars.end() - static_cast<std::ptrdiff_t>(limit));
+    }
+    return bars;
+}
+
+std::vector<TickQuote> TickStore::downsampleQuotes(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                                   std::int64_t bucket_nanos, std::size_t limit) const {
+    if (bucket_nanos <= 0) {
+        throw std::invalid_argument("Downsampling bucket must be positive");
+    }
+    std::vector<TickQuote> quotes;
+    const Series* series = find(symbol, Kind::QUOTES);
+    if (!series || limit == 0) {
+        return quotes;
+    }
+    std::shared_lock<std::shared_mutex> lock(series->mutex);
+    std::int64_t bucket = INT64_MIN;
+    forEachBlock(*series, from, to, false, [&](const Row* rows, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (rows[i].timestamp >= to) {
+                return false;
+            }
+            if (rows[i].timestamp < from) {
+                continue;
+            }
+            std::int64_t start = bucketStart(rows[i].timestamp, bucket_nanos);
+            if (quotes.empty() || start != bucket) {
+                quotes.push_back(toQuote(rows[i]));
+                bucket = start;
+            } else {
+                quotes.back() = toQuote(rows[i]);
+            }
+        }
+        return true;
+    });
+    if (quotes.size() > limit) {
+        quotes.erase(quotes.begin(), quotes.end() - static_cast<std::ptrdiff_t>(limit));
+    }
+    return quotes;
+}
+
+std::vector<std::string> TickStore::symbols() const {
+    std::lock_guard<std::mutex> lock(m_claim_mutex);
+    std::vector<std::string> result;
+    std::size_t count = m_symbol_count.load(std::memory_order_relaxed);
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(m_symbols[i].symbol);
+    }
+    return result;
+}
+
+TickStore::Stats TickStore::getStats() const {
+    Stats stats{};
+    stats.symbols = m_symbol_count.load(std::memory_order_acquire);
+    for (std::size_t symbol = 0; symbol < stats.symbols; ++symbol) {
+        for (const auto& series : m_symbols[symbol].series) {
+            std::shared_lock<std::shared_mutex> lock(series.mutex);
+            (series.kind == Kind::TRADES ? stats.trades : stats.quotes) += series.rows;
+            stats.segments += series.segments.size();
+            for (const auto& segment : series.segments) {
+                stats.bytes_used += segment->used;
+            }
+        }
+    }
+    stats.out_of_order = m_out_of_order.load(std::memory_order_relaxed);
+    return stats;
+}
+
+TickRingRecorder::TickRingRecorder(const marketDataAllocator& rings, TickStore& store)
+    : m_rings(rings)
+    , m_store(store) {}
+
+std::size_t TickRingRecorder::drain() {
+    for (std::size_t symbol = m_followers.size(); symbol < m_rings.symbolCount(); ++symbol) {
+        Follower follower{marketDataAllocator::Cursor(), marketDataAllocator::Cursor(), TickStore::NOT_FOUND};
+        try {
+            follower.store_index = m_store.symbolIndex(m_rings.symbolName(symbol));
+            follower.quotes = m_rings.subscribe(symbol, marketDataAllocator::Channel::QUOTE, true);
+            follower.trades = m_rings.subscribe(symbol, marketDataAllocator::Channel::TRADE, true);
+        } catch (const std::exception&) {
+            // Full, or a name that cannot be a directory
+            follower.store_index = TickStore::NOT_FOUND;
+            ++m_untracked;
+        }
+        m_followers.push_back(std::move(follower));
+    }
+    std::size_t stored = 0;
+    MarketQuote quote;
+    MarketTrade trade;
+    for (auto& follower : m_followers) {
+        if (follower.store_index == TickStore::NOT_FOUND) {
+            continue;
+        }
+        while (m_rings.read(follower.quotes, quote, &m_missed)) {
+            m_store.appendQuote(follower.store_index,
+                                TickQuote{quote.timestamp, quote.bid, quote.bid_size, quote.ask, quote.ask_size});
+            ++stored;
+        }
+        while (m_rings.read(follower.trades, trade, &m_missed)) {
+            m_store.appendTrade(follower.store_index,
+                                TickTrade{trade.timestamp, trade.price, trade.quantity, trade.buyer_aggressor});
+            ++stored;
+        }
+    }
+    return stored;
+}
+
+}}} // namespaces
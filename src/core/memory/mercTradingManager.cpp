@@ -11,8 +11,13 @@ namespace mercuryTrade{
              : m_config(config)
              , m_status(Status::STARTING)
              , m_order_allocator(OrderBookAllocator::Config::getDefaultConfig())
-             , m_market_data_allocator()
+             , m_market_data_allocator([&config]() {
+                   auto rings = marketDataAllocator::getDefaultConfig();
+                   rings.max_symbols = config.max_symbols == 0 ? 1 : config.max_symbols;
+                   return rings;
+               }())
              , m_transaction_allocator(transactionAllocator::Config::getDefaultConfig())
+             , m_last_values(config.max_symbols == 0 ? 1 : config.max_symbols)
              , m_metrics(std::make_unique<performanceMetrics>())
              , m_current_transaction(nullptr)             // Add this member variable
             {
@@ -171,8 +176,9 @@ bool tradingManager::beginTransaction() {
                     throw std::invalid_argument("Symbol cannot be empty");
                 }
                 try{
+                    // The books themselves are maintained by LimitOrderBook;
+                    // this only accounts for the update
                     auto start_time = std::chrono::high_resolution_clock::now();
-                    std::this_thread::sleep_for(std::chrono::microseconds(1));
                     auto end_time = std::chrono::high_resolution_clock::now();
                     auto latency = std::chrono::duration_cast<std::chrono::microseconds>(end_time-start_time).count();
                     updateMetrics(static_cast<double>(latency));
@@ -191,13 +197,24 @@ bool tradingManager::beginTransaction() {
                         beginTransaction();
                     }
 
+                    bool released = false;
+                    {
+                        std::lock_guard<std::mutex> lock(m_order_mutex);
+                        OrderNode* order_node = m_order_allocator.findOrder(order_id);
+                        if (order_node){
+                            m_order_allocator.deallocateOrder(order_node);
+                            m_active_orders--;
+                            released = true;
+                        }
+                    }
+
                     if (m_config.enable_transactions){
                         commitTransaction();
                     }
                     auto end_time = std::chrono::high_resolution_clock::now();
                     auto latency = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
                     updateMetrics(static_cast<double>(latency));
-                    return true;
+                    return released;
                 }catch (...){
                     if (m_config.enable_transactions){
                         rollbackTransaction();
@@ -206,6 +223,52 @@ bool tradingManager::beginTransaction() {
                 }
             }
             
+            bool tradingManager::recordTrade(const trade& t){
+                if (m_status != Status::RUNNING || t.quantity <= 0.0){
+                    return false;
+                }
+                bool applied = false;
+                {
+                    std::lock_guard<std::mutex> lock(m_order_mutex);
+                    for (const std::string* order_id : {&t.buy_order_id, &t.sell_order_id}){
+                        OrderNode* order_node = m_order_allocator.findOrder(*order_id);
+                        if (!order_node){
+                            continue;
+                        }
+                        applied = true;
+                        order_node->quantity -= t.quantity;
+                        if (order_node->quantity <= 1e-9){
+                            m_order_allocator.deallocateOrder(order_node);
+                            m_active_orders--;
+                        }
+                    }
+                }
+                m_total_trades++;
+                if (m_metrics){
+                    m_metrics -> trade_count++;
+                }
+                return applied;
+            }
+
+            bool tradingManager::restoreOrder(const order& ord){
+                if (m_status != Status::RUNNING || !validateOrder(ord)){
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(m_order_mutex);
+                if (m_order_allocator.findOrder(ord.order_id)){
+                    return false;
+                }
+                OrderNode* order_node = m_order_allocator.allocateOrder();
+                if (!order_node){
+                    return false;
+                }
+                order_node->price = ord.price;
+                order_node->quantity = ord.quantity;
+                m_order_allocator.registerOrder(ord.order_id, order_node);
+                m_active_orders++;
+                return true;
+            }
+
             void tradingManager::optimizeMemory(){
                 if (m_status != Status::RUNNING && m_status != Status::PAUSED){
                     return;
@@ -275,7 +338,6 @@ bool tradingManager::beginTransaction() {
                 }
             }
             
-            std::cout << "Order " << ord.order_id << " submitted successfully" << std::endl;
             return true;
         } catch (const std::exception& e) {
             std::cerr << "Order submission failed with error: " << e.what() << std::endl;
@@ -317,12 +379,22 @@ bool tradingManager::beginTransaction() {
     if (m_status != Status::RUNNING) return;
 
     auto start_time = std::chrono::high_resolution_clock::now();
-    void* data_buffer = nullptr;
     try {
-        // Allocate market data memory
-        data_buffer = m_market_data_allocator.allocateQuoteBuffer();
-        if (!data_buffer) {
-            return;
+        // Straight into the symbol's cache entry and quote ring; nothing is
+        // allocated per tick once the symbol has been seen
+        auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            data.timestamp.time_since_epoch()).count();
+        {
+            std::lock_guard<std::mutex> lock(m_market_data_mutex);
+            std::size_t index = m_last_values.index(data.symbol);
+            LastValueCache::Values previous{};
+            m_last_values.read(index, previous);
+            m_last_values.set(index, LastValueCache::Values{
+                data.bid, 0.0, data.ask, 0.0, data.last, 0.0, data.volume, previous.trades,
+                static_cast<std::int64_t>(timestamp), previous.sequence + 1});
+            m_market_data_allocator.publish(m_market_data_allocator.symbolIndex(data.symbol),
+                marketDataAllocator::Channel::QUOTE, MarketQuote{previous.sequence + 1,
+                static_cast<std::int64_t>(timestamp), data.bid, 0.0, data.ask, 0.0});
         }
 
         // Process market data
@@ -334,11 +406,6 @@ bool tradingManager::beginTransaction() {
     } catch (...) {
         std::cerr << "Exception during market data handling." << std::endl;
     }
-
-    // Ensure the buffer is deallocated
-    if (data_buffer) {
-        m_market_data_allocator.deallocateBuffer(data_buffer, m_market_data_allocator.getConfig().quote_size * m_market_data_allocator.getConfig().buffer_capacity);
-    }
 }
 
 
@@ -415,12 +482,8 @@ bool tradingManager::beginTransaction() {
             }
 
             bool tradingManager::validateOrder(const order& ord) const{
-                std::cerr << "validateOrder: OrderID=" << ord.order_id 
-                            << ", Symbol=" << ord.symbol 
-                            << ", Price=" << ord.price 
-                            << ", Quantity=" << ord.quantity << "\n";
-
-                return !ord.order_id.empty() && !ord.symbol.empty() && ord.price > 0.0 && ord.quantity > 0.0;
+                // A zero price is a market order
+                return !ord.order_id.empty() && !ord.symbol.empty() && ord.price >= 0.0 && ord.quantity > 0.0;
             }
 
             void tradingManager::updateMetrics(double latency){
@@ -0,0 +1,167 @@
+// src/http/Compression.cpp
+#include "mercuryTrade/http/Compression.hpp"
+#include "mercuryTrade/http/Headers.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace mercuryTrade {
+namespace http {
+
+namespace {
+    constexpr std::size_t INPUT_SLICE_SIZE = 64 * 1024;
+    constexpr std::size_t OUTPUT_GROWTH = 16 * 1024;
+
+    std::string_view trim(std::string_view value) {
+        while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+            value.remove_prefix(1);
+        }
+        while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+            value.remove_suffix(1);
+        }
+        return value;
+    }
+
+    // Parses the q parameter of one Accept-Encoding element; missing means 1
+    double parse_quality(std::string_view params) {
+        while (!params.empty()) {
+            std::size_t semi = params.find(';');
+            std::string_view param = trim(params.substr(0, semi));
+            params = (semi == std::string_view::npos) ? std::string_view() : params.substr(semi + 1);
+
+            if (param.size() < 2 || (param[0] != 'q' && param[0] != 'Q') || param[1] != '=') {
+                continue;
+            }
+
+            // qvalue = ( "0" [ "." 0*3DIGIT ] ) / ( "1" [ "." 0*3("0") ] )
+            std::string_view digits = param.substr(2);
+            if (digits.empty() || (digits[0] != '0' && digits[0] != '1')) {
+                return 0.0;
+            }
+            double quality = digits[0] - '0';
+            double scale = 0.1;
+            for (std::size_t i = 2; i < digits.size() && i < 5; ++i) {
+                if (digits[i] < '0' || digits[i] > '9') {
+                    break;
+                }
+                quality += (digits[i] - '0') * scale;
+                scale /= 10;
+            }
+            return std::min(quality, 1.0);
+        }
+        return 1.0;
+    }
+}
+
+ContentEncoding negotiateEncoding(std::string_view accept_encoding) {
+    double gzip = -1.0;
+    double deflate = -1.0;
+    double wildcard = -1.0;
+
+    while (!accept_encoding.empty()) {
+        std::size_t comma = accept_encoding.find(',');
+        std::string_view element = accept_encoding.substr(0, comma);
+        accept_encoding = (comma == std::string_view::npos) ? std::string_view() : accept_encoding.substr(comma + 1);
+
+        std::size_t semi = element.find(';');
+        std::string_view coding = trim(element.substr(0, semi));
+        double quality = (semi == std::string_view::npos) ? 1.0 : parse_quality(element.substr(semi + 1));
+
+        if (iequals(coding, "gzip") || iequals(coding, "x-gzip")) {
+            gzip = quality;
+        } else if (iequals(coding, "deflate")) {
+            deflate = quality;
+        } else if (coding == "*") {
+            wildcard = quality;
+        }
+    }
+
+    // Codings not listed explicitly inherit the wildcard's quality
+    if (gzip < 0) gzip = wildcard;
+    if (deflate < 0) deflate = wildcard;
+
+    if (gzip > 0 && gzip >= deflate) {
+        return ContentEncoding::Gzip;
+    }
+    if (deflate > 0) {
+        return ContentEncoding::Deflate;
+    }
+    return ContentEncoding::Identity;
+}
+
+const char* encodingName(ContentEncoding encoding) {
+    switch (encoding) {
+        case ContentEncoding::Gzip: return "gzip";
+        case ContentEncoding::Deflate: return "deflate";
+        default: return nullptr;
+    }
+}
+
+void compress(std::string_view input, ContentEncoding encoding, std::string& output, int level) {
+    if (encoding == ContentEncoding::Identity) {
+        output.assign(input.data(), input.size());
+        return;
+    }
+
+    z_stream stream{};
+    // windowBits 15 + 16 selects the gzip wrapper; plain 15 is the zlib
+    // wrapper that HTTP calls "deflate"
+    int window_bits = (encoding == ContentEncoding::Gzip) ? 15 + 16 : 15;
+    if (deflateInit2(&stream, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("Failed to initialise compressor");
+    }
+
+    output.clear();
+    std::size_t written = 0;
+    std::size_t consumed = 0;
+    int status = Z_OK;
+
+    while (status != Z_STREAM_END) {
+        std::size_t slice = std::min(INPUT_SLICE_SIZE, input.size() - consumed);
+        bool last = consumed + slice == input.size();
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data() + consumed));
+        stream.avail_in = static_cast<uInt>(slice);
+
+        // Drain everything this slice produces before feeding the next one
+        do {
+            if (output.size() - written < OUTPUT_GROWTH) {
+                output.resize(std::max(output.size() * 2, written + OUTPUT_GROWTH));
+            }
+            stream.next_out = reinterpret_cast<Bytef*>(&output[written]);
+            stream.avail_out = static_cast<uInt>(output.size() - written);
+
+            status = deflate(&stream, last ? Z_FINISH : Z_NO_FLUSH);
+            if (status == Z_STREAM_ERROR) {
+                deflateEnd(&stream);
+                throw std::runtime_error("Compression failed");
+            }
+            written = output.size() - stream.avail_out;
+        } while (stream.avail_out == 0 || (last && status != Z_STREAM_END));
+
+        consumed += slice;
+    }
+
+    deflateEnd(&stream);
+    output.resize(written);
+}
+
+Payload::Payload(std::string data, int level)
+    : identity_(std::make_shared<const std::string>(std::move(data)))
+    , level_(level) {}
+
+std::shared_ptr<const std::string> Payload::encoded(ContentEncoding encoding) const {
+    if (encoding == ContentEncoding::Identity) {
+        return identity_;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = encoded_[static_cast<std::size_t>(encoding)];
+    if (!slot) {
+        auto body = std::make_shared<std::string>();
+        compress(*identity_, encoding, *body, level_);
+        slot = std::move(body);
+    }
+    return slot;
+}
+
+}} // namespace mercuryTrade::http
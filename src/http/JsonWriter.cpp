@@ -0,0 +1,147 @@
+// src/http/JsonWriter.cpp
+#include "mercuryTrade/http/JsonWriter.hpp"
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+namespace mercuryTrade {
+namespace http {
+
+namespace {
+    const char HEX_DIGITS[] = "0123456789abcdef";
+
+    bool needs_escape(unsigned char c) {
+        return c < 0x20 || c == '"' || c == '\\';
+    }
+}
+
+JsonWriter& JsonWriter::open(char bracket) {
+    if (depth_ == MAX_DEPTH) {
+        throw std::length_error("JSON nesting too deep");
+    }
+    separate();
+    out_.push_back(bracket);
+    has_items_ &= ~(std::uint64_t{1} << depth_);
+    ++depth_;
+    return *this;
+}
+
+JsonWriter& JsonWriter::close(char bracket) {
+    if (depth_ == 0) {
+        throw std::logic_error("Unbalanced JSON container");
+    }
+    --depth_;
+    out_.push_back(bracket);
+    return *this;
+}
+
+void JsonWriter::separate() {
+    if (after_key_) {
+        after_key_ = false;
+        return;
+    }
+    if (depth_ == 0) {
+        return;
+    }
+    std::uint64_t bit = std::uint64_t{1} << (depth_ - 1);
+    if (has_items_ & bit) {
+        out_.push_back(',');
+    }
+    has_items_ |= bit;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    write_string(name);
+    out_.push_back(':');
+    after_key_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    separate();
+    out_.append("null", 4);
+    return *this;
+}
+
+JsonWriter& JsonWriter::raw(std::string_view json) {
+    separate();
+    out_.append(json);
+    return *this;
+}
+
+void JsonWriter::write_bool(bool v) {
+    separate();
+    if (v) {
+        out_.append("true", 4);
+    } else {
+        out_.append("false", 5);
+    }
+}
+
+void JsonWriter::write_int(std::int64_t v) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), v);
+    out_.append(buffer, result.ptr);
+}
+
+void JsonWriter::write_uint(std::uint64_t v) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), v);
+    out_.append(buffer, result.ptr);
+}
+
+void JsonWriter::write_double(double v) {
+    separate();
+    if (!std::isfinite(v)) {
+        out_.append("null", 4);
+        return;
+    }
+
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), v);
+    out_.append(buffer, result.ptr);
+
+    // Keep the value recognisably floating point, as nlohmann does
+    for (const char* p = buffer; p != result.ptr; ++p) {
+        if (*p == '.' || *p == 'e') {
+            return;
+        }
+    }
+    out_.append(".0", 2);
+}
+
+void JsonWriter::write_string(std::string_view v) {
+    separate();
+    out_.push_back('"');
+
+    // Copy unescaped runs in one go; most strings have no escapes at all
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(v[i]);
+        if (!needs_escape(c)) {
+            continue;
+        }
+        out_.append(v.data() + run, i - run);
+        run = i + 1;
+
+        switch (c) {
+            case '"': out_.append("\\\"", 2); break;
+            case '\\': out_.append("\\\\", 2); break;
+            case '\b': out_.append("\\b", 2); break;
+            case '\f': out_.append("\\f", 2); break;
+            case '\n': out_.append("\\n", 2); break;
+            case '\r': out_.append("\\r", 2); break;
+            case '\t': out_.append("\\t", 2); break;
+            default: {
+                char escaped[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F]};
+                out_.append(escaped, sizeof(escaped));
+            }
+        }
+    }
+    out_.append(v.data() + run, v.size() - run);
+    out_.push_back('"');
+}
+
+}} // namespace
@@ -0,0 +1,275 @@
+// src/http/RequestParser.cpp
+#include "mercuryTrade/http/RequestParser.hpp"
+#include <cstring>
+#include <limits>
+
+namespace mercuryTrade {
+namespace http {
+
+namespace {
+    bool is_space(char c) {
+        return c == ' ' || c == '\t';
+    }
+
+    int hex_value(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    std::string_view view(const char* data, std::size_t offset, std::size_t length) {
+        return std::string_view(data + offset, length);
+    }
+}
+
+RequestParser::RequestParser(std::size_t max_header_bytes, std::size_t max_body_bytes)
+    : max_header_bytes_(max_header_bytes)
+    , max_body_bytes_(max_body_bytes) {}
+
+void RequestParser::reset() {
+    state_ = State::RequestLine;
+    pos_ = 0;
+    error_status_ = 0;
+    error_ = nullptr;
+    header_count_ = 0;
+    content_length_ = 0;
+    chunked_ = false;
+    chunk_remaining_ = 0;
+    body_start_ = 0;
+    body_end_ = 0;
+    trailers_start_ = 0;
+}
+
+// Finds the next line starting at pos_. The span excludes the line terminator
+// (CRLF, or a bare LF from lenient clients) and pos_ moves past it.
+bool RequestParser::next_line(const char* data, std::size_t size, Span& line) {
+    const void* newline = std::memchr(data + pos_, '\n', size - pos_);
+    if (!newline) {
+        return false;
+    }
+    std::size_t end = static_cast<const char*>(newline) - data;
+    std::size_t length = end - pos_;
+    if (length > 0 && data[end - 1] == '\r') {
+        --length;
+    }
+    line = Span{pos_, length};
+    pos_ = end + 1;
+    return true;
+}
+
+bool RequestParser::parse_request_line(const char* data, const Span& line) {
+    std::string_view text = view(data, line.offset, line.length);
+    std::size_t first = text.find(' ');
+    if (first == std::string_view::npos || first == 0) {
+        return false;
+    }
+    std::size_t second = text.find(' ', first + 1);
+    if (second == std::string_view::npos || second == first + 1) {
+        return false;
+    }
+    std::string_view version = text.substr(second + 1);
+    if (version.substr(0, 5) != "HTTP/") {
+        return false;
+    }
+
+    method_ = Span{line.offset, first};
+    target_ = Span{line.offset + first + 1, second - first - 1};
+    version_ = Span{line.offset + second + 1, version.size()};
+    return true;
+}
+
+bool RequestParser::parse_header(const char* data, const Span& line) {
+    std::string_view text = view(data, line.offset, line.length);
+    std::size_t colon = text.find(':');
+    if (colon == std::string_view::npos || colon == 0 || is_space(text[colon - 1])) {
+        return false;
+    }
+
+    std::size_t value_begin = colon + 1;
+    std::size_t value_end = text.size();
+    while (value_begin < value_end && is_space(text[value_begin])) ++value_begin;
+    while (value_end > value_begin && is_space(text[value_end - 1])) --value_end;
+
+    std::string_view name = text.substr(0, colon);
+    std::string_view value = text.substr(value_begin, value_end - value_begin);
+
+    if (iequals(name, "Content-Length")) {
+        std::size_t length = 0;
+        if (value.empty()) {
+            return false;
+        }
+        for (char c : value) {
+            if (c < '0' || c > '9' || length > (std::numeric_limits<std::size_t>::max() - 9) / 10) {
+                return false;
+            }
+            length = length * 10 + static_cast<std::size_t>(c - '0');
+        }
+        content_length_ = length;
+    } else if (iequals(name, "Transfer-Encoding")) {
+        chunked_ = value.size() >= 7 && iequals(value.substr(value.size() - 7), "chunked");
+    }
+
+    header_spans_[header_count_ * 2] = Span{line.offset, colon};
+    header_spans_[header_count_ * 2 + 1] = Span{line.offset + value_begin, value_end - value_begin};
+    ++header_count_;
+    return true;
+}
+
+void RequestParser::finish(const char* data, Request& req) {
+    req.method = view(data, method_.offset, method_.length);
+    std::string_view target = view(data, target_.offset, target_.length);
+    std::size_t query_start = target.find('?');
+    req.path = target.substr(0, query_start);
+    req.query = query_start == std::string_view::npos ? std::string_view() : target.substr(query_start + 1);
+    req.version = view(data, version_.offset, version_.length);
+
+    req.headers.clear();
+    for (std::size_t i = 0; i < header_count_; ++i) {
+        const Span& name = header_spans_[i * 2];
+        const Span& value = header_spans_[i * 2 + 1];
+        req.headers.add(view(data, name.offset, name.length), view(data, value.offset, value.length));
+    }
+
+    req.body = view(data, body_start_, body_end_ - body_start_);
+    req.params.clear();
+
+    consumed_ = pos_;
+    reset();
+}
+
+RequestParser::Result RequestParser::fail(int status, const char* message) {
+    error_status_ = status;
+    error_ = message;
+    return Result::Error;
+}
+
+RequestParser::Result RequestParser::parse(char* data, std::size_t size, Request& req) {
+    if (error_status_ != 0) {
+        return Result::Error;
+    }
+
+    while (true) {
+        Span line;
+        switch (state_) {
+            case State::RequestLine:
+                if (!next_line(data, size, line)) {
+                    return size > max_header_bytes_ ? fail(431, "Request header too large") : Result::Incomplete;
+                }
+                if (line.length == 0) {
+                    // Tolerate stray CRLF between pipelined requests
+                    break;
+                }
+                if (!parse_request_line(data, line)) {
+                    return fail(400, "Malformed request line");
+                }
+                state_ = State::Headers;
+                break;
+
+            case State::Headers:
+                if (!next_line(data, size, line)) {
+                    return size > max_header_bytes_ ? fail(431, "Request header too large") : Result::Incomplete;
+                }
+                if (pos_ > max_header_bytes_) {
+                    return fail(431, "Request header too large");
+                }
+                if (line.length > 0) {
+                    if (header_count_ == HeaderList::MAX_HEADERS) {
+                        return fail(431, "Too many request headers");
+                    }
+                    if (!parse_header(data, line)) {
+                        return fail(400, "Malformed request header");
+                    }
+                    break;
+                }
+
+                body_start_ = body_end_ = pos_;
+                if (chunked_) {
+                    state_ = State::ChunkSize;
+                } else if (content_length_ > max_body_bytes_) {
+                    return fail(413, "Request body too large");
+                } else if (content_length_ > 0) {
+                    state_ = State::Body;
+                } else {
+                    finish(data, req);
+                    return Result::Complete;
+                }
+                break;
+
+            case State::Body:
+                if (size - body_start_ < content_length_) {
+                    return Result::Incomplete;
+                }
+                body_end_ = body_start_ + content_length_;
+                pos_ = body_end_;
+                finish(data, req);
+                return Result::Complete;
+
+            case State::ChunkSize: {
+                // Size lines may carry extensions, but no more than a header's worth
+                if (!next_line(data, size, line)) {
+                    return size - pos_ > max_header_bytes_ ? fail(431, "Chunk size line too large")
+                                                           : Result::Incomplete;
+                }
+                if (line.length > max_header_bytes_) {
+                    return fail(431, "Chunk size line too large");
+                }
+                std::size_t chunk_size = 0;
+                std::size_t digits = 0;
+                for (; digits < line.length; ++digits) {
+                    int value = hex_value(data[line.offset + digits]);
+                    if (value < 0) break;
+                    if (chunk_size > (max_body_bytes_ >> 4)) {
+                        return fail(413, "Request body too large");
+                    }
+                    chunk_size = (chunk_size << 4) | static_cast<std::size_t>(value);
+                }
+                if (digits == 0) {
+                    return fail(400, "Malformed chunk size");
+                }
+                if (chunk_size == 0) {
+                    trailers_start_ = pos_;
+                    state_ = State::Trailers;
+                } else if (body_end_ - body_start_ + chunk_size > max_body_bytes_) {
+                    return fail(413, "Request body too large");
+                } else {
+                    chunk_remaining_ = chunk_size;
+                    state_ = State::ChunkData;
+                }
+                break;
+            }
+
+            case State::ChunkData:
+                if (size - pos_ < chunk_remaining_ + 2) {
+                    return Result::Incomplete;
+                }
+                if (data[pos_ + chunk_remaining_] != '\r' || data[pos_ + chunk_remaining_ + 1] != '\n') {
+                    return fail(400, "Malformed chunk terminator");
+                }
+                // De-chunk in place: the decoded body never overtakes the read position
+                std::memmove(data + body_end_, data + pos_, chunk_remaining_);
+                body_end_ += chunk_remaining_;
+                pos_ += chunk_remaining_ + 2;
+                chunk_remaining_ = 0;
+                state_ = State::ChunkSize;
+                break;
+
+            case State::Trailers:
+                // The trailer section is held to the same limit as the head
+                if (!next_line(data, size, line)) {
+                    return size - trailers_start_ > max_header_bytes_ ? fail(431, "Request trailers too large")
+                                                                       : Result::Incomplete;
+                }
+                if (pos_ - trailers_start_ > max_header_bytes_) {
+                    return fail(431, "Request trailers too large");
+                }
+                if (line.length == 0) {
+                    finish(data, req);
+                    return Result::Complete;
+                }
+                break;
+        }
+    }
+}
+
+}} // namespace mercuryTrade::http
@@ -0,0 +1,195 @@
+// src/http/ResponseWriter.cpp
+#include "mercuryTrade/http/ResponseWriter.hpp"
+#include "mercuryTrade/http/Server.hpp"
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <vector>
+
+namespace mercuryTrade {
+namespace http {
+
+namespace {
+#ifdef MSG_NOSIGNAL
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL;  // A peer closing a keep-alive socket must not kill the server
+#else
+    constexpr int SEND_FLAGS = 0;
+#endif
+
+    // Preformatted header blocks shared by every response
+    constexpr std::string_view CORS_BLOCK = "Access-Control-Allow-Origin: *\r\n";
+    constexpr std::string_view JSON_CONTENT_TYPE_BLOCK = "Content-Type: application/json\r\n";
+    constexpr std::string_view CLOSE_BLOCK = "Connection: close\r\n";
+    constexpr std::string_view GZIP_BLOCK = "Content-Encoding: gzip\r\n";
+    constexpr std::string_view DEFLATE_BLOCK = "Content-Encoding: deflate\r\n";
+    constexpr std::string_view VARY_BLOCK = "Vary: Accept-Encoding\r\n";
+    constexpr std::string_view CONTENT_LENGTH_PREFIX = "Content-Length: ";
+
+    // Full status lines for every code statusText() knows, built once
+    std::string_view status_line(int status) {
+        static const std::vector<std::string> lines = [] {
+            std::vector<std::string> built(500);
+            for (int code = 100; code < 600; ++code) {
+                std::string_view text = ResponseWriter::statusText(code);
+                if (text != "Unknown") {
+                    built[code - 100] = "HTTP/1.1 " + std::to_string(code) + " " + std::string(text) + "\r\n";
+                }
+            }
+            return built;
+        }();
+        if (status < 100 || status >= 600) {
+            return {};
+        }
+        return lines[status - 100];
+    }
+}
+
+ResponseWriter::ResponseWriter(int fd, std::string_view keep_alive_block, int send_timeout_ms)
+    : fd_(fd)
+    , keep_alive_block_(keep_alive_block)
+    , send_timeout_ms_(send_timeout_ms)
+    , nonblocking_((fcntl(fd, F_GETFL) & O_NONBLOCK) != 0) {
+#ifdef SO_NOSIGPIPE
+    int no_sigpipe = 1;
+    setsockopt(fd_, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+    head_.reserve(512);
+}
+
+const char* ResponseWriter::statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 410: return "Gone";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        default: return "Unknown";
+    }
+}
+
+std::string ResponseWriter::keepAliveBlock(int idle_timeout_ms) {
+    return "Connection: keep-alive\r\nKeep-Alive: timeout=" + std::to_string(idle_timeout_ms / 1000) + "\r\n";
+}
+
+void ResponseWriter::serialize_head(const Response& res, bool keep_alive) {
+    head_.clear();
+
+    std::string_view cached_status = status_line(res.status);
+    if (!cached_status.empty()) {
+        head_.append(cached_status);
+    } else {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), res.status);
+        head_.append("HTTP/1.1 ").append(digits, result.ptr).append(" ").append(statusText(res.status)).append("\r\n");
+    }
+
+    bool has_content_type = false;
+    bool has_cors = false;
+    for (const auto& [key, value] : res.headers) {
+        if (iequals(key, "Content-Type")) {
+            has_content_type = true;
+        } else if (iequals(key, "Access-Control-Allow-Origin")) {
+            has_cors = true;
+        }
+        head_.append(key).append(": ").append(value).append("\r\n");
+    }
+
+    if (!has_cors) {
+        head_.append(CORS_BLOCK);
+    }
+    if (!has_content_type) {
+        if (std::string_view(res.content_type) == "application/json") {
+            head_.append(JSON_CONTENT_TYPE_BLOCK);
+        } else {
+            head_.append("Content-Type: ").append(res.content_type).append("\r\n");
+        }
+    }
+    if (res.content_encoding == ContentEncoding::Gzip) {
+        head_.append(GZIP_BLOCK);
+    } else if (res.content_encoding == ContentEncoding::Deflate) {
+        head_.append(DEFLATE_BLOCK);
+    }
+    if (res.vary_encoding) {
+        head_.append(VARY_BLOCK);
+    }
+    head_.append(keep_alive ? keep_alive_block_ : CLOSE_BLOCK);
+
+    // 204 responses must not carry a Content-Length
+    if (res.status != 204) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), res.bodyView().size());
+        head_.append(CONTENT_LENGTH_PREFIX).append(digits, result.ptr).append("\r\n");
+    }
+    head_.append("\r\n");
+}
+
+bool ResponseWriter::write(const Response& res, bool keep_alive) {
+    serialize_head(res, keep_alive);
+
+    std::string_view body = res.bodyView();
+    struct iovec iov[2];
+    iov[0].iov_base = const_cast<char*>(head_.data());
+    iov[0].iov_len = head_.size();
+    iov[1].iov_base = const_cast<char*>(body.data());
+    iov[1].iov_len = body.size();
+
+    return send_all(iov, body.empty() ? 1 : 2);
+}
+
+bool ResponseWriter::send_all(struct iovec* iov, int count) {
+    while (count > 0) {
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        ssize_t sent = sendmsg(fd_, &msg, SEND_FLAGS);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                if (!nonblocking_) {
+                    // A blocking socket only says this once SO_SNDTIMEO ran out
+                    return false;
+                }
+                // Socket buffer full: wait until the peer drains it
+                struct pollfd pfd;
+                pfd.fd = fd_;
+                pfd.events = POLLOUT;
+                pfd.revents = 0;
+                int ready = poll(&pfd, 1, send_timeout_ms_);
+                if (ready <= 0 || (pfd.revents & (POLLERR | POLLHUP))) {
+                    return false;
+                }
+                continue;
+            }
+            return false;
+        }
+
+        // Short write: skip fully sent vectors and trim the partial one
+        std::size_t remaining = static_cast<std::size_t>(sent);
+        while (count > 0 && remaining >= iov->iov_len) {
+            remaining -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return true;
+}
+
+}} // namespace mercuryTrade::http
@@ -0,0 +1,228 @@
+// src/http/Router.cpp
+#include "mercuryTrade/http/Router.hpp"
+#include "mercuryTrade/http/Server.hpp"
+#include <stdexcept>
+
+namespace mercuryTrade {
+namespace http {
+
+namespace {
+    bool is_integer(std::string_view segment) {
+        std::size_t i = (!segment.empty() && segment[0] == '-') ? 1 : 0;
+        if (i == segment.size()) {
+            return false;
+        }
+        for (; i < segment.size(); ++i) {
+            if (segment[i] < '0' || segment[i] > '9') {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+Method parseMethod(std::string_view method) {
+    if (method == "GET") return Method::Get;
+    if (method == "POST") return Method::Post;
+    if (method == "PUT") return Method::Put;
+    if (method == "DELETE") return Method::Delete;
+    if (method == "PATCH") return Method::Patch;
+    if (method == "HEAD") return Method::Head;
+    if (method == "OPTIONS") return Method::Options;
+    return Method::Unknown;
+}
+
+const char* methodName(Method method) {
+    switch (method) {
+        case Method::Get: return "GET";
+        case Method::Post: return "POST";
+        case Method::Put: return "PUT";
+        case Method::Delete: return "DELETE";
+        case Method::Patch: return "PATCH";
+        case Method::Head: return "HEAD";
+        case Method::Options: return "OPTIONS";
+        default: return "UNKNOWN";
+    }
+}
+
+Router::Router() : root_(std::make_unique<Node>()) {}
+
+Router::~Router() = default;
+
+void Router::add(Method method, const std::string& pattern, RequestHandler handler) {
+    if (method == Method::Unknown) {
+        throw std::invalid_argument("Cannot register route for unknown method");
+    }
+    if (pattern.empty() || pattern[0] != '/') {
+        throw std::invalid_argument("Route pattern must start with '/': " + pattern);
+    }
+
+    Node* node = root_.get();
+    std::size_t pos = 0;
+    while (pos < pattern.size()) {
+        if (pattern[pos] == '{') {
+            std::size_t close = pattern.find('}', pos);
+            if (close == std::string::npos || pattern[pos - 1] != '/' ||
+                (close + 1 < pattern.size() && pattern[close + 1] != '/')) {
+                throw std::invalid_argument("Route parameters must span a whole segment: " + pattern);
+            }
+            node = insert_param(node, std::string_view(pattern).substr(pos + 1, close - pos - 1), pattern);
+            pos = close + 1;
+        } else {
+            std::size_t next = pattern.find('{', pos);
+            if (next == std::string::npos) {
+                next = pattern.size();
+            }
+            node = insert_static(node, std::string_view(pattern).substr(pos, next - pos));
+            pos = next;
+        }
+    }
+
+    auto& slot = node->handlers[static_cast<std::size_t>(method)];
+    slot = std::move(handler);
+    node->has_handlers = true;
+
+    // Precompute the Allow header used for 405 responses
+    node->allow.clear();
+    for (std::size_t i = 0; i < node->handlers.size(); ++i) {
+        if (node->handlers[i]) {
+            if (!node->allow.empty()) {
+                node->allow += ", ";
+            }
+            node->allow += methodName(static_cast<Method>(i));
+        }
+    }
+}
+
+Router::Node* Router::insert_static(Node* node, std::string_view text) {
+    while (!text.empty()) {
+        std::unique_ptr<Node>* slot = nullptr;
+        for (auto& child : node->children) {
+            if (child->label[0] == text[0]) {
+                slot = &child;
+                break;
+            }
+        }
+
+        if (!slot) {
+            auto child = std::make_unique<Node>();
+            child->label = std::string(text);
+            node->children.push_back(std::move(child));
+            return node->children.back().get();
+        }
+
+        Node* child = slot->get();
+        std::size_t common = 0;
+        while (common < child->label.size() && common < text.size() && child->label[common] == text[common]) {
+            ++common;
+        }
+
+        if (common < child->label.size()) {
+            // Split the edge: a new node takes the shared prefix
+            auto split = std::make_unique<Node>();
+            split->label = child->label.substr(0, common);
+            (*slot)->label.erase(0, common);
+            split->children.push_back(std::move(*slot));
+            *slot = std::move(split);
+            child = slot->get();
+        }
+
+        text.remove_prefix(common);
+        node = child;
+    }
+    return node;
+}
+
+Router::Node* Router::insert_param(Node* node, std::string_view spec, const std::string& pattern) {
+    std::string_view name = spec;
+    ParamType type = ParamType::String;
+
+    std::size_t colon = spec.find(':');
+    if (colon != std::string_view::npos) {
+        name = spec.substr(0, colon);
+        std::string_view type_name = spec.substr(colon + 1);
+        if (type_name == "int") {
+            type = ParamType::Int;
+        } else if (type_name != "string") {
+            throw std::invalid_argument("Unknown route parameter type in: " + pattern);
+        }
+    }
+    if (name.empty()) {
+        throw std::invalid_argument("Route parameter without a name in: " + pattern);
+    }
+
+    std::unique_ptr<Node>& slot = (type == ParamType::Int) ? node->int_param : node->string_param;
+    if (!slot) {
+        slot = std::make_unique<Node>();
+        slot->param_name = std::string(name);
+    } else if (slot->param_name != name) {
+        throw std::invalid_argument("Conflicting route parameter names in: " + pattern);
+    }
+    return slot.get();
+}
+
+const Router::Node* Router::find(const Node* node, std::string_view path, std::size_t pos, PathParams& params) const {
+    if (pos == path.size()) {
+        return node->has_handlers ? node : nullptr;
+    }
+
+    // Static edges win; first bytes are unique so at most one can match
+    for (const auto& child : node->children) {
+        if (child->label[0] == path[pos]) {
+            if (path.compare(pos, child->label.size(), child->label) == 0) {
+                if (const Node* found = find(child.get(), path, pos + child->label.size(), params)) {
+                    return found;
+                }
+            }
+            break;
+        }
+    }
+
+    if (!node->int_param && !node->string_param) {
+        return nullptr;
+    }
+
+    std::size_t end = path.find('/', pos);
+    if (end == std::string_view::npos) {
+        end = path.size();
+    }
+    std::string_view segment = path.substr(pos, end - pos);
+    if (segment.empty()) {
+        return nullptr;
+    }
+
+    for (const Node* param : {node->int_param.get(), node->string_param.get()}) {
+        if (!param || (param == node->int_param.get() && !is_integer(segment))) {
+            continue;
+        }
+        if (!params.add(param->param_name, segment)) {
+            return nullptr;
+        }
+        if (const Node* found = find(param, path, end, params)) {
+            return found;
+        }
+        params.pop();
+    }
+    return nullptr;
+}
+
+Router::Match Router::match(Method method, std::string_view path, PathParams& params) const {
+    params.clear();
+    Match result;
+
+    const Node* node = find(root_.get(), path, 0, params);
+    if (!node) {
+        return result;
+    }
+
+    result.allow = node->allow.c_str();
+    if (method != Method::Unknown) {
+        const auto& handler = node->handlers[static_cast<std::size_t>(method)];
+        if (handler) {
+            result.handler = &handler;
+        }
+    }
+    return result;
+}
+
+}} // namespace mercuryTrade::http
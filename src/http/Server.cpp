@@ -1,17 +1,27 @@
 // src/http/Server.cpp
 #include "mercuryTrade/http/Server.hpp"
+#include "mercuryTrade/http/RequestParser.hpp"
+#include "mercuryTrade/http/ResponseWriter.hpp"
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <unistd.h>
 #include <iostream>
-#include <sstream>
 #include <thread>
-#include <regex>
+#include <cstring>
+#include <algorithm>
+#include <sys/time.h>
 
 namespace mercuryTrade {
 namespace http {
 
-Server::Server(int port) : port_(port) {
+namespace {
+    constexpr std::size_t READ_CHUNK_SIZE = 4096;
+}
+
+Server::Server(int port, const ServerOptions& options)
+    : port_(port)
+    , options_(options)
+    , keep_alive_block_(ResponseWriter::keepAliveBlock(options.idle_timeout_ms)) {
     server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
     if (server_fd_ < 0) {
         throw std::runtime_error("Failed to create socket");
@@ -57,159 +67,176 @@ void Server::start() {
 }
 
 void Server::handle_connection(int client_fd) {
-    char buffer[4096] = {0};
-    ssize_t bytes_read = read(client_fd, buffer, sizeof(buffer));
-    
-    if (bytes_read > 0) {
-        Request req = parse_request(std::string(buffer, bytes_read));
-        Response res;
-
-        // Handle CORS preflight
-        if (req.method == "OPTIONS") {
-            res.headers["Access-Control-Allow-Origin"] = "*";
-            res.headers["Access-Control-Allow-Methods"] = "GET, POST, PUT, DELETE, OPTIONS";
-            res.headers["Access-Control-Allow-Headers"] = "Content-Type, Authorization";
-            res.status = 204;
-        } else {
-            // Find and execute route handler
-            std::string route_key = req.method + " " + req.path;
-            auto handler = route_handlers_.find(route_key);
-            
-            if (handler != route_handlers_.end()) {
-                try {
-                    res = handler->second(req);
-                } catch (const std::exception& e) {
-                    res = Response::json({{"error", e.what()}}, 500);
-                }
-            } else {
-                res = Response::json({{"error", "Not Found"}}, 404);
+    // Idle keep-alive connections are reaped by the receive timeout
+    struct timeval timeout;
+    timeout.tv_sec = options_.idle_timeout_ms / 1000;
+    timeout.tv_usec = (options_.idle_timeout_ms % 1000) * 1000;
+    setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    timeout.tv_sec = options_.send_timeout_ms / 1000;
+    timeout.tv_usec = (options_.send_timeout_ms % 1000) * 1000;
+    setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // Reusable connection buffer: [start, end) holds bytes not yet consumed
+    std::vector<char> buffer(READ_CHUNK_SIZE);
+    std::size_t start = 0;
+    std::size_t end = 0;
+    const std::size_t max_buffer =
+        std::max(READ_CHUNK_SIZE, options_.max_header_bytes + options_.max_body_bytes);
+
+    RequestParser parser(options_.max_header_bytes, options_.max_body_bytes);
+    ResponseWriter writer(client_fd, keep_alive_block_, options_.send_timeout_ms);
+    Request req;
+    std::string compressed;  // Reused output buffer for per-response compression
+    std::size_t served = 0;
+    bool keep_alive = true;
+
+    while (keep_alive) {
+        // Answer every complete request already buffered, in arrival order
+        while (keep_alive && start < end) {
+            auto result = parser.parse(buffer.data() + start, end - start, req);
+            if (result == RequestParser::Result::Incomplete) {
+                break;
+            }
+            if (result == RequestParser::Result::Error) {
+                writer.write(Response::json({{"error", parser.error()}}, parser.errorStatus()), false);
+                keep_alive = false;
+                break;
             }
-        }
-
-        // Add CORS headers to all responses
-        res.headers["Access-Control-Allow-Origin"] = "*";
-        
-        send_response(client_fd, res);
-    }
 
-    close(client_fd);
-}
+            keep_alive = wants_keep_alive(req) && ++served < options_.max_requests_per_connection;
 
-Request Server::parse_request(const std::string& raw_request) {
-    Request req;
-    std::istringstream stream(raw_request);
-    std::string line;
-
-    // Parse request line
-    std::getline(stream, line);
-    std::istringstream request_line(line);
-    request_line >> req.method >> req.path;
-
-    // Extract route parameters
-    for (const auto& [route_pattern, _] : route_handlers_) {
-        std::regex pattern(route_pattern_to_regex(route_pattern));
-        std::smatch matches;
-        if (std::regex_match(req.path, matches, pattern)) {
-            std::vector<std::string> param_names = extract_param_names(route_pattern);
-            for (size_t i = 1; i < matches.size() && i-1 < param_names.size(); ++i) {
-                req.params[param_names[i-1]] = matches[i].str();
+            Response res = dispatch(req);
+            compress_response(req, res, compressed);
+            if (!writer.write(res, keep_alive)) {
+                keep_alive = false;
             }
+            start += parser.consumed();
+        }
+
+        if (!keep_alive) {
             break;
         }
-    }
 
-    // Parse headers
-    while (std::getline(stream, line) && line != "\r") {
-        auto separator = line.find(':');
-        if (separator != std::string::npos) {
-            std::string key = line.substr(0, separator);
-            std::string value = line.substr(separator + 2, line.length() - separator - 3);
-            req.headers[key] = value;
+        // Make room for the next read; the parser only tracks relative offsets
+        if (start == end) {
+            start = end = 0;
+        } else if (start > 0) {
+            std::memmove(buffer.data(), buffer.data() + start, end - start);
+            end -= start;
+            start = 0;
+        }
+        if (buffer.size() - end < READ_CHUNK_SIZE && buffer.size() < max_buffer) {
+            buffer.resize(std::min(buffer.size() * 2, max_buffer));
+        }
+        if (end == buffer.size()) {
+            // One request never needs more than its head and body limits
+            writer.write(Response::json({{"error", "Request too large"}}, 413), false);
+            break;
         }
-    }
 
-    // Read body
-    std::stringstream body_stream;
-    while (std::getline(stream, line)) {
-        body_stream << line << "\n";
+        // Peer closed, error, or idle timeout all end the connection
+        ssize_t bytes_read = recv(client_fd, buffer.data() + end, buffer.size() - end, 0);
+        if (bytes_read <= 0) {
+            break;
+        }
+        end += static_cast<std::size_t>(bytes_read);
     }
-    req.body = body_stream.str();
 
-    return req;
+    close(client_fd);
 }
 
-void Server::send_response(int client_fd, const Response& res) {
-    std::stringstream response_stream;
-    response_stream << "HTTP/1.1 " << res.status << " " << get_status_text(res.status) << "\r\n";
-    
-    // Add content type if not present
-    if (res.headers.find("Content-Type") == res.headers.end()) {
-        response_stream << "Content-Type: application/json\r\n";
-    }
+Response Server::dispatch(Request& req) {
+    Response res;
 
-    // Add other headers
-    for (const auto& [key, value] : res.headers) {
-        response_stream << key << ": " << value << "\r\n";
+    // Handle CORS preflight
+    if (req.method == "OPTIONS") {
+        res.headers["Access-Control-Allow-Origin"] = "*";
+        res.headers["Access-Control-Allow-Methods"] = "GET, POST, PUT, DELETE, OPTIONS";
+        res.headers["Access-Control-Allow-Headers"] = "Content-Type, Authorization";
+        res.status = 204;
+    } else {
+        auto match = router_.match(parseMethod(req.method), req.path, req.params);
+        
+        if (match.handler) {
+            try {
+                res = (*match.handler)(req);
+            } catch (const std::exception& e) {
+                res = Response::json({{"error", e.what()}}, 500);
+            }
+        } else if (match.allow) {
+            res = Response::json({{"error", "Method Not Allowed"}}, 405);
+            res.headers["Allow"] = match.allow;
+        } else {
+            res = Response::json({{"error", "Not Found"}}, 404);
+        }
     }
 
-    // Add content length and body
-    response_stream << "Content-Length: " << res.body.length() << "\r\n\r\n";
-    response_stream << res.body;
-
-    std::string response_str = response_stream.str();
-    send(client_fd, response_str.c_str(), response_str.length(), 0);
+    return res;
 }
 
-std::string Server::route_pattern_to_regex(const std::string& pattern) {
-    std::string regex_str = pattern;
-    std::regex param_regex("\\{([^}]+)\\}");
-    regex_str = std::regex_replace(regex_str, param_regex, "([^/]+)");
-    return "^" + regex_str + "$";
-}
+void Server::compress_response(const Request& req, Response& res, std::string& scratch) const {
+    if (!options_.compression || res.status == 204 || res.status == 304 ||
+        res.bodyView().size() < options_.compression_min_bytes ||
+        res.content_encoding != ContentEncoding::Identity) {
+        return;
+    }
+    for (const auto& [key, value] : res.headers) {
+        if (iequals(key, "Content-Encoding")) {
+            return;
+        }
+    }
 
-std::vector<std::string> Server::extract_param_names(const std::string& pattern) {
-    std::vector<std::string> names;
-    std::regex param_regex("\\{([^}]+)\\}");
-    auto param_begin = std::sregex_iterator(pattern.begin(), pattern.end(), param_regex);
-    auto param_end = std::sregex_iterator();
+    res.vary_encoding = true;
+    ContentEncoding encoding = negotiateEncoding(req.headers.get("Accept-Encoding"));
+    if (encoding == ContentEncoding::Identity) {
+        return;
+    }
 
-    for (auto it = param_begin; it != param_end; ++it) {
-        names.push_back((*it)[1].str());
+    try {
+        if (res.payload) {
+            // Immutable snapshots keep their compressed form for the next poll
+            res.shared_body = res.payload->encoded(encoding);
+        } else {
+            // Swap so the old body's capacity becomes the next response's scratch space
+            compress(res.body, encoding, scratch, options_.compression_level);
+            res.body.swap(scratch);
+        }
+        res.content_encoding = encoding;
+    } catch (const std::exception& e) {
+        // Identity is always acceptable; send the body uncompressed
+        std::cerr << "Response compression failed: " << e.what() << std::endl;
     }
-    return names;
 }
 
-std::string Server::get_status_text(int status) {
-    switch (status) {
-        case 200: return "OK";
-        case 201: return "Created";
-        case 204: return "No Content";
-        case 400: return "Bad Request";
-        case 401: return "Unauthorized";
-        case 404: return "Not Found";
-        case 500: return "Internal Server Error";
-        default: return "Unknown";
+bool Server::wants_keep_alive(const Request& req) const {
+    std::string_view connection = req.headers.get("Connection");
+
+    // HTTP/1.1 defaults to persistent connections, HTTP/1.0 must opt in.
+    // The header is a token list, e.g. "keep-alive, Upgrade".
+    if (hasToken(connection, "close")) {
+        return false;
     }
+    return req.version != "HTTP/1.0" || hasToken(connection, "keep-alive");
 }
 
-void Server::register_route(const std::string& method, const std::string& path, RequestHandler handler) {
-    route_handlers_[method + " " + path] = std::move(handler);
+void Server::register_route(Method method, const std::string& path, RequestHandler handler) {
+    router_.add(method, path, std::move(handler));
 }
 
 void Server::get(const std::string& path, RequestHandler handler) {
-    register_route("GET", path, std::move(handler));
+    register_route(Method::Get, path, std::move(handler));
 }
 
 void Server::post(const std::string& path, RequestHandler handler) {
-    register_route("POST", path, std::move(handler));
+    register_route(Method::Post, path, std::move(handler));
 }
 
 void Server::put(const std::string& path, RequestHandler handler) {
-    register_route("PUT", path, std::move(handler));
+    register_route(Method::Put, path, std::move(handler));
 }
 
 void Server::del(const std::string& path, RequestHandler handler) {
-    register_route("DELETE", path, std::move(handler));
+    register_route(Method::Delete, path, std::move(handler));
 }
 
 }} // namespace mercuryTrade::http
\ No newline at end of file
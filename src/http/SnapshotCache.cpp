@@ -0,0 +1,95 @@
+// src/http/SnapshotCache.cpp
+#include "mercuryTrade/http/SnapshotCache.hpp"
+
+namespace mercuryTrade {
+namespace http {
+
+SnapshotCache::SnapshotCache(unsigned max_rebuilds_per_second, int compression_level, std::size_t max_entries)
+    : min_interval_(max_rebuilds_per_second == 0
+          ? std::chrono::steady_clock::duration::zero()
+          : std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::seconds(1)) / max_rebuilds_per_second)
+    , compression_level_(compression_level)
+    , max_entries_(max_entries) {}
+
+SnapshotCache::Entry* SnapshotCache::entry(const std::string& key) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            return it->second.get();
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        return it->second.get();
+    }
+    if (entries_.size() >= max_entries_) {
+        return nullptr;
+    }
+    return entries_.emplace(key, std::make_unique<Entry>()).first->second.get();
+}
+
+bool SnapshotCache::usable(const Snapshot* snapshot, std::uint64_t version,
+                           std::chrono::steady_clock::time_point now) {
+    if (!snapshot) {
+        return false;
+    }
+    if (snapshot->version == version) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    if (now - snapshot->built_at < min_interval_) {
+        throttled_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+std::shared_ptr<const Payload> SnapshotCache::get(const std::string& key, std::uint64_t version,
+                                                  const Builder& build) {
+    Entry* found = entry(key);
+    if (!found) {
+        rebuilds_.fetch_add(1, std::memory_order_relaxed);
+        return Payload::make(build(), compression_level_);
+    }
+    Entry& e = *found;
+    auto now = std::chrono::steady_clock::now();
+
+    auto snapshot = std::atomic_load(&e.current);
+    if (usable(snapshot.get(), version, now)) {
+        return snapshot->payload;
+    }
+
+    std::lock_guard<std::mutex> lock(e.build_mutex);
+    // Another caller may have rebuilt it while we waited
+    snapshot = std::atomic_load(&e.current);
+    if (usable(snapshot.get(), version, now)) {
+        return snapshot->payload;
+    }
+
+    auto fresh = std::make_shared<const Snapshot>(Snapshot{
+        version, std::chrono::steady_clock::now(), Payload::make(build(), compression_level_)});
+    std::atomic_store(&e.current, fresh);
+    rebuilds_.fetch_add(1, std::memory_order_relaxed);
+    return fresh->payload;
+}
+
+void SnapshotCache::invalidate(const std::string& key) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        std::atomic_store(&it->second->current, std::shared_ptr<const Snapshot>());
+    }
+}
+
+SnapshotCache::Stats SnapshotCache::stats() const {
+    return Stats{
+        hits_.load(std::memory_order_relaxed),
+        rebuilds_.load(std::memory_order_relaxed),
+        throttled_.load(std::memory_order_relaxed)
+    };
+}
+
+}} // namespace
@@ -0,0 +1,81 @@
+// src/services/BookEventPublisher.cpp
+#include "../../include/mercuryTrade/services/BookEventPublisher.hpp"
+#include <iostream>
+
+namespace mercuryTrade {
+
+BookEventPublisher::~BookEventPublisher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void BookEventPublisher::start(OrderBookService& books) {
+    books.addDeltaListener([this](const std::string& symbol, const core::memory::LevelDelta& delta) {
+        enqueue(symbol, delta);
+    });
+    books.addFillListener([this](const std::string& symbol, const core::memory::BookFill& fill) {
+        enqueue(symbol, fill);
+    });
+    books.addTopListener([this](const std::string& symbol, const core::memory::BookTop& top) {
+        enqueue(symbol, top);
+    });
+    thread_ = std::thread([this]() { run(); });
+}
+
+std::size_t BookEventPublisher::backlog() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+template <typename T>
+void BookEventPublisher::enqueue(const std::string& symbol, const T& data) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(Event{symbol, data});
+    }
+    ready_.notify_one();
+}
+
+void BookEventPublisher::run() {
+    std::vector<Event> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return;  // Stopping, and everything queued has been published
+            }
+            batch.swap(pending_);
+        }
+
+        for (const auto& event : batch) {
+            try {
+                if (const auto* delta = std::get_if<core::memory::LevelDelta>(&event.data)) {
+                    for (const auto& listener : deltaListeners_) {
+                        listener(event.symbol, *delta);
+                    }
+                } else if (const auto* fill = std::get_if<core::memory::BookFill>(&event.data)) {
+                    for (const auto& listener : fillListeners_) {
+                        listener(event.symbol, *fill);
+                    }
+                } else {
+                    const auto& top = std::get<core::memory::BookTop>(event.data);
+                    for (const auto& listener : topListeners_) {
+                        listener(event.symbol, top);
+                    }
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Book event publisher: " << e.what() << std::endl;
+            }
+        }
+        batch.clear();
+    }
+}
+
+} // namespace mercuryTrade
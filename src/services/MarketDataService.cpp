@@ -1,10 +1,34 @@
 // src/services/MarketDataService.cpp
 #include "../../include/mercuryTrade/services/MarketDataService.hpp"
+#include "../../include/mercuryTrade/core/analytics/mercAnalyticsKernels.hpp"
 #include <chrono>
+#include <stdexcept>
 
 namespace mercuryTrade {
 
+MarketDataService::MarketDataService(std::shared_ptr<const core::memory::LastValueCache> cache,
+                                     std::shared_ptr<const core::memory::BarAggregator> bars,
+                                     std::shared_ptr<const core::memory::TickStore> ticks)
+    : cache_(std::move(cache))
+    , bars_(std::move(bars))
+    , ticks_(std::move(ticks)) {}
+
 MarketData MarketDataService::getMarketData(const std::string& symbol) {
+    if (cache_) {
+        core::memory::LastValueCache::Values values;
+        if (!cache_->read(symbol, values)) {
+            throw std::invalid_argument("No market data for " + symbol);
+        }
+        MarketData data;
+        data.symbol = symbol;
+        data.bid = values.bid;
+        data.ask = values.ask;
+        data.last = values.last;
+        data.volume = values.volume;
+        data.timestamp = static_cast<long>(values.timestamp);
+        return data;
+    }
+
     // In a real implementation, this would fetch real market data
     // This is just a mock implementation
     MarketData data;
@@ -19,7 +43,101 @@ MarketData MarketDataService::getMarketData(const std::string& symbol) {
 }
 
 std::vector<std::string> MarketDataService::getAvailableSymbols() const {
+    if (cache_) {
+        return cache_->symbols();
+    }
     return {"BTC-USD", "ETH-USD", "SOL-USD"};
 }
 
-} // namespace
\ No newline at end of file
+BarSeries MarketDataService::getBars(const std::string& symbol, const std::string& interval, std::int64_t from,
+                                     std::int64_t to, std::size_t limit) const {
+    if (!bars_) {
+        throw std::runtime_error("Bars are not available");
+    }
+    BarSeries series;
+    series.symbol = symbol;
+    series.interval = core::memory::BarAggregator::parseInterval(interval);
+    series.bars = bars_->range(symbol, series.interval, from, to, limit);
+    return series;
+}
+
+TradeHistory MarketDataService::getTrades(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                          std::size_t limit) const {
+    if (!ticks_) {
+        throw std::runtime_error("Trade history is not kept");
+    }
+    TradeHistory history;
+    history.symbol = symbol;
+    history.trades = ticks_->trades(symbol, from, to, limit);
+    return history;
+}
+
+HistoryBars MarketDataService::getHistory(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                          std::int64_t bucket, std::size_t limit) const {
+    if (!ticks_) {
+        throw std::runtime_error("Trade history is not kept");
+    }
+    HistoryBars history;
+    history.symbol = symbol;
+    history.bucket = bucket;
+    history.bars = ticks_->downsampleTrades(symbol, from, to, bucket, limit);
+    return history;
+}
+
+MarketAnalysis MarketDataService::getAnalysis(const std::string& symbol, std::int64_t from, std::int64_t to,
+                                              std::size_t window, std::size_t buckets,
+                                              std::size_t max_trades) const {
+    if (!ticks_) {
+        throw std::runtime_error("Trade history is not kept");
+    }
+    namespace analytics = core::analytics;
+    const analytics::Kernels& kernels = analytics::kernels();
+    core::memory::TradeColumns columns = ticks_->tradeColumns(symbol, from, to, max_trades);
+    const std::size_t count = columns.prices.size();
+
+    MarketAnalysis analysis{symbol, count, 0, 0, 0.0, 0.0, 0.0, 0.0, window, 0.0, 0.0, 0.0, {}, kernels.name};
+    analysis.profile.assign(buckets, 0.0);
+    if (count == 0) {
+        return analysis;
+    }
+    analysis.first = columns.timestamps.front();
+    analysis.last = columns.timestamps.back();
+
+    analytics::VwapResult vwap = kernels.vwap(columns.prices.data(), columns.quantities.data(), count);
+    analysis.vwap = vwap.vwap;
+    analysis.volume = vwap.volume;
+    analytics::MinMax range = kernels.minMax(columns.prices.data(), count);
+    analysis.low = range.min;
+    analysis.high = range.max;
+
+    // Only the latest window is reported, so only its window + 1 prices are read
+    if (analytics::rollingVolatilityCount(count, window) > 0) {
+        kernels.rollingVolatility(columns.prices.data() + count - window - 1, window + 1, window,
+                                  &analysis.volatility);
+    }
+
+    // Buckets split [low, high]; one spare bucket takes the trades exactly
+    // at high and is folded into the last
+    analysis.profile_low = range.min;
+    analysis.bucket_width = range.max > range.min ? (range.max - range.min) / static_cast<double>(buckets) : 1.0;
+    analysis.profile.push_back(0.0);
+    kernels.volumeProfile(columns.prices.data(), columns.quantities.data(), count, analysis.profile_low,
+                          analysis.bucket_width, buckets + 1, analysis.profile.data());
+    analysis.profile[buckets - 1] += analysis.profile[buckets];
+    analysis.profile.pop_back();
+    return analysis;
+}
+
+std::string MarketDataService::barToJson(const std::string& symbol, core::memory::BarInterval interval,
+                                         const core::memory::Bar& bar) {
+    std::string out;
+    http::JsonWriter writer(out);
+    writer.beginObject()
+          .field("symbol", symbol)
+          .field("interval", core::memory::BarAggregator::intervalName(interval))
+          .field("bar", bar)
+          .endObject();
+    return out;
+}
+
+} // namespace
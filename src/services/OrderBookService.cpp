@@ -1,34 +1,169 @@
 // src/services/OrderBookService.cpp
 #include "../../include/mercuryTrade/services/OrderBookService.hpp"
 #include <chrono>
+#include <iostream>
 
 namespace mercuryTrade {
 
-OrderBook OrderBookService::getOrderBook(const std::string& symbol) {
-    // Mock implementation
-    OrderBook book;
-    book.symbol = symbol;
-    book.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-
-    // Add some sample bids
-    book.bids = {
-        {49990.0, 1.5},
-        {49980.0, 2.0},
-        {49970.0, 2.5}
-    };
+namespace {
 
-    // Add some sample asks
-    book.asks = {
-        {50010.0, 1.0},
-        {50020.0, 1.8},
-        {50030.0, 2.2}
-    };
+std::int64_t busTimestamp() {
+    return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+OrderBookService::OrderBookService(std::size_t deltaHistory, unsigned snapshotRebuildsPerSecond,
+                                   const core::memory::OrderBookAllocator::Config& config)
+    : deltaHistory_(deltaHistory)
+    , allocator_(config)
+    , snapshotCache_(snapshotRebuildsPerSecond) {}
+
+OrderBookService::SymbolBook& OrderBookService::symbolBook(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = books_.find(symbol);
+    if (it != books_.end()) {
+        return it->second;
+    }
+
+    SymbolBook entry;
+    entry.book = std::make_unique<core::memory::LimitOrderBook>(symbol, allocator_);
+    entry.history = std::make_unique<core::memory::LevelDeltaLog>(deltaHistory_);
+
+    auto* history = entry.history.get();
+    const std::string* name = &entry.book->symbol();
+    auto* bus = marketDataBus_;
+    core::memory::BusChannel* channel = nullptr;
+    if (bus) {
+        try {
+            channel = bus->channel(symbol);
+        } catch (const std::exception& e) {
+            std::cerr << "Market data bus: " << e.what() << "; " << symbol << " will not be published" << std::endl;
+        }
+    }
+    entry.book->setDeltaListener([this, history, name](const core::memory::LevelDelta& delta) {
+        history->append(delta);
+        for (const auto& listener : deltaListeners_) {
+            listener(*name, delta);
+        }
+    });
+    entry.book->setFillListener([this, name, bus, channel](const core::memory::BookFill& fill) {
+        if (channel) {
+            bus->publishTrade(channel, {fill.trade_id, fill.price, fill.quantity, busTimestamp(),
+                                        fill.taker_side == core::memory::BookSide::BID});
+        }
+        for (const auto& listener : fillListeners_) {
+            listener(*name, fill);
+        }
+    });
+    entry.book->setTopListener([this, name, bus, channel](const core::memory::BookTop& top) {
+        if (channel) {
+            bus->publishQuote(channel, {top.seq, top.bid, top.bid_size, top.ask, top.ask_size, busTimestamp()});
+        }
+        for (const auto& listener : topListeners_) {
+            listener(*name, top);
+        }
+    });
+
+    return books_.emplace(symbol, std::move(entry)).first->second;
+}
+
+core::memory::LimitOrderBook& OrderBookService::book(const std::string& symbol) {
+    return *symbolBook(symbol).book;
+}
+
+std::vector<std::string> OrderBookService::symbols() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> result;
+    result.reserve(books_.size());
+    for (const auto& entry : books_) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
+std::vector<core::memory::LimitOrderBook*> OrderBookService::books() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<core::memory::LimitOrderBook*> result;
+    result.reserve(books_.size());
+    for (const auto& entry : books_) {
+        result.push_back(entry.second.book.get());
+    }
+    return result;
+}
+
+OrderBook OrderBookService::getOrderBook(const std::string& symbol, const OrderBookQuery& query) {
+    auto snapshot = book(symbol).snapshot(query.depth, query.tick);
+
+    OrderBook result;
+    result.symbol = symbol;
+    result.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+    result.seq = snapshot.seq;
+    result.cumulative = query.cumulative;
+
+    double total = 0.0;
+    result.bids.reserve(snapshot.bids.size());
+    for (const auto& level : snapshot.bids) {
+        total += level.size;
+        result.bids.push_back({level.price, level.size, total});
+    }
+    total = 0.0;
+    result.asks.reserve(snapshot.asks.size());
+    for (const auto& level : snapshot.asks) {
+        total += level.size;
+        result.asks.push_back({level.price, level.size, total});
+    }
+    return result;
+}
 
-    return book;
+std::shared_ptr<const http::Payload> OrderBookService::getOrderBookPayload(const std::string& symbol,
+                                                                           const OrderBookQuery& query) {
+    std::string key = symbol;
+    if (!query.isDefault()) {
+        key.append("?depth=").append(std::to_string(query.depth))
+           .append("&tick=").append(std::to_string(query.tick))
+           .append(query.cumulative ? "&cumulative" : "");
+    }
+
+    // The book's delta sequence doubles as its version
+    std::uint64_t version = book(symbol).sequence();
+    return snapshotCache_.get(key, version, [&]() {
+        std::string body;
+        http::JsonWriter(body).value(getOrderBook(symbol, query));
+        return body;
+    });
+}
+
+std::optional<std::vector<core::memory::LevelDelta>> OrderBookService::getDeltasSince(
+    const std::string& symbol, std::uint64_t afterSeq) {
+    std::vector<core::memory::LevelDelta> deltas;
+    if (!symbolBook(symbol).history->since(afterSeq, deltas)) {
+        return std::nullopt;
+    }
+    return deltas;
+}
+
+nlohmann::json OrderBookService::deltaToJson(const core::memory::LevelDelta& delta) {
+    return {
+        {"seq", delta.seq},
+        {"side", delta.side == core::memory::BookSide::BID ? "bid" : "ask"},
+        {"price", delta.price},
+        {"quantity", delta.size},
+        {"orders", delta.order_count}
+    };
 }
 
-void OrderBookService::updateOrderBook(const std::string& symbol, const OrderBook& book) {
-    // Would update internal order book state
+void OrderBookService::deltaToBinary(const std::string& symbol, const core::memory::LevelDelta& delta,
+                                     std::string& out) {
+    wire::BookDelta message;
+    message.symbol.assign(symbol);
+    message.seq = delta.seq;
+    message.price = delta.price;
+    message.quantity = delta.size;
+    message.orders = static_cast<std::uint32_t>(delta.order_count);
+    message.side = delta.side == core::memory::BookSide::BID ? wire::Side::Buy : wire::Side::Sell;
+    wire::encode(message, out);
 }
 
-} // namespace
\ No newline at end of file
+} // namespace
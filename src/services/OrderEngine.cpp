@@ -0,0 +1,62 @@
+// src/services/OrderEngine.cpp
+#include "../../include/mercuryTrade/services/OrderEngine.hpp"
+#include <stdexcept>
+
+namespace mercuryTrade {
+
+OrderEngine::OrderEngine(const Manager::Config& config)
+    : manager_(config) {
+    if (!manager_.start()) {
+        throw std::runtime_error("Failed to start trading manager");
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+OrderEngine::~OrderEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    manager_.stop();
+}
+
+OrderEngine::Manager::Stats OrderEngine::stats() {
+    return post([](Manager& manager) { return manager.getStats(); }).get();
+}
+
+void OrderEngine::enqueue(Command command) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            throw std::runtime_error("Order engine is shutting down");
+        }
+        pending_.push_back(std::move(command));
+    }
+    ready_.notify_one();
+}
+
+void OrderEngine::run() {
+    std::vector<Command> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return;  // Stopping, and everything posted has run
+            }
+            batch.swap(pending_);
+        }
+
+        // Tasks capture their own exceptions for the waiting caller
+        for (auto& command : batch) {
+            command(manager_);
+        }
+        batch.clear();
+    }
+}
+
+} // namespace mercuryTrade
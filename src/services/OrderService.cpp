@@ -1,54 +1,745 @@
 // src/services/OrderService.cpp
 #include "../../include/mercuryTrade/services/OrderService.hpp"
+#include "../../include/mercuryTrade/core/memory/mercSnapshotFile.hpp"
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
-#include <random>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <sys/wait.h>
+#include <unistd.h>
 
 namespace mercuryTrade {
 
+namespace {
+    // Snapshot payload: u32 version, u64 journal sequence, u64 next order
+    // sequence, the orders, each book's symbol and saved state, then the
+    // risk engine's positions. Version 1 had no accounts and no positions.
+    constexpr std::uint32_t SNAPSHOT_FORMAT = 2;
+    constexpr const char* SNAPSHOT_PREFIX = "snapshot-";
+    constexpr const char* SNAPSHOT_SUFFIX = ".bin";
+
+    bool isOpen(const Order& order) {
+        return order.status == OrderStatus::New || order.status == OrderStatus::PartiallyFilled;
+    }
+
+    // Zero-padded, so names sort in sequence order
+    std::string snapshotName(std::uint64_t sequence) {
+        char name[48];
+        std::snprintf(name, sizeof(name), "%s%020llu%s", SNAPSHOT_PREFIX,
+                      static_cast<unsigned long long>(sequence), SNAPSHOT_SUFFIX);
+        return name;
+    }
+
+    bool isSnapshotFile(const std::filesystem::path& path) {
+        std::string name = path.filename().string();
+        return name.size() == snapshotName(0).size() && name.rfind(SNAPSHOT_PREFIX, 0) == 0 &&
+               path.extension() == SNAPSHOT_SUFFIX;
+    }
+
+    std::vector<std::filesystem::path> snapshotFiles(const std::string& directory) {
+        std::vector<std::filesystem::path> files;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (entry.is_regular_file() && isSnapshotFile(entry.path())) {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    void putOrder(core::memory::SnapshotWriter& out, const Order& order) {
+        out.putString(order.id);
+        out.putString(order.symbol);
+        out.putU8(static_cast<std::uint8_t>(order.side));
+        out.putU8(static_cast<std::uint8_t>(order.type));
+        out.putU8(static_cast<std::uint8_t>(order.status));
+        out.putDouble(order.quantity);
+        out.putDouble(order.price);
+        out.putDouble(order.filled_quantity);
+        out.putU64(static_cast<std::uint64_t>(order.timestamp));
+        out.putString(order.account);
+    }
+
+    Order getOrder(core::memory::SnapshotReader& in, std::uint32_t format) {
+        Order order{};
+        order.id = in.getString();
+        order.symbol = in.getString();
+        order.side = static_cast<OrderSide>(in.getU8());
+        order.type = static_cast<OrderType>(in.getU8());
+        order.status = static_cast<OrderStatus>(in.getU8());
+        order.quantity = in.getDouble();
+        order.price = in.getDouble();
+        order.filled_quantity = in.getDouble();
+        order.timestamp = static_cast<long>(in.getU64());
+        if (format >= 2) {
+            order.account = in.getString();
+        }
+        return order;
+    }
+}
+
+template <typename Fn>
+auto OrderService::execute(Fn fn) -> std::invoke_result_t<Fn&, core::memory::tradingManager&> {
+    struct Acked {
+        std::invoke_result_t<Fn&, core::memory::tradingManager&> result;
+        std::uint64_t sequence;
+        std::uint64_t ticket;  // 0 if there was nothing to publish
+    };
+    Acked acked = engine_.post([this, &fn](core::memory::tradingManager& manager) {
+        try {
+            auto result = fn(manager);
+            std::uint64_t ticket = 0;
+            if (!pending_.empty()) {
+                std::vector<Order> updates;
+                updates.swap(pending_);
+                ticket = publisher_.push(journaled_, std::move(updates));
+            }
+            return Acked{std::move(result), journaled_, ticket};
+        } catch (...) {
+            pending_.clear();
+            throw;
+        }
+    }).get();
+
+    // Waiting here rather than on the engine thread lets one sync cover
+    // every command that ran meanwhile. The publisher waits for the same
+    // sync before any client hears of a change a crash could still undo.
+    if (acked.ticket != 0) {
+        publisher_.waitPublished(acked.ticket);
+    }
+    if (journal_ && acked.sequence != 0) {
+        journal_->waitDurable(acked.sequence);  // Rethrows a failed sync
+    }
+    return std::move(acked.result);
+}
+
+OrderService::UpdatePublisher::UpdatePublisher(OrderService& service)
+    : service_(service)
+    , thread_([this]() { run(); }) {}
+
+OrderService::UpdatePublisher::~UpdatePublisher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_one();
+    thread_.join();
+}
+
+std::uint64_t OrderService::UpdatePublisher::push(std::uint64_t sequence, std::vector<Order> updates) {
+    std::uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(Batch{sequence, std::move(updates)});
+        ticket = ++queued_;
+    }
+    ready_.notify_one();
+    return ticket;
+}
+
+void OrderService::UpdatePublisher::waitPublished(std::uint64_t ticket) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this, ticket]() { return published_ >= ticket; });
+}
+
+void OrderService::UpdatePublisher::run() {
+    std::vector<Batch> batches;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return;  // Stopping, and everything queued has been published
+            }
+            batches.swap(pending_);
+        }
+
+        for (const auto& batch : batches) {
+            try {
+                // Sequences only grow, so one wait usually covers the rest
+                if (service_.journal_ && batch.sequence != 0) {
+                    service_.journal_->waitDurable(batch.sequence);
+                }
+                for (const auto& order : batch.updates) {
+                    service_.listener_(order);
+                }
+            } catch (const std::exception& e) {
+                // The caller sees a failed sync itself; a listener error only loses its updates
+                std::cerr << "Order updates not published: " << e.what() << std::endl;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            published_ += batches.size();
+        }
+        done_.notify_all();
+        batches.clear();
+    }
+}
+
+OrderService::OrderService(std::shared_ptr<OrderBookService> orderBooks,
+                           std::shared_ptr<core::memory::CommandJournal> journal,
+                           const core::memory::RiskEngine::Config& risk)
+    : orderBooks_(std::move(orderBooks)), journal_(std::move(journal)), risk_(risk), publisher_(*this) {
+    if (orderBooks_) {
+        // Books only match on the engine thread, so this runs there too
+        orderBooks_->addFillListener([this](const std::string& symbol, const core::memory::BookFill& fill) {
+            applyFill(fill.maker_order_id, fill.quantity);
+            applyFill(fill.taker_order_id, fill.quantity);
+            risk_.trade(risk_.symbolIndex(symbol), fill.price);
+
+            core::memory::trade trade{
+                std::to_string(fill.trade_id),
+                fill.taker_side == core::memory::BookSide::BID ? fill.taker_order_id : fill.maker_order_id,
+                fill.taker_side == core::memory::BookSide::BID ? fill.maker_order_id : fill.taker_order_id,
+                symbol, fill.price, fill.quantity, std::chrono::system_clock::now()};
+            engine_.post([trade](core::memory::tradingManager& manager) { return manager.recordTrade(trade); });
+        });
+    }
+}
+
 Order OrderService::placeOrder(const Order& order) {
-    // Generate a unique order ID
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(1000, 9999);
-    
-    Order newOrder = order;
-    newOrder.id = "ORD-" + std::to_string(dis(gen));
-    newOrder.status = OrderStatus::New;
-    newOrder.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-    
-    orders_.push_back(newOrder);
-    return newOrder;
+    return placeOrders({order}).front();
 }
 
-void OrderService::cancelOrder(const std::string& orderId) {
-    for (auto& order : orders_) {
-        if (order.id == orderId) {
+std::vector<Order> OrderService::placeOrders(const std::vector<Order>& orders) {
+    std::vector<Order> placed;
+    placed.reserve(orders.size());
+    for (const auto& order : orders) {
+        Order newOrder = order;
+        newOrder.id = store_.nextId();
+        newOrder.status = OrderStatus::New;
+        newOrder.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+        newOrder.filled_quantity = 0.0;
+        placed.push_back(std::move(newOrder));
+    }
+
+    return execute([this, placed = std::move(placed)](core::memory::tradingManager& manager) mutable {
+        return admitOrders(std::move(placed), manager);
+    });
+}
+
+std::vector<Order> OrderService::admitOrders(std::vector<Order> placed, core::memory::tradingManager& manager) {
+    // Stored here rather than by the caller, so the engine thread is the
+    // only writer and a snapshot always agrees with the journal
+    for (const auto& order : placed) {
+        store_.insert(order);
+        notify(order);
+    }
+
+    // Risk checks, then admission: the manager owns the pooled order
+    // memory, and only admitted orders are journaled
+    std::vector<Order> admitted;
+    admitted.reserve(placed.size());
+    for (auto& order : placed) {
+        if (reserveRisk(order) == core::memory::RiskCheck::PASSED) {
+            core::memory::order entry{order.id, order.symbol, order.price, order.quantity,
+                                      order.side == OrderSide::Buy, std::chrono::system_clock::now()};
+            if (manager.submitOrder(entry)) {
+                try {
+                    journalNew(order);
+                    admitted.push_back(order);
+                    continue;
+                } catch (const std::exception&) {
+                    manager.cancelOrder(order.id);  // Not durable, so not accepted
+                }
+            }
+            releaseRisk(order, order.quantity);
+        }
+        auto rejected = store_.update(order.id, [](Order& o) { o.status = OrderStatus::Rejected; });
+        if (rejected) {
+            order = *rejected;
+            notify(order);
+        }
+    }
+
+    if (orderBooks_) {
+        matchOrders(admitted, manager);
+    }
+
+    // Bring the admitted orders' final state back in request order
+    std::size_t next = 0;
+    for (auto& order : placed) {
+        if (next < admitted.size() && admitted[next].id == order.id) {
+            order = std::move(admitted[next++]);
+        }
+    }
+    return placed;
+}
+
+void OrderService::matchOrders(std::vector<Order>& orders, core::memory::tradingManager& manager) {
+    // Group by symbol, keeping request order within each book
+    std::vector<std::pair<std::string, std::vector<std::size_t>>> groups;
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        auto group = std::find_if(groups.begin(), groups.end(),
+            [&](const auto& entry) { return entry.first == orders[i].symbol; });
+        if (group == groups.end()) {
+            groups.emplace_back(orders[i].symbol, std::vector<std::size_t>());
+            group = std::prev(groups.end());
+        }
+        group->second.push_back(i);
+    }
+
+    for (const auto& group : groups) {
+        std::vector<core::memory::LimitOrderBook::BatchOrder> batch;
+        batch.reserve(group.second.size());
+        for (std::size_t index : group.second) {
+            const Order& order = orders[index];
+            batch.push_back({
+                order.id,
+                order.side == OrderSide::Buy ? core::memory::BookSide::BID : core::memory::BookSide::ASK,
+                order.price, order.quantity, order.type == OrderType::Market});
+        }
+
+        // Fills, including these orders' own, arrive through applyFill
+        auto results = orderBooks_->book(group.first).addOrders(batch);
+        for (std::size_t k = 0; k < results.size(); ++k) {
+            settlePlacement(orders[group.second[k]], results[k], manager);
+        }
+    }
+}
+
+void OrderService::settlePlacement(Order& placed, const core::memory::LimitOrderBook::Result& result,
+                                   core::memory::tradingManager& manager) {
+    bool closed = false;
+    auto stored = store_.update(placed.id, [&](Order& order) {
+        if (!result.accepted) {
+            order.status = OrderStatus::Rejected;
+            closed = true;
+        } else if (result.resting_quantity <= 0.0 && order.status != OrderStatus::Filled) {
+            // Unfilled market remainder is dropped, and so is a limit
+            // remainder the book had no room to rest
             order.status = OrderStatus::Cancelled;
-            return;
+            closed = true;
         }
+    });
+    if (stored) {
+        placed = *stored;
+    }
+    if (closed) {
+        releaseRisk(placed, placed.quantity - placed.filled_quantity);
+        manager.cancelOrder(placed.id);
+        notify(placed);
     }
-    throw std::runtime_error("Order not found");
 }
 
-std::vector<Order> OrderService::getOrders(const std::string& symbol) {
-    if (symbol.empty()) {
-        return orders_;
+void OrderService::applyFill(const std::string& orderId, double quantity) {
+    auto updated = store_.update(orderId, [&](Order& order) {
+        order.filled_quantity += quantity;
+        order.status = order.filled_quantity >= order.quantity - 1e-9
+            ? OrderStatus::Filled : OrderStatus::PartiallyFilled;
+    });
+    if (!updated) {
+        return;
     }
-    
-    std::vector<Order> filtered;
-    std::copy_if(orders_.begin(), orders_.end(), std::back_inserter(filtered),
-        [&](const Order& order) { return order.symbol == symbol; });
-    return filtered;
+    risk_.fill(risk_.accountIndex(updated->account), risk_.symbolIndex(updated->symbol),
+               updated->side == OrderSide::Buy, updated->type == OrderType::Limit ? updated->price : 0.0, quantity,
+               updated->status == OrderStatus::Filled);
+    notify(*updated);
 }
 
-std::optional<Order> OrderService::getOrderById(const std::string& orderId) {
-    auto it = std::find_if(orders_.begin(), orders_.end(),
-        [&](const Order& order) { return order.id == orderId; });
-    
-    if (it != orders_.end()) {
-        return *it;
+core::memory::RiskCheck OrderService::reserveRisk(const Order& order) {
+    std::uint32_t account = risk_.findAccount(order.account);
+    std::uint32_t symbol;
+    try {
+        if (account == core::memory::RiskEngine::NOT_FOUND) {
+            // Only the default account is numbered on first use, so clients
+            // cannot use up slots by making names up. Replayed orders were
+            // admitted once already.
+            if (!order.account.empty() && !replaying_) {
+                return core::memory::RiskCheck::UNKNOWN_ACCOUNT;
+            }
+            account = risk_.accountIndex(order.account);
+        }
+        symbol = risk_.symbolIndex(order.symbol);
+    } catch (const std::length_error&) {
+        return core::memory::RiskCheck::CAPACITY;
+    }
+    bool isBuy = order.side == OrderSide::Buy;
+    if (!replaying_) {
+        auto verdict = risk_.check(account, symbol, isBuy, order.type == OrderType::Limit ? order.price : 0.0,
+                                   order.quantity);
+        if (verdict != core::memory::RiskCheck::PASSED) {
+            return verdict;
+        }
+    }
+    if (order.type == OrderType::Limit) {
+        risk_.reserve(account, symbol, isBuy, order.price, order.quantity);
+    }
+    return core::memory::RiskCheck::PASSED;
+}
+
+void OrderService::releaseRisk(const Order& order, double remaining) {
+    if (order.type == OrderType::Limit) {
+        risk_.release(risk_.accountIndex(order.account), risk_.symbolIndex(order.symbol),
+                      order.side == OrderSide::Buy, order.price, remaining);
+    }
+}
+
+void OrderService::setRiskLimits(const std::string& account, const core::memory::RiskEngine::Limits& limits) {
+    engine_.post([this, &account, &limits](core::memory::tradingManager&) {
+        risk_.setLimits(account, limits);
+        return true;
+    }).get();
+}
+
+core::memory::RiskEngine::Exposure OrderService::riskExposure(const std::string& account, const std::string& symbol) {
+    return engine_.post([this, &account, &symbol](core::memory::tradingManager&) {
+        std::uint32_t index = risk_.findAccount(account);
+        if (index == core::memory::RiskEngine::NOT_FOUND) {
+            return core::memory::RiskEngine::Exposure{0.0, 0.0, 0.0};
+        }
+        return risk_.exposure(index, risk_.symbolIndex(symbol));
+    }).get();
+}
+
+void OrderService::notify(const Order& order) {
+    if (!listener_) {
+        return;
     }
-    return std::nullopt;
+    if (replaying_) {
+        listener_(order);  // Replayed changes are durable already
+    } else {
+        pending_.push_back(order);
+    }
+}
+
+void OrderService::journalNew(const Order& order) {
+    if (!journal_ || replaying_) {
+        return;
+    }
+    core::memory::JournalCommand command;
+    command.type = core::memory::JournalCommand::Type::NEW_ORDER;
+    command.order_id = order.id;
+    command.symbol = order.symbol;
+    command.price = order.price;
+    command.quantity = order.quantity;
+    command.is_buy = order.side == OrderSide::Buy;
+    command.is_market = order.type == OrderType::Market;
+    command.timestamp = order.timestamp;
+    command.account = order.account;
+    journaled_ = journal_->append(command);
+}
+
+void OrderService::journalCancel(const std::string& orderId, const std::string& symbol) {
+    if (!journal_ || replaying_) {
+        return;
+    }
+    core::memory::JournalCommand command;
+    command.type = core::memory::JournalCommand::Type::CANCEL;
+    command.order_id = orderId;
+    command.symbol = symbol;
+    command.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+    journaled_ = journal_->append(command);
+}
+
+std::optional<Order> OrderService::markCancelled(const std::string& orderId, core::memory::tradingManager& manager) {
+    bool changed = false;
+    auto updated = store_.update(orderId, [&](Order& order) {
+        if (isOpen(order)) {
+            order.status = OrderStatus::Cancelled;
+            changed = true;
+        }
+    });
+    if (!changed) {
+        return std::nullopt;
+    }
+    releaseRisk(*updated, updated->quantity - updated->filled_quantity);
+    manager.cancelOrder(orderId);
+    notify(*updated);
+    return updated;
+}
+
+void OrderService::cancelOrder(const std::string& orderId) {
+    if (!store_.get(orderId)) {
+        throw std::runtime_error("Order not found");
+    }
+
+    execute([this, &orderId](core::memory::tradingManager& manager) {
+        return cancelOpen(orderId, manager);
+    });
+}
+
+bool OrderService::cancelOpen(const std::string& orderId, core::memory::tradingManager& manager) {
+    // Re-read on the engine thread: the order may have filled meanwhile
+    auto order = store_.get(orderId);
+    if (!order || !isOpen(*order)) {
+        return false;
+    }
+    journalCancel(orderId, order->symbol);
+    if (orderBooks_) {
+        orderBooks_->book(order->symbol).cancelOrder(orderId);
+    }
+    return markCancelled(orderId, manager).has_value();
+}
+
+std::vector<std::optional<Order>> OrderService::cancelOrders(const std::vector<std::string>& orderIds) {
+    return execute([this, &orderIds](core::memory::tradingManager& manager) {
+        std::vector<std::optional<Order>> results(orderIds.size());
+
+        // Open orders grouped by symbol, so each book is locked once
+        std::vector<std::pair<std::string, std::vector<std::string>>> groups;
+        for (std::size_t i = 0; i < orderIds.size(); ++i) {
+            results[i] = store_.get(orderIds[i]);
+            if (!results[i] || !isOpen(*results[i])) {
+                continue;
+            }
+
+            const std::string& symbol = results[i]->symbol;
+            auto group = std::find_if(groups.begin(), groups.end(),
+                [&](const auto& entry) { return entry.first == symbol; });
+            if (group == groups.end()) {
+                groups.emplace_back(symbol, std::vector<std::string>());
+                group = std::prev(groups.end());
+            }
+            group->second.push_back(orderIds[i]);
+            journalCancel(orderIds[i], symbol);
+        }
+
+        for (const auto& group : groups) {
+            if (orderBooks_) {
+                orderBooks_->book(group.first).cancelOrders(group.second);
+            }
+            // Cancelling is idempotent for orders that no longer rest in the book
+            for (const auto& orderId : group.second) {
+                markCancelled(orderId, manager);
+            }
+        }
+
+        for (std::size_t i = 0; i < orderIds.size(); ++i) {
+            if (results[i]) {
+                results[i] = store_.get(orderIds[i]);
+            }
+        }
+        return results;
+    });
+}
+
+std::vector<Order> OrderService::cancelAllOrders(const std::string& symbol) {
+    return execute([this, &symbol](core::memory::tradingManager& manager) {
+        auto open = store_.openOrderIds(symbol);
+        for (const auto& orderId : open) {
+            journalCancel(orderId, symbol);
+        }
+        if (orderBooks_) {
+            orderBooks_->book(symbol).cancelAll();
+        }
+
+        std::vector<Order> cancelled;
+        for (const auto& orderId : open) {
+            if (auto order = markCancelled(orderId, manager)) {
+                cancelled.push_back(std::move(*order));
+            }
+        }
+        return cancelled;
+    });
+}
+
+std::string OrderService::snapshot(const std::string& directory) {
+    std::lock_guard<std::mutex> snapshotting(snapshotMutex_);
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    struct Forked {
+        pid_t pid;
+        int error;
+        std::uint64_t sequence;
+    };
+    std::string path;
+    Forked forked = engine_.post([this, &directory, &path](core::memory::tradingManager&) {
+        std::uint64_t sequence = journaled_;
+        path = (std::filesystem::path(directory) / snapshotName(sequence)).string();
+        auto books = orderBooks_ ? orderBooks_->books() : std::vector<core::memory::LimitOrderBook*>();
+
+        // The child gets a copy-on-write image of the state as of this
+        // command; the engine resumes as soon as fork() returns. It only
+        // writes the temporary file, which the parent commits.
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            int status = 0;
+            try {
+                core::memory::writeSnapshotTemporary(path, encodeSnapshot(sequence, books));
+            } catch (...) {
+                status = 1;
+            }
+            ::_exit(status);
+        }
+        return Forked{pid, errno, sequence};
+    }).get();
+
+    if (forked.pid < 0) {
+        throw std::runtime_error(std::string("Cannot fork snapshot process: ") + std::strerror(forked.error));
+    }
+    int status = 0;
+    while (::waitpid(forked.pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw std::runtime_error("Snapshot process failed writing " + path);
+    }
+
+    // Under GROUP or INTERVAL sync the journal up to this sequence may
+    // still be in flight. A durable snapshot ahead of its journal could not
+    // be recovered, so the journal is synced first, whatever the policy.
+    try {
+        if (journal_) {
+            journal_->sync();
+        }
+        core::memory::commitSnapshotFile(path);
+    } catch (...) {
+        std::filesystem::remove(path + ".tmp", error);
+        throw;
+    }
+
+    for (const auto& file : snapshotFiles(directory)) {
+        if (file.string() != path) {
+            std::filesystem::remove(file, error);
+        }
+    }
+    if (journal_) {
+        journal_->truncateBefore(forked.sequence + 1);
+    }
+    return path;
+}
+
+std::string OrderService::encodeSnapshot(std::uint64_t sequence,
+                                         const std::vector<core::memory::LimitOrderBook*>& books) const {
+    core::memory::SnapshotWriter out;
+    out.reserve(store_.size() * 96);
+    out.putU32(SNAPSHOT_FORMAT);
+    out.putU64(sequence);
+    out.putU64(store_.nextSequence());
+
+    out.putU64(store_.size());
+    store_.forEachUnlocked([&](const Order& order) { putOrder(out, order); });
+
+    out.putU64(books.size());
+    for (const auto* book : books) {
+        out.putString(book->symbol());
+        book->saveState(out);
+    }
+    risk_.saveState(out);
+    return out.release();
+}
+
+std::size_t OrderService::recover(const std::string& directory) {
+    return engine_.post([this, &directory](core::memory::tradingManager& manager) -> std::size_t {
+        std::uint64_t sequence = 0;
+        auto files = snapshotFiles(directory);
+        if (!files.empty()) {
+            sequence = loadSnapshot(files.back().string(), manager);
+        }
+        if (!journal_) {
+            return 0;
+        }
+        if (journal_->lastSequence() < sequence) {
+            throw std::runtime_error("Journal ends before the snapshot it should continue");
+        }
+
+        std::size_t replayed = 0;
+        core::memory::JournalReader reader(journal_->directory(), sequence);
+        core::memory::JournalCommand command;
+        replaying_ = true;
+        try {
+            while (reader.next(command)) {
+                if (command.sequence != sequence + replayed + 1) {
+                    throw std::runtime_error("Journal has a gap after sequence " +
+                                             std::to_string(sequence + replayed));
+                }
+                replay(command, manager);
+                ++replayed;
+            }
+        } catch (...) {
+            replaying_ = false;
+            throw;
+        }
+        replaying_ = false;
+        journaled_ = journal_->lastSequence();
+        return replayed;
+    }).get();
+}
+
+std::uint64_t OrderService::loadSnapshot(const std::string& path, core::memory::tradingManager& manager) {
+    std::string payload = core::memory::readSnapshotFile(path);
+    core::memory::SnapshotReader in(payload);
+    std::uint32_t format = in.getU32();
+    if (format < 1 || format > SNAPSHOT_FORMAT) {
+        throw std::runtime_error("Unsupported snapshot format: " + path);
+    }
+    std::uint64_t sequence = in.getU64();
+    std::uint64_t nextSequence = in.getU64();
+
+    std::vector<Order> orders(in.getU64());
+    for (auto& order : orders) {
+        order = getOrder(in, format);
+        if (isOpen(order)) {
+            core::memory::order entry{order.id, order.symbol, order.price,
+                                      order.quantity - order.filled_quantity,
+                                      order.side == OrderSide::Buy, std::chrono::system_clock::now()};
+            manager.restoreOrder(entry);
+            if (order.type == OrderType::Limit) {
+                risk_.reserve(risk_.accountIndex(order.account), risk_.symbolIndex(order.symbol),
+                              order.side == OrderSide::Buy, order.price, order.quantity - order.filled_quantity);
+            }
+        }
+    }
+    store_.restore(std::move(orders), nextSequence);
+
+    std::uint64_t bookCount = in.getU64();
+    for (std::uint64_t i = 0; i < bookCount; ++i) {
+        std::string symbol = in.getString();
+        if (!orderBooks_) {
+            throw std::runtime_error("Snapshot has order books but the service has none");
+        }
+        orderBooks_->book(symbol).loadState(in);
+    }
+    if (format >= 2) {
+        risk_.loadState(in);
+    }
+    if (!in.atEnd()) {
+        throw std::runtime_error("Unexpected data at the end of snapshot " + path);
+    }
+    return sequence;
+}
+
+void OrderService::replay(const core::memory::JournalCommand& command, core::memory::tradingManager& manager) {
+    switch (command.type) {
+        case core::memory::JournalCommand::Type::NEW_ORDER: {
+            Order order{};
+            order.id = command.order_id;
+            order.symbol = command.symbol;
+            order.side = command.is_buy ? OrderSide::Buy : OrderSide::Sell;
+            order.type = command.is_market ? OrderType::Market : OrderType::Limit;
+            order.quantity = command.quantity;
+            order.price = command.price;
+            order.status = OrderStatus::New;
+            order.timestamp = static_cast<long>(command.timestamp);
+            order.account = command.account;
+            store_.reserveThrough(order.id);
+            admitOrders({order}, manager);
+            break;
+        }
+        case core::memory::JournalCommand::Type::CANCEL:
+            cancelOpen(command.order_id, manager);
+            break;
+        case core::memory::JournalCommand::Type::MODIFY:
+            // Nothing here journals modifies, so skipping one would silently
+            // restore a different book than the one that was running
+            throw std::runtime_error("Journal record " + std::to_string(command.sequence) + " modifies order " +
+                                     command.order_id + ", which cannot be replayed");
+    }
+}
+
+OrderPage OrderService::getOrders(const OrderQuery& query) {
+    return store_.list(query);
+}
+
+std::optional<Order> OrderService::getOrderById(const std::string& orderId) {
+    return store_.get(orderId);
 }
 
-} // namespace
\ No newline at end of file
+} // namespace
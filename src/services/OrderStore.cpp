@@ -0,0 +1,214 @@
+// src/services/OrderStore.cpp
+#include "../../include/mercuryTrade/services/OrderStore.hpp"
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+namespace mercuryTrade {
+
+namespace {
+    constexpr std::string_view ID_PREFIX = "ORD-";
+
+    std::size_t statusIndex(OrderStatus status) {
+        return static_cast<std::size_t>(status);
+    }
+}
+
+std::string OrderStore::nextId() {
+    std::uint64_t seq = nextSequence_.fetch_add(1, std::memory_order_relaxed);
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), seq);
+
+    std::string id;
+    id.reserve(ID_PREFIX.size() + (result.ptr - buffer));
+    id.append(ID_PREFIX).append(buffer, result.ptr);
+    return id;
+}
+
+bool OrderStore::parseSequence(std::string_view orderId, std::uint64_t& seq) {
+    if (orderId.substr(0, ID_PREFIX.size()) != ID_PREFIX) {
+        return false;
+    }
+    const char* begin = orderId.data() + ID_PREFIX.size();
+    const char* end = orderId.data() + orderId.size();
+    auto result = std::from_chars(begin, end, seq);
+    return result.ec == std::errc() && result.ptr == end && begin != end && *begin != '0';
+}
+
+void OrderStore::insert(const Order& order) {
+    std::uint64_t seq;
+    if (!parseSequence(order.id, seq) || seq >= nextSequence_.load(std::memory_order_relaxed)) {
+        throw std::invalid_argument("Order id was not issued by this store: " + order.id);
+    }
+
+    Shard& s = shard(seq);
+    std::unique_lock<std::shared_mutex> lock(s.mutex);
+    if (!s.orders.emplace(seq, order).second) {
+        throw std::invalid_argument("Duplicate order id: " + order.id);
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> index(indexMutex_);
+        bySymbol_[order.symbol][statusIndex(order.status)].insert(seq);
+        byStatus_[statusIndex(order.status)].insert(seq);
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OrderStore::reserveThrough(const std::string& orderId) {
+    std::uint64_t seq;
+    if (!parseSequence(orderId, seq)) {
+        throw std::invalid_argument("Malformed order id: " + orderId);
+    }
+    std::uint64_t next = nextSequence_.load(std::memory_order_relaxed);
+    while (next <= seq && !nextSequence_.compare_exchange_weak(next, seq + 1, std::memory_order_relaxed)) {
+    }
+}
+
+void OrderStore::restore(std::vector<Order> orders, std::uint64_t nextSequence) {
+    if (size() != 0) {
+        throw std::logic_error("Orders can only be restored into an empty store");
+    }
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> sequences;
+    sequences.reserve(orders.size());
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        std::uint64_t seq;
+        if (!parseSequence(orders[i].id, seq)) {
+            throw std::invalid_argument("Malformed order id: " + orders[i].id);
+        }
+        sequences.emplace_back(seq, i);
+        nextSequence = std::max(nextSequence, seq + 1);
+    }
+    std::sort(sequences.begin(), sequences.end());
+
+    for (const auto& entry : sequences) {
+        Order& order = orders[entry.second];
+        Shard& s = shard(entry.first);
+        std::unique_lock<std::shared_mutex> lock(s.mutex);
+        if (!s.orders.emplace(entry.first, order).second) {
+            throw std::invalid_argument("Duplicate order id: " + order.id);
+        }
+    }
+
+    // Sorted, every index insert lands at the end of its set
+    std::unique_lock<std::shared_mutex> index(indexMutex_);
+    for (const auto& entry : sequences) {
+        const Order& order = orders[entry.second];
+        auto& symbolSet = bySymbol_[order.symbol][statusIndex(order.status)];
+        auto& statusSet = byStatus_[statusIndex(order.status)];
+        symbolSet.emplace_hint(symbolSet.end(), entry.first);
+        statusSet.emplace_hint(statusSet.end(), entry.first);
+    }
+    size_.store(sequences.size(), std::memory_order_relaxed);
+    nextSequence_.store(nextSequence, std::memory_order_relaxed);
+}
+
+std::optional<Order> OrderStore::get(const std::string& orderId) const {
+    std::uint64_t seq;
+    if (!parseSequence(orderId, seq)) {
+        return std::nullopt;
+    }
+    const Shard& s = shard(seq);
+    std::shared_lock<std::shared_mutex> lock(s.mutex);
+    auto it = s.orders.find(seq);
+    if (it == s.orders.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void OrderStore::reindex(std::uint64_t seq, const std::string& symbol, OrderStatus from, OrderStatus to) {
+    std::unique_lock<std::shared_mutex> index(indexMutex_);
+    auto& symbolIndex = bySymbol_[symbol];
+    symbolIndex[statusIndex(from)].erase(seq);
+    symbolIndex[statusIndex(to)].insert(seq);
+    byStatus_[statusIndex(from)].erase(seq);
+    byStatus_[statusIndex(to)].insert(seq);
+}
+
+OrderPage OrderStore::list(const OrderQuery& query) const {
+    std::size_t limit = std::min(std::max<std::size_t>(query.limit, 1), MAX_PAGE_SIZE);
+
+    // Sequences first, under the index lock; one past the limit tells
+    // whether there is another page
+    std::vector<std::uint64_t> sequences;
+    sequences.reserve(limit + 1);
+    {
+        std::shared_lock<std::shared_mutex> index(indexMutex_);
+
+        const StatusIndex* statuses = &byStatus_;
+        if (!query.symbol.empty()) {
+            auto it = bySymbol_.find(query.symbol);
+            if (it == bySymbol_.end()) {
+                return OrderPage{};
+            }
+            statuses = &it->second;
+        }
+
+        // Merge the per-status sets, each already in sequence order
+        std::vector<std::pair<std::set<std::uint64_t>::const_iterator,
+                              std::set<std::uint64_t>::const_iterator>> cursors;
+        for (std::size_t i = 0; i < STATUS_COUNT; ++i) {
+            if (query.status && statusIndex(*query.status) != i) {
+                continue;
+            }
+            const auto& set = (*statuses)[i];
+            auto begin = set.upper_bound(query.after);
+            if (begin != set.end()) {
+                cursors.emplace_back(begin, set.end());
+            }
+        }
+
+        while (sequences.size() <= limit && !cursors.empty()) {
+            auto next = std::min_element(cursors.begin(), cursors.end(),
+                [](const auto& a, const auto& b) { return *a.first < *b.first; });
+            sequences.push_back(*next->first);
+            if (++next->first == next->second) {
+                cursors.erase(next);
+            }
+        }
+    }
+
+    OrderPage page;
+    if (sequences.size() > limit) {
+        sequences.pop_back();
+        page.next_cursor = sequences.back();
+    }
+
+    page.orders.reserve(sequences.size());
+    for (std::uint64_t seq : sequences) {
+        const Shard& s = shard(seq);
+        std::shared_lock<std::shared_mutex> lock(s.mutex);
+        auto it = s.orders.find(seq);
+        // The status may have moved on since the index was read
+        if (it != s.orders.end() && (!query.status || it->second.status == *query.status)) {
+            page.orders.push_back(it->second);
+        }
+    }
+    return page;
+}
+
+std::vector<std::string> OrderStore::openOrderIds(const std::string& symbol) const {
+    std::vector<std::uint64_t> sequences;
+    {
+        std::shared_lock<std::shared_mutex> index(indexMutex_);
+        auto it = bySymbol_.find(symbol);
+        if (it == bySymbol_.end()) {
+            return {};
+        }
+        const auto& open = it->second[statusIndex(OrderStatus::New)];
+        const auto& partial = it->second[statusIndex(OrderStatus::PartiallyFilled)];
+        sequences.reserve(open.size() + partial.size());
+        std::merge(open.begin(), open.end(), partial.begin(), partial.end(), std::back_inserter(sequences));
+    }
+
+    std::vector<std::string> ids;
+    ids.reserve(sequences.size());
+    for (std::uint64_t seq : sequences) {
+        ids.push_back(std::string(ID_PREFIX) + std::to_string(seq));
+    }
+    return ids;
+}
+
+} // namespace mercuryTrade
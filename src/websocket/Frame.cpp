@@ -0,0 +1,106 @@
+// src/websocket/Frame.cpp
+#include "mercuryTrade/websocket/Frame.hpp"
+
+namespace mercuryTrade {
+namespace websocket {
+
+namespace {
+    constexpr std::uint8_t FIN_BIT = 0x80;
+    constexpr std::uint8_t RESERVED_BITS = 0x70;
+    constexpr std::uint8_t OPCODE_MASK = 0x0F;
+    constexpr std::uint8_t MASK_BIT = 0x80;
+    constexpr std::uint8_t LENGTH_MASK = 0x7F;
+
+    bool is_control(Opcode opcode) {
+        return static_cast<std::uint8_t>(opcode) & 0x8;
+    }
+
+    bool is_known(std::uint8_t opcode) {
+        return opcode <= 0x2 || (opcode >= 0x8 && opcode <= 0xA);
+    }
+}
+
+std::string encodeFrame(Opcode opcode, std::string_view payload) {
+    std::string frame;
+    frame.reserve(payload.size() + 10);
+    frame.push_back(static_cast<char>(FIN_BIT | static_cast<std::uint8_t>(opcode)));
+
+    std::uint64_t length = payload.size();
+    if (length < 126) {
+        frame.push_back(static_cast<char>(length));
+    } else if (length <= 0xFFFF) {
+        frame.push_back(static_cast<char>(126));
+        frame.push_back(static_cast<char>(length >> 8));
+        frame.push_back(static_cast<char>(length & 0xFF));
+    } else {
+        frame.push_back(static_cast<char>(127));
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            frame.push_back(static_cast<char>((length >> shift) & 0xFF));
+        }
+    }
+
+    frame.append(payload.data(), payload.size());
+    return frame;
+}
+
+DecodeResult decodeFrame(char* data, std::size_t size, std::size_t max_payload, DecodedFrame& frame) {
+    if (size < 2) {
+        return DecodeResult::Incomplete;
+    }
+
+    auto first = static_cast<std::uint8_t>(data[0]);
+    auto second = static_cast<std::uint8_t>(data[1]);
+    std::uint8_t opcode = first & OPCODE_MASK;
+
+    if ((first & RESERVED_BITS) || !is_known(opcode) || !(second & MASK_BIT)) {
+        return DecodeResult::Error;
+    }
+
+    frame.fin = first & FIN_BIT;
+    frame.opcode = static_cast<Opcode>(opcode);
+
+    std::size_t header_size = 2;
+    std::uint64_t length = second & LENGTH_MASK;
+    if (length == 126) {
+        header_size += 2;
+        if (size < header_size) {
+            return DecodeResult::Incomplete;
+        }
+        length = (static_cast<std::uint64_t>(static_cast<std::uint8_t>(data[2])) << 8) |
+                 static_cast<std::uint8_t>(data[3]);
+    } else if (length == 127) {
+        header_size += 8;
+        if (size < header_size) {
+            return DecodeResult::Incomplete;
+        }
+        length = 0;
+        for (std::size_t i = 2; i < 10; ++i) {
+            length = (length << 8) | static_cast<std::uint8_t>(data[i]);
+        }
+    }
+
+    if (is_control(frame.opcode) && (!frame.fin || length > 125)) {
+        return DecodeResult::Error;
+    }
+    if (length > max_payload) {
+        return DecodeResult::Error;
+    }
+
+    const std::size_t mask_offset = header_size;
+    header_size += 4;
+    if (size < header_size + length) {
+        return DecodeResult::Incomplete;
+    }
+
+    char* payload = data + header_size;
+    const char* mask = data + mask_offset;
+    for (std::size_t i = 0; i < length; ++i) {
+        payload[i] ^= mask[i & 3];
+    }
+
+    frame.payload = std::string_view(payload, static_cast<std::size_t>(length));
+    frame.consumed = header_size + static_cast<std::size_t>(length);
+    return DecodeResult::Complete;
+}
+
+}} // namespace mercuryTrade::websocket
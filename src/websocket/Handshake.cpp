@@ -0,0 +1,129 @@
+// src/websocket/Handshake.cpp
+#include "mercuryTrade/websocket/Handshake.hpp"
+#include <array>
+#include <cstdint>
+
+namespace mercuryTrade {
+namespace websocket {
+
+namespace {
+    constexpr std::string_view HANDSHAKE_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+    std::uint32_t rotl(std::uint32_t value, int bits) {
+        return (value << bits) | (value >> (32 - bits));
+    }
+
+    // SHA-1 (FIPS 180-4). Only used for the handshake, never for security.
+    std::array<std::uint8_t, 20> sha1(std::string_view input) {
+        std::uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+        std::string message(input);
+        std::uint64_t bit_length = static_cast<std::uint64_t>(input.size()) * 8;
+        message.push_back(static_cast<char>(0x80));
+        while (message.size() % 64 != 56) {
+            message.push_back('\0');
+        }
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            message.push_back(static_cast<char>((bit_length >> shift) & 0xFF));
+        }
+
+        for (std::size_t block = 0; block < message.size(); block += 64) {
+            std::uint32_t w[80];
+            for (int i = 0; i < 16; ++i) {
+                const auto* p = reinterpret_cast<const std::uint8_t*>(message.data() + block + i * 4);
+                w[i] = (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) |
+                       (std::uint32_t(p[2]) << 8) | std::uint32_t(p[3]);
+            }
+            for (int i = 16; i < 80; ++i) {
+                w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+            }
+
+            std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+            for (int i = 0; i < 80; ++i) {
+                std::uint32_t f, k;
+                if (i < 20) {
+                    f = (b & c) | (~b & d);
+                    k = 0x5A827999;
+                } else if (i < 40) {
+                    f = b ^ c ^ d;
+                    k = 0x6ED9EBA1;
+                } else if (i < 60) {
+                    f = (b & c) | (b & d) | (c & d);
+                    k = 0x8F1BBCDC;
+                } else {
+                    f = b ^ c ^ d;
+                    k = 0xCA62C1D6;
+                }
+                std::uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+                e = d;
+                d = c;
+                c = rotl(b, 30);
+                b = a;
+                a = temp;
+            }
+            h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+        }
+
+        std::array<std::uint8_t, 20> digest;
+        for (int i = 0; i < 5; ++i) {
+            digest[i * 4] = static_cast<std::uint8_t>(h[i] >> 24);
+            digest[i * 4 + 1] = static_cast<std::uint8_t>(h[i] >> 16);
+            digest[i * 4 + 2] = static_cast<std::uint8_t>(h[i] >> 8);
+            digest[i * 4 + 3] = static_cast<std::uint8_t>(h[i]);
+        }
+        return digest;
+    }
+
+    std::string base64(const std::uint8_t* data, std::size_t size) {
+        static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string out;
+        out.reserve((size + 2) / 3 * 4);
+        for (std::size_t i = 0; i < size; i += 3) {
+            std::uint32_t chunk = std::uint32_t(data[i]) << 16;
+            if (i + 1 < size) chunk |= std::uint32_t(data[i + 1]) << 8;
+            if (i + 2 < size) chunk |= data[i + 2];
+
+            out.push_back(alphabet[(chunk >> 18) & 0x3F]);
+            out.push_back(alphabet[(chunk >> 12) & 0x3F]);
+            out.push_back(i + 1 < size ? alphabet[(chunk >> 6) & 0x3F] : '=');
+            out.push_back(i + 2 < size ? alphabet[chunk & 0x3F] : '=');
+        }
+        return out;
+    }
+}
+
+std::string acceptKey(std::string_view client_key) {
+    std::string input(client_key);
+    input.append(HANDSHAKE_GUID);
+    auto digest = sha1(input);
+    return base64(digest.data(), digest.size());
+}
+
+const char* validateUpgrade(const http::Request& req) {
+    if (req.method != "GET") {
+        return "WebSocket upgrade requires GET";
+    }
+    if (!http::iequals(req.headers.get("Upgrade"), "websocket")) {
+        return "Missing Upgrade: websocket";
+    }
+    if (!http::hasToken(req.headers.get("Connection"), "upgrade")) {
+        return "Missing Connection: Upgrade";
+    }
+    if (req.headers.get("Sec-WebSocket-Version") != "13") {
+        return "Unsupported WebSocket version";
+    }
+    // The key is 16 random bytes, base64 encoded
+    if (req.headers.get("Sec-WebSocket-Key").size() != 24) {
+        return "Invalid Sec-WebSocket-Key";
+    }
+    return nullptr;
+}
+
+std::string upgradeResponse(std::string_view client_key) {
+    return "HTTP/1.1 101 Switching Protocols\r\n"
+           "Upgrade: websocket\r\n"
+           "Connection: Upgrade\r\n"
+           "Sec-WebSocket-Accept: " + acceptKey(client_key) + "\r\n\r\n";
+}
+
+}} // namespace mercuryTrade::websocket
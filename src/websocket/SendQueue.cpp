@@ -0,0 +1,93 @@
+// src/websocket/SendQueue.cpp
+#include "mercuryTrade/websocket/SendQueue.hpp"
+
+namespace mercuryTrade {
+namespace websocket {
+
+SendQueue::SendQueue(std::size_t capacity) : capacity_(capacity) {}
+
+SendQueue::PushResult SendQueue::push(Frame frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return PushResult::Closed;
+        }
+        if (lossless_count_ >= capacity_) {
+            return PushResult::Overflow;
+        }
+        entries_.push_back(Entry{nullptr, std::move(frame)});
+        ++lossless_count_;
+        ++stats_.queued;
+    }
+    ready_.notify_one();
+    return PushResult::Queued;
+}
+
+SendQueue::PushResult SendQueue::pushLatest(const std::string& key, Frame frame) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return PushResult::Closed;
+        }
+
+        auto it = latest_.find(key);
+        if (it != latest_.end()) {
+            // Keep the queue position, send the newest value
+            it->second->frame = std::move(frame);
+            ++stats_.conflated;
+            return PushResult::Conflated;
+        }
+
+        // Keyed entries are bounded by the number of subscribed channels,
+        // so they do not count against the lossless capacity
+        it = latest_.emplace(key, nullptr).first;
+        entries_.push_back(Entry{&it->first, std::move(frame)});
+        it->second = &entries_.back();
+        ++stats_.queued;
+    }
+    ready_.notify_one();
+    return PushResult::Queued;
+}
+
+bool SendQueue::pop(std::vector<Frame>& batch, std::size_t max_frames) {
+    batch.clear();
+    std::unique_lock<std::mutex> lock(mutex_);
+    ready_.wait(lock, [this] { return closed_ || !entries_.empty(); });
+
+    while (!entries_.empty() && batch.size() < max_frames) {
+        Entry& entry = entries_.front();
+        batch.push_back(std::move(entry.frame));
+        if (entry.key) {
+            latest_.erase(latest_.find(*entry.key));  // The key lives in the node being erased
+        } else {
+            --lossless_count_;
+        }
+        entries_.pop_front();
+    }
+    return !batch.empty();
+}
+
+void SendQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    ready_.notify_all();
+}
+
+bool SendQueue::closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+}
+
+std::size_t SendQueue::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+SendQueue::Stats SendQueue::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+}} // namespace mercuryTrade::websocket
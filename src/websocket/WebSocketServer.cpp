@@ -0,0 +1,565 @@
+// src/websocket/WebSocketServer.cpp
+#include "mercuryTrade/websocket/WebSocketServer.hpp"
+#include "mercuryTrade/websocket/Handshake.hpp"
+#include "mercuryTrade/http/RequestParser.hpp"
+#include "mercuryTrade/http/ResponseWriter.hpp"
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace mercuryTrade {
+namespace websocket {
+
+namespace {
+    constexpr std::size_t READ_CHUNK_SIZE = 4096;
+    constexpr std::size_t MAX_FRAME_HEADER = 14;
+    constexpr std::size_t MAX_HANDSHAKE_BYTES = 8 * 1024;
+    const std::string ALL_CHANNELS = "*";
+
+#ifdef MSG_NOSIGNAL
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    constexpr int SEND_FLAGS = 0;
+#endif
+
+    // Close status codes (RFC 6455 7.4.1)
+    constexpr std::uint16_t CLOSE_PROTOCOL_ERROR = 1002;
+    constexpr std::uint16_t CLOSE_TOO_BIG = 1009;
+
+    void set_timeout(int fd, int option, int timeout_ms) {
+        struct timeval timeout;
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_usec = (timeout_ms % 1000) * 1000;
+        setsockopt(fd, SOL_SOCKET, option, &timeout, sizeof(timeout));
+    }
+
+    Frame close_frame(std::uint16_t code) {
+        char payload[2] = {static_cast<char>(code >> 8), static_cast<char>(code & 0xFF)};
+        return makeFrame(Opcode::Close, std::string_view(payload, sizeof(payload)));
+    }
+
+    Frame message_frame(const char* type, const nlohmann::json& payload) {
+        return makeFrame(Opcode::Text, nlohmann::json{{"type", type}, {"payload", payload}}.dump());
+    }
+
+    bool send_all(int fd, std::vector<struct iovec>& iov) {
+        struct iovec* next = iov.data();
+        std::size_t count = iov.size();
+        while (count > 0) {
+            struct msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = next;
+            msg.msg_iovlen = count;
+
+            ssize_t sent = sendmsg(fd, &msg, SEND_FLAGS);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // Includes EAGAIN from SO_SNDTIMEO: the peer stopped reading
+                return false;
+            }
+
+            std::size_t remaining = static_cast<std::size_t>(sent);
+            while (count > 0 && remaining >= next->iov_len) {
+                remaining -= next->iov_len;
+                ++next;
+                --count;
+            }
+            if (count > 0) {
+                next->iov_base = static_cast<char*>(next->iov_base) + remaining;
+                next->iov_len -= remaining;
+            }
+        }
+        return true;
+    }
+}
+
+struct WebSocketServer::Connection {
+    Connection(int fd, std::size_t capacity) : fd(fd), queue(capacity) {}
+
+    int fd;
+    bool binary = false;  // Negotiated with ?format=binary; fixed after the handshake
+    SendQueue queue;
+    std::vector<std::string> channels;  // Guarded by WebSocketServer::mutex_
+
+    // Wildcard patterns among channels, so broadcast() can skip subscribers
+    // a broader pattern already reached; also guarded by mutex_
+    bool all_channels = false;
+    std::vector<std::string> type_wildcards;
+
+    // Serialises shutdown() against close() so a late disconnect from a
+    // broadcasting thread can never hit a reused descriptor
+    std::mutex fd_mutex;
+    bool fd_closed = false;
+};
+
+WebSocketServer::WebSocketServer(int port, const WebSocketOptions& options)
+    : port_(port)
+    , options_(options) {
+    server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (server_fd_ < 0) {
+        throw std::runtime_error("Failed to create socket");
+    }
+
+    int opt = 1;
+    if (setsockopt(server_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
+        close(server_fd_);
+        throw std::runtime_error("Failed to set socket options");
+    }
+
+    struct sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port_);
+
+    if (bind(server_fd_, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        close(server_fd_);
+        throw std::runtime_error("Failed to bind to port");
+    }
+
+    socklen_t length = sizeof(address);
+    if (getsockname(server_fd_, (struct sockaddr*)&address, &length) == 0) {
+        port_ = ntohs(address.sin_port);
+    }
+
+    if (listen(server_fd_, SOMAXCONN) < 0) {
+        close(server_fd_);
+        throw std::runtime_error("Failed to listen on socket");
+    }
+}
+
+WebSocketServer::~WebSocketServer() {
+    stop();
+
+    // Connection threads hold `this`; kick them all and wait for them to leave
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& conn : connections_) {
+            disconnect(*conn);
+        }
+    }
+    std::unique_lock<std::mutex> lock(threads_mutex_);
+    threads_done_.wait(lock, [this]() { return live_threads_ == 0; });
+    close(server_fd_);
+}
+
+void WebSocketServer::start() {
+    std::cout << "WebSocket server listening on port " << port_ << std::endl;
+
+    while (running_) {
+        int client_fd = accept(server_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            if (running_) {
+                std::cerr << "Failed to accept WebSocket connection" << std::endl;
+            }
+            continue;
+        }
+
+        auto conn = std::make_shared<Connection>(client_fd, options_.max_queued_frames);
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            connections_.insert(conn);
+        }
+        if (!running_) {
+            disconnect(*conn);  // Accepted as the destructor kicked the others
+        }
+        {
+            std::lock_guard<std::mutex> lock(threads_mutex_);
+            ++live_threads_;
+        }
+        std::thread([this, conn]() {
+            handle_connection(conn);
+            // Last touch of `this`; notify under the lock so the destructor cannot run first
+            std::lock_guard<std::mutex> lock(threads_mutex_);
+            if (--live_threads_ == 0) {
+                threads_done_.notify_all();
+            }
+        }).detach();
+    }
+}
+
+void WebSocketServer::stop() {
+    running_ = false;
+    shutdown(server_fd_, SHUT_RDWR);  // Wakes a blocked accept()
+}
+
+std::size_t WebSocketServer::connectionCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return connections_.size();
+}
+
+void WebSocketServer::broadcast(const std::string& channel, const std::string& message, Delivery delivery) {
+    broadcast(channel, message, std::string_view(), delivery);
+}
+
+void WebSocketServer::broadcast(const std::string& channel, const std::string& message, std::string_view binary,
+                                Delivery delivery) {
+    // Serialise once per format; every subscriber queues the same buffer
+    Frame text_frame = makeFrame(Opcode::Text, message);
+    Frame binary_frame = binary.empty() ? text_frame : makeFrame(Opcode::Binary, binary);
+    std::vector<ConnectionPtr> too_slow;
+
+    // Every subscriber is served by the broadest pattern it holds:
+    // "*", then "<TYPE>:*", then the exact channel
+    std::size_t colon = channel.find(':');
+    const std::string type_wildcard = (colon == std::string::npos) ? std::string() : channel.substr(0, colon + 1) + "*";
+
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const std::string* key : {&ALL_CHANNELS, &type_wildcard, &channel}) {
+            if (key->empty()) {
+                continue;
+            }
+            auto it = subscriptions_.find(*key);
+            if (it == subscriptions_.end()) {
+                continue;
+            }
+            for (const auto& conn : it->second) {
+                if (key != &ALL_CHANNELS && conn->all_channels) {
+                    continue;
+                }
+                if (key == &channel && !conn->type_wildcards.empty() &&
+                    std::find(conn->type_wildcards.begin(), conn->type_wildcards.end(), type_wildcard) !=
+                        conn->type_wildcards.end()) {
+                    continue;
+                }
+
+                const Frame& frame = conn->binary ? binary_frame : text_frame;
+                auto result = (delivery == Delivery::Conflate)
+                    ? conn->queue.pushLatest(channel, frame)
+                    : conn->queue.push(frame);
+                if (result == SendQueue::PushResult::Overflow) {
+                    too_slow.push_back(conn);
+                }
+            }
+        }
+    }
+
+    // A subscriber that cannot keep up with lossless traffic must resync
+    for (const auto& conn : too_slow) {
+        disconnect(*conn);
+    }
+}
+
+void WebSocketServer::publish(std::string_view type, const std::string& symbol, const nlohmann::json& payload,
+                              Delivery delivery) {
+    std::string channel(type);
+    channel.append(":").append(symbol);
+    nlohmann::json message = {{"type", std::string(type)}, {"symbol", symbol}, {"payload", payload}};
+    broadcast(channel, message.dump(), delivery);
+}
+
+void WebSocketServer::publishEncoded(std::string_view type, const std::string& symbol,
+                                     const nlohmann::json& payload, std::string_view binary, Delivery delivery) {
+    std::string channel(type);
+    channel.append(":").append(symbol);
+    nlohmann::json message = {{"type", std::string(type)}, {"symbol", symbol}, {"payload", payload}};
+    broadcast(channel, message.dump(), binary, delivery);
+}
+
+void WebSocketServer::publishSerialized(std::string_view type, const std::string& symbol,
+                                        std::string_view payload_json, Delivery delivery) {
+    std::string channel(type);
+    channel.append(":").append(symbol);
+
+    // Type and symbol are identifiers, so only the payload needs escaping, and it is already JSON
+    std::string message;
+    message.reserve(payload_json.size() + channel.size() + 40);
+    message.append("{\"payload\":").append(payload_json);
+    message.append(",\"symbol\":").append(nlohmann::json(symbol).dump());
+    message.append(",\"type\":").append(nlohmann::json(std::string(type)).dump()).append("}");
+    broadcast(channel, message, delivery);
+}
+
+void WebSocketServer::handle_connection(const ConnectionPtr& conn) {
+    set_timeout(conn->fd, SO_RCVTIMEO, options_.handshake_timeout_ms);
+    set_timeout(conn->fd, SO_SNDTIMEO, options_.send_timeout_ms);
+#ifdef SO_NOSIGPIPE
+    int no_sigpipe = 1;
+    setsockopt(conn->fd, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+
+    std::vector<char> buffer(READ_CHUNK_SIZE);
+    std::size_t end = 0;
+
+    if (handshake(*conn, buffer, end)) {
+        // Subscribers may stay quiet indefinitely once upgraded
+        set_timeout(conn->fd, SO_RCVTIMEO, 0);
+
+        std::thread writer([this, conn]() {
+            write_frames(conn);
+        });
+        read_frames(conn, buffer, end);
+
+        remove_connection(conn);
+        conn->queue.close();  // Writer flushes what is left, e.g. the close reply
+        writer.join();
+    } else {
+        remove_connection(conn);
+    }
+
+    std::lock_guard<std::mutex> lock(conn->fd_mutex);
+    conn->fd_closed = true;
+    close(conn->fd);
+}
+
+bool WebSocketServer::handshake(Connection& conn, std::vector<char>& buffer, std::size_t& end) {
+    http::RequestParser parser(MAX_HANDSHAKE_BYTES, 0);
+    http::Request req;
+
+    while (true) {
+        ssize_t bytes_read = recv(conn.fd, buffer.data() + end, buffer.size() - end, 0);
+        if (bytes_read <= 0) {
+            return false;
+        }
+        end += static_cast<std::size_t>(bytes_read);
+
+        auto result = parser.parse(buffer.data(), end, req);
+        if (result == http::RequestParser::Result::Incomplete) {
+            if (end == buffer.size()) {
+                buffer.resize(buffer.size() * 2);
+            }
+            continue;
+        }
+
+        const char* error = (result == http::RequestParser::Result::Error)
+            ? parser.error()
+            : validateUpgrade(req);
+        if (error) {
+            http::ResponseWriter writer(conn.fd, {}, options_.send_timeout_ms);
+            writer.write(http::Response::json({{"error", error}}, 400), false);
+            return false;
+        }
+
+        conn.binary = req.getQuery("format") == "binary";
+        std::string response = upgradeResponse(req.headers.get("Sec-WebSocket-Key"));
+        if (send(conn.fd, response.data(), response.size(), SEND_FLAGS) != static_cast<ssize_t>(response.size())) {
+            return false;
+        }
+
+        // Frames the client sent right behind the handshake
+        std::size_t consumed = parser.consumed();
+        std::memmove(buffer.data(), buffer.data() + consumed, end - consumed);
+        end -= consumed;
+        return true;
+    }
+}
+
+void WebSocketServer::read_frames(const ConnectionPtr& conn, std::vector<char>& buffer, std::size_t end) {
+    std::size_t start = 0;
+    std::string message;      // Reassembled fragments of the current message
+    bool in_message = false;
+
+    while (true) {
+        while (start < end) {
+            DecodedFrame frame;
+            auto result = decodeFrame(buffer.data() + start, end - start, options_.max_message_bytes, frame);
+            if (result == DecodeResult::Incomplete) {
+                break;
+            }
+            if (result == DecodeResult::Error) {
+                conn->queue.push(close_frame(CLOSE_PROTOCOL_ERROR));
+                return;
+            }
+            start += frame.consumed;
+
+            switch (frame.opcode) {
+                case Opcode::Text:
+                case Opcode::Binary:
+                    if (in_message) {
+                        conn->queue.push(close_frame(CLOSE_PROTOCOL_ERROR));
+                        return;
+                    }
+                    if (frame.fin) {
+                        handle_message(conn, frame.payload);
+                    } else {
+                        message.assign(frame.payload);
+                        in_message = true;
+                    }
+                    break;
+
+                case Opcode::Continuation:
+                    if (!in_message) {
+                        conn->queue.push(close_frame(CLOSE_PROTOCOL_ERROR));
+                        return;
+                    }
+                    if (message.size() + frame.payload.size() > options_.max_message_bytes) {
+                        conn->queue.push(close_frame(CLOSE_TOO_BIG));
+                        return;
+                    }
+                    message.append(frame.payload);
+                    if (frame.fin) {
+                        handle_message(conn, message);
+                        message.clear();
+                        in_message = false;
+                    }
+                    break;
+
+                case Opcode::Ping:
+                    conn->queue.push(makeFrame(Opcode::Pong, frame.payload));
+                    break;
+
+                case Opcode::Pong:
+                    break;
+
+                case Opcode::Close:
+                    // Echo the status code and finish the closing handshake
+                    conn->queue.push(makeFrame(Opcode::Close, frame.payload.substr(0, 2)));
+                    return;
+            }
+        }
+
+        if (start == end) {
+            start = end = 0;
+        } else if (start > 0) {
+            std::memmove(buffer.data(), buffer.data() + start, end - start);
+            end -= start;
+            start = 0;
+        }
+        if (buffer.size() - end < READ_CHUNK_SIZE) {
+            if (buffer.size() >= options_.max_message_bytes + MAX_FRAME_HEADER + READ_CHUNK_SIZE) {
+                conn->queue.push(close_frame(CLOSE_TOO_BIG));
+                return;
+            }
+            buffer.resize(buffer.size() * 2);
+        }
+
+        ssize_t bytes_read = recv(conn->fd, buffer.data() + end, buffer.size() - end, 0);
+        if (bytes_read <= 0) {
+            return;
+        }
+        end += static_cast<std::size_t>(bytes_read);
+    }
+}
+
+void WebSocketServer::write_frames(const ConnectionPtr& conn) {
+    std::vector<Frame> batch;
+    std::vector<struct iovec> iov;
+    batch.reserve(options_.max_batch_frames);
+    iov.reserve(options_.max_batch_frames);
+
+    while (conn->queue.pop(batch, options_.max_batch_frames)) {
+        // Everything pending goes out in one sendmsg() straight from the shared buffers
+        iov.clear();
+        for (const auto& frame : batch) {
+            struct iovec entry;
+            entry.iov_base = const_cast<char*>(frame->data());
+            entry.iov_len = frame->size();
+            iov.push_back(entry);
+        }
+        if (!send_all(conn->fd, iov)) {
+            disconnect(*conn);
+            return;
+        }
+    }
+}
+
+void WebSocketServer::handle_message(const ConnectionPtr& conn, std::string_view message) {
+    auto request = nlohmann::json::parse(message.begin(), message.end(), nullptr, false);
+    if (request.is_discarded() || !request.is_object()) {
+        conn->queue.push(message_frame("ERROR", {{"message", "Invalid JSON"}}));
+        return;
+    }
+
+    auto action_it = request.find("action");
+    std::string action = (action_it != request.end() && action_it->is_string()) ? action_it->get<std::string>() : "";
+    if (action != "subscribe" && action != "unsubscribe") {
+        conn->queue.push(message_frame("ERROR", {{"message", "Unknown action"}}));
+        return;
+    }
+
+    std::vector<std::string> channels;
+    if (request.contains("channels") && request["channels"].is_array()) {
+        for (const auto& channel : request["channels"]) {
+            if (channel.is_string()) {
+                channels.push_back(channel.get<std::string>());
+            }
+        }
+    } else if (request.contains("channel") && request["channel"].is_string()) {
+        channels.push_back(request["channel"].get<std::string>());
+    }
+
+    nlohmann::json subscribed = nlohmann::json::array();
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& channel : channels) {
+            if (action == "subscribe") {
+                subscribe(conn, channel);
+            } else {
+                unsubscribe(conn, channel);
+            }
+        }
+        for (const auto& channel : conn->channels) {
+            subscribed.push_back(channel);
+        }
+    }
+    conn->queue.push(message_frame("SUBSCRIBED", {{"channels", subscribed}}));
+}
+
+void WebSocketServer::subscribe(const ConnectionPtr& conn, const std::string& channel) {
+    auto& channels = conn->channels;
+    if (std::find(channels.begin(), channels.end(), channel) != channels.end()) {
+        return;
+    }
+    channels.push_back(channel);
+    subscriptions_[channel].push_back(conn);
+
+    if (channel == ALL_CHANNELS) {
+        conn->all_channels = true;
+    } else if (channel.size() > 2 && channel.compare(channel.size() - 2, 2, ":*") == 0) {
+        conn->type_wildcards.push_back(channel);
+    }
+}
+
+void WebSocketServer::unsubscribe(const ConnectionPtr& conn, const std::string& channel) {
+    auto& channels = conn->channels;
+    auto own = std::find(channels.begin(), channels.end(), channel);
+    if (own == channels.end()) {
+        return;
+    }
+    channels.erase(own);
+
+    if (channel == ALL_CHANNELS) {
+        conn->all_channels = false;
+    } else {
+        auto& wildcards = conn->type_wildcards;
+        wildcards.erase(std::remove(wildcards.begin(), wildcards.end(), channel), wildcards.end());
+    }
+
+    auto it = subscriptions_.find(channel);
+    if (it != subscriptions_.end()) {
+        auto& subscribers = it->second;
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), conn), subscribers.end());
+        if (subscribers.empty()) {
+            subscriptions_.erase(it);
+        }
+    }
+}
+
+void WebSocketServer::remove_connection(const ConnectionPtr& conn) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    while (!conn->channels.empty()) {
+        unsubscribe(conn, std::string(conn->channels.back()));
+    }
+    connections_.erase(conn);
+}
+
+void WebSocketServer::disconnect(Connection& conn) {
+    conn.queue.close();
+    std::lock_guard<std::mutex> lock(conn.fd_mutex);
+    if (!conn.fd_closed) {
+        shutdown(conn.fd, SHUT_RDWR);  // Unblocks the reader; it cleans up
+    }
+}
+
+}} // namespace mercuryTrade::websocket
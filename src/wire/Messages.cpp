@@ -0,0 +1,248 @@
+// src/wire/Messages.cpp
+#include "mercuryTrade/wire/Messages.hpp"
+
+namespace mercuryTrade {
+namespace wire {
+
+namespace {
+    // Fields are written byte by byte in little-endian order, so the
+    // encoding is identical on every host and needs no alignment
+
+    class Writer {
+    public:
+        Writer(std::string& out, TemplateId id, std::size_t block) : out_(out) {
+            out_.reserve(out_.size() + HEADER_SIZE + block);
+            u16(static_cast<std::uint16_t>(block));
+            u16(static_cast<std::uint16_t>(id));
+            u16(SCHEMA_ID);
+            u16(SCHEMA_VERSION);
+        }
+
+        void u8(std::uint8_t value) { out_.push_back(static_cast<char>(value)); }
+        void u16(std::uint16_t value) { put(value, 2); }
+        void u32(std::uint32_t value) { put(value, 4); }
+        void u64(std::uint64_t value) { put(value, 8); }
+        void i64(std::int64_t value) { put(static_cast<std::uint64_t>(value), 8); }
+        void f64(double value) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            put(bits, 8);
+        }
+        template <std::size_t N>
+        void text(const FixedString<N>& value) { out_.append(value.data, N); }
+        void pad(std::size_t count) { out_.append(count, '\0'); }
+
+    private:
+        std::string& out_;
+
+        void put(std::uint64_t value, int bytes) {
+            char buffer[8];
+            for (int i = 0; i < bytes; ++i) {
+                buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+            }
+            out_.append(buffer, bytes);
+        }
+    };
+
+    class Reader {
+    public:
+        explicit Reader(const char* data) : data_(data) {}
+
+        std::uint8_t u8() { return static_cast<std::uint8_t>(data_[pos_++]); }
+        std::uint16_t u16() { return static_cast<std::uint16_t>(get(2)); }
+        std::uint32_t u32() { return static_cast<std::uint32_t>(get(4)); }
+        std::uint64_t u64() { return get(8); }
+        std::int64_t i64() { return static_cast<std::int64_t>(get(8)); }
+        double f64() {
+            std::uint64_t bits = get(8);
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        template <std::size_t N>
+        void text(FixedString<N>& value) {
+            std::memcpy(value.data, data_ + pos_, N);
+            pos_ += N;
+        }
+        void skip(std::size_t count) { pos_ += count; }
+
+    private:
+        const char* data_;
+        std::size_t pos_ = 0;
+
+        std::uint64_t get(int bytes) {
+            std::uint64_t value = 0;
+            for (int i = 0; i < bytes; ++i) {
+                value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data_[pos_ + i])) << (8 * i);
+            }
+            pos_ += bytes;
+            return value;
+        }
+    };
+
+    // Validates the header and returns a reader positioned at the block
+    DecodeResult open(std::string_view in, TemplateId expected, std::size_t min_block,
+                      std::size_t& consumed, Reader& block) {
+        if (in.size() < HEADER_SIZE) {
+            return DecodeResult::Incomplete;
+        }
+        Reader header(in.data());
+        std::size_t block_length = header.u16();
+        auto id = static_cast<TemplateId>(header.u16());
+        std::uint16_t schema = header.u16();
+        header.u16();  // Version: any block at least min_block long is readable
+
+        if (schema != SCHEMA_ID) {
+            return DecodeResult::WrongSchema;
+        }
+        if (id != expected) {
+            return DecodeResult::WrongTemplate;
+        }
+        if (block_length < min_block) {
+            return DecodeResult::BlockTooShort;
+        }
+        if (in.size() < HEADER_SIZE + block_length) {
+            return DecodeResult::Incomplete;
+        }
+
+        consumed = HEADER_SIZE + block_length;
+        block = Reader(in.data() + HEADER_SIZE);
+        return DecodeResult::Ok;
+    }
+}
+
+void encode(const Quote& message, std::string& out) {
+    Writer w(out, TemplateId::Quote, QUOTE_BLOCK);
+    w.text(message.symbol);
+    w.f64(message.bid);
+    w.f64(message.ask);
+    w.f64(message.last);
+    w.f64(message.volume);
+    w.i64(message.timestamp);
+}
+
+void encode(const Trade& message, std::string& out) {
+    Writer w(out, TemplateId::Trade, TRADE_BLOCK);
+    w.text(message.symbol);
+    w.u64(message.trade_id);
+    w.f64(message.price);
+    w.f64(message.quantity);
+    w.i64(message.timestamp);
+    w.u8(static_cast<std::uint8_t>(message.aggressor));
+    w.pad(7);
+}
+
+void encode(const BookDelta& message, std::string& out) {
+    Writer w(out, TemplateId::BookDelta, BOOK_DELTA_BLOCK);
+    w.text(message.symbol);
+    w.u64(message.seq);
+    w.f64(message.price);
+    w.f64(message.quantity);
+    w.u32(message.orders);
+    w.u8(static_cast<std::uint8_t>(message.side));
+    w.pad(3);
+}
+
+void encode(const OrderUpdate& message, std::string& out) {
+    Writer w(out, TemplateId::OrderUpdate, ORDER_UPDATE_BLOCK);
+    w.text(message.order_id);
+    w.text(message.symbol);
+    w.f64(message.price);
+    w.f64(message.quantity);
+    w.f64(message.filled_quantity);
+    w.i64(message.timestamp);
+    w.u8(static_cast<std::uint8_t>(message.side));
+    w.u8(message.type);
+    w.u8(message.status);
+    w.pad(5);
+}
+
+DecodeResult decode(std::string_view in, Quote& message, std::size_t& consumed) {
+    Reader r(nullptr);
+    DecodeResult result = open(in, TemplateId::Quote, QUOTE_BLOCK, consumed, r);
+    if (result != DecodeResult::Ok) return result;
+    r.text(message.symbol);
+    message.bid = r.f64();
+    message.ask = r.f64();
+    message.last = r.f64();
+    message.volume = r.f64();
+    message.timestamp = r.i64();
+    return result;
+}
+
+DecodeResult decode(std::string_view in, Trade& message, std::size_t& consumed) {
+    Reader r(nullptr);
+    DecodeResult result = open(in, TemplateId::Trade, TRADE_BLOCK, consumed, r);
+    if (result != DecodeResult::Ok) return result;
+    r.text(message.symbol);
+    message.trade_id = r.u64();
+    message.price = r.f64();
+    message.quantity = r.f64();
+    message.timestamp = r.i64();
+    message.aggressor = static_cast<Side>(r.u8());
+    return result;
+}
+
+DecodeResult decode(std::string_view in, BookDelta& message, std::size_t& consumed) {
+    Reader r(nullptr);
+    DecodeResult result = open(in, TemplateId::BookDelta, BOOK_DELTA_BLOCK, consumed, r);
+    if (result != DecodeResult::Ok) return result;
+    r.text(message.symbol);
+    message.seq = r.u64();
+    message.price = r.f64();
+    message.quantity = r.f64();
+    message.orders = r.u32();
+    message.side = static_cast<Side>(r.u8());
+    return result;
+}
+
+DecodeResult decode(std::string_view in, OrderUpdate& message, std::size_t& consumed) {
+    Reader r(nullptr);
+    DecodeResult result = open(in, TemplateId::OrderUpdate, ORDER_UPDATE_BLOCK, consumed, r);
+    if (result != DecodeResult::Ok) return result;
+    r.text(message.order_id);
+    r.text(message.symbol);
+    message.price = r.f64();
+    message.quantity = r.f64();
+    message.filled_quantity = r.f64();
+    message.timestamp = r.i64();
+    message.side = static_cast<Side>(r.u8());
+    message.type = r.u8();
+    message.status = r.u8();
+    return result;
+}
+
+bool peekTemplate(std::string_view in, TemplateId& id) {
+    if (in.size() < HEADER_SIZE) {
+        return false;
+    }
+    Reader header(in.data());
+    header.skip(2);
+    id = static_cast<TemplateId>(header.u16());
+    return true;
+}
+
+bool acceptsBinary(std::string_view accept) {
+    // Media ranges are case-insensitive; parameters such as q are ignored
+    std::string_view type(CONTENT_TYPE);
+    while (!accept.empty()) {
+        std::size_t comma = accept.find(',');
+        std::string_view range = accept.substr(0, comma);
+        while (!range.empty() && (range.front() == ' ' || range.front() == '\t')) range.remove_prefix(1);
+        range = range.substr(0, range.find(';'));
+        while (!range.empty() && (range.back() == ' ' || range.back() == '\t')) range.remove_suffix(1);
+
+        if (range.size() == type.size()) {
+            bool match = true;
+            for (std::size_t i = 0; i < type.size() && match; ++i) {
+                match = (range[i] | 0x20) == type[i] || range[i] == type[i];
+            }
+            if (match) return true;
+        }
+        if (comma == std::string_view::npos) break;
+        accept.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+}} // namespace
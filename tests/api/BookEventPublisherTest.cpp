@@ -0,0 +1,150 @@
+#include "../../include/mercuryTrade/services/BookEventPublisher.hpp"
+#include "../../include/mercuryTrade/core/memory/mercMarketDataBusReader.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace mercuryTrade;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+// Test that a slow listener no longer holds up the book that produced the event
+void testListenersOffMatchingThread() {
+    const char* TEST_NAME = "Listeners Off Matching Thread Test";
+
+    OrderBookService books;
+    auto& book = books.book("BTC-USD");
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<bool> onMatchingThread{false};
+    std::atomic<std::thread::id> matchingThread{std::this_thread::get_id()};
+
+    {
+        BookEventPublisher publisher;
+        publisher.addDeltaListener([&](const std::string&, const core::memory::LevelDelta&) {
+            if (std::this_thread::get_id() == matchingThread) {
+                onMatchingThread = true;
+            }
+            released.wait();
+        });
+        publisher.start(books);
+
+        auto placed = std::async(std::launch::async, [&]() {
+            matchingThread = std::this_thread::get_id();
+            for (int i = 0; i < 100; ++i) {
+                book.addOrder("B" + std::to_string(i), core::memory::BookSide::BID, 100.0 - i, 1.0);
+            }
+        });
+        verify(placed.wait_for(std::chrono::seconds(5)) == std::future_status::ready, TEST_NAME,
+               "Orders should not wait for a blocked listener");
+        verify(publisher.backlog() > 0, TEST_NAME, "Events should queue behind the blocked listener");
+        release.set_value();
+    }
+    verify(!onMatchingThread, TEST_NAME, "Listeners should run on the publisher thread");
+}
+
+// Test that deltas, fills and tops arrive in the order the books made them
+void testEventOrder() {
+    const char* TEST_NAME = "Event Order Test";
+
+    OrderBookService books;
+    std::vector<std::string> events;
+    std::uint64_t lastSeq = 0;
+    bool inOrder = true;
+
+    {
+        BookEventPublisher publisher;
+        publisher.addDeltaListener([&](const std::string& symbol, const core::memory::LevelDelta& delta) {
+            inOrder = inOrder && delta.seq > lastSeq;
+            lastSeq = delta.seq;
+            events.push_back("delta:" + symbol);
+        });
+        publisher.addFillListener([&](const std::string& symbol, const core::memory::BookFill& fill) {
+            events.push_back("fill:" + symbol + ":" + fill.maker_order_id);
+        });
+        publisher.addTopListener([&](const std::string& symbol, const core::memory::BookTop&) {
+            events.push_back("top:" + symbol);
+        });
+        publisher.start(books);
+
+        auto& book = books.book("BTC-USD");
+        book.addOrder("ASK", core::memory::BookSide::ASK, 101.0, 1.0);
+        book.addOrder("BUY", core::memory::BookSide::BID, 101.0, 1.0);
+        for (int i = 0; i < 1000; ++i) {
+            book.addOrder("R" + std::to_string(i), core::memory::BookSide::BID, 50.0 + (i % 10), 1.0);
+        }
+    }
+
+    verify(events.size() > 4 && events[0] == "delta:BTC-USD" && events[1] == "top:BTC-USD", TEST_NAME,
+           "The resting ask should publish its delta, then the new top");
+    bool fillBeforeRemoval = false;
+    for (std::size_t i = 2; i + 1 < events.size(); ++i) {
+        if (events[i] == "fill:BTC-USD:ASK" && events[i + 1] == "delta:BTC-USD") {
+            fillBeforeRemoval = true;
+            break;
+        }
+    }
+    verify(fillBeforeRemoval, TEST_NAME, "The fill should come before the level it emptied");
+    verify(inOrder, TEST_NAME, "Deltas should keep their sequence order");
+    verify(lastSeq == books.book("BTC-USD").sequence(), TEST_NAME, "Every delta should be published by shutdown");
+}
+
+// Test that each book publishes its top and fills through its own bus channel
+void testMarketDataBus() {
+    const char* TEST_NAME = "Market Data Bus Test";
+
+    auto config = core::memory::MarketDataBus::Config::getDefaultConfig(
+        "/mercBookBusTest-" + std::to_string(::getpid()));
+    config.max_symbols = 1;
+    core::memory::MarketDataBus bus(config);
+    core::memory::MarketDataBusReader reader(bus.name());
+    OrderBookService books;
+    books.setMarketDataBus(&bus);
+
+    auto& btc = books.book("BTC-USD");
+    btc.addOrder("ASK", core::memory::BookSide::ASK, 101.0, 2.0);
+    btc.addOrder("BUY", core::memory::BookSide::BID, 101.0, 0.5);
+    auto subscription = reader.subscribe("BTC-USD", true);
+    core::memory::BusQuote quote{};
+    core::memory::BusTrade trade{};
+    verify(subscription && subscription->quote(quote) && quote.seq == btc.sequence() && quote.ask == 101.0 &&
+           quote.ask_size == 1.5, TEST_NAME, "The bus should hold the book's latest top");
+    verify(subscription->nextTrade(trade) && trade.price == 101.0 && trade.quantity == 0.5 &&
+           trade.buyer_aggressor == 1 && !subscription->nextTrade(trade), TEST_NAME,
+           "The bus should carry the book's fill");
+
+    // No channel is left, so the book trades but is not published
+    auto& eth = books.book("ETH-USD");
+    eth.addOrder("ASK", core::memory::BookSide::ASK, 10.0, 1.0);
+    eth.addOrder("BUY", core::memory::BookSide::BID, 10.0, 1.0);
+    verify(eth.sequence() > 0 && reader.symbols() == std::vector<std::string>({"BTC-USD"}), TEST_NAME,
+           "A book without a channel should still match");
+}
+
+int main() {
+    std::cout << "\nStarting book event publisher tests...\n" << std::endl;
+
+    try {
+        testListenersOffMatchingThread();
+        testEventOrder();
+        testMarketDataBus();
+
+        std::cout << "\nAll book event publisher tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,206 @@
+#include "../../include/mercuryTrade/api/orders/OrderEntryParser.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+
+using namespace mercuryTrade;
+using namespace mercuryTrade::api::orders;
+
+namespace {
+    std::size_t allocations = 0;
+}
+
+// Counts heap allocations so the parser can be held to zero.
+// GCC flags free() in the replacement delete once it inlines through
+// std::allocator, even though both replacements go through malloc/free.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+// Parses body expecting failure; returns the error
+OrderEntryError reject(const std::string& body) {
+    OrderEntry entry;
+    OrderEntryError error;
+    if (parseOrderEntry(body, entry, error)) {
+        throw std::runtime_error("Expected rejection of " + body);
+    }
+    return error;
+}
+
+// Test decoding of well-formed orders
+void testValidOrders() {
+    const char* TEST_NAME = "Valid Orders Test";
+
+    OrderEntry entry;
+    OrderEntryError error;
+    std::string body = R"({"symbol":"BTC-USD","side":"sell","type":"limit","quantity":1.5,"price":50000.25})";
+    verify(parseOrderEntry(body, entry, error), TEST_NAME, "Limit order should parse");
+    verify(entry.symbolView() == "BTC-USD" && entry.side == OrderSide::Sell && entry.type == OrderType::Limit &&
+           entry.quantity == 1.5 && entry.price == 50000.25, TEST_NAME, "Limit order fields mismatch");
+
+    body = " {\n \"type\" : \"market\", \"quantity\": 2e0, \"side\": \"buy\",\t\"symbol\": \"ETH-USD\" } \r\n";
+    verify(parseOrderEntry(body, entry, error), TEST_NAME, "Market order with whitespace should parse");
+    verify(entry.type == OrderType::Market && entry.side == OrderSide::Buy && entry.quantity == 2.0 &&
+           entry.price == 0.0, TEST_NAME, "Market order fields mismatch");
+
+    body = R"({"clientOrderId":"abc","meta":{"tags":["a",{"b":[1,2,null]}],"ok":true},"symbol":"SOL-USD",)"
+           R"("side":"buy","type":"market","quantity":0.001,"price":-1})";
+    verify(parseOrderEntry(body, entry, error), TEST_NAME, "Unknown members should be skipped");
+    verify(entry.symbolView() == "SOL-USD" && entry.price == 0.0, TEST_NAME, "Escapes should be decoded");
+
+    Order order = entry.toOrder();
+    verify(order.symbol == "SOL-USD" && order.type == OrderType::Market && order.quantity == 0.001 &&
+           order.account.empty(), TEST_NAME, "Order conversion mismatch");
+
+    body = R"({"account":"desk-7","symbol":"BTC-USD","side":"buy","type":"market","quantity":1})";
+    verify(parseOrderEntry(body, entry, error) && entry.toOrder().account == "desk-7", TEST_NAME,
+           "The account should be carried into the order");
+}
+
+// Test that each problem is reported with its message and position
+void testErrors() {
+    const char* TEST_NAME = "Error Reporting Test";
+
+    auto error = reject(R"({"symbol":"BTC-USD","side":"hold","type":"limit","quantity":1,"price":1})");
+    verify(std::strcmp(error.message, "side must be \"buy\" or \"sell\"") == 0 && error.offset == 27, TEST_NAME,
+           "Bad side should point at the value");
+
+    error = reject(R"({"symbol":"BTC-USD","side":"buy","type":"limit","quantity":"1","price":1})");
+    verify(std::strcmp(error.message, "quantity must be a number") == 0 && error.offset == 59, TEST_NAME,
+           "String quantity should be refused");
+
+    error = reject(R"({"symbol":"BTC-USD","side":"buy","type":"limit","quantity":0,"price":1})");
+    verify(std::strcmp(error.message, "quantity must be positive") == 0, TEST_NAME, "Zero quantity refused");
+
+    error = reject(R"({"symbol":"BTC-USD","side":"buy","type":"limit","quantity":1})");
+    verify(std::strcmp(error.message, "Missing price for limit order") == 0 && error.offset == 0, TEST_NAME,
+           "Limit order needs a price");
+
+    error = reject(R"({"side":"buy","type":"market","quantity":1})");
+    verify(std::strcmp(error.message, "Missing symbol") == 0, TEST_NAME, "Missing symbol refused");
+
+    error = reject(R"({"symbol":"A-VERY-LONG-SYMBOL-X","side":"buy","type":"market","quantity":1})");
+    verify(std::strcmp(error.message, "symbol must be 1 to 16 characters") == 0, TEST_NAME, "Long symbol refused");
+
+    error = reject(R"({"symbol":"BTC-USD","account":"","side":"buy","type":"market","quantity":1})");
+    verify(std::strcmp(error.message, "account must be 1 to 32 characters") == 0, TEST_NAME, "Empty account refused");
+
+    error = reject(R"({"symbol":"BTC-USD","symbol":"ETH-USD","side":"buy","type":"market","quantity":1})");
+    verify(std::strcmp(error.message, "Duplicate member") == 0, TEST_NAME, "Duplicate member refused");
+
+    error = reject(R"({"symbol":"BTC-USD","side":"buy","type":"market","quantity":1,"price":01})");
+    verify(std::strcmp(error.message, "Expected ',' or '}'") == 0, TEST_NAME, "Leading zero refused");
+
+    error = reject(R"({"symbol":"BTC-USD","side":"buy","type":"market","quantity":1e999})");
+    verify(std::strcmp(error.message, "Number out of range") == 0, TEST_NAME, "Overflow refused");
+
+    error = reject(R"({"symbol":"BTC-USD","side":"buy","type":"market","quantity":1} x)");
+    verify(std::strcmp(error.message, "Unexpected data after the order") == 0 && error.offset == 63, TEST_NAME,
+           "Trailing data refused");
+
+    error = reject(R"({"symbol":"BTC-USD)");
+    verify(std::strcmp(error.message, "Unterminated string") == 0, TEST_NAME, "Truncated body refused");
+
+    error = reject(R"({"symbol":"\ud800","side":"buy","type":"market","quantity":1})");
+    verify(std::strcmp(error.message, "Unpaired surrogate in \\u escape") == 0, TEST_NAME, "Lone surrogate refused");
+
+    error = reject(R"([1,2])");
+    verify(std::strcmp(error.message, "Expected an order object") == 0, TEST_NAME, "Non-object refused");
+
+    error = reject(std::string(40, '[') + std::string(40, ']'));
+    verify(std::strcmp(error.message, "Expected an order object") == 0, TEST_NAME, "Deep arrays refused");
+
+    error = reject(R"({"x":)" + std::string(40, '[') + std::string(40, ']') + "}");
+    verify(std::strcmp(error.message, "Nesting too deep") == 0, TEST_NAME, "Deeply nested members refused");
+}
+
+// Test batch decoding with per-item failures
+void testBatch() {
+    const char* TEST_NAME = "Batch Parsing Test";
+
+    std::vector<OrderEntryItem> items;
+    OrderEntryError error;
+    std::string body = R"([
+        {"symbol":"BTC-USD","side":"buy","type":"limit","quantity":1,"price":100},
+        {"symbol":"BTC-USD","side":"hold","type":"limit","quantity":1,"price":100},
+        {"symbol":"ETH-USD","side":"sell","type":"market","quantity":2,"extra":[{"nested":true}]}
+    ])";
+    verify(parseOrderEntries(body, items, error, 10), TEST_NAME, "Batch should parse");
+    verify(items.size() == 3 && items[0].ok && !items[1].ok && items[2].ok, TEST_NAME, "Per-item status mismatch");
+    verify(std::strcmp(items[1].error.message, "side must be \"buy\" or \"sell\"") == 0 &&
+           body.compare(items[1].error.offset, 6, "\"hold\"") == 0, TEST_NAME, "Item error should point into the body");
+    verify(items[2].entry.symbolView() == "ETH-USD" && items[2].entry.quantity == 2.0, TEST_NAME,
+           "Item after a refused one should decode");
+
+    verify(parseOrderEntries(" [ ] ", items, error, 10) && items.empty(), TEST_NAME, "Empty batch should parse");
+
+    verify(!parseOrderEntries(R"([{"symbol":"BTC-USD"}, {"symbol": ])", items, error, 10) &&
+           std::strcmp(error.message, "Unexpected character") == 0, TEST_NAME, "Malformed batch should fail as a whole");
+    verify(!parseOrderEntries(R"({"symbol":"BTC-USD"})", items, error, 10) &&
+           std::strcmp(error.message, "Expected an array of orders") == 0, TEST_NAME, "Non-array refused");
+
+    std::string many = "[";
+    for (int i = 0; i < 3; ++i) many += R"({"symbol":"X","side":"buy","type":"market","quantity":1},)";
+    many.back() = ']';
+    verify(!parseOrderEntries(many, items, error, 2) && std::strcmp(error.message, "Too many orders in batch") == 0,
+           TEST_NAME, "Batch limit should be enforced");
+}
+
+// Test that decoding does not touch the heap
+void testNoAllocation() {
+    const char* TEST_NAME = "No Allocation Test";
+
+    std::string body = R"({"symbol":"BTC-USD","side":"buy","type":"limit","quantity":1.25,"price":49999.5,)"
+                       R"("note":"escaped \"text\" é","extra":[1,{"a":null}]})";
+    std::string bad = R"({"symbol":"BTC-USD","side":"buy","type":"limit","quantity":-1,"price":1})";
+    OrderEntry entry;
+    OrderEntryError error;
+
+    std::size_t before = allocations;
+    bool ok = true;
+    for (int i = 0; i < 1000; ++i) {
+        ok = ok && parseOrderEntry(body, entry, error);
+        ok = ok && !parseOrderEntry(bad, entry, error);
+    }
+    verify(ok, TEST_NAME, "Unexpected parse results");
+    verify(allocations == before, TEST_NAME, "Parsing should not allocate");
+}
+
+int main() {
+    std::cout << "\nStarting order entry parser tests...\n" << std::endl;
+
+    try {
+        testValidOrders();
+        testErrors();
+        testBatch();
+        testNoAllocation();
+
+        std::cout << "\nAll order entry parser tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
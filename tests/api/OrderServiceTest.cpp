@@ -0,0 +1,470 @@
+#include "../../include/mercuryTrade/services/OrderService.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace mercuryTrade;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+    Order makeOrder(OrderSide side, OrderType type, double quantity, double price) {
+        Order order{};
+        order.symbol = "BTC-USD";
+        order.side = side;
+        order.type = type;
+        order.quantity = quantity;
+        order.price = price;
+        return order;
+    }
+
+    Order accountOrder(const std::string& account, OrderSide side, OrderType type, double quantity, double price) {
+        Order order = makeOrder(side, type, quantity, price);
+        order.account = account;
+        return order;
+    }
+}
+
+// Test that placement, matching and cancels go through the trading manager
+void testEngineLifecycle() {
+    const char* TEST_NAME = "Engine Lifecycle Test";
+    OrderService service(std::make_shared<OrderBookService>());
+
+    std::atomic<bool> onCaller{false};
+    std::atomic<int> updates{0};
+    std::thread::id caller = std::this_thread::get_id();
+    service.setOrderListener([&](const Order&) {
+        // Published by the service's publisher thread
+        if (std::this_thread::get_id() == caller) {
+            onCaller = true;
+        }
+        ++updates;
+    });
+
+    Order resting = service.placeOrder(makeOrder(OrderSide::Sell, OrderType::Limit, 5.0, 100.0));
+    verify(resting.status == OrderStatus::New, TEST_NAME, "Limit order should rest");
+    verify(updates == 1, TEST_NAME, "The update should be published before the call returns");
+    verify(service.engineStats().active_orders == 1, TEST_NAME, "Resting order should be held by the manager");
+
+    Order taker = service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Market, 2.0, 0.0));
+    verify(taker.status == OrderStatus::Filled, TEST_NAME, "Market order should fill against the book");
+    auto maker = service.getOrderById(resting.id);
+    verify(maker && maker->status == OrderStatus::PartiallyFilled && maker->filled_quantity == 2.0, TEST_NAME,
+           "Maker should be partially filled");
+
+    auto stats = service.engineStats();
+    verify(stats.active_orders == 1 && stats.total_trades == 1, TEST_NAME,
+           "Filled taker should be released and the trade recorded");
+
+    Order unfilled = service.placeOrder(makeOrder(OrderSide::Sell, OrderType::Market, 1.0, 0.0));
+    verify(unfilled.status == OrderStatus::Rejected, TEST_NAME, "Unmatched market order should be rejected");
+    verify(service.engineStats().active_orders == 1, TEST_NAME, "Rejected market order should be released");
+
+    service.cancelOrder(resting.id);
+    verify(service.getOrderById(resting.id)->status == OrderStatus::Cancelled, TEST_NAME, "Cancel should apply");
+    verify(service.engineStats().active_orders == 0, TEST_NAME, "Cancel should release the order");
+    verify(!onCaller, TEST_NAME, "Updates should reach the listener from the publisher thread");
+}
+
+// Test that orders outside their account's limits never reach the book
+void testRiskLimits() {
+    const char* TEST_NAME = "Risk Limits Test";
+    OrderService service(std::make_shared<OrderBookService>());
+    auto limits = core::memory::RiskEngine::Limits::unlimited();
+    limits.max_position = 10.0;
+    limits.max_notional = 2000.0;
+    limits.max_open_orders = 2;
+    limits.price_band = 0.1;
+    service.setRiskLimits("alice", limits);
+    service.setRiskLimits("bob", core::memory::RiskEngine::Limits::unlimited());
+
+    Order first = service.placeOrder(accountOrder("alice", OrderSide::Sell, OrderType::Limit, 5.0, 100.0));
+    Order taker = service.placeOrder(accountOrder("bob", OrderSide::Buy, OrderType::Market, 3.0, 0.0));
+    verify(first.status == OrderStatus::New && taker.status == OrderStatus::Filled, TEST_NAME,
+           "Orders within limits should trade");
+
+    verify(service.placeOrder(accountOrder("alice", OrderSide::Sell, OrderType::Limit, 1.0, 115.0)).status ==
+           OrderStatus::Rejected, TEST_NAME, "A price outside the band should be rejected");
+    verify(service.placeOrder(accountOrder("alice", OrderSide::Buy, OrderType::Limit, 20.0, 95.0)).status ==
+           OrderStatus::Rejected, TEST_NAME, "Orders past the notional limit should be rejected");
+    verify(service.placeOrder(accountOrder("alice", OrderSide::Sell, OrderType::Limit, 6.0, 101.0)).status ==
+           OrderStatus::Rejected, TEST_NAME, "A short of 3 with 2 offered cannot offer 6 more under a limit of 10");
+    verify(service.placeOrder(accountOrder("alice", OrderSide::Sell, OrderType::Limit, 5.0, 101.0)).status ==
+           OrderStatus::New, TEST_NAME, "Up to the position limit is allowed");
+    verify(service.placeOrder(accountOrder("alice", OrderSide::Buy, OrderType::Limit, 1.0, 99.0)).status ==
+           OrderStatus::Rejected, TEST_NAME, "A third resting order should be rejected");
+    verify(service.getOrderById(first.id) && service.engineStats().active_orders == 2, TEST_NAME,
+           "Rejected orders should not reach the manager");
+
+    service.cancelOrder(first.id);
+    verify(service.placeOrder(accountOrder("alice", OrderSide::Buy, OrderType::Limit, 1.0, 99.0)).status ==
+           OrderStatus::New, TEST_NAME, "Cancelling should free the open order slot");
+    auto exposure = service.riskExposure("alice", "BTC-USD");
+    verify(exposure.position == -3.0 && exposure.open_buys == 1.0 && exposure.open_sells == 5.0, TEST_NAME,
+           "Fills and cancels should keep the exposure current");
+    verify(service.riskExposure("bob", "BTC-USD").position == 3.0, TEST_NAME, "Each account has its own position");
+
+    verify(service.placeOrder(accountOrder("mallory", OrderSide::Buy, OrderType::Limit, 1.0, 99.0)).status ==
+           OrderStatus::Rejected, TEST_NAME, "Accounts without limits should be rejected");
+    verify(service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Limit, 1.0, 99.0)).status == OrderStatus::New,
+           TEST_NAME, "Orders without an account should use the default limits");
+}
+
+// Test that made-up accounts and symbols past capacity get their own verdicts
+void testRiskCapacity() {
+    const char* TEST_NAME = "Risk Capacity Test";
+    auto config = core::memory::RiskEngine::Config::getDefaultConfig();
+    config.max_accounts = 2;
+    config.max_symbols = 1;
+    OrderService service(std::make_shared<OrderBookService>(), nullptr, config);
+    service.setRiskLimits("alice", core::memory::RiskEngine::Limits::unlimited());
+
+    for (int i = 0; i < 3; ++i) {
+        verify(service.placeOrder(accountOrder("guest" + std::to_string(i), OrderSide::Buy, OrderType::Limit, 1.0,
+                                               99.0)).status == OrderStatus::Rejected, TEST_NAME,
+               "Unconfigured accounts should be rejected");
+    }
+    verify(service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Limit, 1.0, 99.0)).status == OrderStatus::New,
+           TEST_NAME, "Rejected names should not use up the default account's slot");
+    Order other = accountOrder("alice", OrderSide::Buy, OrderType::Limit, 1.0, 10.0);
+    other.symbol = "ETH-USD";
+    verify(service.placeOrder(other).status == OrderStatus::Rejected, TEST_NAME,
+           "A symbol past max_symbols should be rejected");
+    verify(std::string(core::memory::RiskEngine::checkName(core::memory::RiskCheck::UNKNOWN_ACCOUNT)) ==
+           "unknown account" && std::string(core::memory::RiskEngine::checkName(core::memory::RiskCheck::CAPACITY)) ==
+           "capacity", TEST_NAME, "The new verdicts should have readable names");
+}
+
+// Test that a partly filled limit order is closed when its remainder cannot rest
+void testPoolExhaustion() {
+    const char* TEST_NAME = "Pool Exhaustion Test";
+    auto config = core::memory::OrderBookAllocator::Config::getDefaultConfig();
+    config.max_orders = 1;
+    auto books = std::make_shared<OrderBookService>(4096, 0, config);
+    OrderService service(books);
+    service.setRiskLimits("alice", core::memory::RiskEngine::Limits::unlimited());
+    service.setRiskLimits("bob", core::memory::RiskEngine::Limits::unlimited());
+
+    // Takes the slot the maker frees before the taker's remainder can rest
+    auto& other = books->book("ETH-USD");
+    bool squat = false;
+    books->addDeltaListener([&](const std::string& symbol, const core::memory::LevelDelta&) {
+        if (squat && symbol == "BTC-USD") {
+            squat = false;
+            other.addOrder("squatter", core::memory::BookSide::BID, 10.0, 1.0);
+        }
+    });
+
+    Order maker = service.placeOrder(accountOrder("alice", OrderSide::Sell, OrderType::Limit, 1.0, 100.0));
+    squat = true;
+    Order taker = service.placeOrder(accountOrder("bob", OrderSide::Buy, OrderType::Limit, 3.0, 100.0));
+    verify(service.getOrderById(maker.id)->status == OrderStatus::Filled && taker.filled_quantity == 1.0 &&
+           taker.status == OrderStatus::Cancelled, TEST_NAME, "The remainder that could not rest should be cancelled");
+    verify(service.engineStats().active_orders == 0, TEST_NAME, "The cancelled order should be released");
+    auto exposure = service.riskExposure("bob", "BTC-USD");
+    verify(exposure.position == 1.0 && exposure.open_buys == 0.0, TEST_NAME,
+           "The remainder's risk reservation should be released");
+}
+
+// Test that many request threads can place and cancel concurrently
+void testConcurrentRequests() {
+    const char* TEST_NAME = "Concurrent Requests Test";
+    OrderService service(std::make_shared<OrderBookService>());
+
+    const int THREADS = 8;
+    const int ORDERS_PER_THREAD = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&service, t]() {
+            // Non-crossing prices, so every other order stays open
+            OrderSide side = t % 2 == 0 ? OrderSide::Buy : OrderSide::Sell;
+            double price = side == OrderSide::Buy ? 90.0 : 110.0;
+            for (int i = 0; i < ORDERS_PER_THREAD; ++i) {
+                Order placed = service.placeOrder(makeOrder(side, OrderType::Limit, 1.0, price));
+                if (i % 2 == 0) {
+                    service.cancelOrder(placed.id);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const std::size_t OPEN = THREADS * ORDERS_PER_THREAD / 2;
+    verify(service.engineStats().active_orders == OPEN, TEST_NAME, "Manager should hold exactly the open orders");
+
+    auto cancelled = service.cancelAllOrders("BTC-USD");
+    verify(cancelled.size() == OPEN, TEST_NAME, "Cancel-all should return every open order");
+    verify(service.engineStats().active_orders == 0, TEST_NAME, "Cancel-all should release every order");
+}
+
+// Test that accepted orders and cancels are journaled before the ack
+void testJournal() {
+    const char* TEST_NAME = "Journal Test";
+    char pattern[] = "/tmp/orderServiceJournalXXXXXX";
+    if (!mkdtemp(pattern)) {
+        throw std::runtime_error("Cannot create temporary directory");
+    }
+    std::string dir = pattern;
+
+    std::vector<core::memory::JournalCommand> commands;
+    try {
+        auto journal = std::make_shared<core::memory::CommandJournal>(
+            core::memory::CommandJournal::Config::getDefaultConfig(dir));
+        OrderService service(std::make_shared<OrderBookService>(), journal);
+        int updates = 0;
+        bool early = false;
+        service.setOrderListener([&](const Order&) {
+            ++updates;
+            early = early || journal->durableSequence() < journal->lastSequence();
+        });
+
+        Order first = service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Limit, 1.0, 90.0));
+        verify(journal->durableSequence() == 1, TEST_NAME, "New order should be durable when acknowledged");
+        Order second = service.placeOrder(makeOrder(OrderSide::Sell, OrderType::Limit, 2.0, 110.0));
+        service.cancelOrder(first.id);
+        verify(journal->durableSequence() == 3, TEST_NAME, "Cancel should be durable when acknowledged");
+        service.cancelOrder(first.id);
+        verify(journal->lastSequence() == 3, TEST_NAME, "Cancelling a closed order should not be journaled");
+        service.cancelAllOrders("BTC-USD");
+        verify(updates == 4 && !early, TEST_NAME, "Order updates should be published only once durable");
+
+        core::memory::JournalReader reader(dir);
+        core::memory::JournalCommand command;
+        while (reader.next(command)) {
+            commands.push_back(command);
+        }
+        verify(commands.size() == 4, TEST_NAME, "Two new orders and two cancels should be journaled");
+        verify(commands[0].type == core::memory::JournalCommand::Type::NEW_ORDER && commands[0].order_id == first.id &&
+               commands[0].is_buy && commands[0].price == 90.0, TEST_NAME, "New order record should match");
+        verify(commands[2].type == core::memory::JournalCommand::Type::CANCEL && commands[2].order_id == first.id,
+               TEST_NAME, "Cancel record should match");
+        verify(commands[3].order_id == second.id, TEST_NAME, "Cancel-all should journal each open order");
+    } catch (...) {
+        std::filesystem::remove_all(dir);
+        throw;
+    }
+    std::filesystem::remove_all(dir);
+}
+
+// Test that updates from commands on different threads arrive in journal order
+void testUpdateOrder() {
+    const char* TEST_NAME = "Update Order Test";
+    char pattern[] = "/tmp/orderServiceOrderXXXXXX";
+    if (!mkdtemp(pattern)) {
+        throw std::runtime_error("Cannot create temporary directory");
+    }
+    std::string dir = pattern;
+
+    try {
+        auto journal = std::make_shared<core::memory::CommandJournal>(
+            core::memory::CommandJournal::Config::getDefaultConfig(dir));
+        OrderService service(std::make_shared<OrderBookService>(), journal);
+        std::mutex mutex;
+        std::unordered_map<std::string, OrderStatus> last;
+        bool regressed = false;
+        service.setOrderListener([&](const Order& order) {
+            std::lock_guard<std::mutex> lock(mutex);
+            // New, then PartiallyFilled, then a final state; never back
+            auto it = last.find(order.id);
+            if (it != last.end() && (it->second >= OrderStatus::Filled || order.status < it->second)) {
+                regressed = true;
+            }
+            last[order.id] = order.status;
+        });
+
+        // One thread rests sells, the other fills them straight away, so
+        // each fill lands on a thread other than the one that rested the order
+        const int ORDERS = 300;
+        std::thread seller([&]() {
+            for (int i = 0; i < ORDERS; ++i) {
+                service.placeOrder(makeOrder(OrderSide::Sell, OrderType::Limit, 1.0, 100.0));
+            }
+        });
+        std::thread buyer([&]() {
+            for (int i = 0; i < ORDERS; ++i) {
+                service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Limit, 1.0, 100.0));
+            }
+        });
+        seller.join();
+        buyer.join();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        verify(last.size() == 2 * ORDERS, TEST_NAME, "Every order should have published updates");
+        verify(!regressed, TEST_NAME, "No order should be published out of lifecycle order");
+    } catch (...) {
+        std::filesystem::remove_all(dir);
+        throw;
+    }
+    std::filesystem::remove_all(dir);
+}
+
+// Test that a snapshot plus the journal after it restores the same state
+void testSnapshotRecovery() {
+    const char* TEST_NAME = "Snapshot Recovery Test";
+    char pattern[] = "/tmp/orderServiceSnapshotXXXXXX";
+    if (!mkdtemp(pattern)) {
+        throw std::runtime_error("Cannot create temporary directory");
+    }
+    std::string dir = pattern;
+
+    try {
+        auto config = core::memory::CommandJournal::Config::getDefaultConfig(dir);
+        config.sync_policy = core::memory::CommandJournal::SyncPolicy::NONE;
+        std::vector<Order> before;
+        std::string resting;
+        core::memory::RiskEngine::Exposure exposure{};
+        {
+            auto journal = std::make_shared<core::memory::CommandJournal>(config);
+            OrderService service(std::make_shared<OrderBookService>(), journal);
+            service.setRiskLimits("alice", core::memory::RiskEngine::Limits::unlimited());
+            resting = service.placeOrder(makeOrder(OrderSide::Sell, OrderType::Limit, 5.0, 101.0)).id;
+            service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Limit, 1.0, 99.0));
+            service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Market, 2.0, 0.0));
+
+            std::string path = service.snapshot(dir);
+            verify(std::filesystem::exists(path), TEST_NAME, "Snapshot file should be written");
+
+            // Journaled after the snapshot, so recovered by replay
+            Order cancelled = service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Limit, 1.0, 98.0));
+            service.cancelOrder(cancelled.id);
+            service.placeOrder(accountOrder("alice", OrderSide::Buy, OrderType::Limit, 1.0, 101.0));
+            before = service.getOrders().orders;
+            exposure = service.riskExposure("", "BTC-USD");
+        }
+
+        auto journal = std::make_shared<core::memory::CommandJournal>(config);
+        auto books = std::make_shared<OrderBookService>();
+        OrderService service(books, journal);
+        verify(service.recover(dir) == 3, TEST_NAME, "Only the journal tail should be replayed");
+
+        auto after = service.getOrders().orders;
+        bool same = before.size() == after.size();
+        for (std::size_t i = 0; same && i < before.size(); ++i) {
+            same = before[i].id == after[i].id && before[i].status == after[i].status &&
+                   before[i].filled_quantity == after[i].filled_quantity;
+        }
+        verify(same, TEST_NAME, "Recovered orders should match");
+        verify(service.getOrderById(resting)->filled_quantity == 3.0, TEST_NAME, "Fills should be recovered");
+        verify(books->book("BTC-USD").bestAsk() == 101.0 && books->book("BTC-USD").bestBid() == 99.0, TEST_NAME,
+               "Books should be rebuilt");
+        verify(service.engineStats().active_orders == 2, TEST_NAME, "Open orders should be back in the manager");
+        auto recovered = service.riskExposure("", "BTC-USD");
+        verify(recovered.position == exposure.position && recovered.open_buys == exposure.open_buys &&
+               recovered.open_sells == exposure.open_sells && service.riskExposure("alice", "BTC-USD").position == 1.0,
+               TEST_NAME, "Positions and open exposure should be recovered per account");
+
+        Order next = service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Limit, 1.0, 101.0));
+        verify(next.status == OrderStatus::Filled && next.id > before.back().id, TEST_NAME,
+               "Trading should continue against the recovered book with fresh ids");
+    } catch (...) {
+        std::filesystem::remove_all(dir);
+        throw;
+    }
+    std::filesystem::remove_all(dir);
+}
+
+// Test that a snapshot never becomes durable ahead of the journal it covers
+void testSnapshotAfterJournal() {
+    const char* TEST_NAME = "Snapshot After Journal Test";
+    char pattern[] = "/tmp/orderServiceSnapshotSyncXXXXXX";
+    if (!mkdtemp(pattern)) {
+        throw std::runtime_error("Cannot create temporary directory");
+    }
+    std::string dir = pattern;
+
+    try {
+        // The interval sync would not run during the test
+        auto config = core::memory::CommandJournal::Config::getDefaultConfig(dir);
+        config.sync_policy = core::memory::CommandJournal::SyncPolicy::INTERVAL;
+        config.sync_interval = std::chrono::hours(1);
+        auto journal = std::make_shared<core::memory::CommandJournal>(config);
+        OrderService service(std::make_shared<OrderBookService>(), journal);
+        service.placeOrder(makeOrder(OrderSide::Sell, OrderType::Limit, 1.0, 101.0));
+        service.placeOrder(makeOrder(OrderSide::Buy, OrderType::Limit, 1.0, 99.0));
+
+        std::string path = service.snapshot(dir);
+        verify(std::filesystem::exists(path) && !std::filesystem::exists(path + ".tmp"), TEST_NAME,
+               "The snapshot should be committed under its final name");
+        verify(journal->durableSequence() >= 2, TEST_NAME, "The journal it covers should be durable first");
+    } catch (...) {
+        std::filesystem::remove_all(dir);
+        throw;
+    }
+    std::filesystem::remove_all(dir);
+}
+
+// Test that recovery refuses a journal record it cannot replay
+void testUnreplayableModify() {
+    const char* TEST_NAME = "Unreplayable Modify Test";
+    char pattern[] = "/tmp/orderServiceModifyXXXXXX";
+    if (!mkdtemp(pattern)) {
+        throw std::runtime_error("Cannot create temporary directory");
+    }
+    std::string dir = pattern;
+
+    try {
+        auto config = core::memory::CommandJournal::Config::getDefaultConfig(dir);
+        config.sync_policy = core::memory::CommandJournal::SyncPolicy::NONE;
+        {
+            core::memory::CommandJournal journal(config);
+            core::memory::JournalCommand modify;
+            modify.type = core::memory::JournalCommand::Type::MODIFY;
+            modify.order_id = "ORD-1";
+            modify.symbol = "BTC-USD";
+            journal.append(modify);
+        }
+
+        auto journal = std::make_shared<core::memory::CommandJournal>(config);
+        OrderService service(std::make_shared<OrderBookService>(), journal);
+        bool refused = false;
+        try {
+            service.recover(dir);
+        } catch (const std::runtime_error&) {
+            refused = true;
+        }
+        verify(refused, TEST_NAME, "A modify record should stop recovery instead of being skipped");
+    } catch (...) {
+        std::filesystem::remove_all(dir);
+        throw;
+    }
+    std::filesystem::remove_all(dir);
+}
+
+int main() {
+    std::cout << "\nStarting order service tests...\n" << std::endl;
+
+    try {
+        testEngineLifecycle();
+        testRiskLimits();
+        testRiskCapacity();
+        testPoolExhaustion();
+        testConcurrentRequests();
+        testJournal();
+        testUpdateOrder();
+        testSnapshotRecovery();
+        testSnapshotAfterJournal();
+        testUnreplayableModify();
+
+        std::cout << "\nAll order service tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,199 @@
+#include "../../include/mercuryTrade/services/OrderStore.hpp"
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mercuryTrade;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+    Order makeOrder(OrderStore& store, const std::string& symbol) {
+        Order order{};
+        order.id = store.nextId();
+        order.symbol = symbol;
+        order.side = OrderSide::Buy;
+        order.type = OrderType::Limit;
+        order.quantity = 1.0;
+        order.price = 100.0;
+        order.status = OrderStatus::New;
+        return order;
+    }
+}
+
+// Test id issue, insert, lookup and update
+void testBasicOperations() {
+    const char* TEST_NAME = "Basic Operations Test";
+    OrderStore store;
+
+    std::string first = store.nextId();
+    std::string second = store.nextId();
+    verify(first == "ORD-1" && second == "ORD-2", TEST_NAME, "Ids should be sequential");
+
+    Order order = makeOrder(store, "BTC-USD");
+    store.insert(order);
+    verify(store.size() == 1, TEST_NAME, "Size should count inserted orders");
+    verify(store.get(order.id) && store.get(order.id)->symbol == "BTC-USD", TEST_NAME,
+           "Inserted order should be found");
+    verify(!store.get(first) && !store.get("ORD-0") && !store.get("ORD-03") && !store.get("bogus"),
+           TEST_NAME, "Unknown or malformed ids should not be found");
+
+    bool threw = false;
+    try {
+        store.insert(order);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Duplicate insert should throw");
+
+    threw = false;
+    try {
+        Order foreign = order;
+        foreign.id = "ORD-999";
+        store.insert(foreign);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Ids not issued by the store should be refused");
+
+    auto updated = store.update(order.id, [](Order& o) { o.status = OrderStatus::Filled; });
+    verify(updated && updated->status == OrderStatus::Filled, TEST_NAME, "Update should return the new state");
+    verify(store.get(order.id)->status == OrderStatus::Filled, TEST_NAME, "Update should be stored");
+    verify(!store.update("ORD-999", [](Order&) {}), TEST_NAME, "Updating an unknown id should fail");
+}
+
+// Test symbol and status filters, open-order lookup and cursor pagination
+void testQueries() {
+    const char* TEST_NAME = "Query Test";
+    OrderStore store;
+
+    std::vector<std::string> ids;
+    for (int i = 0; i < 10; ++i) {
+        Order order = makeOrder(store, i % 2 == 0 ? "BTC-USD" : "ETH-USD");
+        store.insert(order);
+        ids.push_back(order.id);
+    }
+    store.update(ids[2], [](Order& o) { o.status = OrderStatus::Cancelled; });
+    store.update(ids[4], [](Order& o) { o.status = OrderStatus::PartiallyFilled; });
+    store.update(ids[6], [](Order& o) { o.status = OrderStatus::Filled; });
+
+    OrderQuery query;
+    query.symbol = "BTC-USD";
+    OrderPage page = store.list(query);
+    verify(page.orders.size() == 5 && page.next_cursor == 0, TEST_NAME, "Symbol filter should match all its orders");
+    verify(page.orders.front().id == ids[0] && page.orders.back().id == ids[8], TEST_NAME,
+           "Orders should be oldest first across statuses");
+
+    query.status = OrderStatus::New;
+    page = store.list(query);
+    verify(page.orders.size() == 2 && page.orders[0].id == ids[0] && page.orders[1].id == ids[8], TEST_NAME,
+           "Status filter should follow updates");
+
+    auto open = store.openOrderIds("BTC-USD");
+    verify(open == std::vector<std::string>{ids[0], ids[4], ids[8]}, TEST_NAME,
+           "Open orders should include partially filled ones, in order");
+    verify(store.openOrderIds("XRP-USD").empty(), TEST_NAME, "Unknown symbol should have no open orders");
+
+    OrderQuery all;
+    all.limit = 3;
+    std::vector<std::string> seen;
+    do {
+        page = store.list(all);
+        verify(page.orders.size() <= 3, TEST_NAME, "Pages should respect the limit");
+        for (const auto& order : page.orders) {
+            seen.push_back(order.id);
+        }
+        all.after = page.next_cursor;
+    } while (page.next_cursor != 0);
+    verify(seen == ids, TEST_NAME, "Paging should visit every order once, in order");
+
+    query.symbol = "XRP-USD";
+    query.status.reset();
+    verify(store.list(query).orders.empty(), TEST_NAME, "Unknown symbol should list nothing");
+}
+
+// Test that concurrent writers and readers keep the indexes consistent
+void testConcurrency() {
+    const char* TEST_NAME = "Concurrency Test";
+    OrderStore store;
+
+    const int THREADS = 8;
+    const int ORDERS_PER_THREAD = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&store, t]() {
+            std::string symbol = t % 2 == 0 ? "BTC-USD" : "ETH-USD";
+            for (int i = 0; i < ORDERS_PER_THREAD; ++i) {
+                Order order = makeOrder(store, symbol);
+                store.insert(order);
+                if (i % 3 == 0) {
+                    store.update(order.id, [](Order& o) { o.status = OrderStatus::Cancelled; });
+                }
+                if (i % 50 == 0) {
+                    OrderQuery query;
+                    query.symbol = symbol;
+                    query.limit = 10;
+                    store.list(query);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const std::size_t TOTAL = THREADS * ORDERS_PER_THREAD;
+    verify(store.size() == TOTAL, TEST_NAME, "Every insert should be stored");
+
+    OrderQuery query;
+    query.limit = OrderStore::MAX_PAGE_SIZE;
+    std::set<std::string> seen;
+    std::size_t cancelled = 0;
+    OrderPage page;
+    do {
+        page = store.list(query);
+        for (const auto& order : page.orders) {
+            seen.insert(order.id);
+            cancelled += order.status == OrderStatus::Cancelled;
+        }
+        query.after = page.next_cursor;
+    } while (page.next_cursor != 0);
+    verify(seen.size() == TOTAL, TEST_NAME, "Paging should return every order exactly once");
+    verify(cancelled == THREADS * ((ORDERS_PER_THREAD + 2) / 3), TEST_NAME, "Status updates should all land");
+
+    query = OrderQuery();
+    query.status = OrderStatus::Cancelled;
+    query.limit = OrderStore::MAX_PAGE_SIZE;
+    std::size_t indexed = 0;
+    do {
+        page = store.list(query);
+        indexed += page.orders.size();
+        query.after = page.next_cursor;
+    } while (page.next_cursor != 0);
+    verify(indexed == cancelled, TEST_NAME, "Status index should match stored statuses");
+}
+
+int main() {
+    std::cout << "\nStarting order store tests...\n" << std::endl;
+
+    try {
+        testBasicOperations();
+        testQueries();
+        testConcurrency();
+
+        std::cout << "\nAll order store tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
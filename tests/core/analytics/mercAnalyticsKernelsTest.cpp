@@ -0,0 +1,179 @@
+#include "../../../include/mercuryTrade/core/analytics/mercAnalyticsKernels.hpp"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mercuryTrade::core::analytics;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+
+// Lengths around the vector widths, so every tail path runs
+const std::size_t LENGTHS[] = {0, 1, 3, 4, 5, 7, 8, 9, 16, 17, 1001};
+
+struct Trades {
+    std::vector<double> prices;
+    std::vector<double> quantities;
+};
+
+Trades randomTrades(std::size_t count, unsigned seed) {
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<int> step(-10, 10);
+    std::uniform_int_distribution<int> size(1, 5000);
+    Trades trades;
+    double price = 50000.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        price += 0.25 * step(random);
+        trades.prices.push_back(price);
+        trades.quantities.push_back(size(random) / 1000.0);
+    }
+    return trades;
+}
+
+// The kernel sets this build and CPU can run
+std::vector<const Kernels*> available() {
+    std::vector<const Kernels*> sets{&scalarKernels()};
+    if (avx2Kernels()) {
+        sets.push_back(avx2Kernels());
+    }
+    return sets;
+}
+
+bool close(double a, double b, double tolerance) {
+    return std::fabs(a - b) <= tolerance * std::fmax(1.0, std::fmax(std::fabs(a), std::fabs(b)));
+}
+
+} // namespace
+
+// Test VWAP and min/max against plain loops
+void testVwapAndMinMax() {
+    const char* TEST_NAME = "VWAP And MinMax Test";
+    for (const Kernels* set : available()) {
+        bool vwapMatches = true;
+        bool minMaxMatches = true;
+        for (std::size_t length : LENGTHS) {
+            Trades trades = randomTrades(length, 7);
+            long double notional = 0.0L;
+            long double volume = 0.0L;
+            double low = INFINITY;
+            double high = -INFINITY;
+            for (std::size_t i = 0; i < length; ++i) {
+                notional += static_cast<long double>(trades.prices[i]) * trades.quantities[i];
+                volume += trades.quantities[i];
+                low = std::fmin(low, trades.prices[i]);
+                high = std::fmax(high, trades.prices[i]);
+            }
+            VwapResult result = set->vwap(trades.prices.data(), trades.quantities.data(), length);
+            double expected = volume != 0.0L ? static_cast<double>(notional / volume) : 0.0;
+            vwapMatches = vwapMatches && close(result.vwap, expected, 1e-12) &&
+                          close(result.volume, static_cast<double>(volume), 1e-12);
+
+            MinMax range = set->minMax(trades.prices.data(), length);
+            minMaxMatches = minMaxMatches && range.min == low && range.max == high;
+        }
+        verify(vwapMatches, TEST_NAME, set->name);
+        verify(minMaxMatches, TEST_NAME, set->name);
+    }
+}
+
+// Test rolling volatility against recomputing every window
+void testRollingVolatility() {
+    const char* TEST_NAME = "Rolling Volatility Test";
+    const std::size_t WINDOWS[] = {2, 3, 5, 50};
+    for (const Kernels* set : available()) {
+        bool matches = true;
+        for (std::size_t length : LENGTHS) {
+            Trades trades = randomTrades(length, 11);
+            for (std::size_t window : WINDOWS) {
+                std::size_t outputs = rollingVolatilityCount(length, window);
+                std::vector<double> out(outputs + 1, -1.0);
+                set->rollingVolatility(trades.prices.data(), length, window, out.data());
+                for (std::size_t k = 0; k < outputs; ++k) {
+                    double mean = 0.0;
+                    for (std::size_t i = k + 1; i <= k + window; ++i) {
+                        mean += trades.prices[i] / trades.prices[i - 1] - 1.0;
+                    }
+                    mean /= static_cast<double>(window);
+                    double squares = 0.0;
+                    for (std::size_t i = k + 1; i <= k + window; ++i) {
+                        double r = trades.prices[i] / trades.prices[i - 1] - 1.0 - mean;
+                        squares += r * r;
+                    }
+                    // Compared as variances: running sums leave an absolute
+                    // error that the square root magnifies near zero
+                    double expected = squares / static_cast<double>(window - 1);
+                    matches = matches && std::fabs(out[k] * out[k] - expected) <= 1e-9 * expected + 1e-16;
+                }
+                matches = matches && out[outputs] == -1.0;
+            }
+        }
+        verify(matches, TEST_NAME, set->name);
+    }
+    verify(rollingVolatilityCount(10, 1) == 0 && rollingVolatilityCount(10, 10) == 0 &&
+           rollingVolatilityCount(10, 4) == 6, TEST_NAME, "Output counts should follow the window");
+}
+
+// Test that every set bins volume exactly like a plain loop
+void testVolumeProfile() {
+    const char* TEST_NAME = "Volume Profile Test";
+    Trades trades = randomTrades(1001, 13);
+    MinMax range = scalarKernels().minMax(trades.prices.data(), trades.prices.size());
+    const std::size_t BUCKETS = 16;
+    const double width = (range.max - range.min) / 12.0;
+    const double low = range.min + 2.0 * width;  // Some prices fall below and above the buckets
+
+    std::vector<double> expected(BUCKETS, 0.0);
+    for (std::size_t i = 0; i < trades.prices.size(); ++i) {
+        double slot = std::floor((trades.prices[i] - low) * (1.0 / width));
+        if (slot >= 0.0 && slot < static_cast<double>(BUCKETS)) {
+            expected[static_cast<std::size_t>(slot)] += trades.quantities[i];
+        }
+    }
+    for (const Kernels* set : available()) {
+        std::vector<double> volumes(BUCKETS, 0.0);
+        set->volumeProfile(trades.prices.data(), trades.quantities.data(), trades.prices.size(), low, width,
+                           BUCKETS, volumes.data());
+        verify(volumes == expected, TEST_NAME, set->name);
+    }
+}
+
+// Test that the best set the CPU supports is the one used
+void testDispatch() {
+    const char* TEST_NAME = "Dispatch Test";
+    const Kernels& selected = kernels();
+    verify(&selected == (avx2Kernels() ? avx2Kernels() : &scalarKernels()), TEST_NAME,
+           "kernels() should prefer AVX2 when available");
+    std::cout << "Using " << selected.name << " kernels" << std::endl;
+
+    Trades trades = randomTrades(100, 17);
+    verify(vwap(trades.prices.data(), trades.quantities.data(), 100).vwap ==
+           selected.vwap(trades.prices.data(), trades.quantities.data(), 100).vwap, TEST_NAME,
+           "The free functions should call the selected set");
+}
+
+int main() {
+    std::cout << "\nStarting analytics kernel tests...\n" << std::endl;
+
+    try {
+        testVwapAndMinMax();
+        testRollingVolatility();
+        testVolumeProfile();
+        testDispatch();
+
+        std::cout << "\nAll analytics kernel tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,197 @@
+#include "../../../include/mercuryTrade/core/memory/mercBarAggregator.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mercuryTrade::core::memory;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+
+constexpr std::int64_t SECOND = 1000000000LL;
+constexpr std::int64_t MINUTE = 60 * SECOND;
+
+// An hour boundary, so every interval starts together
+constexpr std::int64_t BASE = 1700000000LL / 3600 * 3600 * SECOND;
+
+struct Closed {
+    std::string symbol;
+    BarInterval interval;
+    Bar bar;
+};
+
+} // namespace
+
+// Test that trades within an interval build one bar per interval
+void testBuildBars() {
+    const char* TEST_NAME = "Build Bars Test";
+    BarAggregator bars;
+
+    bars.onTrade("BTC-USD", 100.0, 1.0, BASE + 100);
+    bars.onTrade("BTC-USD", 105.0, 2.0, BASE + 200 * 1000000LL);
+    bars.onTrade("BTC-USD", 95.0, 0.5, BASE + 900 * 1000000LL);
+    bars.onTrade("BTC-USD", 101.0, 1.5, BASE + 950 * 1000000LL);
+
+    for (std::size_t i = 0; i < BarAggregator::INTERVALS; ++i) {
+        auto result = bars.range("BTC-USD", static_cast<BarInterval>(i), 0, INT64_MAX, 10);
+        verify(result.size() == 1, TEST_NAME, "Each interval should hold one bar");
+        const Bar& bar = result[0];
+        verify(bar.start == BASE && bar.open == 100.0 && bar.high == 105.0 && bar.low == 95.0 &&
+               bar.close == 101.0 && bar.volume == 5.0 && bar.trades == 4 && !bar.closed, TEST_NAME,
+               "Bar should carry OHLCV of every trade");
+    }
+    verify(bars.range("ETH-USD", BarInterval::MINUTE_1, 0, INT64_MAX, 10).empty(), TEST_NAME,
+           "Unknown symbols have no bars");
+}
+
+// Test that bars close when the next interval starts or time passes
+void testCloseBars() {
+    const char* TEST_NAME = "Close Bars Test";
+    BarAggregator bars;
+    std::vector<Closed> closed;
+    bars.setCloseListener([&](const std::string& symbol, BarInterval interval, const Bar& bar) {
+        closed.push_back(Closed{symbol, interval, bar});
+    });
+
+    bars.onTrade("ETH-USD", 10.0, 1.0, BASE);
+    bars.onTrade("ETH-USD", 11.0, 1.0, BASE + SECOND / 2);
+    verify(closed.empty(), TEST_NAME, "Nothing closes within the first second");
+
+    bars.onTrade("ETH-USD", 12.0, 1.0, BASE + SECOND);
+    verify(closed.size() == 1 && closed[0].interval == BarInterval::SECOND_1 && closed[0].bar.closed &&
+           closed[0].bar.close == 11.0 && closed[0].bar.trades == 2, TEST_NAME,
+           "Next second's trade should close the 1s bar");
+
+    bars.onTrade("ETH-USD", 13.0, 1.0, BASE + 5 * MINUTE);
+    verify(closed.size() == 4 && closed[1].interval == BarInterval::SECOND_1 &&
+           closed[2].interval == BarInterval::MINUTE_1 && closed[3].interval == BarInterval::MINUTE_5,
+           TEST_NAME, "Crossing five minutes should close 1s, 1m and 5m bars");
+    verify(closed[2].bar.open == 10.0 && closed[2].bar.close == 12.0 && closed[2].bar.volume == 3.0, TEST_NAME,
+           "Closed 1m bar should cover the first minute");
+
+    bars.advance(BASE + 5 * MINUTE + SECOND);
+    verify(closed.size() == 5 && closed[4].interval == BarInterval::SECOND_1 && closed[4].bar.close == 13.0,
+           TEST_NAME, "advance should close the 1s bar without a trade");
+    bars.advance(BASE + 5 * MINUTE + SECOND);
+    verify(closed.size() == 5, TEST_NAME, "A bar closes only once");
+
+    // The closed 1s bar cannot take more trades
+    bars.onTrade("ETH-USD", 14.0, 1.0, BASE + 5 * MINUTE + SECOND / 2);
+    bars.onTrade("ETH-USD", 9.0, 1.0, BASE + SECOND / 2);
+    verify(bars.lateTrades() == 2, TEST_NAME, "Trades for closed or past bars should be counted as late");
+    auto minute = bars.range("ETH-USD", BarInterval::MINUTE_1, BASE + 5 * MINUTE, INT64_MAX, 10);
+    verify(minute.size() == 1 && minute[0].close == 14.0 && minute[0].trades == 2, TEST_NAME,
+           "A trade late for 1s should still reach the open 1m bar");
+}
+
+// Test range queries over a wrapped circular array
+void testRangeQueries() {
+    const char* TEST_NAME = "Range Queries Test";
+    auto config = BarAggregator::Config::getDefaultConfig();
+    config.history = {10, 10, 10, 10};
+    BarAggregator bars(config);
+
+    // 25 one-second bars, skipping every fifth second
+    std::size_t traded = 0;
+    for (std::int64_t second = 0; second < 31; ++second) {
+        if (second % 5 == 4) {
+            continue;
+        }
+        bars.onTrade("SOL-USD", 20.0 + static_cast<double>(second), 1.0, BASE + second * SECOND);
+        ++traded;
+    }
+    verify(traded == 25, TEST_NAME, "Setup should trade in 25 seconds");
+
+    auto all = bars.range("SOL-USD", BarInterval::SECOND_1, 0, INT64_MAX, 100);
+    verify(all.size() == 10 && all.front().start == BASE + 18 * SECOND && all.back().start == BASE + 30 * SECOND,
+           TEST_NAME, "Only the newest bars should be kept");
+    bool ordered = true;
+    for (std::size_t i = 1; i < all.size(); ++i) {
+        ordered = ordered && all[i - 1].start < all[i].start && all[i - 1].closed;
+    }
+    verify(ordered && !all.back().closed, TEST_NAME, "Bars should be oldest first with only the last running");
+
+    auto window = bars.range("SOL-USD", BarInterval::SECOND_1, BASE + 20 * SECOND, BASE + 25 * SECOND, 100);
+    verify(window.size() == 4 && window.front().start == BASE + 20 * SECOND &&
+           window.back().start == BASE + 23 * SECOND, TEST_NAME, "from is inclusive and to exclusive");
+
+    auto limited = bars.range("SOL-USD", BarInterval::SECOND_1, 0, INT64_MAX, 3);
+    verify(limited.size() == 3 && limited.back().start == BASE + 30 * SECOND, TEST_NAME,
+           "limit should keep the newest bars");
+    verify(bars.range("SOL-USD", BarInterval::SECOND_1, BASE + 40 * SECOND, INT64_MAX, 10).empty(), TEST_NAME,
+           "A range after the last bar is empty");
+
+    verify(BarAggregator::parseInterval("5m") == BarInterval::MINUTE_5 &&
+           std::string(BarAggregator::intervalName(BarInterval::HOUR_1)) == "1h", TEST_NAME,
+           "Interval names should round-trip");
+    bool threw = false;
+    try {
+        BarAggregator::parseInterval("2m");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Unknown interval names should be rejected");
+}
+
+// Test that bars can be fed from the allocator's trade rings
+void testTradeRingFeed() {
+    const char* TEST_NAME = "Trade Ring Feed Test";
+    marketDataAllocator rings;
+    BarAggregator bars;
+    TradeRingBarFeed feed(rings, bars);
+
+    std::size_t btc = rings.symbolIndex("BTC-USD");
+    for (std::uint64_t i = 0; i < 10; ++i) {
+        rings.publish(btc, marketDataAllocator::Channel::TRADE,
+                      MarketTrade{i, BASE + static_cast<std::int64_t>(i) * SECOND, 100.0 + static_cast<double>(i), 1.0, 1});
+    }
+    verify(feed.drain() == 10, TEST_NAME, "Trades already in the ring should be drained");
+
+    std::size_t eth = rings.symbolIndex("ETH-USD");
+    rings.publish(eth, marketDataAllocator::Channel::TRADE, MarketTrade{11, BASE, 10.0, 2.0, 0});
+    rings.publish(btc, marketDataAllocator::Channel::TRADE, MarketTrade{12, BASE + 10 * SECOND, 90.0, 1.0, 0});
+    verify(feed.drain() == 2 && feed.drain() == 0, TEST_NAME, "Later trades and symbols should be picked up once");
+
+    auto minute = bars.range("BTC-USD", BarInterval::MINUTE_1, 0, INT64_MAX, 10);
+    verify(minute.size() == 1 && minute[0].high == 109.0 && minute[0].low == 90.0 && minute[0].volume == 11.0,
+           TEST_NAME, "Bars should reflect every ring trade");
+    verify(bars.range("ETH-USD", BarInterval::HOUR_1, 0, INT64_MAX, 10).size() == 1 && feed.missedTrades() == 0,
+           TEST_NAME, "New symbols should get bars too");
+
+    // More ring symbols than the aggregator holds
+    auto config = BarAggregator::Config::getDefaultConfig();
+    config.max_symbols = 1;
+    BarAggregator small(config);
+    TradeRingBarFeed limited(rings, small);
+    verify(limited.drain() == 11 && limited.untrackedSymbols() == 1, TEST_NAME,
+           "A symbol past capacity should be counted and skipped");
+    rings.publish(btc, marketDataAllocator::Channel::TRADE, MarketTrade{13, BASE + 11 * SECOND, 95.0, 1.0, 0});
+    rings.publish(eth, marketDataAllocator::Channel::TRADE, MarketTrade{14, BASE + SECOND, 11.0, 1.0, 0});
+    verify(limited.drain() == 1 && limited.untrackedSymbols() == 1 && small.findSymbol("ETH-USD") ==
+           BarAggregator::NOT_FOUND, TEST_NAME, "Tracked symbols should keep flowing");
+}
+
+int main() {
+    std::cout << "\nStarting bar aggregator tests...\n" << std::endl;
+
+    try {
+        testBuildBars();
+        testCloseBars();
+        testRangeQueries();
+        testTradeRingFeed();
+
+        std::cout << "\nAll bar aggregator tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,285 @@
+#include "../../../include/mercuryTrade/core/memory/mercCommandJournal.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mercuryTrade::core::memory;
+namespace fs = std::filesystem;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+
+// A fresh directory, removed again when the test is done
+struct TempDirectory {
+    std::string path;
+
+    TempDirectory() {
+        char pattern[] = "/tmp/mercJournalTestXXXXXX";
+        if (!mkdtemp(pattern)) {
+            throw std::runtime_error("Cannot create temporary directory");
+        }
+        path = pattern;
+    }
+    ~TempDirectory() {
+        std::error_code error;
+        fs::remove_all(path, error);
+    }
+};
+
+CommandJournal::Config smallSegments(const std::string& directory, CommandJournal::SyncPolicy policy) {
+    auto config = CommandJournal::Config::getDefaultConfig(directory);
+    config.segment_size = CommandJournal::SEGMENT_HEADER_SIZE + 4096;
+    config.sync_policy = policy;
+    return config;
+}
+
+JournalCommand newOrder(int i) {
+    JournalCommand command;
+    command.type = JournalCommand::Type::NEW_ORDER;
+    command.order_id = "ORD-" + std::to_string(i);
+    command.symbol = i % 2 == 0 ? "BTC-USD" : "ETH-USD";
+    command.price = 100.0 + i;
+    command.quantity = 1.5;
+    command.is_buy = i % 3 != 0;
+    command.is_market = i % 5 == 0;
+    command.timestamp = 1700000000000000000LL + i;
+    command.account = i % 4 == 0 ? "" : "ACCT-" + std::to_string(i % 4);
+    return command;
+}
+
+std::vector<JournalCommand> readAll(const std::string& directory) {
+    JournalReader reader(directory);
+    std::vector<JournalCommand> commands;
+    JournalCommand command;
+    while (reader.next(command)) {
+        commands.push_back(command);
+    }
+    return commands;
+}
+
+} // namespace
+
+// Test that records round-trip across several segments
+void testRoundTrip() {
+    const char* TEST_NAME = "Round Trip Test";
+    TempDirectory dir;
+
+    const int COUNT = 500;
+    {
+        CommandJournal journal(smallSegments(dir.path, CommandJournal::SyncPolicy::NONE));
+        for (int i = 0; i < COUNT; ++i) {
+            JournalCommand command = newOrder(i);
+            if (i % 7 == 0) {
+                command.type = JournalCommand::Type::CANCEL;
+            }
+            verify(journal.append(command) == static_cast<std::uint64_t>(i + 1), TEST_NAME,
+                   "Sequences should start at 1 and be contiguous");
+        }
+        verify(journal.getStats().segments > 1, TEST_NAME, "Small segments should have rolled");
+    }
+
+    auto commands = readAll(dir.path);
+    verify(commands.size() == COUNT, TEST_NAME, "Every record should be read back");
+    bool same = true;
+    for (int i = 0; i < COUNT; ++i) {
+        JournalCommand expected = newOrder(i);
+        const JournalCommand& actual = commands[i];
+        same = same && actual.sequence == static_cast<std::uint64_t>(i + 1) &&
+               actual.type == (i % 7 == 0 ? JournalCommand::Type::CANCEL : JournalCommand::Type::NEW_ORDER) &&
+               actual.order_id == expected.order_id && actual.symbol == expected.symbol &&
+               actual.price == expected.price && actual.quantity == expected.quantity &&
+               actual.is_buy == expected.is_buy && actual.is_market == expected.is_market &&
+               actual.timestamp == expected.timestamp && actual.account == expected.account;
+    }
+    verify(same, TEST_NAME, "Records should match what was appended");
+}
+
+// Test that reopening continues the sequence and a torn tail is dropped
+void testRecovery() {
+    const char* TEST_NAME = "Recovery Test";
+    TempDirectory dir;
+
+    {
+        CommandJournal journal(smallSegments(dir.path, CommandJournal::SyncPolicy::GROUP));
+        for (int i = 0; i < 100; ++i) {
+            journal.append(newOrder(i));
+        }
+        journal.waitDurable(100);
+    }
+
+    // Flip a byte inside the last record to simulate a torn write
+    std::string newest;
+    std::uint64_t newestSize = 0;
+    for (const auto& entry : fs::directory_iterator(dir.path)) {
+        if (entry.path().string() > newest) {
+            newest = entry.path().string();
+            newestSize = entry.file_size();
+        }
+    }
+    {
+        JournalReader reader(dir.path);
+        JournalCommand command;
+        while (reader.next(command)) {}
+        verify(reader.lastSequence() == 100, TEST_NAME, "Reader should see every record before corruption");
+    }
+    {
+        std::fstream file(newest, std::ios::in | std::ios::out | std::ios::binary);
+        std::vector<char> bytes(newestSize);
+        file.read(bytes.data(), bytes.size());
+        std::size_t end = bytes.size();
+        while (end > 0 && bytes[end - 1] == 0) {
+            --end;
+        }
+        file.seekp(end - 1);
+        file.put(static_cast<char>(bytes[end - 1] ^ 0x5A));
+    }
+
+    auto commands = readAll(dir.path);
+    verify(commands.size() == 99, TEST_NAME, "Reading should stop before the torn record");
+
+    {
+        CommandJournal journal(smallSegments(dir.path, CommandJournal::SyncPolicy::GROUP));
+        verify(journal.lastSequence() == 99, TEST_NAME, "Reopened journal should end at the last intact record");
+        std::uint64_t sequence = journal.append(newOrder(1000));
+        verify(sequence == 100, TEST_NAME, "Appending should reuse the torn record's sequence");
+        journal.waitDurable(sequence);
+    }
+
+    commands = readAll(dir.path);
+    verify(commands.size() == 100 && commands.back().order_id == "ORD-1000", TEST_NAME,
+           "The replacement record should follow the intact ones");
+}
+
+// Test that concurrent appenders are acknowledged by shared syncs
+void testGroupCommit() {
+    const char* TEST_NAME = "Group Commit Test";
+    TempDirectory dir;
+
+    const int THREADS = 8;
+    const int PER_THREAD = 200;
+    CommandJournal::Stats stats;
+    {
+        auto config = CommandJournal::Config::getDefaultConfig(dir.path);
+        config.segment_size = 1024 * 1024;
+        CommandJournal journal(config);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&journal, t]() {
+                for (int i = 0; i < PER_THREAD; ++i) {
+                    std::uint64_t sequence = journal.append(newOrder(t * PER_THREAD + i));
+                    journal.waitDurable(sequence);
+                    if (journal.durableSequence() < sequence) {
+                        throw std::runtime_error("Acknowledged before durable");
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        stats = journal.getStats();
+    }
+
+    verify(stats.last_sequence == THREADS * PER_THREAD && stats.durable_sequence == stats.last_sequence,
+           TEST_NAME, "Every record should be durable");
+    verify(stats.syncs > 0 && stats.syncs <= stats.last_sequence, TEST_NAME, "Syncs should cover the records");
+
+    std::set<std::string> ids;
+    for (const auto& command : readAll(dir.path)) {
+        ids.insert(command.order_id);
+    }
+    verify(ids.size() == THREADS * PER_THREAD, TEST_NAME, "Every appended command should be read back once");
+}
+
+// Test the interval policy and oversized records
+void testIntervalPolicy() {
+    const char* TEST_NAME = "Interval Policy Test";
+    TempDirectory dir;
+
+    auto config = smallSegments(dir.path, CommandJournal::SyncPolicy::INTERVAL);
+    config.sync_interval = std::chrono::microseconds(200);
+    CommandJournal journal(config);
+
+    std::uint64_t sequence = journal.append(newOrder(1));
+    journal.waitDurable(sequence);  // Does not block under INTERVAL
+    journal.sync();
+    verify(journal.durableSequence() == sequence, TEST_NAME, "sync() should make everything durable");
+
+    JournalCommand huge = newOrder(2);
+    huge.symbol.assign(5000, 'X');
+    bool threw = false;
+    try {
+        journal.append(huge);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "A record larger than a segment should be refused");
+}
+
+// Test reading after a sequence and dropping segments a snapshot covers
+void testTruncate() {
+    const char* TEST_NAME = "Truncate Test";
+    TempDirectory dir;
+
+    CommandJournal journal(smallSegments(dir.path, CommandJournal::SyncPolicy::NONE));
+    for (int i = 0; i < 300; ++i) {
+        journal.append(newOrder(i));
+    }
+    std::size_t files = std::distance(fs::directory_iterator(dir.path), fs::directory_iterator());
+
+    {
+        JournalReader reader(dir.path, 250);
+        JournalCommand command;
+        verify(reader.next(command) && command.sequence == 251, TEST_NAME,
+               "Reading should resume right after the given sequence");
+    }
+
+    std::size_t removed = journal.truncateBefore(251);
+    std::size_t left = std::distance(fs::directory_iterator(dir.path), fs::directory_iterator());
+    verify(removed > 0 && left == files - removed, TEST_NAME, "Covered segments should be deleted");
+
+    JournalReader reader(dir.path, 250);
+    JournalCommand command;
+    std::uint64_t expected = 251;
+    bool contiguous = true;
+    while (reader.next(command)) {
+        contiguous = contiguous && command.sequence == expected++;
+    }
+    verify(contiguous && expected == 301, TEST_NAME, "Every record after the sequence should remain");
+
+    verify(journal.truncateBefore(1000000) < left, TEST_NAME, "The active segment should never be deleted");
+    verify(journal.append(newOrder(300)) == 301, TEST_NAME, "Appending should continue after truncation");
+}
+
+int main() {
+    std::cout << "\nStarting command journal tests...\n" << std::endl;
+
+    try {
+        testRoundTrip();
+        testRecovery();
+        testGroupCommit();
+        testIntervalPolicy();
+        testTruncate();
+
+        std::cout << "\nAll command journal tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,268 @@
+#include "../../../include/mercuryTrade/core/memory/mercFeedHandler.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercFeedSimulator.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercLastValueCache.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace mercuryTrade::core::memory;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+
+marketDataAllocator::bufferConfig smallRing(std::size_t capacity) {
+    auto config = marketDataAllocator::getDefaultConfig();
+    config.buffer_capacity = capacity;
+    return config;
+}
+
+} // namespace
+
+// Test that definitions, quotes and trades land in the last value cache
+void testDecodeIntoCache() {
+    const char* TEST_NAME = "Decode Into Cache Test";
+    LastValueCache cache(16);
+    marketDataAllocator allocator;
+    FeedHandler handler(cache, allocator);
+
+    feed::PacketWriter writer;
+    writer.definition(7, "BTC-USD", 1);
+    writer.quote(7, 2, 1000, 99.5, 2.0, 100.5, 3.0);
+    writer.trade(7, 3, 1001, 100.5, 0.25, true);
+    writer.trade(7, 4, 1002, 99.5, 0.75, false);
+    verify(handler.onPacket(writer.data().data(), writer.data().size()) == 3, TEST_NAME,
+           "Every quote and trade should produce a tick");
+
+    LastValueCache::Values values{};
+    verify(cache.read("BTC-USD", values), TEST_NAME, "Defined symbol should be in the cache");
+    verify(values.bid == 99.5 && values.ask == 100.5 && values.ask_size == 3.0, TEST_NAME,
+           "Quote should be cached");
+    verify(values.last == 99.5 && values.volume == 1.0 && values.trades == 2 && values.sequence == 4 &&
+           values.timestamp == 1002, TEST_NAME, "Trades should update last, volume and count");
+
+    std::size_t ring = allocator.findSymbol("BTC-USD");
+    verify(ring != marketDataAllocator::NOT_FOUND, TEST_NAME, "Definition should claim the symbol's rings");
+    auto quotes = allocator.subscribe(ring, marketDataAllocator::Channel::QUOTE, true);
+    auto trades = allocator.subscribe(ring, marketDataAllocator::Channel::TRADE, true);
+    MarketQuote quote{};
+    MarketTrade trade{};
+    verify(allocator.read(quotes, quote) && quote.sequence == 2 && quote.bid_size == 2.0 &&
+           !allocator.read(quotes, quote), TEST_NAME, "Quote ring should hold the quote");
+    verify(allocator.read(trades, trade) && trade.sequence == 3 && trade.buyer_aggressor == 1, TEST_NAME,
+           "Aggressor flag should be decoded");
+    verify(allocator.read(trades, trade) && trade.buyer_aggressor == 0 && !allocator.read(trades, trade),
+           TEST_NAME, "Trade ring should hold exactly the trades written");
+
+    auto stats = handler.getStats();
+    verify(stats.packets == 1 && stats.quotes == 1 && stats.trades == 2 && stats.definitions == 1 &&
+           stats.gaps == 0, TEST_NAME, "Stats should count each message kind");
+}
+
+// Test that bad packets, unknown symbols and sequence gaps are counted
+void testBadInput() {
+    const char* TEST_NAME = "Bad Input Test";
+    LastValueCache cache(16);
+    marketDataAllocator allocator;
+    FeedHandler handler(cache, allocator);
+
+    std::string garbage = "not a feed packet at all";
+    verify(handler.onPacket(garbage.data(), garbage.size()) == 0, TEST_NAME, "Bad magic yields nothing");
+
+    feed::PacketWriter writer;
+    writer.definition(1, "ETH-USD", 1);
+    writer.quote(1, 2, 1, 10.0, 1.0, 11.0, 1.0);
+    std::string truncated = writer.data().substr(0, writer.data().size() - 8);
+    verify(handler.onPacket(truncated.data(), truncated.size()) == 0, TEST_NAME,
+           "A count beyond the packet should be rejected");
+
+    writer.clear();
+    writer.quote(2, 3, 1, 10.0, 1.0, 11.0, 1.0);  // Symbol 2 was never defined
+    writer.definition(1, "ETH-USD", 4);
+    writer.quote(1, 9, 1, 10.0, 1.0, 11.0, 1.0);   // Sequences 5 to 8 were lost
+    verify(handler.onPacket(writer.data().data(), writer.data().size()) == 1, TEST_NAME,
+           "Only the defined symbol's quote should be kept");
+
+    auto stats = handler.getStats();
+    verify(stats.malformed == 2 && stats.unknown_symbols == 1, TEST_NAME, "Rejections should be counted");
+    verify(stats.gaps == 1 && stats.lost_messages == 4, TEST_NAME, "The sequence jump should be counted");
+}
+
+// Test that each symbol's ticks go to its own rings
+void testSymbolRouting() {
+    const char* TEST_NAME = "Symbol Routing Test";
+    LastValueCache cache(4);
+    marketDataAllocator allocator(smallRing(8));
+    FeedHandler handler(cache, allocator);
+
+    feed::PacketWriter writer;
+    writer.definition(0, "SOL-USD", 1);
+    writer.definition(9, "ADA-USD", 2);
+    for (std::uint64_t i = 0; i < 20; ++i) {
+        writer.trade(i % 2 ? 9 : 0, 3 + i, static_cast<std::int64_t>(i), 20.0 + static_cast<double>(i), 1.0, true);
+    }
+    handler.onPacket(writer.data().data(), writer.data().size());
+    verify(handler.ticksWritten() == 20, TEST_NAME, "Every trade should be written");
+
+    std::size_t ada = allocator.findSymbol("ADA-USD");
+    verify(allocator.written(allocator.findSymbol("SOL-USD"), marketDataAllocator::Channel::TRADE) == 10 &&
+           allocator.written(ada, marketDataAllocator::Channel::TRADE) == 10, TEST_NAME,
+           "Trades should be split by symbol");
+
+    auto cursor = allocator.subscribe(ada, marketDataAllocator::Channel::TRADE, true);
+    std::uint64_t missed = 0;
+    MarketTrade trade{};
+    verify(allocator.read(cursor, trade, &missed) && trade.price == 25.0 && missed == 0, TEST_NAME,
+           "Oldest held trade should be the third for the symbol");
+    LastValueCache::Values values{};
+    verify(cache.read("ADA-USD", values) && values.last == 39.0 && values.trades == 10, TEST_NAME,
+           "Cache should follow each symbol separately");
+}
+
+// Test that definitions past the symbol capacity are dropped, not fatal
+void testSymbolCapacity() {
+    const char* TEST_NAME = "Symbol Capacity Test";
+    LastValueCache cache(4);
+    marketDataAllocator allocator;
+    FeedHandler handler(cache, allocator);
+
+    feed::PacketWriter writer;
+    const char* symbols[] = {"BTC-USD", "ETH-USD", "SOL-USD", "ADA-USD", "XRP-USD"};
+    for (std::uint16_t id = 0; id < 5; ++id) {
+        writer.definition(id, symbols[id], id + 1);
+    }
+    writer.quote(4, 6, 1, 0.5, 1.0, 0.6, 1.0);
+    writer.quote(3, 7, 1, 0.3, 1.0, 0.4, 1.0);
+    verify(handler.onPacket(writer.data().data(), writer.data().size()) == 1, TEST_NAME,
+           "Only the tracked symbol's quote should be kept");
+
+    auto stats = handler.getStats();
+    verify(stats.definitions == 4 && stats.rejected_definitions == 1 && stats.unknown_symbols == 1, TEST_NAME,
+           "The definition past capacity should be counted and its id left undefined");
+    LastValueCache::Values values{};
+    verify(!cache.read("XRP-USD", values) && cache.read("ADA-USD", values) && values.bid == 0.3, TEST_NAME,
+           "The symbols that fit should keep working");
+}
+
+// Test that a capture file replays to the same cache as live packets
+void testCaptureReplay() {
+    const char* TEST_NAME = "Capture Replay Test";
+    std::string path = "/tmp/mercFeedCapture-" + std::to_string(::getpid()) + ".bin";
+    std::remove(path.c_str());
+
+    FeedSimulator simulator;
+    auto packets = simulator.packets(50);
+    FileFeedSource::writeCapture(path, packets);
+
+    LastValueCache live(16);
+    marketDataAllocator liveAllocator;
+    FeedHandler liveHandler(live, liveAllocator);
+    for (const auto& packet : packets) {
+        liveHandler.onPacket(packet.data(), packet.size());
+    }
+
+    LastValueCache replayed(16);
+    marketDataAllocator replayAllocator;
+    FeedHandler replayHandler(replayed, replayAllocator);
+    FileFeedSource source(path);
+    std::atomic<bool> stop{false};
+    replayHandler.run(source, stop);
+    std::remove(path.c_str());
+
+    verify(source.exhausted() && replayHandler.getStats().packets == 50, TEST_NAME,
+           "Every captured packet should be replayed");
+    verify(replayHandler.getStats().gaps == 0 && replayHandler.getStats().unknown_symbols == 0, TEST_NAME,
+           "Simulator output should be gap free");
+    verify(replayed.symbols() == live.symbols() && live.size() == 3, TEST_NAME, "Symbols should match");
+    for (const auto& symbol : live.symbols()) {
+        LastValueCache::Values a{}, b{};
+        verify(live.read(symbol, a) && replayed.read(symbol, b) && a.sequence == b.sequence && a.bid == b.bid &&
+               a.volume == b.volume, TEST_NAME, "Replayed values should match the live ones");
+    }
+}
+
+// Test that packets sent over loopback UDP are ingested
+void testUdpLoopback() {
+    const char* TEST_NAME = "UDP Loopback Test";
+    LastValueCache cache(16);
+    marketDataAllocator allocator;
+    FeedHandler handler(cache, allocator);
+    UdpFeedSource source(0);
+    verify(source.port() != 0, TEST_NAME, "Port 0 should bind a free port");
+
+    FeedSimulator simulator;
+    simulator.sendUdp("127.0.0.1", source.port(), 20);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (handler.getStats().packets < 20 && std::chrono::steady_clock::now() < deadline) {
+        if (handler.poll(source) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    verify(handler.getStats().packets == 20 && cache.size() == 3, TEST_NAME, "Every datagram should arrive");
+    verify(handler.ticksWritten() == simulator.messagesSent() - 3, TEST_NAME,
+           "Every message but the definitions should become a tick");
+}
+
+// Test that readers never see a torn entry while the feed thread writes
+void testConcurrentReader() {
+    const char* TEST_NAME = "Concurrent Reader Test";
+    LastValueCache cache(4);
+    std::size_t index = cache.index("BTC-USD");
+    std::atomic<bool> done{false};
+
+    std::thread writer([&]() {
+        for (std::uint64_t i = 1; i <= 200000; ++i) {
+            double mid = static_cast<double>(i);
+            cache.updateQuote(index, mid - 0.5, mid, mid + 0.5, mid, static_cast<std::int64_t>(i), i);
+        }
+        done = true;
+    });
+
+    bool consistent = true;
+    std::uint64_t last = 0;
+    while (!done.load()) {
+        LastValueCache::Values values{};
+        if (cache.read(index, values)) {
+            double mid = static_cast<double>(values.sequence);
+            consistent = consistent && values.bid == mid - 0.5 && values.ask == mid + 0.5 &&
+                         values.bid_size == mid && values.sequence >= last;
+            last = values.sequence;
+        }
+        std::this_thread::yield();
+    }
+    writer.join();
+    verify(consistent, TEST_NAME, "Every read should be one whole update, in order");
+}
+
+int main() {
+    std::cout << "\nStarting feed handler tests...\n" << std::endl;
+
+    try {
+        testDecodeIntoCache();
+        testBadInput();
+        testSymbolRouting();
+        testSymbolCapacity();
+        testCaptureReplay();
+        testUdpLoopback();
+        testConcurrentReader();
+
+        std::cout << "\nAll feed handler tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
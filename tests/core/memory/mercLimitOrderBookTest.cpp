@@ -0,0 +1,476 @@
+#include "../../../include/mercuryTrade/core/memory/mercLimitOrderBook.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercBookRegionReader.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercLevelDeltaLog.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercSnapshotFile.hpp"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <vector>
+
+using namespace mercuryTrade::core::memory;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+OrderBookAllocator::Config smallConfig() {
+    return OrderBookAllocator::Config{
+        1000,   // max_orders
+        200,    // max_price_levels
+        64,     // order_data_size
+        true    // track_modifications
+    };
+}
+
+// Test that resting orders emit one sequenced delta per level change
+void testRestingDeltas() {
+    const char* TEST_NAME = "Resting Order Delta Test";
+    OrderBookAllocator allocator(smallConfig());
+    LimitOrderBook book("BTC-USD", allocator);
+
+    std::vector<LevelDelta> deltas;
+    book.setDeltaListener([&](const LevelDelta& delta) { deltas.push_back(delta); });
+
+    book.addOrder("B1", BookSide::BID, 100.0, 1.0);
+    book.addOrder("B2", BookSide::BID, 100.0, 2.0);
+    book.addOrder("B3", BookSide::BID, 99.0, 1.5);
+    book.addOrder("A1", BookSide::ASK, 101.0, 3.0);
+
+    verify(deltas.size() == 4, TEST_NAME, "Expected one delta per order");
+    for (std::size_t i = 0; i < deltas.size(); ++i) {
+        verify(deltas[i].seq == i + 1, TEST_NAME, "Sequence numbers must be contiguous");
+    }
+    verify(deltas[1].price == 100.0 && deltas[1].size == 3.0 && deltas[1].order_count == 2,
+           TEST_NAME, "Delta should carry the new level size");
+
+    auto snapshot = book.snapshot();
+    verify(snapshot.seq == 4 && snapshot.bids.size() == 2 && snapshot.asks.size() == 1, TEST_NAME, "Snapshot shape mismatch");
+    verify(snapshot.bids[0].price == 100.0 && snapshot.bids[1].price == 99.0, TEST_NAME, "Bids should be best first");
+
+    verify(book.reduceOrder("B2", 0.5), TEST_NAME, "Reduce failed");
+    verify(deltas.back().size == 1.5, TEST_NAME, "Reduce delta mismatch");
+    verify(!book.reduceOrder("B2", 5.0), TEST_NAME, "Increase should be refused");
+
+    verify(book.cancelOrder("B3"), TEST_NAME, "Cancel failed");
+    verify(deltas.back().price == 99.0 && deltas.back().size == 0.0, TEST_NAME, "Removed level should report size 0");
+    verify(!book.cancelOrder("B3"), TEST_NAME, "Double cancel should fail");
+    verify(book.getStats().bid_levels == 1, TEST_NAME, "Level not removed");
+}
+
+// Test price-time matching, fills and the deltas they produce
+void testMatching() {
+    const char* TEST_NAME = "Matching Test";
+    OrderBookAllocator allocator(smallConfig());
+    LimitOrderBook book("ETH-USD", allocator);
+
+    book.addOrder("A1", BookSide::ASK, 10.0, 1.0);
+    book.addOrder("A2", BookSide::ASK, 10.0, 2.0);
+    book.addOrder("A3", BookSide::ASK, 11.0, 5.0);
+
+    std::vector<BookFill> fills;
+    std::vector<LevelDelta> deltas;
+    book.setFillListener([&](const BookFill& fill) { fills.push_back(fill); });
+    book.setDeltaListener([&](const LevelDelta& delta) { deltas.push_back(delta); });
+
+    auto result = book.addOrder("B1", BookSide::BID, 11.0, 4.0);
+    verify(result.accepted && result.filled_quantity == 4.0 && result.resting_quantity == 0.0,
+           TEST_NAME, "Taker should fill completely");
+    verify(fills.size() == 3 && fills[0].maker_order_id == "A1" && fills[1].maker_order_id == "A2",
+           TEST_NAME, "Fills should follow time priority");
+    verify(fills[2].price == 11.0 && fills[2].quantity == 1.0, TEST_NAME, "Fill should trade at the resting price");
+    verify(deltas.size() == 2 && deltas[0].price == 10.0 && deltas[0].size == 0.0 &&
+           deltas[1].price == 11.0 && deltas[1].size == 4.0, TEST_NAME, "One delta per touched level");
+
+    result = book.addOrder("B2", BookSide::BID, 10.5, 2.0);
+    verify(result.filled_quantity == 0.0 && result.resting_quantity == 2.0, TEST_NAME, "Non-crossing order should rest");
+    verify(book.bestBid() == 10.5 && book.bestAsk() == 11.0, TEST_NAME, "Top of book mismatch");
+
+    result = book.addOrder("S1", BookSide::ASK, 0.0, 10.0, true);
+    verify(result.filled_quantity == 2.0 && result.resting_quantity == 0.0, TEST_NAME, "Market remainder should not rest");
+    verify(book.getStats().bid_levels == 0, TEST_NAME, "Bid side should be empty");
+    verify(!book.addOrder("A3", BookSide::ASK, 12.0, 1.0).accepted, TEST_NAME, "Duplicate id should be rejected");
+}
+
+// Test that a snapshot plus later deltas reproduces the live book
+void testSnapshotReplay() {
+    const char* TEST_NAME = "Snapshot Replay Test";
+    OrderBookAllocator allocator(smallConfig());
+    LimitOrderBook book("SOL-USD", allocator);
+    LevelDeltaLog history(64);
+    book.setDeltaListener([&](const LevelDelta& delta) { history.append(delta); });
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> price_dist(90, 110);
+    std::uniform_int_distribution<> qty_dist(1, 5);
+    std::vector<std::string> ids;
+
+    auto snapshot = book.snapshot();
+    for (int i = 0; i < 500; ++i) {
+        if (i == 250) {
+            snapshot = book.snapshot();
+        }
+        if (!ids.empty() && gen() % 4 == 0) {
+            book.cancelOrder(ids[gen() % ids.size()]);
+        } else {
+            std::string id = "O" + std::to_string(i);
+            BookSide side = gen() % 2 ? BookSide::BID : BookSide::ASK;
+            book.addOrder(id, side, price_dist(gen), qty_dist(gen));
+            ids.push_back(id);
+        }
+    }
+
+    std::vector<LevelDelta> replay;
+    verify(!history.since(snapshot.seq, replay), TEST_NAME, "Old sequence should be reported as a gap");
+
+    // Start over from a fresh snapshot and replay what follows it
+    snapshot = book.snapshot();
+    std::uint64_t base_seq = snapshot.seq;
+    for (int i = 0; i < 40; ++i) {
+        book.addOrder("R" + std::to_string(i), i % 2 ? BookSide::BID : BookSide::ASK, price_dist(gen), qty_dist(gen));
+    }
+    replay.clear();
+    verify(history.since(base_seq, replay), TEST_NAME, "Recent deltas should be retained");
+    verify(!replay.empty() && replay.front().seq == base_seq + 1, TEST_NAME, "Replay should start right after the snapshot");
+
+    std::map<double, double> bids, asks;
+    for (const auto& level : snapshot.bids) bids[level.price] = level.size;
+    for (const auto& level : snapshot.asks) asks[level.price] = level.size;
+    for (const auto& delta : replay) {
+        auto& side = delta.side == BookSide::BID ? bids : asks;
+        if (delta.size > 0.0) {
+            side[delta.price] = delta.size;
+        } else {
+            side.erase(delta.price);
+        }
+    }
+
+    auto live = book.snapshot();
+    verify(live.bids.size() == bids.size() && live.asks.size() == asks.size(), TEST_NAME, "Replayed level count mismatch");
+    for (const auto& level : live.bids) {
+        verify(bids[level.price] == level.size, TEST_NAME, "Replayed bid size mismatch");
+    }
+    for (const auto& level : live.asks) {
+        verify(asks[level.price] == level.size, TEST_NAME, "Replayed ask size mismatch");
+    }
+}
+
+// Test depth limits and price-bucket aggregation
+void testDepthAndBuckets() {
+    const char* TEST_NAME = "Depth And Bucket Test";
+    OrderBookAllocator allocator(smallConfig());
+    LimitOrderBook book("BTC-USD", allocator);
+
+    // Bids 100.0 .. 95.5 and asks 101.0 .. 105.5 in 0.5 steps, one unit each
+    for (int i = 0; i < 10; ++i) {
+        book.addOrder("B" + std::to_string(i), BookSide::BID, 100.0 - 0.5 * i, 1.0);
+        book.addOrder("A" + std::to_string(i), BookSide::ASK, 101.0 + 0.5 * i, 1.0);
+    }
+    book.addOrder("B10", BookSide::BID, 99.5, 2.0);
+
+    auto top = book.snapshot(3);
+    verify(top.bids.size() == 3 && top.asks.size() == 3, TEST_NAME, "Depth limit not applied");
+    verify(top.bids[1].price == 99.5 && top.bids[1].size == 3.0 && top.bids[1].order_count == 2,
+           TEST_NAME, "Level aggregate mismatch");
+
+    auto buckets = book.snapshot(2, 2.0);
+    verify(buckets.bids.size() == 2 && buckets.asks.size() == 2, TEST_NAME, "Bucket depth not applied");
+    // Bids round down: 100.0 -> 100, 99.5..98.0 -> 98, 97.5..96.0 -> 96
+    verify(buckets.bids[0].price == 100.0 && buckets.bids[0].size == 1.0, TEST_NAME, "Top bid bucket mismatch");
+    verify(buckets.bids[1].price == 98.0 && buckets.bids[1].size == 6.0, TEST_NAME, "Second bid bucket mismatch");
+    // Asks round up: 101.0..102.0 -> 102, 102.5..104.0 -> 104
+    verify(buckets.asks[0].price == 102.0 && buckets.asks[0].size == 3.0, TEST_NAME, "Top ask bucket mismatch");
+    verify(buckets.asks[1].price == 104.0 && buckets.asks[1].size == 4.0, TEST_NAME, "Second ask bucket mismatch");
+
+    auto fine = book.snapshot(100, 0.1);
+    verify(fine.asks.size() == 10 && fine.asks[0].price == 101.0, TEST_NAME, "Exact multiples should keep their bucket");
+}
+
+// Test that destroying a book returns its nodes to a shared allocator
+void testSharedAllocator() {
+    const char* TEST_NAME = "Shared Allocator Test";
+    OrderBookAllocator allocator(smallConfig());
+
+    {
+        LimitOrderBook first("BTC-USD", allocator);
+        LimitOrderBook second("ETH-USD", allocator);
+        first.addOrder("X1", BookSide::BID, 100.0, 1.0);
+        second.addOrder("Y1", BookSide::ASK, 200.0, 1.0);
+        verify(!second.cancelOrder("X1"), TEST_NAME, "A book must not cancel another book's order");
+        verify(allocator.getStats().active_orders == 2, TEST_NAME, "Active order count mismatch");
+    }
+
+    auto stats = allocator.getStats();
+    verify(stats.active_orders == 0 && stats.active_price_levels == 0, TEST_NAME, "Books leaked pool nodes");
+}
+
+// Test batch submission, batch cancel and cancel-all
+void testBatchOperations() {
+    const char* TEST_NAME = "Batch Operations Test";
+    OrderBookAllocator allocator(smallConfig());
+    LimitOrderBook book("SOL-USD", allocator);
+
+    std::vector<LevelDelta> deltas;
+    std::vector<BookFill> fills;
+    book.setDeltaListener([&](const LevelDelta& delta) { deltas.push_back(delta); });
+    book.setFillListener([&](const BookFill& fill) { fills.push_back(fill); });
+
+    auto results = book.addOrders({
+        {"A1", BookSide::ASK, 10.0, 1.0, false},
+        {"A2", BookSide::ASK, 10.5, 1.0, false},
+        {"B1", BookSide::BID, 10.0, 0.5, false},   // Crosses A1 from the same batch
+        {"A1", BookSide::ASK, 11.0, 1.0, false},   // Duplicate of a resting id
+        {"B2", BookSide::BID, 9.0, 2.0, false},
+        {"B3", BookSide::BID, 9.0, 1.0, false}
+    });
+    verify(results.size() == 6, TEST_NAME, "One result per order");
+    verify(results[2].filled_quantity == 0.5 && fills.size() == 1 && fills[0].maker_order_id == "A1",
+           TEST_NAME, "Later orders should match earlier ones in the batch");
+    verify(!results[3].accepted, TEST_NAME, "Duplicate id should be refused");
+    verify(book.getStats().resting_orders == 4, TEST_NAME, "Resting order count mismatch");
+
+    auto cancelled = book.cancelOrders({"B2", "missing", "B2"});
+    verify(cancelled == std::vector<bool>({true, false, false}), TEST_NAME, "Batch cancel results mismatch");
+
+    std::size_t before = deltas.size();
+    auto ids = book.cancelAll();
+    verify(ids.size() == 3 && book.getStats().resting_orders == 0, TEST_NAME, "Cancel all should empty the book");
+    verify(deltas.size() == before + 3, TEST_NAME, "Cancel all should emit one delta per level");
+    for (std::size_t i = before; i < deltas.size(); ++i) {
+        verify(deltas[i].size == 0.0 && deltas[i].seq == deltas[i - 1].seq + 1, TEST_NAME,
+               "Cleared levels should report size 0 in sequence");
+    }
+    auto snapshot = book.snapshot();
+    verify(snapshot.bids.empty() && snapshot.asks.empty(), TEST_NAME, "Snapshot should be empty");
+
+    verify(book.addOrder("A1", BookSide::ASK, 12.0, 1.0).accepted, TEST_NAME, "Ids should be reusable after cancel all");
+    verify(allocator.getStats().active_price_levels == 1, TEST_NAME, "Cleared levels should be released");
+}
+
+// Test that saved state rebuilds the same book, queue order and counters
+void testSaveLoadState() {
+    const char* TEST_NAME = "Save And Load State Test";
+    OrderBookAllocator allocator(smallConfig());
+    LimitOrderBook book("BTC-USD", allocator);
+    book.addOrder("B1", BookSide::BID, 100.0, 1.0);
+    book.addOrder("B2", BookSide::BID, 100.0, 2.0);
+    book.addOrder("B3", BookSide::BID, 99.0, 1.5);
+    book.addOrder("A1", BookSide::ASK, 101.0, 3.0);
+    book.addOrder("A2", BookSide::ASK, 102.0, 1.0);
+    book.addOrder("T1", BookSide::BID, 101.0, 1.0);  // Partially fills A1
+
+    SnapshotWriter out;
+    book.saveState(out);
+    std::string path = "/tmp/mercBookStateTest.bin";
+    writeSnapshotFile(path, out.data());
+
+    OrderBookAllocator restoredAllocator(smallConfig());
+    LimitOrderBook restored("BTC-USD", restoredAllocator);
+    std::size_t deltas = 0;
+    restored.setDeltaListener([&](const LevelDelta&) { ++deltas; });
+    std::string payload = readSnapshotFile(path);
+    SnapshotReader in(payload);
+    restored.loadState(in);
+
+    auto before = book.snapshot();
+    auto after = restored.snapshot();
+    bool same = before.seq == after.seq && before.bids.size() == after.bids.size() &&
+                before.asks.size() == after.asks.size();
+    for (std::size_t i = 0; same && i < before.bids.size(); ++i) {
+        same = before.bids[i].price == after.bids[i].price && before.bids[i].size == after.bids[i].size &&
+               before.bids[i].order_count == after.bids[i].order_count;
+    }
+    for (std::size_t i = 0; same && i < before.asks.size(); ++i) {
+        same = before.asks[i].price == after.asks[i].price && before.asks[i].size == after.asks[i].size;
+    }
+    verify(same && in.atEnd(), TEST_NAME, "Restored book should match the original");
+    verify(deltas == 0, TEST_NAME, "Loading should not emit deltas");
+
+    // Time priority survives: B1 is still ahead of B2
+    std::vector<BookFill> fills;
+    restored.setFillListener([&](const BookFill& fill) { fills.push_back(fill); });
+    restored.addOrder("S1", BookSide::ASK, 100.0, 1.5);
+    verify(fills.size() == 2 && fills[0].maker_order_id == "B1" && fills[1].maker_order_id == "B2", TEST_NAME,
+           "Queue order should be preserved");
+    verify(fills[0].trade_id == 2, TEST_NAME, "Trade ids should continue where the original stopped");
+
+    bool threw = false;
+    try {
+        SnapshotReader again(payload);
+        restored.loadState(again);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Loading into a non-empty book should be refused");
+
+    // A flipped byte fails the checksum
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(40);
+        char byte = 0;
+        file.get(byte);
+        file.seekp(40);
+        file.put(static_cast<char>(byte ^ 0x5A));
+    }
+    threw = false;
+    try {
+        readSnapshotFile(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    std::remove(path.c_str());
+    verify(threw, TEST_NAME, "A corrupt snapshot file should be rejected");
+}
+
+// Test that the top of book is reported once per operation that moves it
+void testTopListener() {
+    const char* TEST_NAME = "Top Listener Test";
+    OrderBookAllocator allocator(smallConfig());
+    LimitOrderBook book("ETH-USD", allocator);
+    std::vector<BookTop> tops;
+    book.setTopListener([&](const BookTop& top) { tops.push_back(top); });
+
+    book.addOrder("B1", BookSide::BID, 99.0, 1.0);
+    book.addOrder("A1", BookSide::ASK, 101.0, 2.0);
+    book.addOrder("B2", BookSide::BID, 98.0, 1.0);  // Behind the best bid
+    verify(tops.size() == 2 && tops[1].bid == 99.0 && tops[1].bid_size == 1.0 && tops[1].ask == 101.0 &&
+           tops[1].ask_size == 2.0, TEST_NAME, "Only changes to the best levels should be reported");
+    verify(tops[1].seq == 2, TEST_NAME, "Tops should carry the book sequence");
+
+    book.addOrders({
+        {"T1", BookSide::BID, 101.0, 2.0, false},   // Takes the whole ask level
+        {"A2", BookSide::ASK, 102.0, 1.0, false}
+    });
+    verify(tops.size() == 3 && tops[2].ask == 102.0 && tops[2].ask_size == 1.0, TEST_NAME,
+           "A batch should be reported once, as it ends");
+
+    book.cancelOrder("B1");
+    verify(tops.size() == 4 && tops[3].bid == 98.0, TEST_NAME, "The next level should become the top");
+    book.cancelAll();
+    verify(tops.size() == 5 && tops[4].bid == 0.0 && tops[4].ask == 0.0 && tops[4].ask_size == 0.0, TEST_NAME,
+           "An empty book should report zero on both sides");
+}
+
+bool sameLevels(const std::vector<BookLevel>& a, const std::vector<BookLevel>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].price != b[i].price || a[i].size != b[i].size || a[i].order_count != b[i].order_count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Test that a book on persistent pools resumes warm and can be read from outside
+void testPersistentBook() {
+    const char* TEST_NAME = "Persistent Book Test";
+    std::string path = "/tmp/mercPersistentBookTest.bin";
+    std::remove(path.c_str());
+    auto config = smallConfig();
+    config.backing_file = path;
+
+    BookSnapshot before;
+    {
+        OrderBookAllocator allocator(config);
+        LimitOrderBook book("BTC-USD", allocator);
+        book.addOrder("B1", BookSide::BID, 100.0, 1.0);
+        book.addOrder("B2", BookSide::BID, 100.0, 2.0);
+        book.addOrder("B3", BookSide::BID, 99.0, 1.5);
+        book.addOrder("A1", BookSide::ASK, 101.0, 3.0);
+        book.addOrder("A2", BookSide::ASK, 102.0, 1.0);
+        book.addOrder("T1", BookSide::BID, 101.0, 1.0);  // Partially fills A1
+        book.cancelOrder("A2");
+        verify(!book.addOrder(std::string(64, 'X'), BookSide::BID, 98.0, 1.0).accepted, TEST_NAME,
+               "Ids the pools cannot keep should be refused");
+        before = book.snapshot();
+
+        BookRegionReader reader(path);
+        auto seen = reader.snapshot("BTC-USD", 10);
+        verify(seen && seen->seq == before.seq && sameLevels(seen->bids, before.bids) &&
+               sameLevels(seen->asks, before.asks), TEST_NAME, "Reader should see the live book");
+        verify(reader.symbols() == std::vector<std::string>{"BTC-USD"} && !reader.snapshot("ETH-USD", 10),
+               TEST_NAME, "Reader should only list books in the region");
+    }
+
+    OrderBookAllocator allocator(config);
+    LimitOrderBook book("BTC-USD", allocator);
+    auto after = book.snapshot();
+    verify(after.seq == before.seq && sameLevels(after.bids, before.bids) && sameLevels(after.asks, before.asks),
+           TEST_NAME, "Book should resume with the same levels and sequence");
+    verify(book.getStats().resting_orders == 4, TEST_NAME, "Resting order count should resume");
+
+    std::vector<BookFill> fills;
+    book.setFillListener([&](const BookFill& fill) { fills.push_back(fill); });
+    book.addOrder("S1", BookSide::ASK, 100.0, 1.5);
+    verify(fills.size() == 2 && fills[0].maker_order_id == "B1" && fills[1].maker_order_id == "B2", TEST_NAME,
+           "Queue order should survive the restart");
+    verify(fills[0].trade_id == 2, TEST_NAME, "Trade ids should continue where the last process stopped");
+
+    // A reader polling while the book changes only ever sees consistent books
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    std::atomic<std::size_t> reads{0};
+    std::thread monitor([&]() {
+        BookRegionReader reader(path);
+        while (!done.load()) {
+            auto seen = reader.snapshot("BTC-USD", 100);
+            if (!seen) {
+                continue;
+            }
+            ++reads;
+            for (std::size_t i = 1; i < seen->bids.size(); ++i) {
+                consistent = consistent && seen->bids[i].price < seen->bids[i - 1].price;
+            }
+            for (const auto& level : seen->bids) {
+                consistent = consistent && level.order_count > 0 && level.size > 0.0;
+            }
+            consistent = consistent && (seen->bids.empty() || seen->asks.empty() ||
+                                        seen->bids[0].price < seen->asks[0].price);
+        }
+    });
+    std::mt19937 rng(7);
+    for (int i = 0; i < 20000; ++i) {
+        std::string id = "R" + std::to_string(i);
+        book.addOrder(id, BookSide::BID, 50.0 + static_cast<double>(rng() % 40), 1.0);
+        if (i >= 50) {
+            book.cancelOrder("R" + std::to_string(i - 50));
+        }
+    }
+    done = true;
+    monitor.join();
+    std::remove(path.c_str());
+    verify(consistent && reads > 0, TEST_NAME, "Reader snapshots should always be consistent");
+}
+
+int main() {
+    std::cout << "\nStarting Limit Order Book Tests...\n" << std::endl;
+
+    try {
+        testRestingDeltas();
+        testMatching();
+        testSnapshotReplay();
+        testDepthAndBuckets();
+        testSharedAllocator();
+        testBatchOperations();
+        testSaveLoadState();
+        testPersistentBook();
+        testTopListener();
+
+        std::cout << "\nAll limit order book tests completed successfully!\n" << std::endl;
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "\nTest failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -5,6 +5,7 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <stdexcept>
 
 using namespace mercuryTrade::core::memory;
 
@@ -16,103 +17,200 @@ void verify(bool condition, const char* testName, const char* message) {
     std::cout << testName << " : Passed " << std::endl;
 }
 
+marketDataAllocator::bufferConfig smallRings(std::size_t capacity, std::size_t symbols) {
+    auto config = marketDataAllocator::getDefaultConfig();
+    config.buffer_capacity = capacity;
+    config.max_symbols = symbols;
+    return config;
+}
+
+MarketTrade makeTrade(std::uint64_t sequence) {
+    return MarketTrade{sequence, static_cast<std::int64_t>(sequence), 100.0 + static_cast<double>(sequence), 1.0, 1};
+}
+
 void testBasicAllocation() {
     const char* TEST_NAME = "Basic Market Data Allocation Test";
     marketDataAllocator allocator;
 
-    void* quoteBuffer = allocator.allocateQuoteBuffer();
-    void* tradeBuffer = allocator.allocateTradeBuffer();
-    void* snapshotBuffer = allocator.allocateSnapshotBuffer();
-
-    verify(quoteBuffer != nullptr, TEST_NAME, "Quote Buffer Allocation Failed");
-    verify(tradeBuffer != nullptr, TEST_NAME, "Trade Buffer Allocation Failed");
-    verify(snapshotBuffer != nullptr, TEST_NAME, "Snapshot Buffer Allocation Failed");
+    std::size_t btc = allocator.symbolIndex("BTC-USD");
+    std::size_t eth = allocator.symbolIndex("ETH-USD");
+    verify(btc != eth && allocator.symbolIndex("BTC-USD") == btc, TEST_NAME, "Symbols should keep their index");
+    verify(allocator.findSymbol("SOL-USD") == marketDataAllocator::NOT_FOUND, TEST_NAME,
+           "Unclaimed symbol should not be found");
 
     auto stats = allocator.getStats();
-    verify(stats.quotes_allocated == 1, TEST_NAME, "Quote allocation count mismatch");
-    verify(stats.trades_allocated == 1, TEST_NAME, "Trade allocation count mismatch");
-    verify(stats.snapshots_allocated == 1, TEST_NAME, "Snapshot allocation count mismatch");
+    verify(stats.symbols == 2 && stats.total_memory_used > 0, TEST_NAME, "Rings should be claimed per symbol");
+    std::size_t memory = stats.total_memory_used;
+
+    auto quotes = allocator.subscribe(btc, marketDataAllocator::Channel::QUOTE);
+    allocator.publish(btc, marketDataAllocator::Channel::QUOTE, MarketQuote{1, 10, 99.5, 2.0, 100.5, 3.0});
+    allocator.publish(eth, marketDataAllocator::Channel::QUOTE, MarketQuote{2, 11, 9.5, 2.0, 10.5, 3.0});
+    allocator.publish(btc, marketDataAllocator::Channel::TRADE, makeTrade(3));
+
+    MarketQuote quote{};
+    verify(allocator.read(quotes, quote) && quote.sequence == 1 && quote.ask == 100.5, TEST_NAME,
+           "Cursor should read the symbol's quote");
+    verify(!allocator.read(quotes, quote), TEST_NAME, "Other symbols and channels should not show up");
+
+    // Publishing reuses the rings; nothing more is allocated
+    for (std::uint64_t i = 0; i < 5000; ++i) {
+        allocator.publish(btc, marketDataAllocator::Channel::TRADE, makeTrade(i));
+    }
+    stats = allocator.getStats();
+    verify(stats.total_memory_used == memory, TEST_NAME, "Steady-state publishing should not allocate");
+    verify(stats.quotes_written == 2 && stats.trades_written == 5001, TEST_NAME, "Writes should be counted");
 
-    auto config = marketDataAllocator::getDefaultConfig();
-    allocator.deallocateBuffer(quoteBuffer, config.quote_size * config.buffer_capacity);
-    allocator.deallocateBuffer(tradeBuffer, config.trade_size * config.buffer_capacity);
-    allocator.deallocateBuffer(snapshotBuffer, config.snapshot_size * config.buffer_capacity);
+    bool threw = false;
+    try {
+        struct Oversized { char bytes[128]; } big{};
+        allocator.publish(btc, marketDataAllocator::Channel::TRADE, big);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Records larger than the slot should be rejected");
+}
 
-    stats = allocator.getStats();
-    verify(stats.quotes_allocated == 0, TEST_NAME, "Quote Deallocation Failed");
-    verify(stats.trades_allocated == 0, TEST_NAME, "Trade Deallocation Failed");
-    verify(stats.snapshots_allocated == 0, TEST_NAME, "Snapshot Deallocation Failed");
+void testOverwriteOldest() {
+    const char* TEST_NAME = "Overwrite Oldest Test";
+    marketDataAllocator allocator(smallRings(8, 2));
+    std::size_t sol = allocator.symbolIndex("SOL-USD");
+
+    auto late = allocator.subscribe(sol, marketDataAllocator::Channel::TRADE);
+    for (std::uint64_t i = 0; i < 20; ++i) {
+        allocator.publish(sol, marketDataAllocator::Channel::TRADE, makeTrade(i));
+    }
+    verify(allocator.written(sol, marketDataAllocator::Channel::TRADE) == 20, TEST_NAME, "Every write should land");
+
+    std::uint64_t missed = 0;
+    MarketTrade trade{};
+    verify(allocator.read(late, trade, &missed) && missed == 12 && trade.sequence == 12, TEST_NAME,
+           "A lapped cursor should skip to the oldest record still held");
+    std::size_t read = 1;
+    while (allocator.read(late, trade, &missed)) {
+        ++read;
+    }
+    verify(read == 8 && trade.sequence == 19 && late.position() == 20, TEST_NAME,
+           "Remaining records should be read in order");
+
+    auto oldest = allocator.subscribe(sol, marketDataAllocator::Channel::TRADE, true);
+    verify(allocator.read(oldest, trade) && trade.sequence == 12, TEST_NAME,
+           "from_oldest should start at the oldest record held");
+    auto newest = allocator.subscribe(sol, marketDataAllocator::Channel::TRADE);
+    verify(!allocator.read(newest, trade), TEST_NAME, "A new cursor should only see later records");
+}
+
+void testCapacity() {
+    const char* TEST_NAME = "Ring Capacity Test";
+    marketDataAllocator allocator(smallRings(4, 1));
+    std::size_t btc = allocator.symbolIndex("BTC-USD");
+
+    for (std::uint64_t i = 0; i < 10; ++i) {
+        allocator.publish(btc, marketDataAllocator::Channel::TRADE, makeTrade(i));
+    }
+    verify(allocator.hasCapacity() && allocator.occupancy(btc, marketDataAllocator::Channel::TRADE) == 0,
+           TEST_NAME, "Without cursors nothing unread is held");
+
+    {
+        auto cursor = allocator.subscribe(btc, marketDataAllocator::Channel::TRADE);
+        for (std::uint64_t i = 0; i < 3; ++i) {
+            allocator.publish(btc, marketDataAllocator::Channel::TRADE, makeTrade(i));
+        }
+        verify(allocator.occupancy(btc, marketDataAllocator::Channel::TRADE) == 3 && allocator.hasCapacity(),
+               TEST_NAME, "Occupancy should count records the cursor has not read");
+        allocator.publish(btc, marketDataAllocator::Channel::TRADE, makeTrade(3));
+        verify(!allocator.hasCapacity(), TEST_NAME, "A full ring should report no capacity");
+
+        MarketTrade trade{};
+        allocator.read(cursor, trade);
+        verify(allocator.occupancy(btc, marketDataAllocator::Channel::TRADE) == 3 && allocator.hasCapacity(),
+               TEST_NAME, "Reading should free a slot");
+    }
+    verify(allocator.occupancy(btc, marketDataAllocator::Channel::TRADE) == 0, TEST_NAME,
+           "Closed cursors should no longer hold records");
+
+    std::vector<marketDataAllocator::Cursor> cursors;
+    for (std::size_t i = 0; i < marketDataAllocator::MAX_READERS; ++i) {
+        cursors.push_back(allocator.subscribe(btc, marketDataAllocator::Channel::QUOTE));
+    }
+    bool threw = false;
+    try {
+        allocator.subscribe(btc, marketDataAllocator::Channel::QUOTE);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Cursors beyond MAX_READERS should be refused");
+
+    threw = false;
+    try {
+        allocator.symbolIndex("ETH-USD");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Symbols beyond max_symbols should be refused");
 }
 
 void testConcurrentAllocation() {
     const char* TEST_NAME = "Concurrent Market Data Allocation Test";
 
-    marketDataAllocator allocator;
+    marketDataAllocator allocator(smallRings(64, 4));
+    std::size_t btc = allocator.symbolIndex("BTC-USD");
+    const std::uint64_t TRADES = 200000;
     std::atomic<bool> test_failed{false};
-    std::mutex buffers_mutex;
-    std::vector<std::pair<void*, std::size_t>> all_buffers;
-
-    auto thread_func = [&](int thread_id) {
-        try {
-            std::vector<std::pair<void*, std::size_t>> thread_buffers;
-            auto config = marketDataAllocator::getDefaultConfig();
-
-            for (int i = 0; i < 10; ++i) {
-                void* buffer = nullptr;
-                std::size_t size = 0;
-
-                switch (thread_id % 3) {
-                    case 0:
-                        buffer = allocator.allocateQuoteBuffer();
-                        size = config.quote_size * config.buffer_capacity;
-                        break;
-                    case 1:
-                        buffer = allocator.allocateTradeBuffer();
-                        size = config.trade_size * config.buffer_capacity;
-                        break;
-                    case 2:
-                        buffer = allocator.allocateSnapshotBuffer();
-                        size = config.snapshot_size * config.buffer_capacity;
-                        break;
-                }
-
-                if (!buffer) {
+    std::atomic<bool> done{false};
+    std::atomic<int> subscribed{0};
+
+    auto reader_func = [&]() {
+        auto cursor = allocator.subscribe(btc, marketDataAllocator::Channel::TRADE);
+        ++subscribed;
+        std::uint64_t missed = 0;
+        std::uint64_t seen = 0;
+        std::int64_t last = -1;
+        MarketTrade trade{};
+        for (;;) {
+            bool finished = done.load();
+            while (allocator.read(cursor, trade, &missed)) {
+                // Each record must be whole and later than the one before
+                if (trade.price != 100.0 + static_cast<double>(trade.sequence) ||
+                    static_cast<std::int64_t>(trade.sequence) <= last) {
                     test_failed = true;
-                } else {
-                    thread_buffers.emplace_back(buffer, size);
                 }
+                last = static_cast<std::int64_t>(trade.sequence);
+                ++seen;
             }
-
-            {
-                std::lock_guard<std::mutex> lock(buffers_mutex);
-                all_buffers.insert(all_buffers.end(), thread_buffers.begin(), thread_buffers.end());
+            if (finished) {
+                break;
             }
-
-        } catch (...) {
+            std::this_thread::yield();
+        }
+        if (seen + missed != TRADES) {
             test_failed = true;
         }
     };
 
-    std::vector<std::thread> threads;
-    for (int i = 0; i < 4; ++i) {
-        threads.emplace_back(thread_func, i);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back(reader_func);
     }
-
-    for (auto& thread : threads) {
-        thread.join();
+    // Every reader has to be registered before the first write
+    while (subscribed.load() < 3) {
+        std::this_thread::yield();
     }
-
-    for (const auto& [buffer, size] : all_buffers) {
-        allocator.deallocateBuffer(buffer, size);
+    for (std::uint64_t i = 0; i < TRADES; ++i) {
+        allocator.publish(btc, marketDataAllocator::Channel::TRADE, makeTrade(i));
+        if (i % 1024 == 0) {
+            std::this_thread::yield();
+        }
     }
+    done = true;
 
-    verify(!test_failed, TEST_NAME, "Concurrent allocation test failed");
+    for (auto& thread : readers) {
+        thread.join();
+    }
 
-    auto stats = allocator.getStats();
-    verify(stats.total_memory_used == 0, TEST_NAME, "Memory leak detected");
-    verify(stats.quotes_allocated == 0, TEST_NAME, "Quote allocations not properly cleaned up");
-    verify(stats.trades_allocated == 0, TEST_NAME, "Trade allocations not properly cleaned up");
-    verify(stats.snapshots_allocated == 0, TEST_NAME, "Snapshot allocations not properly cleaned up");
+    verify(!test_failed, TEST_NAME, "Readers should see whole records in order and account for every one");
+    verify(allocator.getStats().trades_written == TRADES, TEST_NAME, "Every trade should be written");
+    verify(allocator.occupancy(btc, marketDataAllocator::Channel::TRADE) == 0, TEST_NAME,
+           "Finished readers should release their cursors");
 }
 
 void testInvalidConfiguration() {
@@ -137,6 +235,8 @@ int main() {
 
     try {
         testBasicAllocation();
+        testOverwriteOldest();
+        testCapacity();
         testConcurrentAllocation();
         testInvalidConfiguration();
 
@@ -0,0 +1,203 @@
+#include "../../../include/mercuryTrade/core/memory/mercMarketDataBus.hpp"
+#include "../../../include/mercuryTrade/core/memory/mercMarketDataBusReader.hpp"
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace mercuryTrade::core::memory;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+
+std::string busName(const char* test) {
+    return std::string("/mercBusTest-") + test + "-" + std::to_string(::getpid());
+}
+
+BusTrade makeTrade(std::uint64_t id) {
+    return BusTrade{id, 100.0 + static_cast<double>(id % 10), 1.0, static_cast<std::int64_t>(id), 1};
+}
+
+} // namespace
+
+// Test that quotes and trades published by symbol reach a reader
+void testPublishAndRead() {
+    const char* TEST_NAME = "Publish And Read Test";
+    MarketDataBus bus(MarketDataBus::Config::getDefaultConfig(busName("basic")));
+    MarketDataBusReader reader(bus.name());
+
+    verify(reader.live() && reader.symbols().empty(), TEST_NAME, "New bus should be live and empty");
+    verify(!reader.subscribe("BTC-USD"), TEST_NAME, "Unpublished symbols cannot be subscribed to");
+
+    bus.publishQuote("BTC-USD", BusQuote{1, 99.5, 2.0, 100.5, 3.0, 10});
+    auto btc = reader.subscribe("BTC-USD");
+    verify(btc.has_value(), TEST_NAME, "Published symbol should be found");
+
+    BusQuote quote{};
+    verify(btc->quote(quote) && quote.seq == 1 && quote.bid == 99.5 && quote.ask_size == 3.0, TEST_NAME,
+           "Reader should see the latest quote");
+    bus.publishQuote("BTC-USD", BusQuote{2, 99.75, 1.0, 100.5, 3.0, 11});
+    verify(btc->quote(quote) && quote.seq == 2 && quote.bid == 99.75, TEST_NAME, "Quote updates should be seen");
+
+    BusTrade trade{};
+    verify(!btc->nextTrade(trade), TEST_NAME, "No trades before one is published");
+    bus.publishTrade("BTC-USD", makeTrade(1));
+    bus.publishTrade("BTC-USD", makeTrade(2));
+    bus.publishTrade("ETH-USD", makeTrade(7));
+    verify(btc->nextTrade(trade) && trade.trade_id == 1 && btc->nextTrade(trade) && trade.trade_id == 2 &&
+           !btc->nextTrade(trade), TEST_NAME, "Trades should be read once each, in order");
+
+    auto eth = reader.subscribe("ETH-USD", true);
+    verify(eth && eth->nextTrade(trade) && trade.trade_id == 7, TEST_NAME,
+           "A subscription from the oldest trade should see earlier trades");
+    verify(!eth->quote(quote), TEST_NAME, "A symbol without quotes should report none");
+    verify(reader.symbols() == std::vector<std::string>({"BTC-USD", "ETH-USD"}), TEST_NAME,
+           "Symbols should be listed in publication order");
+
+    bool threw = false;
+    try {
+        bus.publishQuote(std::string(40, 'X'), quote);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "A symbol longer than a channel name should be refused");
+    verify(bus.channel("BTC-USD") == bus.channel("BTC-USD") && reader.symbols().size() == 2, TEST_NAME,
+           "A symbol's channel should be claimed once and then reused");
+}
+
+// Test that a reader lapped by the producer skips ahead and counts the loss
+void testSlowReader() {
+    const char* TEST_NAME = "Slow Reader Test";
+    auto config = MarketDataBus::Config::getDefaultConfig(busName("slow"));
+    config.trade_capacity = 10;  // Rounded up to 16
+    MarketDataBus bus(config);
+    bus.publishTrade("SOL-USD", makeTrade(1));
+
+    MarketDataBusReader reader(bus.name());
+    auto subscription = reader.subscribe("SOL-USD");
+    for (std::uint64_t id = 2; id <= 41; ++id) {
+        bus.publishTrade("SOL-USD", makeTrade(id));
+    }
+
+    BusTrade trade{};
+    verify(subscription->nextTrade(trade) && trade.trade_id == 26, TEST_NAME,
+           "Reading should resume at the oldest trade still held");
+    verify(subscription->missedTrades() == 24, TEST_NAME, "Overwritten trades should be counted");
+    std::uint64_t last = trade.trade_id;
+    while (subscription->nextTrade(trade)) {
+        last = trade.trade_id;
+    }
+    verify(last == 41, TEST_NAME, "Every trade still held should be read");
+}
+
+// Test that a reader polling a busy producer never sees torn data
+void testConcurrentReader() {
+    const char* TEST_NAME = "Concurrent Reader Test";
+    auto config = MarketDataBus::Config::getDefaultConfig(busName("concurrent"));
+    config.trade_capacity = 64;
+    MarketDataBus bus(config);
+    bus.publishQuote("BTC-USD", BusQuote{0, 100.0, 0.0, 101.0, 0.0, 0});
+
+    const std::uint64_t COUNT = 200000;
+    std::atomic<bool> started{false};
+    std::atomic<bool> consistent{true};
+    std::uint64_t readTrades = 0;
+    std::uint64_t missed = 0;
+    std::thread consumer([&]() {
+        MarketDataBusReader reader(bus.name());
+        auto subscription = reader.subscribe("BTC-USD", true);
+        started = true;
+        std::uint64_t expected = 1;
+        BusQuote quote{};
+        BusTrade trade{};
+        while (expected <= COUNT) {
+            // The producer keeps ask = bid + 1 and both sizes equal to the seq
+            if (subscription->quote(quote)) {
+                double seq = static_cast<double>(quote.seq);
+                consistent = consistent && quote.ask == quote.bid + 1.0 && quote.bid_size == seq &&
+                             quote.ask_size == seq;
+            }
+            while (subscription->nextTrade(trade)) {
+                consistent = consistent && trade.trade_id >= expected && trade.timestamp ==
+                             static_cast<std::int64_t>(trade.trade_id);
+                expected = trade.trade_id + 1;
+                ++readTrades;
+            }
+        }
+        missed = subscription->missedTrades();
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+
+    BusChannel* btc = bus.channel("BTC-USD");
+    for (std::uint64_t i = 1; i <= COUNT; ++i) {
+        double seq = static_cast<double>(i);
+        bus.publishQuote(btc, BusQuote{i, 100.0 + seq, seq, 101.0 + seq, seq, 0});
+        bus.publishTrade(btc, makeTrade(i));
+    }
+    consumer.join();
+
+    verify(consistent, TEST_NAME, "Quotes and trades should never be torn or out of order");
+    verify(readTrades + missed == COUNT, TEST_NAME, "Every trade should be either read or counted as missed");
+}
+
+// Test that readers see a closed producer and that names are validated
+void testLifecycle() {
+    const char* TEST_NAME = "Bus Lifecycle Test";
+    std::string name = busName("lifecycle");
+    std::unique_ptr<MarketDataBusReader> reader;
+    {
+        MarketDataBus bus(MarketDataBus::Config::getDefaultConfig(name));
+        reader = std::make_unique<MarketDataBusReader>(name);
+        bus.publishQuote("BTC-USD", BusQuote{1, 1.0, 1.0, 2.0, 1.0, 0});
+    }
+    verify(!reader->live(), TEST_NAME, "Readers should see that the producer closed the bus");
+    BusQuote quote{};
+    verify(reader->subscribe("BTC-USD")->quote(quote) && quote.seq == 1, TEST_NAME,
+           "The last values should stay readable after the producer closes");
+
+    bool threw = false;
+    try {
+        MarketDataBusReader missing(name);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Opening a closed bus by name should fail");
+
+    threw = false;
+    try {
+        MarketDataBus invalid(MarketDataBus::Config::getDefaultConfig("no-slash"));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Names must be a single '/'-prefixed component");
+}
+
+int main() {
+    std::cout << "\nStarting market data bus tests...\n" << std::endl;
+
+    try {
+        testPublishAndRead();
+        testSlowReader();
+        testConcurrentReader();
+        testLifecycle();
+
+        std::cout << "\nAll market data bus tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -5,6 +5,8 @@
 #include <thread>
 #include <random>
 #include <sstream>
+#include <cstdio>
+#include <stdexcept>
 
 using namespace mercuryTrade::core::memory;
 
@@ -363,6 +365,116 @@ void testCapacityLimits() {
     cleanupTest(allocator);
 }
 
+// Test that released slots are reused without clobbering live orders
+void testSlotReuse() {
+    const char* TEST_NAME = "Slot Reuse Test";
+
+    OrderBookAllocator allocator(OrderBookAllocator::Config{
+        3,      // max_orders
+        2,      // max_price_levels
+        128,    // order_data_size
+        true    // track_modifications
+    });
+
+    OrderNode* first = allocator.allocateOrder();
+    OrderNode* second = allocator.allocateOrder();
+    OrderNode* third = allocator.allocateOrder();
+    allocator.registerOrder("FIRST", first);
+    allocator.registerOrder("SECOND", second);
+    allocator.registerOrder("THIRD", third);
+
+    // Free out of allocation order, then allocate again
+    allocator.deallocateOrder(first);
+    OrderNode* reused = allocator.allocateOrder();
+    verify(reused == first, TEST_NAME, "Released slot should be reused");
+    verify(reused != second && reused != third, TEST_NAME, "Live order slot handed out twice");
+    verify(allocator.findOrder("THIRD") == third && third->order_id == "THIRD", TEST_NAME, "Live order clobbered");
+    verify(allocator.allocateOrder() == nullptr, TEST_NAME, "Pool should be exhausted");
+
+    PriceLevel* level = allocator.allocatePriceLevel();
+    allocator.deallocatePriceLevel(level);
+    verify(allocator.allocatePriceLevel() == level, TEST_NAME, "Released price level should be reused");
+
+    auto stats = allocator.getStats();
+    verify(stats.peak_orders == 3, TEST_NAME, "Peak order count mismatch");
+
+    allocator.deallocateOrder(reused);
+    allocator.deallocateOrder(second);
+    allocator.deallocateOrder(third);
+    cleanupTest(allocator);
+    verify(allocator.getStats().active_price_levels == 0, TEST_NAME, "Cleanup should release price levels");
+}
+
+// Test that file-backed pools come back with their orders after a reopen
+void testPersistentPools() {
+    const char* TEST_NAME = "Persistent Pools Test";
+    std::string path = "/tmp/mercOrderBookRegionTest.bin";
+    std::remove(path.c_str());
+
+    OrderBookAllocator::Config config{
+        4,      // max_orders
+        4,      // max_price_levels
+        32,     // order_data_size
+        true,   // track_modifications
+        path
+    };
+    OrderNode* kept = nullptr;
+    {
+        OrderBookAllocator allocator(config);
+        verify(allocator.isPersistent() && !allocator.wasCleanlyClosed(), TEST_NAME, "New region should be open");
+        OrderNode* first = allocator.allocateOrder();
+        kept = allocator.allocateOrder();
+        first->quantity = 1.0;
+        kept->quantity = 2.0;
+        allocator.registerOrder("FIRST", first);
+        allocator.registerOrder("KEPT", kept);
+        PriceLevel* level = allocator.allocatePriceLevel();
+        level->first_order = kept;
+        kept->parent_level = level;
+        allocator.unregisterOrder("FIRST");
+        allocator.deallocateOrder(first);
+
+        bool threw = false;
+        try {
+            allocator.registerOrder(std::string(40, 'X'), allocator.allocateOrder());
+        } catch (const std::length_error&) {
+            threw = true;
+        }
+        verify(threw, TEST_NAME, "Ids longer than the slot can keep should be refused");
+    }
+
+    {
+        OrderBookAllocator allocator(config);
+        verify(allocator.wasCleanlyClosed(), TEST_NAME, "Orderly close should be recorded");
+        OrderNode* order = allocator.findOrder("KEPT");
+        verify(order && order->quantity == 2.0 && order->order_id == "KEPT", TEST_NAME,
+               "Live orders should be found again by id");
+        verify(allocator.findOrder("FIRST") == nullptr, TEST_NAME, "Released orders should stay released");
+        verify(order->parent_level && order->parent_level->first_order == order, TEST_NAME,
+               "Links should survive a remap");
+
+        auto stats = allocator.getStats();
+        verify(stats.active_orders == 2 && stats.active_price_levels == 1, TEST_NAME,
+               "Counters should be rebuilt from the pools");
+        std::vector<OrderNode*> fresh;
+        while (OrderNode* next = allocator.allocateOrder()) {
+            verify(next != order, TEST_NAME, "A live slot must not be handed out again");
+            fresh.push_back(next);
+        }
+        verify(fresh.size() == 2, TEST_NAME, "Free slots should be reused before the pool is exhausted");
+    }
+
+    config.max_orders = 8;
+    bool threw = false;
+    try {
+        OrderBookAllocator mismatched(config);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    std::remove(path.c_str());
+    verify(threw, TEST_NAME, "A region made with another configuration should be refused");
+}
+
 int main() {
     std::cout << "\nStarting Order Book Allocator Tests...\n" << std::endl;
     
@@ -371,6 +483,8 @@ int main() {
         testPriceLevelManagement();
         testConcurrentOperations();
         testCapacityLimits();
+        testSlotReuse();
+        testPersistentPools();
         
         std::cout << "\nAll order book allocator tests completed successfully!\n" << std::endl;
         return 0;
@@ -0,0 +1,169 @@
+#include "../../../include/mercuryTrade/core/memory/mercRiskEngine.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace mercuryTrade::core::memory;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+
+RiskEngine::Config limitedConfig() {
+    auto config = RiskEngine::Config::getDefaultConfig();
+    config.max_accounts = 4;
+    config.max_symbols = 4;
+    config.default_limits.max_position = 10.0;
+    config.default_limits.max_notional = 5000.0;
+    config.default_limits.max_open_orders = 3;
+    config.default_limits.price_band = 0.05;
+    return config;
+}
+
+} // namespace
+
+// Test that each limit refuses exactly the orders past it
+void testChecks() {
+    const char* TEST_NAME = "Risk Checks Test";
+    RiskEngine risk(limitedConfig());
+    std::uint32_t account = risk.accountIndex("alice");
+    std::uint32_t symbol = risk.symbolIndex("BTC-USD");
+
+    verify(risk.check(account, symbol, true, 1000.0, 5.0) == RiskCheck::PASSED, TEST_NAME,
+           "Without a last trade there is no band to leave");
+    verify(risk.check(account, symbol, true, 100.0, 11.0) == RiskCheck::POSITION_LIMIT, TEST_NAME,
+           "Buying past max_position should be refused");
+    verify(risk.check(account, symbol, false, 100.0, 11.0) == RiskCheck::POSITION_LIMIT, TEST_NAME,
+           "Selling past max_position should be refused");
+    verify(risk.check(account, symbol, true, 600.0, 9.0) == RiskCheck::NOTIONAL_LIMIT, TEST_NAME,
+           "Orders worth more than max_notional should be refused");
+
+    risk.trade(symbol, 100.0);
+    verify(risk.check(account, symbol, true, 105.0, 1.0) == RiskCheck::PASSED &&
+           risk.check(account, symbol, false, 95.0, 1.0) == RiskCheck::PASSED, TEST_NAME,
+           "Prices at the edge of the band are allowed");
+    verify(risk.check(account, symbol, true, 105.5, 1.0) == RiskCheck::PRICE_BAND &&
+           risk.check(account, symbol, false, 94.5, 1.0) == RiskCheck::PRICE_BAND, TEST_NAME,
+           "Prices beyond the band should be refused");
+    verify(risk.check(account, symbol, true, 0.0, 60.0) == RiskCheck::NOTIONAL_LIMIT, TEST_NAME,
+           "Market orders should be valued at the last trade");
+
+    for (int i = 0; i < 3; ++i) {
+        risk.reserve(account, symbol, true, 100.0, 1.0);
+    }
+    verify(risk.check(account, symbol, true, 100.0, 1.0) == RiskCheck::OPEN_ORDER_LIMIT, TEST_NAME,
+           "A fourth resting order should be refused");
+    verify(risk.check(account, symbol, true, 0.0, 1.0) == RiskCheck::PASSED, TEST_NAME,
+           "Market orders never rest, so the open order limit does not apply");
+    verify(risk.check(account, symbol, true, 0.0, 8.0) == RiskCheck::POSITION_LIMIT, TEST_NAME,
+           "Resting buys count towards the position limit");
+    verify(risk.findAccount("bob") == RiskEngine::NOT_FOUND, TEST_NAME, "Looking an account up should not number it");
+    verify(risk.check(risk.accountIndex("bob"), symbol, true, 100.0, 1.0) == RiskCheck::PASSED, TEST_NAME,
+           "Accounts are limited separately");
+    verify(risk.findAccount("bob") == risk.accountIndex("bob") && risk.findAccount("alice") == account, TEST_NAME,
+           "Numbered accounts should be found");
+
+    bool threw = false;
+    try {
+        risk.setLimits("alice", RiskEngine::Limits{-1.0, 0.0, 0, 0.0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Negative limits should be refused");
+    risk.setLimits("alice", RiskEngine::Limits::unlimited());
+    verify(risk.check(account, symbol, true, 1000.0, 1000.0) == RiskCheck::PASSED, TEST_NAME,
+           "Per-account limits should replace the defaults");
+}
+
+// Test that reserve, fill and release keep the open exposure exact
+void testExposure() {
+    const char* TEST_NAME = "Risk Exposure Test";
+    RiskEngine risk(limitedConfig());
+    std::uint32_t account = risk.accountIndex("alice");
+    std::uint32_t symbol = risk.symbolIndex("ETH-USD");
+
+    risk.reserve(account, symbol, true, 100.0, 4.0);
+    risk.reserve(account, symbol, false, 110.0, 2.0);
+    verify(risk.usage(account).open_orders == 2 && risk.usage(account).open_notional == 620.0, TEST_NAME,
+           "Reserving should add the order and its notional");
+
+    risk.fill(account, symbol, true, 100.0, 1.5, false);
+    auto exposure = risk.exposure(account, symbol);
+    verify(exposure.position == 1.5 && exposure.open_buys == 2.5 && risk.usage(account).open_orders == 2 &&
+           risk.usage(account).open_notional == 470.0, TEST_NAME, "A partial fill should move quantity to the position");
+
+    risk.fill(account, symbol, true, 100.0, 2.5, true);
+    verify(risk.exposure(account, symbol).position == 4.0 && risk.exposure(account, symbol).open_buys == 0.0 &&
+           risk.usage(account).open_orders == 1, TEST_NAME, "The last fill should close the order");
+
+    risk.fill(account, symbol, false, 0.0, 1.0, true);
+    verify(risk.exposure(account, symbol).position == 3.0 && risk.usage(account).open_orders == 1, TEST_NAME,
+           "Market fills change only the position");
+
+    risk.release(account, symbol, false, 110.0, 2.0);
+    verify(risk.usage(account).open_orders == 0 && risk.usage(account).open_notional == 0.0 &&
+           risk.exposure(account, symbol).open_sells == 0.0, TEST_NAME, "Releasing should return the reservation");
+
+    for (const char* name : {"b", "c", "d"}) {
+        risk.accountIndex(name);
+    }
+    bool threw = false;
+    try {
+        risk.accountIndex("e");
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Accounts past max_accounts should be refused");
+}
+
+// Test that positions and last prices survive a save and load
+void testState() {
+    const char* TEST_NAME = "Risk State Test";
+    RiskEngine risk(limitedConfig());
+    risk.symbolIndex("SOL-USD");
+    std::uint32_t symbol = risk.symbolIndex("BTC-USD");
+    std::uint32_t account = risk.accountIndex("alice");
+    risk.reserve(account, symbol, false, 100.0, 5.0);
+    risk.fill(account, symbol, false, 100.0, 2.0, false);
+    risk.trade(symbol, 100.0);
+
+    SnapshotWriter out;
+    risk.saveState(out);
+    std::string saved = out.release();
+    SnapshotReader in(saved);
+
+    RiskEngine restored(limitedConfig());
+    std::uint32_t first = restored.accountIndex("bob");  // Numbered differently on purpose
+    restored.loadState(in);
+    std::uint32_t moved = restored.symbolIndex("BTC-USD");
+    verify(in.atEnd() && restored.exposure(restored.accountIndex("alice"), moved).position == -2.0 &&
+           restored.exposure(first, moved).position == 0.0, TEST_NAME, "Positions should be restored by name");
+    verify(restored.usage(restored.accountIndex("alice")).open_orders == 0, TEST_NAME,
+           "Open orders are reserved again by the caller, not restored");
+    verify(restored.check(restored.accountIndex("alice"), moved, true, 110.0, 1.0) == RiskCheck::PRICE_BAND,
+           TEST_NAME, "The last trade price should be restored");
+    verify(std::string(RiskEngine::checkName(RiskCheck::PRICE_BAND)) == "price band", TEST_NAME,
+           "Checks should have readable names");
+}
+
+int main() {
+    std::cout << "\nStarting risk engine tests...\n" << std::endl;
+
+    try {
+        testChecks();
+        testExposure();
+        testState();
+
+        std::cout << "\nAll risk engine tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,301 @@
+#include "../../../include/mercuryTrade/core/memory/mercTickStore.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mercuryTrade::core::memory;
+namespace fs = std::filesystem;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+
+constexpr std::int64_t SECOND = 1000000000LL;
+constexpr std::int64_t MINUTE = 60 * SECOND;
+constexpr std::int64_t BASE = 1700000000LL / 3600 * 3600 * SECOND;
+
+// A fresh directory, removed again when the test is done
+struct TempDirectory {
+    std::string path;
+
+    TempDirectory() {
+        char pattern[] = "/tmp/mercTickStoreTestXXXXXX";
+        if (!mkdtemp(pattern)) {
+            throw std::runtime_error("Cannot create temporary directory");
+        }
+        path = pattern;
+    }
+    ~TempDirectory() {
+        std::error_code error;
+        fs::remove_all(path, error);
+    }
+};
+
+// One-minute partitions of small blocks, so a few hundred rows span many
+TickStore::Config smallPartitions(const std::string& directory) {
+    auto config = TickStore::Config::getDefaultConfig(directory);
+    config.partition_nanos = MINUTE;
+    config.segment_size = 4096;
+    config.block_rows = 16;
+    return config;
+}
+
+TickTrade tradeAt(std::int64_t i) {
+    return TickTrade{BASE + i * SECOND, 100.0 + 0.01 * static_cast<double>(i % 50), 0.5 + 0.25 * static_cast<double>(i % 3),
+                     static_cast<std::uint8_t>(i % 2)};
+}
+
+std::size_t segmentFiles(const std::string& directory) {
+    std::size_t files = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+        files += entry.is_regular_file() ? 1 : 0;
+    }
+    return files;
+}
+
+} // namespace
+
+// Test that rows come back exactly, in order, from blocks and the open block
+void testAppendAndScan() {
+    const char* TEST_NAME = "Append And Scan Test";
+    TempDirectory dir;
+    TickStore store(smallPartitions(dir.path));
+
+    for (std::int64_t i = 0; i < 100; ++i) {
+        verify(store.appendTrade("BTC-USD", tradeAt(i)), TEST_NAME, "In-order trades should be stored");
+    }
+    std::vector<TickTrade> seen;
+    std::size_t count = store.scanTrades("BTC-USD", 0, INT64_MAX, [&](const TickTrade& trade) { seen.push_back(trade); });
+    verify(count == 100 && seen.size() == 100, TEST_NAME, "Every trade should be scanned, open block included");
+    bool exact = true;
+    for (std::int64_t i = 0; i < 100; ++i) {
+        TickTrade expected = tradeAt(i);
+        const TickTrade& got = seen[static_cast<std::size_t>(i)];
+        exact = exact && got.timestamp == expected.timestamp && got.price == expected.price &&
+                got.quantity == expected.quantity && got.buyer_aggressor == expected.buyer_aggressor;
+    }
+    verify(exact, TEST_NAME, "Prices and quantities should round-trip exactly");
+
+    std::size_t window = store.scanTrades("BTC-USD", BASE + 10 * SECOND, BASE + 20 * SECOND, [&](const TickTrade& trade) {
+        seen.push_back(trade);
+    });
+    verify(window == 10 && seen[100].timestamp == BASE + 10 * SECOND && seen.back().timestamp == BASE + 19 * SECOND,
+           TEST_NAME, "from is inclusive and to exclusive");
+    verify(store.scanTrades("ETH-USD", 0, INT64_MAX, [](const TickTrade&) {}) == 0, TEST_NAME,
+           "Unknown symbols have no history");
+
+    verify(!store.appendTrade("BTC-USD", tradeAt(50)), TEST_NAME, "Trades going back in time are refused");
+    verify(store.getStats().out_of_order == 1 && store.getStats().trades == 100, TEST_NAME,
+           "Refused trades are counted, not stored");
+
+    store.appendQuote("BTC-USD", TickQuote{BASE, 99.5, 2.0, 100.5, 3.0});
+    store.appendQuote("BTC-USD", TickQuote{BASE + SECOND, 99.75, 1.0, 100.25, 4.0});
+    std::vector<TickQuote> quotes;
+    store.scanQuotes("BTC-USD", BASE, BASE + MINUTE, [&](const TickQuote& quote) { quotes.push_back(quote); });
+    verify(quotes.size() == 2 && quotes[1].bid == 99.75 && quotes[1].ask_size == 4.0, TEST_NAME,
+           "Quotes are kept apart from trades");
+
+    bool threw = false;
+    try {
+        store.symbolIndex("../escape");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Symbols that are not plain directory names should be refused");
+}
+
+// Test that partitions become segment files that are read back on reopen
+void testPartitionsAndReopen() {
+    const char* TEST_NAME = "Partitions And Reopen Test";
+    TempDirectory dir;
+    {
+        TickStore store(smallPartitions(dir.path));
+        for (std::int64_t i = 0; i < 600; ++i) {
+            store.appendTrade("ETH-USD", tradeAt(i));
+        }
+        verify(store.getStats().segments >= 10, TEST_NAME, "Ten minutes of trades should span ten partitions");
+    }
+    std::size_t files = segmentFiles(dir.path);
+
+    TickStore store(smallPartitions(dir.path));
+    verify(store.symbols().size() == 1 && store.getStats().trades == 600, TEST_NAME,
+           "Reopening should load every stored trade");
+    std::int64_t expected = 120;
+    bool ordered = true;
+    std::size_t count = store.scanTrades("ETH-USD", BASE + 2 * MINUTE, BASE + 3 * MINUTE, [&](const TickTrade& trade) {
+        ordered = ordered && trade.timestamp == tradeAt(expected).timestamp && trade.price == tradeAt(expected).price;
+        ++expected;
+    });
+    verify(count == 60 && ordered, TEST_NAME, "A partition should scan back exactly after reopening");
+
+    verify(!store.appendTrade("ETH-USD", tradeAt(10)), TEST_NAME, "Reopened history still refuses older trades");
+    verify(store.appendTrade("ETH-USD", tradeAt(600)), TEST_NAME, "Appends continue after the reopened history");
+    store.flush();
+    verify(segmentFiles(dir.path) == files + 1, TEST_NAME, "Appends after reopening go to a new segment file");
+    verify(store.scanTrades("ETH-USD", 0, INT64_MAX, [](const TickTrade&) {}) == 601, TEST_NAME,
+           "Old and new segments scan together");
+}
+
+// Test that a torn block at the end of a segment is dropped on reopen
+void testTornBlock() {
+    const char* TEST_NAME = "Torn Block Test";
+    TempDirectory dir;
+    {
+        TickStore store(smallPartitions(dir.path));
+        for (std::int64_t i = 0; i < 40; ++i) {
+            store.appendTrade("SOL-USD", tradeAt(i));
+        }
+    }
+    // Corrupt the tail of the last block
+    fs::path segment;
+    for (const auto& entry : fs::recursive_directory_iterator(dir.path)) {
+        if (entry.is_regular_file()) {
+            segment = entry.path();
+        }
+    }
+    auto size = fs::file_size(segment);
+    {
+        std::fstream file(segment, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(size - 9));
+        file.put('\x55');
+    }
+
+    TickStore store(smallPartitions(dir.path));
+    std::vector<TickTrade> trades = store.trades("SOL-USD", 0, INT64_MAX, 1000);
+    verify(trades.size() == 32 && trades.back().timestamp == tradeAt(31).timestamp, TEST_NAME,
+           "Only the intact blocks should be loaded");
+    verify(store.appendTrade("SOL-USD", tradeAt(32)), TEST_NAME, "The lost trades can be appended again");
+}
+
+// Test the newest-first limit and downsampling to bars and quotes
+void testQueries() {
+    const char* TEST_NAME = "Queries Test";
+    TempDirectory dir;
+    TickStore store(smallPartitions(dir.path));
+    for (std::int64_t i = 0; i < 300; ++i) {
+        store.appendTrade("BTC-USD", tradeAt(i));
+        store.appendQuote("BTC-USD", TickQuote{BASE + i * SECOND, 99.0, 1.0, 101.0 + static_cast<double>(i), 1.0});
+    }
+
+    std::vector<TickTrade> last = store.trades("BTC-USD", 0, INT64_MAX, 5);
+    verify(last.size() == 5 && last.front().timestamp == tradeAt(295).timestamp &&
+           last.back().timestamp == tradeAt(299).timestamp, TEST_NAME, "limit should keep the newest trades, oldest first");
+    TradeColumns columns = store.tradeColumns("BTC-USD", 0, INT64_MAX, 5);
+    verify(columns.prices.size() == 5 && columns.timestamps.front() == last.front().timestamp &&
+           columns.prices.back() == last.back().price && columns.quantities.back() == last.back().quantity,
+           TEST_NAME, "Trade columns should hold the same trades as trades()");
+    std::vector<TickTrade> early = store.trades("BTC-USD", BASE, BASE + 3 * SECOND, 100);
+    verify(early.size() == 3 && early[2].timestamp == BASE + 2 * SECOND, TEST_NAME, "A limit above the range takes it all");
+
+    std::vector<Bar> bars = store.downsampleTrades("BTC-USD", 0, INT64_MAX, MINUTE, 100);
+    verify(bars.size() == 5 && bars[0].start == BASE && bars[0].trades == 60, TEST_NAME,
+           "Five minutes of trades should make five one-minute bars");
+    double volume = 0.0;
+    double high = 0.0;
+    double low = 1e9;
+    for (std::int64_t i = 60; i < 120; ++i) {
+        volume += tradeAt(i).quantity;
+        high = std::max(high, tradeAt(i).price);
+        low = std::min(low, tradeAt(i).price);
+    }
+    verify(bars[1].open == tradeAt(60).price && bars[1].close == tradeAt(119).price && bars[1].high == high &&
+           bars[1].low == low && bars[1].volume == volume, TEST_NAME, "Bars should carry the OHLCV of their trades");
+    verify(bars[3].closed && !bars[4].closed, TEST_NAME, "Only the bucket of the newest trade is still open");
+
+    std::vector<Bar> newest = store.downsampleTrades("BTC-USD", BASE + MINUTE, INT64_MAX, MINUTE, 2);
+    verify(newest.size() == 2 && newest[0].start == BASE + 3 * MINUTE, TEST_NAME, "Downsampling keeps the newest buckets");
+
+    std::vector<TickQuote> quotes = store.downsampleQuotes("BTC-USD", 0, INT64_MAX, MINUTE, 100);
+    verify(quotes.size() == 5 && quotes[0].ask == 160.0 && quotes[4].ask == 400.0, TEST_NAME,
+           "Each bucket should hold its last quote");
+
+    bool threw = false;
+    try {
+        store.downsampleTrades("BTC-USD", 0, INT64_MAX, 0, 10);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "A zero bucket should be rejected");
+}
+
+// Test that steady trades compress well below their raw size
+void testCompression() {
+    const char* TEST_NAME = "Compression Test";
+    TempDirectory dir;
+    auto config = TickStore::Config::getDefaultConfig(dir.path);
+    TickStore store(config);
+    for (std::int64_t i = 0; i < 100000; ++i) {
+        store.appendTrade("BTC-USD", TickTrade{BASE + i * 3000000LL, 50000.0 + 0.5 * static_cast<double>(i % 40),
+                                               0.001 * static_cast<double>(1 + i % 7), static_cast<std::uint8_t>(i % 2)});
+    }
+    store.flush();
+    auto stats = store.getStats();
+    verify(stats.bytes_used < 100000 * 10, TEST_NAME, "Trades should take under 10 bytes each on disk");
+    verify(store.trades("BTC-USD", 0, INT64_MAX, 1).back().price == 50000.0 + 0.5 * 39, TEST_NAME,
+           "The newest trade should read back");
+}
+
+// Test that trade and quote rings are recorded into the store
+void testRingRecorder() {
+    const char* TEST_NAME = "Ring Recorder Test";
+    TempDirectory dir;
+    TickStore store(smallPartitions(dir.path));
+    marketDataAllocator rings;
+    TickRingRecorder recorder(rings, store);
+
+    std::size_t btc = rings.symbolIndex("BTC-USD");
+    for (std::uint64_t i = 0; i < 10; ++i) {
+        std::int64_t timestamp = BASE + static_cast<std::int64_t>(i) * SECOND;
+        rings.publish(btc, marketDataAllocator::Channel::TRADE, MarketTrade{i, timestamp, 100.0, 1.0, 1});
+        rings.publish(btc, marketDataAllocator::Channel::QUOTE, MarketQuote{i, timestamp, 99.0, 1.0, 101.0, 2.0});
+    }
+    verify(recorder.drain() == 20 && recorder.drain() == 0, TEST_NAME, "Ring records should be stored once");
+    verify(store.getStats().trades == 10 && store.getStats().quotes == 10 && recorder.missed() == 0, TEST_NAME,
+           "Both trades and quotes should reach the store");
+
+    // Names that cannot be a directory and symbols past capacity are skipped
+    std::size_t path = rings.symbolIndex("BTC/USD");
+    std::size_t eth = rings.symbolIndex("ETH-USD");
+    std::size_t sol = rings.symbolIndex("SOL-USD");
+    for (std::size_t symbol : {path, eth, sol}) {
+        rings.publish(symbol, marketDataAllocator::Channel::TRADE, MarketTrade{20, BASE, 10.0, 1.0, 0});
+    }
+    TempDirectory smallDir;
+    auto config = smallPartitions(smallDir.path);
+    config.max_symbols = 2;
+    TickStore small(config);
+    TickRingRecorder limited(rings, small);
+    verify(limited.drain() == 21 && limited.untrackedSymbols() == 2, TEST_NAME,
+           "Untrackable symbols should be counted, not thrown");
+    verify(small.findSymbol("ETH-USD") != TickStore::NOT_FOUND && small.findSymbol("SOL-USD") == TickStore::NOT_FOUND,
+           TEST_NAME, "Symbols that fit should still be stored");
+}
+
+int main() {
+    std::cout << "\nStarting tick store tests...\n" << std::endl;
+
+    try {
+        testAppendAndScan();
+        testPartitionsAndReopen();
+        testTornBlock();
+        testQueries();
+        testCompression();
+        testRingRecorder();
+
+        std::cout << "\nAll tick store tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -260,6 +260,32 @@ void testMemoryOptimization(){
     cleanupTest(manager);
 }
 
+void testOrderRelease(){
+    const char* TEST_NAME = "Order Release Test";
+
+    tradingManager manager;
+    verify(manager.start(), TEST_NAME, "Failed to start trading system");
+
+    verify(manager.submitOrder(createTestOrder("BUY_1", "AAPL", 150.0, 10.0, true)), TEST_NAME, "Buy submission failed");
+    verify(manager.submitOrder(createTestOrder("SELL_1", "AAPL", 150.0, 4.0, false)), TEST_NAME, "Sell submission failed");
+    verify(manager.submitOrder(createTestOrder("MKT_1", "AAPL", 0.0, 1.0, true)), TEST_NAME, "Market order should be accepted");
+    verify(manager.getStats().active_orders == 3, TEST_NAME, "Three orders should be active");
+
+    // A partial fill keeps the buy, a full fill releases the sell
+    trade t{"T1", "BUY_1", "SELL_1", "AAPL", 150.0, 4.0, std::chrono::system_clock::now()};
+    verify(manager.recordTrade(t), TEST_NAME, "Trade should apply to known orders");
+    auto stats = manager.getStats();
+    verify(stats.active_orders == 2 && stats.total_trades == 1, TEST_NAME, "Filled order should be released");
+
+    verify(manager.cancelOrder("BUY_1"), TEST_NAME, "Cancel should release a live order");
+    verify(!manager.cancelOrder("BUY_1"), TEST_NAME, "Second cancel should find nothing");
+    verify(manager.cancelOrder("MKT_1"), TEST_NAME, "Market order should be cancellable");
+    verify(manager.getStats().active_orders == 0, TEST_NAME, "No orders should remain active");
+
+    verify(manager.stop(), TEST_NAME, "Failed to stop trading system");
+    cleanupTest(manager);
+}
+
 int main() {
     std::cout << "\nStarting Trading Manager Tests...\n" << std::endl;
     
@@ -305,6 +331,14 @@ int main() {
             throw;
         }
 
+        try {
+            testOrderRelease();
+            std::cout << "Order release test completed\n" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Order release test failed: " << e.what() << std::endl;
+            throw;
+        }
+
         std::cout << "\nAll trading manager tests completed successfully!\n" << std::endl;
         return 0;
     } catch (const std::exception& e) {
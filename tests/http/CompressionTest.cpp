@@ -0,0 +1,159 @@
+#include "../../include/mercuryTrade/http/Compression.hpp"
+#include "../../include/mercuryTrade/http/ResponseWriter.hpp"
+#include "../../include/mercuryTrade/http/Server.hpp"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <cassert>
+#include <iostream>
+#include <string>
+
+using namespace mercuryTrade::http;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+std::string inflateAll(const std::string& compressed, ContentEncoding encoding) {
+    z_stream stream{};
+    inflateInit2(&stream, encoding == ContentEncoding::Gzip ? 15 + 16 : 15);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+
+    std::string output;
+    char buffer[16384];
+    int status;
+    do {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        status = inflate(&stream, Z_NO_FLUSH);
+        output.append(buffer, sizeof(buffer) - stream.avail_out);
+    } while (status == Z_OK);
+    inflateEnd(&stream);
+
+    if (status != Z_STREAM_END) {
+        throw std::runtime_error("Inflate failed");
+    }
+    return output;
+}
+
+std::string makeOrderJson(std::size_t orders) {
+    std::string json = "[";
+    for (std::size_t i = 0; i < orders; ++i) {
+        if (i) json += ",";
+        json += "{\"id\":\"ORD-" + std::to_string(i) + "\",\"symbol\":\"BTC-USD\",\"side\":\"BUY\","
+                "\"price\":" + std::to_string(50000 + i % 97) + ",\"quantity\":1.5,\"status\":\"NEW\"}";
+    }
+    return json + "]";
+}
+
+// Test Accept-Encoding negotiation including q-values and wildcards
+void testNegotiation() {
+    const char* TEST_NAME = "Encoding Negotiation Test";
+
+    verify(negotiateEncoding("") == ContentEncoding::Identity, TEST_NAME, "Missing header should mean identity");
+    verify(negotiateEncoding("gzip, deflate, br") == ContentEncoding::Gzip, TEST_NAME, "gzip should win ties");
+    verify(negotiateEncoding("deflate") == ContentEncoding::Deflate, TEST_NAME, "deflate only");
+    verify(negotiateEncoding("gzip;q=0.5, deflate;q=0.8") == ContentEncoding::Deflate, TEST_NAME, "Higher q should win");
+    verify(negotiateEncoding("GZIP ; Q=1.0") == ContentEncoding::Gzip, TEST_NAME, "Tokens are case-insensitive");
+    verify(negotiateEncoding("gzip;q=0, deflate;q=0") == ContentEncoding::Identity, TEST_NAME, "q=0 forbids a coding");
+    verify(negotiateEncoding("*;q=0.3") == ContentEncoding::Gzip, TEST_NAME, "Wildcard should allow gzip");
+    verify(negotiateEncoding("gzip;q=0, *") == ContentEncoding::Deflate, TEST_NAME, "Explicit q=0 overrides wildcard");
+    verify(negotiateEncoding("br, identity") == ContentEncoding::Identity, TEST_NAME, "Unsupported codings only");
+}
+
+// Test gzip and deflate round trips across several input slices
+void testRoundTrip() {
+    const char* TEST_NAME = "Compression Round Trip Test";
+
+    std::string input = makeOrderJson(5000);
+    verify(input.size() > 3 * 64 * 1024, TEST_NAME, "Input should span several slices");
+
+    std::string output;
+    for (ContentEncoding encoding : {ContentEncoding::Gzip, ContentEncoding::Deflate}) {
+        compress(input, encoding, output);
+        verify(output.size() < input.size() / 4, TEST_NAME, "Repetitive JSON should compress well");
+        verify(inflateAll(output, encoding) == input, TEST_NAME, "Round trip mismatch");
+    }
+
+    compress("", ContentEncoding::Gzip, output);
+    verify(inflateAll(output, ContentEncoding::Gzip).empty(), TEST_NAME, "Empty input round trip");
+
+    // Reused output buffer must be fully replaced by a smaller result
+    compress(input, ContentEncoding::Gzip, output);
+    compress("{\"small\":true}", ContentEncoding::Gzip, output);
+    verify(inflateAll(output, ContentEncoding::Gzip) == "{\"small\":true}", TEST_NAME, "Stale bytes after reuse");
+}
+
+// Test that shared payloads compress once per coding
+void testPayloadCaching() {
+    const char* TEST_NAME = "Payload Caching Test";
+
+    auto payload = Payload::make(makeOrderJson(200));
+    verify(payload->encoded(ContentEncoding::Identity) == payload->identity(), TEST_NAME, "Identity should be the original body");
+
+    auto gzip = payload->encoded(ContentEncoding::Gzip);
+    verify(payload->encoded(ContentEncoding::Gzip) == gzip, TEST_NAME, "gzip representation should be memoised");
+    verify(payload->encoded(ContentEncoding::Deflate) != gzip, TEST_NAME, "Codings should be cached separately");
+    verify(inflateAll(*gzip, ContentEncoding::Gzip) == *payload->identity(), TEST_NAME, "Cached body mismatch");
+
+    Response res = Response::shared(payload);
+    verify(res.bodyView().data() == payload->identity()->data(), TEST_NAME, "Shared response should not copy the body");
+}
+
+// Test that encoded responses carry Content-Encoding and Vary
+void testEncodedHead() {
+    const char* TEST_NAME = "Encoded Response Head Test";
+
+    int fds[2];
+    verify(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, TEST_NAME, "socketpair failed");
+
+    auto payload = Payload::make(makeOrderJson(50));
+    Response res = Response::shared(payload);
+    res.shared_body = payload->encoded(ContentEncoding::Gzip);
+    res.content_encoding = ContentEncoding::Gzip;
+    res.vary_encoding = true;
+    {
+        std::string keep_alive = ResponseWriter::keepAliveBlock(5000);
+        ResponseWriter writer(fds[0], keep_alive);
+        verify(writer.write(res, false), TEST_NAME, "Write failed");
+    }
+    close(fds[0]);
+
+    std::string data;
+    char buffer[8192];
+    ssize_t n;
+    while ((n = read(fds[1], buffer, sizeof(buffer))) > 0) {
+        data.append(buffer, n);
+    }
+    close(fds[1]);
+
+    std::size_t body_start = data.find("\r\n\r\n") + 4;
+    std::string head = data.substr(0, body_start);
+    verify(head.find("Content-Encoding: gzip\r\n") != std::string::npos, TEST_NAME, "Content-Encoding missing");
+    verify(head.find("Vary: Accept-Encoding\r\n") != std::string::npos, TEST_NAME, "Vary missing");
+    verify(head.find("Content-Length: " + std::to_string(res.shared_body->size()) + "\r\n") != std::string::npos,
+           TEST_NAME, "Content-Length should describe the encoded body");
+    verify(inflateAll(data.substr(body_start), ContentEncoding::Gzip) == *payload->identity(), TEST_NAME, "Body mismatch");
+}
+
+int main() {
+    std::cout << "\nStarting compression tests...\n" << std::endl;
+
+    try {
+        testNegotiation();
+        testRoundTrip();
+        testPayloadCaching();
+        testEncodedHead();
+
+        std::cout << "\nAll compression tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
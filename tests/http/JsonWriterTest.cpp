@@ -0,0 +1,140 @@
+#include "../../include/mercuryTrade/http/Server.hpp"
+#include "../../include/mercuryTrade/services/MarketDataService.hpp"
+#include "../../include/mercuryTrade/services/OrderService.hpp"
+#include "../../include/mercuryTrade/services/UserService.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace mercuryTrade;
+using namespace mercuryTrade::http;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+template <typename T>
+std::string write(const T& value) {
+    std::string out;
+    JsonWriter(out).value(value);
+    return out;
+}
+
+// Test separators across nested containers
+void testStructure() {
+    const char* TEST_NAME = "Structure Test";
+
+    std::string out;
+    JsonWriter writer(out);
+    writer.beginObject()
+          .field("a", 1)
+          .key("list").beginArray().value(1).value("two").null().beginObject().endObject().beginArray().endArray().endArray()
+          .key("nested").beginObject().field("x", true).field("y", false).endObject()
+          .field("z", -5)
+          .endObject();
+    verify(out == R"({"a":1,"list":[1,"two",null,{},[]],"nested":{"x":true,"y":false},"z":-5})", TEST_NAME,
+           "Unexpected output");
+
+    std::string appended = "prefix:";
+    JsonWriter(appended).beginArray().raw(R"({"k":1})").value(2u).endArray();
+    verify(appended == R"(prefix:[{"k":1},2])", TEST_NAME, "Writer should append and embed raw JSON");
+
+    bool threw = false;
+    try {
+        std::string unbalanced;
+        JsonWriter(unbalanced).endObject();
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    verify(threw, TEST_NAME, "Unbalanced close should throw");
+}
+
+// Test number formatting against nlohmann::json::dump()
+void testNumbers() {
+    const char* TEST_NAME = "Number Formatting Test";
+
+    const double values[] = {0.0, -0.0, 1.0, 50000.0, 0.1, 50000.25, 1e-7, 1e21, 123456789.123,
+                             std::numeric_limits<double>::max(), std::numeric_limits<double>::min()};
+    for (double value : values) {
+        std::string text = write(value);
+        verify(text == nlohmann::json(value).dump(), TEST_NAME, "Double formatting differs from nlohmann");
+        verify(nlohmann::json::parse(text).get<double>() == value, TEST_NAME, "Double should round-trip");
+    }
+
+    verify(write(std::numeric_limits<double>::quiet_NaN()) == "null", TEST_NAME, "NaN should be null");
+    verify(write(std::numeric_limits<double>::infinity()) == "null", TEST_NAME, "Infinity should be null");
+    verify(write(std::numeric_limits<std::int64_t>::min()) == "-9223372036854775808", TEST_NAME, "Int64 min");
+    verify(write(std::numeric_limits<std::uint64_t>::max()) == "18446744073709551615", TEST_NAME, "Uint64 max");
+}
+
+// Test string escaping against nlohmann::json::dump()
+void testStrings() {
+    const char* TEST_NAME = "String Escaping Test";
+
+    const std::string values[] = {"", "plain", "quote\"back\\slash", "line\nbreak\ttab\r",
+                                  std::string("nul\0ctl\x01\x1f", 9), "caf\xc3\xa9 \xe2\x82\xac", "/slash"};
+    for (const auto& value : values) {
+        verify(write(value) == nlohmann::json(value).dump(), TEST_NAME, "Escaping differs from nlohmann");
+    }
+
+    std::string out;
+    JsonWriter(out).beginObject().field("k\"ey", "v").endObject();
+    verify(out == R"({"k\"ey":"v"})", TEST_NAME, "Keys should be escaped");
+}
+
+// Test that the serializers match the existing toJson() output
+void testSerializers() {
+    const char* TEST_NAME = "Serializer Test";
+
+    Order order{"ORD-1", "BTC-USD", OrderSide::Sell, OrderType::Limit, 2.0, 50000.5,
+                OrderStatus::PartiallyFilled, 1700000000123456789L, 0.5, ""};
+    verify(nlohmann::json::parse(write(order)) == order.toJson(), TEST_NAME, "Order mismatch");
+
+    std::vector<Order> orders{order, order};
+    orders[1].id = "ORD-2";
+    orders[1].side = OrderSide::Buy;
+    auto parsed = nlohmann::json::parse(write(orders));
+    verify(parsed.size() == 2 && parsed[1] == orders[1].toJson(), TEST_NAME, "Order list mismatch");
+
+    MarketData data{"ETH-USD", 2999.5, 3000.5, 3000.0, 1234.25, 1700000000L};
+    verify(nlohmann::json::parse(write(data)) == data.toJson(), TEST_NAME, "Market data mismatch");
+
+    User user("u-1", "trader@example.com", "trader \"one\"");
+    verify(nlohmann::json::parse(write(user)) == user.toJson(), TEST_NAME, "User mismatch");
+
+    OrderBook book{"BTC-USD", {{50000.0, 1.5, 1.5}, {49999.0, 2.0, 3.5}}, {{50001.0, 0.25, 0.25}}, 1700000000L, 42, false};
+    verify(nlohmann::json::parse(write(book)) == book.toJson(), TEST_NAME, "Order book mismatch");
+    book.cumulative = true;
+    verify(nlohmann::json::parse(write(book)) == book.toJson(), TEST_NAME, "Cumulative order book mismatch");
+
+    core::memory::LevelDelta delta{7, core::memory::BookSide::ASK, 50001.0, 0.0, 0};
+    nlohmann::json expected = {{"seq", 7}, {"side", "ask"}, {"price", 50001.0}, {"quantity", 0.0}, {"orders", 0}};
+    verify(nlohmann::json::parse(write(delta)) == expected, TEST_NAME, "Level delta mismatch");
+
+    Response res = Response::serialize(order, 201);
+    verify(res.status == 201 && nlohmann::json::parse(res.body) == order.toJson(), TEST_NAME,
+           "Response::serialize mismatch");
+}
+
+int main() {
+    std::cout << "\nStarting JSON writer tests...\n" << std::endl;
+
+    try {
+        testStructure();
+        testNumbers();
+        testStrings();
+        testSerializers();
+
+        std::cout << "\nAll JSON writer tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,191 @@
+#include "../../include/mercuryTrade/http/RequestParser.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mercuryTrade::http;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+// Test a simple request with headers and a Content-Length body
+void testBasicRequest() {
+    const char* TEST_NAME = "Basic Request Parsing Test";
+
+    std::string raw = "POST /api/orders?symbol=BTC-USD HTTP/1.1\r\n"
+                      "Host: localhost\r\n"
+                      "content-type:  application/json \r\n"
+                      "Content-Length: 13\r\n"
+                      "\r\n"
+                      "{\"a\":\"b\\r\\n\"}";
+
+    RequestParser parser;
+    Request req;
+    auto result = parser.parse(raw.data(), raw.size(), req);
+
+    verify(result == RequestParser::Result::Complete, TEST_NAME, "Request not complete");
+    verify(req.method == "POST", TEST_NAME, "Method mismatch");
+    verify(req.path == "/api/orders", TEST_NAME, "Path mismatch");
+    verify(req.query == "symbol=BTC-USD", TEST_NAME, "Query mismatch");
+    verify(req.version == "HTTP/1.1", TEST_NAME, "Version mismatch");
+    verify(req.headers.size() == 3, TEST_NAME, "Header count mismatch");
+    verify(req.headers.get("Content-Type") == "application/json", TEST_NAME, "Case-insensitive header lookup failed");
+    verify(req.body == "{\"a\":\"b\\r\\n\"}", TEST_NAME, "Body mismatch");
+    verify(parser.consumed() == raw.size(), TEST_NAME, "Consumed byte count mismatch");
+}
+
+// Test that a request split across many reads is assembled correctly
+void testIncrementalParsing() {
+    const char* TEST_NAME = "Incremental Parsing Test";
+
+    std::string raw = "PUT /api/orders/42 HTTP/1.1\r\n"
+                      "Content-Length: 10\r\n"
+                      "\r\n"
+                      "0123456789";
+
+    RequestParser parser;
+    Request req;
+    std::string buffer;
+    RequestParser::Result result = RequestParser::Result::Incomplete;
+
+    for (std::size_t i = 0; i < raw.size(); ++i) {
+        buffer.push_back(raw[i]);
+        result = parser.parse(buffer.data(), buffer.size(), req);
+        if (i + 1 < raw.size()) {
+            verify(result == RequestParser::Result::Incomplete, TEST_NAME, "Partial request reported complete");
+        }
+    }
+
+    verify(result == RequestParser::Result::Complete, TEST_NAME, "Request not complete after final byte");
+    verify(req.path == "/api/orders/42", TEST_NAME, "Path mismatch");
+    verify(req.body == "0123456789", TEST_NAME, "Body mismatch");
+}
+
+// Test chunked transfer encoding across reads, including binary data
+void testChunkedBody() {
+    const char* TEST_NAME = "Chunked Body Test";
+
+    std::string body_part1("ab\0c", 4);
+    std::string raw = "POST /upload HTTP/1.1\r\n"
+                      "Transfer-Encoding: chunked\r\n"
+                      "\r\n"
+                      "4\r\n" + body_part1 + "\r\n"
+                      "6;ext=1\r\n\r\nxyz1\r\n"
+                      "0\r\n"
+                      "Trailer: value\r\n"
+                      "\r\n";
+
+    RequestParser parser;
+    Request req;
+    std::string buffer = raw.substr(0, 40);
+    auto result = parser.parse(buffer.data(), buffer.size(), req);
+    verify(result == RequestParser::Result::Incomplete, TEST_NAME, "Truncated chunked body reported complete");
+
+    buffer = raw;
+    result = parser.parse(buffer.data(), buffer.size(), req);
+    verify(result == RequestParser::Result::Complete, TEST_NAME, "Chunked request not complete");
+    verify(req.body == body_part1 + "\r\nxyz1", TEST_NAME, "De-chunked body mismatch");
+    verify(parser.consumed() == raw.size(), TEST_NAME, "Consumed byte count mismatch");
+}
+
+// Test that pipelined requests are returned one at a time, in order
+void testPipelinedRequests() {
+    const char* TEST_NAME = "Pipelined Requests Test";
+
+    std::string raw = "GET /a HTTP/1.1\r\n\r\n"
+                      "POST /b HTTP/1.1\r\nContent-Length: 2\r\n\r\nhi"
+                      "GET /c HTTP/1.0\r\nConnection: keep-alive\r\n\r\n";
+
+    RequestParser parser;
+    Request req;
+    std::vector<std::string> paths;
+    std::size_t offset = 0;
+
+    while (offset < raw.size()) {
+        auto result = parser.parse(raw.data() + offset, raw.size() - offset, req);
+        verify(result == RequestParser::Result::Complete, TEST_NAME, "Pipelined request not complete");
+        paths.emplace_back(req.path);
+        offset += parser.consumed();
+    }
+
+    verify(paths.size() == 3, TEST_NAME, "Pipelined request count mismatch");
+    verify(paths[0] == "/a" && paths[1] == "/b" && paths[2] == "/c", TEST_NAME, "Pipelined order mismatch");
+    verify(req.headers.get("connection") == "keep-alive", TEST_NAME, "Last request headers mismatch");
+}
+
+// Test malformed and oversized requests
+void testInvalidRequests() {
+    const char* TEST_NAME = "Invalid Request Test";
+
+    {
+        std::string raw = "GARBAGE\r\n\r\n";
+        RequestParser parser;
+        Request req;
+        verify(parser.parse(raw.data(), raw.size(), req) == RequestParser::Result::Error, TEST_NAME, "Malformed request line accepted");
+        verify(parser.errorStatus() == 400, TEST_NAME, "Wrong status for malformed request line");
+    }
+    {
+        std::string raw = "POST / HTTP/1.1\r\nContent-Length: 100\r\n\r\n";
+        RequestParser parser(1024, 10);
+        Request req;
+        verify(parser.parse(raw.data(), raw.size(), req) == RequestParser::Result::Error, TEST_NAME, "Oversized body accepted");
+        verify(parser.errorStatus() == 413, TEST_NAME, "Wrong status for oversized body");
+    }
+    {
+        std::string raw = "GET / HTTP/1.1\r\nX-Long: " + std::string(2048, 'x');
+        RequestParser parser(1024, 10);
+        Request req;
+        verify(parser.parse(raw.data(), raw.size(), req) == RequestParser::Result::Error, TEST_NAME, "Oversized header accepted");
+        verify(parser.errorStatus() == 431, TEST_NAME, "Wrong status for oversized header");
+    }
+    {
+        // A chunk size whose extension never ends
+        std::string raw = "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5;ext=" + std::string(2048, 'x');
+        RequestParser parser(1024, 10);
+        Request req;
+        verify(parser.parse(raw.data(), raw.size(), req) == RequestParser::Result::Error, TEST_NAME,
+               "Endless chunk size line accepted");
+        verify(parser.errorStatus() == 431, TEST_NAME, "Wrong status for oversized chunk size line");
+    }
+    {
+        // Trailer lines that are each short but never end
+        std::string raw = "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n1\r\na\r\n0\r\n";
+        for (int i = 0; i < 100; ++i) {
+            raw += "X-Trailer: " + std::to_string(i) + "\r\n";
+        }
+        RequestParser parser(1024, 10);
+        Request req;
+        verify(parser.parse(raw.data(), raw.size(), req) == RequestParser::Result::Error, TEST_NAME,
+               "Endless trailers accepted");
+        verify(parser.errorStatus() == 431, TEST_NAME, "Wrong status for oversized trailers");
+
+        std::string ok = "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n1\r\na\r\n0\r\nX-T: 1\r\n";
+        RequestParser fresh(1024, 10);
+        verify(fresh.parse(ok.data(), ok.size(), req) == RequestParser::Result::Incomplete, TEST_NAME,
+               "Short trailers should wait for more bytes");
+    }
+}
+
+int main() {
+    std::cout << "\nStarting request parser tests...\n" << std::endl;
+
+    try {
+        testBasicRequest();
+        testIncrementalParsing();
+        testChunkedBody();
+        testPipelinedRequests();
+        testInvalidRequests();
+
+        std::cout << "\nAll request parser tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,149 @@
+#include "../../include/mercuryTrade/http/ResponseWriter.hpp"
+#include "../../include/mercuryTrade/http/Server.hpp"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace mercuryTrade::http;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+std::string readAll(int fd) {
+    std::string data;
+    char buffer[8192];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        data.append(buffer, n);
+    }
+    return data;
+}
+
+// Test head serialisation with cached and custom header blocks
+void testHeadSerialisation() {
+    const char* TEST_NAME = "Response Head Serialisation Test";
+
+    int fds[2];
+    verify(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, TEST_NAME, "socketpair failed");
+
+    std::string keep_alive = ResponseWriter::keepAliveBlock(5000);
+    {
+        ResponseWriter writer(fds[0], keep_alive);
+        Response res = Response::json({{"status", "ok"}}, 201);
+        res.headers["X-Request-Id"] = "abc";
+        verify(writer.write(res, true), TEST_NAME, "First write failed");
+
+        Response text;
+        text.status = 418;
+        text.body = "teapot";
+        text.content_type = "text/plain";
+        verify(writer.write(text, false), TEST_NAME, "Second write failed");
+    }
+    close(fds[0]);
+
+    std::string data = readAll(fds[1]);
+    close(fds[1]);
+
+    std::string expected =
+        "HTTP/1.1 201 Created\r\n"
+        "X-Request-Id: abc\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "Content-Type: application/json\r\n"
+        "Connection: keep-alive\r\n"
+        "Keep-Alive: timeout=5\r\n"
+        "Content-Length: 15\r\n"
+        "\r\n"
+        "{\"status\":\"ok\"}"
+        "HTTP/1.1 418 Unknown\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "Content-Type: text/plain\r\n"
+        "Connection: close\r\n"
+        "Content-Length: 6\r\n"
+        "\r\n"
+        "teapot";
+    verify(data == expected, TEST_NAME, "Serialised bytes mismatch");
+}
+
+// Test that a body larger than the socket buffer survives short writes and EAGAIN
+void testLargeBodyOnNonBlockingSocket() {
+    const char* TEST_NAME = "Large Body Short Write Test";
+
+    int fds[2];
+    verify(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, TEST_NAME, "socketpair failed");
+    int sndbuf = 4096;
+    setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    Response res;
+    res.body.resize(4 * 1024 * 1024);
+    for (std::size_t i = 0; i < res.body.size(); ++i) {
+        res.body[i] = static_cast<char>('a' + i % 26);
+    }
+
+    std::string received;
+    std::thread reader([&]() {
+        // Drain slowly so the writer keeps hitting a full socket buffer
+        char buffer[16384];
+        ssize_t n;
+        while ((n = read(fds[1], buffer, sizeof(buffer))) > 0) {
+            received.append(buffer, n);
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    bool ok;
+    {
+        std::string keep_alive = ResponseWriter::keepAliveBlock(5000);
+        ResponseWriter writer(fds[0], keep_alive);
+        ok = writer.write(res, false);
+    }
+    close(fds[0]);
+    reader.join();
+    close(fds[1]);
+
+    verify(ok, TEST_NAME, "Write reported failure");
+    std::size_t body_start = received.find("\r\n\r\n");
+    verify(body_start != std::string::npos, TEST_NAME, "Header terminator missing");
+    verify(received.substr(body_start + 4) == res.body, TEST_NAME, "Body corrupted across partial writes");
+}
+
+// Test that writing to a closed peer fails cleanly instead of raising SIGPIPE
+void testClosedPeer() {
+    const char* TEST_NAME = "Closed Peer Test";
+
+    int fds[2];
+    verify(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, TEST_NAME, "socketpair failed");
+    close(fds[1]);
+
+    std::string keep_alive = ResponseWriter::keepAliveBlock(5000);
+    ResponseWriter writer(fds[0], keep_alive);
+    Response res = Response::json({{"status", "ok"}});
+    verify(!writer.write(res, true), TEST_NAME, "Write to closed peer should fail");
+    close(fds[0]);
+}
+
+int main() {
+    std::cout << "\nStarting response writer tests...\n" << std::endl;
+
+    try {
+        testHeadSerialisation();
+        testLargeBodyOnNonBlockingSocket();
+        testClosedPeer();
+
+        std::cout << "\nAll response writer tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,134 @@
+#include "../../include/mercuryTrade/http/Server.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+using namespace mercuryTrade::http;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+RequestHandler tagged(const std::string& tag) {
+    return [tag](const Request&) {
+        Response res;
+        res.body = tag;
+        return res;
+    };
+}
+
+std::string call(const Router::Match& match) {
+    Request req;
+    return match.handler ? (*match.handler)(req).body : "";
+}
+
+void buildRoutes(Router& router) {
+    router.add(Method::Get, "/api/orders", tagged("list"));
+    router.add(Method::Post, "/api/orders", tagged("create"));
+    router.add(Method::Get, "/api/orders/{id}", tagged("get"));
+    router.add(Method::Delete, "/api/orders/{id}", tagged("cancel"));
+    router.add(Method::Post, "/api/orders/batch", tagged("batch"));
+    router.add(Method::Get, "/api/order-book/{symbol}", tagged("book"));
+    router.add(Method::Get, "/api/market-data/{symbol}/bars/{interval:int}", tagged("bars-int"));
+    router.add(Method::Get, "/api/market-data/{symbol}/bars/{interval}", tagged("bars-str"));
+}
+
+// Test static and parameterised route matching
+void testRouteMatching() {
+    const char* TEST_NAME = "Route Matching Test";
+    Router router;
+    buildRoutes(router);
+    PathParams params;
+
+    verify(call(router.match(Method::Get, "/api/orders", params)) == "list", TEST_NAME, "Static GET mismatch");
+    verify(call(router.match(Method::Post, "/api/orders", params)) == "create", TEST_NAME, "Static POST mismatch");
+
+    auto match = router.match(Method::Get, "/api/orders/ORD-42", params);
+    verify(call(match) == "get", TEST_NAME, "Parameterised route mismatch");
+    verify(params.find("id") && params.find("id")->value == "ORD-42", TEST_NAME, "Captured parameter mismatch");
+
+    verify(call(router.match(Method::Post, "/api/orders/batch", params)) == "batch", TEST_NAME, "Static segment should win over parameter");
+    verify(params.empty(), TEST_NAME, "Static match left parameters behind");
+
+    verify(call(router.match(Method::Get, "/api/order-book/BTC-USD", params)) == "book", TEST_NAME, "Radix split route mismatch");
+    verify(params.find("symbol")->value == "BTC-USD", TEST_NAME, "Symbol parameter mismatch");
+}
+
+// Test typed parameters and backtracking between them
+void testTypedParameters() {
+    const char* TEST_NAME = "Typed Parameter Test";
+    Router router;
+    buildRoutes(router);
+    PathParams params;
+
+    verify(call(router.match(Method::Get, "/api/market-data/ETH-USD/bars/60", params)) == "bars-int", TEST_NAME, "Int parameter mismatch");
+    verify(params.size() == 2, TEST_NAME, "Parameter count mismatch");
+    verify(params.find("interval")->value == "60", TEST_NAME, "Int parameter value mismatch");
+
+    verify(call(router.match(Method::Get, "/api/market-data/ETH-USD/bars/1m", params)) == "bars-str", TEST_NAME, "String fallback mismatch");
+    verify(params.find("interval")->value == "1m", TEST_NAME, "String parameter value mismatch");
+}
+
+// Test 404 and 405 handling
+void testUnmatchedRoutes() {
+    const char* TEST_NAME = "Unmatched Route Test";
+    Router router;
+    buildRoutes(router);
+    PathParams params;
+
+    auto missing = router.match(Method::Get, "/api/unknown", params);
+    verify(!missing.handler && !missing.allow, TEST_NAME, "Unknown path should not match");
+
+    auto partial = router.match(Method::Get, "/api/order", params);
+    verify(!partial.handler && !partial.allow, TEST_NAME, "Path prefix should not match");
+
+    auto wrong_method = router.match(Method::Put, "/api/orders/ORD-1", params);
+    verify(!wrong_method.handler && wrong_method.allow, TEST_NAME, "Wrong method should report allowed methods");
+    verify(std::string(wrong_method.allow) == "GET, DELETE", TEST_NAME, "Allow header mismatch");
+}
+
+// Test that malformed patterns are rejected at registration
+void testInvalidPatterns() {
+    const char* TEST_NAME = "Invalid Pattern Test";
+    Router router;
+    buildRoutes(router);
+
+    const char* bad_patterns[] = {
+        "api/orders",
+        "/api/orders/x{id}",
+        "/api/orders/{id",
+        "/api/orders/{name}",
+        "/api/orders/{id:float}"
+    };
+
+    for (const char* pattern : bad_patterns) {
+        bool thrown = false;
+        try {
+            router.add(Method::Get, pattern, tagged("bad"));
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        verify(thrown, TEST_NAME, pattern);
+    }
+}
+
+int main() {
+    std::cout << "\nStarting router tests...\n" << std::endl;
+
+    try {
+        testRouteMatching();
+        testTypedParameters();
+        testUnmatchedRoutes();
+        testInvalidPatterns();
+
+        std::cout << "\nAll router tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,276 @@
+#include "../../include/mercuryTrade/http/Server.hpp"
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace mercuryTrade::http;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+namespace {
+
+// One connection served by handle_connection() over a socketpair
+class Connection {
+public:
+    explicit Connection(Server& server) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+            throw std::runtime_error("socketpair failed");
+        }
+        fd_ = fds[0];
+        struct timeval timeout{5, 0};
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        thread_ = std::thread([&server, fd = fds[1]]() { server.handle_connection(fd); });
+    }
+
+    ~Connection() {
+        close(fd_);
+        thread_.join();
+    }
+
+    void send(const std::string& data) {
+        ::send(fd_, data.data(), data.size(), 0);
+    }
+
+    // The next whole response, or empty once the server has closed
+    std::string readResponse() {
+        while (true) {
+            std::size_t head = buffer_.find("\r\n\r\n");
+            if (head != std::string::npos) {
+                std::size_t length = 0;
+                std::size_t field = buffer_.find("Content-Length: ");
+                if (field != std::string::npos && field < head) {
+                    length = std::strtoul(buffer_.c_str() + field + 16, nullptr, 10);
+                }
+                if (buffer_.size() >= head + 4 + length) {
+                    std::string response = buffer_.substr(0, head + 4 + length);
+                    buffer_.erase(0, response.size());
+                    return response;
+                }
+            }
+            if (!fill()) {
+                return "";
+            }
+        }
+    }
+
+    // Bytes left to read before the server's close
+    std::size_t drain() {
+        while (fill()) {
+        }
+        std::size_t total = buffer_.size();
+        buffer_.clear();
+        return total;
+    }
+
+    // True once the server has closed its end and nothing is left unread
+    bool closed() {
+        return buffer_.empty() && !fill();
+    }
+
+private:
+    int fd_;
+    std::thread thread_;
+    std::string buffer_;
+
+    bool fill() {
+        char chunk[8192];
+        ssize_t n = recv(fd_, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            return false;
+        }
+        buffer_.append(chunk, static_cast<std::size_t>(n));
+        return true;
+    }
+};
+
+void addRoutes(Server& server) {
+    server.get("/echo/{word}", [](const Request& req) {
+        return Response::json({{"word", req.getParam("word")}});
+    });
+    server.post("/echo/{word}", [](const Request& req) {
+        return Response::json({{"word", req.getParam("word")}, {"bytes", req.body.size()}});
+    });
+}
+
+std::string get(const std::string& word, const std::string& version = "HTTP/1.1",
+                const std::string& connection = "") {
+    std::string request = "GET /echo/" + word + " " + version + "\r\nHost: localhost\r\n";
+    if (!connection.empty()) {
+        request += "Connection: " + connection + "\r\n";
+    }
+    return request + "\r\n";
+}
+
+bool hasBody(const std::string& response, const std::string& word) {
+    std::size_t body = response.find("\r\n\r\n");
+    return body != std::string::npos && response.find("\"word\":\"" + word + "\"", body) != std::string::npos;
+}
+
+bool keptAlive(const std::string& response) {
+    return response.find("Connection: keep-alive\r\n") != std::string::npos;
+}
+
+} // namespace
+
+// Test that one connection serves request after request
+void testKeepAlive() {
+    const char* TEST_NAME = "Keep-Alive Test";
+    Server server(0);
+    addRoutes(server);
+    Connection connection(server);
+
+    for (const char* word : {"one", "two", "three"}) {
+        connection.send(get(word));
+        std::string response = connection.readResponse();
+        verify(response.rfind("HTTP/1.1 200 OK\r\n", 0) == 0 && hasBody(response, word) && keptAlive(response),
+               TEST_NAME, "Each request should be answered on the same connection");
+    }
+}
+
+// Test that the connection is closed after max_requests_per_connection
+void testRequestLimit() {
+    const char* TEST_NAME = "Request Limit Test";
+    ServerOptions options;
+    options.max_requests_per_connection = 2;
+    Server server(0, options);
+    addRoutes(server);
+    Connection connection(server);
+
+    connection.send(get("one"));
+    verify(keptAlive(connection.readResponse()), TEST_NAME, "The first request should keep the connection");
+    connection.send(get("two"));
+    std::string last = connection.readResponse();
+    verify(hasBody(last, "two") && last.find("Connection: close\r\n") != std::string::npos, TEST_NAME,
+           "The last allowed request should be told the connection closes");
+    verify(connection.closed(), TEST_NAME, "The server should close after the last allowed request");
+}
+
+// Test HTTP/1.0 opt-in and Connection headers listing several tokens
+void testConnectionHeader() {
+    const char* TEST_NAME = "Connection Header Test";
+    Server server(0);
+    addRoutes(server);
+
+    {
+        Connection connection(server);
+        connection.send(get("old", "HTTP/1.0"));
+        verify(hasBody(connection.readResponse(), "old") && connection.closed(), TEST_NAME,
+               "HTTP/1.0 without keep-alive should close");
+    }
+    {
+        Connection connection(server);
+        connection.send(get("old", "HTTP/1.0", "Keep-Alive"));
+        verify(keptAlive(connection.readResponse()), TEST_NAME, "HTTP/1.0 may opt in to keep-alive");
+        connection.send(get("again", "HTTP/1.0", "keep-alive"));
+        verify(hasBody(connection.readResponse(), "again"), TEST_NAME, "An opted-in connection should stay open");
+    }
+    {
+        Connection connection(server);
+        connection.send(get("listed", "HTTP/1.1", "keep-alive, Upgrade"));
+        verify(keptAlive(connection.readResponse()), TEST_NAME, "A token list without close should keep alive");
+        connection.send(get("closing", "HTTP/1.1", "close, foo"));
+        std::string response = connection.readResponse();
+        verify(hasBody(response, "closing") && response.find("Connection: close\r\n") != std::string::npos &&
+               connection.closed(), TEST_NAME, "close anywhere in the list should close");
+    }
+}
+
+// Test that pipelined requests are answered in order on one socket
+void testPipelining() {
+    const char* TEST_NAME = "Pipelining Test";
+    Server server(0);
+    addRoutes(server);
+    Connection connection(server);
+
+    connection.send(get("a") + "POST /echo/b HTTP/1.1\r\nContent-Length: 3\r\n\r\nxyz" + get("c"));
+    std::string first = connection.readResponse();
+    std::string second = connection.readResponse();
+    std::string third = connection.readResponse();
+    verify(hasBody(first, "a") && hasBody(second, "b") && second.find("\"bytes\":3") != std::string::npos &&
+           hasBody(third, "c"), TEST_NAME, "Responses should come back in request order");
+    connection.send(get("d"));
+    verify(hasBody(connection.readResponse(), "d"), TEST_NAME, "The connection should stay usable");
+}
+
+// Test that a request whose framing outgrows the buffer cap is refused
+void testBufferCap() {
+    const char* TEST_NAME = "Buffer Cap Test";
+    ServerOptions options;
+    options.max_header_bytes = 1000;
+    options.max_body_bytes = 1000;
+    Server server(0, options);
+    addRoutes(server);
+
+    {
+        // Split across reads but within the limits, so it is served
+        Connection connection(server);
+        connection.send("POST /echo/split HTTP/1.1\r\nContent-Length: 900\r\n\r\n");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        connection.send(std::string(900, 'x'));
+        std::string response = connection.readResponse();
+        verify(hasBody(response, "split") && response.find("\"bytes\":900") != std::string::npos, TEST_NAME,
+               "A request arriving in pieces should be served");
+    }
+    {
+        // One-byte chunks: under the body limit, but six bytes on the wire each
+        Connection connection(server);
+        std::string request = "POST /echo/chunks HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n";
+        for (int i = 0; i < 800; ++i) {
+            request += "1\r\nx\r\n";
+        }
+        connection.send(request);
+        std::string response = connection.readResponse();
+        verify(response.rfind("HTTP/1.1 413 ", 0) == 0 && response.find("Request too large") != std::string::npos &&
+               connection.closed(), TEST_NAME, "A request past the buffer cap should get 413 and a close");
+    }
+}
+
+// Test that a client that stops reading is dropped after send_timeout_ms
+void testSendTimeout() {
+    const char* TEST_NAME = "Send Timeout Test";
+    ServerOptions options;
+    options.send_timeout_ms = 100;
+    options.compression = false;
+    Server server(0, options);
+    const std::size_t body_size = 8 * 1024 * 1024;
+    server.get("/big", [body_size](const Request&) {
+        return Response::bytes(std::string(body_size, 'x'), "text/plain");
+    });
+    Connection connection(server);
+
+    connection.send("GET /big HTTP/1.1\r\n\r\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    verify(connection.drain() < body_size, TEST_NAME, "The stalled response should be abandoned");
+}
+
+int main() {
+    std::cout << "\nStarting HTTP server connection tests...\n" << std::endl;
+
+    try {
+        testKeepAlive();
+        testRequestLimit();
+        testConnectionHeader();
+        testPipelining();
+        testBufferCap();
+        testSendTimeout();
+
+        std::cout << "\nAll HTTP server connection tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,123 @@
+#include "../../include/mercuryTrade/http/SnapshotCache.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mercuryTrade::http;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+// Test that a payload is reused until the version changes
+void testVersionedReuse() {
+    const char* TEST_NAME = "Versioned Reuse Test";
+    SnapshotCache cache;
+    int builds = 0;
+    auto build = [&]() { return "{\"build\":" + std::to_string(++builds) + "}"; };
+
+    auto first = cache.get("BTC-USD", 1, build);
+    auto second = cache.get("BTC-USD", 1, build);
+    verify(first == second && builds == 1, TEST_NAME, "Same version should share one payload");
+
+    auto other = cache.get("ETH-USD", 1, build);
+    verify(other != first && builds == 2, TEST_NAME, "Keys should be cached independently");
+
+    auto third = cache.get("BTC-USD", 2, build);
+    verify(third != first && *third->identity() == "{\"build\":3}", TEST_NAME, "New version should rebuild");
+
+    cache.invalidate("BTC-USD");
+    cache.get("BTC-USD", 2, build);
+    verify(builds == 4, TEST_NAME, "Invalidated entry should rebuild");
+
+    auto stats = cache.stats();
+    verify(stats.hits == 1 && stats.rebuilds == 4, TEST_NAME, "Statistics mismatch");
+}
+
+// Test that the rebuild limit serves the previous payload in between
+void testRateLimit() {
+    const char* TEST_NAME = "Rebuild Rate Limit Test";
+    SnapshotCache cache(5);  // At most one rebuild per 200ms
+    int builds = 0;
+    auto build = [&]() { return std::to_string(++builds); };
+
+    cache.get("BOOK", 1, build);
+    auto stale = cache.get("BOOK", 2, build);
+    verify(*stale->identity() == "1" && builds == 1, TEST_NAME, "Rebuild inside the interval should be throttled");
+    verify(cache.stats().throttled == 1, TEST_NAME, "Throttle count mismatch");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    auto fresh = cache.get("BOOK", 2, build);
+    verify(*fresh->identity() == "2", TEST_NAME, "Rebuild after the interval should happen");
+}
+
+// Test that keys beyond the limit are built but not retained
+void testEntryLimit() {
+    const char* TEST_NAME = "Entry Limit Test";
+    SnapshotCache cache(0, 6, 2);
+    int builds = 0;
+    auto build = [&]() { return std::to_string(++builds); };
+
+    cache.get("a", 1, build);
+    cache.get("b", 1, build);
+    cache.get("c", 1, build);
+    cache.get("c", 1, build);
+    verify(builds == 4, TEST_NAME, "Key over the limit should not be cached");
+    cache.get("a", 1, build);
+    verify(builds == 4, TEST_NAME, "Existing keys should stay cached");
+}
+
+// Test that concurrent readers of a changed snapshot serialize it once
+void testConcurrentReaders() {
+    const char* TEST_NAME = "Concurrent Readers Test";
+    SnapshotCache cache;
+    std::atomic<int> builds{0};
+    auto build = [&]() {
+        ++builds;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return std::string(4096, 'x');
+    };
+
+    std::vector<std::thread> readers;
+    std::atomic<int> served{0};
+    for (int i = 0; i < 16; ++i) {
+        readers.emplace_back([&]() {
+            for (int j = 0; j < 100; ++j) {
+                if (cache.get("BOOK", 7, build)->size() == 4096) {
+                    ++served;
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    verify(served == 1600, TEST_NAME, "Every reader should get the payload");
+    verify(builds == 1, TEST_NAME, "Concurrent readers should share a single rebuild");
+}
+
+int main() {
+    std::cout << "\nStarting snapshot cache tests...\n" << std::endl;
+
+    try {
+        testVersionedReuse();
+        testRateLimit();
+        testEntryLimit();
+        testConcurrentReaders();
+
+        std::cout << "\nAll snapshot cache tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
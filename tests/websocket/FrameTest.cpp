@@ -0,0 +1,127 @@
+#include "../../include/mercuryTrade/websocket/Frame.hpp"
+#include "../../include/mercuryTrade/websocket/Handshake.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+using namespace mercuryTrade::websocket;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+// Builds a masked client frame the way a browser would
+std::string clientFrame(Opcode opcode, const std::string& payload, bool fin = true) {
+    std::string frame = encodeFrame(opcode, payload);
+    if (!fin) {
+        frame[0] = static_cast<char>(frame[0] & 0x7F);
+    }
+
+    const char mask[4] = {0x12, 0x34, 0x56, 0x78};
+    std::size_t header = frame.size() - payload.size();
+    frame[1] = static_cast<char>(frame[1] | 0x80);
+    frame.insert(header, mask, 4);
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        frame[header + 4 + i] ^= mask[i & 3];
+    }
+    return frame;
+}
+
+// Test the length encodings of server frames
+void testEncodeLengths() {
+    const char* TEST_NAME = "Frame Encode Length Test";
+
+    std::string small = encodeFrame(Opcode::Text, "hello");
+    verify(small.size() == 7 && static_cast<unsigned char>(small[0]) == 0x81 && small[1] == 5,
+           TEST_NAME, "7-bit length header mismatch");
+
+    std::string medium = encodeFrame(Opcode::Text, std::string(300, 'x'));
+    verify(medium.size() == 304 && medium[1] == 126 &&
+           static_cast<unsigned char>(medium[2]) == 0x01 && static_cast<unsigned char>(medium[3]) == 0x2C,
+           TEST_NAME, "16-bit length header mismatch");
+
+    std::string large = encodeFrame(Opcode::Binary, std::string(70000, 'x'));
+    verify(large.size() == 70010 && large[1] == 127 && static_cast<unsigned char>(large[7]) == 0x01 &&
+           static_cast<unsigned char>(large[8]) == 0x11 && static_cast<unsigned char>(large[9]) == 0x70,
+           TEST_NAME, "64-bit length header mismatch");
+}
+
+// Test decoding masked client frames, including partial input
+void testDecode() {
+    const char* TEST_NAME = "Frame Decode Test";
+
+    std::string payload = "{\"action\":\"subscribe\"}";
+    std::string frame = clientFrame(Opcode::Text, payload);
+
+    DecodedFrame decoded;
+    for (std::size_t size = 0; size < frame.size(); ++size) {
+        std::string partial = frame.substr(0, size);
+        verify(decodeFrame(partial.data(), partial.size(), 1024, decoded) == DecodeResult::Incomplete,
+               TEST_NAME, "Partial frame should be incomplete");
+    }
+
+    std::string buffer = frame + clientFrame(Opcode::Ping, "p");
+    verify(decodeFrame(buffer.data(), buffer.size(), 1024, decoded) == DecodeResult::Complete, TEST_NAME, "Decode failed");
+    verify(decoded.fin && decoded.opcode == Opcode::Text, TEST_NAME, "Header bits mismatch");
+    verify(decoded.payload == payload, TEST_NAME, "Payload not unmasked");
+    verify(decoded.consumed == frame.size(), TEST_NAME, "Consumed size mismatch");
+
+    std::size_t offset = decoded.consumed;
+    verify(decodeFrame(buffer.data() + offset, buffer.size() - offset, 1024, decoded) == DecodeResult::Complete,
+           TEST_NAME, "Second frame decode failed");
+    verify(decoded.opcode == Opcode::Ping && decoded.payload == "p", TEST_NAME, "Ping mismatch");
+
+    std::string long_frame = clientFrame(Opcode::Text, std::string(1000, 'y'));
+    verify(decodeFrame(long_frame.data(), long_frame.size(), 2048, decoded) == DecodeResult::Complete &&
+           decoded.payload == std::string(1000, 'y'), TEST_NAME, "16-bit length decode failed");
+}
+
+// Test protocol violations
+void testDecodeErrors() {
+    const char* TEST_NAME = "Frame Decode Error Test";
+    DecodedFrame decoded;
+
+    std::string unmasked = encodeFrame(Opcode::Text, "hi");
+    verify(decodeFrame(unmasked.data(), unmasked.size(), 1024, decoded) == DecodeResult::Error,
+           TEST_NAME, "Unmasked client frame should be rejected");
+
+    std::string fragmented_ping = clientFrame(Opcode::Ping, "p", false);
+    verify(decodeFrame(fragmented_ping.data(), fragmented_ping.size(), 1024, decoded) == DecodeResult::Error,
+           TEST_NAME, "Fragmented control frame should be rejected");
+
+    std::string oversized = clientFrame(Opcode::Text, std::string(2000, 'z'));
+    verify(decodeFrame(oversized.data(), oversized.size(), 1024, decoded) == DecodeResult::Error,
+           TEST_NAME, "Oversized frame should be rejected");
+
+    std::string reserved = clientFrame(Opcode::Text, "hi");
+    reserved[0] = static_cast<char>(reserved[0] | 0x40);
+    verify(decodeFrame(reserved.data(), reserved.size(), 1024, decoded) == DecodeResult::Error,
+           TEST_NAME, "Reserved bits should be rejected");
+}
+
+// Test the handshake key from RFC 6455 section 1.3
+void testAcceptKey() {
+    const char* TEST_NAME = "Handshake Accept Key Test";
+    verify(acceptKey("dGhlIHNhbXBsZSBub25jZQ==") == "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=", TEST_NAME, "Accept key mismatch");
+}
+
+int main() {
+    std::cout << "\nStarting WebSocket frame tests...\n" << std::endl;
+
+    try {
+        testEncodeLengths();
+        testDecode();
+        testDecodeErrors();
+        testAcceptKey();
+
+        std::cout << "\nAll WebSocket frame tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,101 @@
+#include "../../include/mercuryTrade/websocket/SendQueue.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace mercuryTrade::websocket;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+Frame frame(const std::string& text) {
+    return std::make_shared<const std::string>(text);
+}
+
+// Test that keyed frames are replaced in place and keep their position
+void testConflation() {
+    const char* TEST_NAME = "Conflation Test";
+    SendQueue queue(16);
+
+    queue.pushLatest("ORDER_BOOK:BTC-USD", frame("book-1"));
+    queue.push(frame("trade-1"));
+    queue.pushLatest("ORDER_BOOK:ETH-USD", frame("eth-1"));
+    verify(queue.pushLatest("ORDER_BOOK:BTC-USD", frame("book-2")) == SendQueue::PushResult::Conflated,
+           TEST_NAME, "Second update should conflate");
+    queue.pushLatest("ORDER_BOOK:BTC-USD", frame("book-3"));
+    verify(queue.size() == 3, TEST_NAME, "Conflated frames should not grow the queue");
+
+    std::vector<Frame> batch;
+    verify(queue.pop(batch, 16), TEST_NAME, "Pop failed");
+    verify(batch.size() == 3 && *batch[0] == "book-3" && *batch[1] == "trade-1" && *batch[2] == "eth-1",
+           TEST_NAME, "Latest value should be sent at the original position");
+    verify(queue.stats().conflated == 2, TEST_NAME, "Conflation count mismatch");
+
+    // Once sent, the key starts a fresh entry
+    verify(queue.pushLatest("ORDER_BOOK:BTC-USD", frame("book-4")) == SendQueue::PushResult::Queued,
+           TEST_NAME, "Key should be released after pop");
+}
+
+// Test the lossless bound and batch limits
+void testBoundedLossless() {
+    const char* TEST_NAME = "Bounded Lossless Queue Test";
+    SendQueue queue(4);
+
+    for (int i = 0; i < 4; ++i) {
+        verify(queue.push(frame("t" + std::to_string(i))) == SendQueue::PushResult::Queued, TEST_NAME, "Push failed");
+    }
+    verify(queue.push(frame("t4")) == SendQueue::PushResult::Overflow, TEST_NAME, "Full queue should overflow");
+    verify(queue.pushLatest("quote", frame("q")) == SendQueue::PushResult::Queued,
+           TEST_NAME, "Keyed frames should not count against the lossless bound");
+
+    std::vector<Frame> batch;
+    queue.pop(batch, 2);
+    verify(batch.size() == 2 && *batch[0] == "t0" && *batch[1] == "t1", TEST_NAME, "Batch limit mismatch");
+    verify(queue.push(frame("t4")) == SendQueue::PushResult::Queued, TEST_NAME, "Space should be reclaimed after pop");
+}
+
+// Test that close wakes the consumer and still drains pending frames
+void testClose() {
+    const char* TEST_NAME = "Queue Close Test";
+    SendQueue queue(4);
+
+    std::vector<std::string> received;
+    std::thread consumer([&]() {
+        std::vector<Frame> batch;
+        while (queue.pop(batch, 8)) {
+            for (const auto& f : batch) {
+                received.push_back(*f);
+            }
+        }
+    });
+
+    queue.push(frame("a"));
+    queue.push(frame("b"));
+    queue.close();
+    consumer.join();
+
+    verify(queue.push(frame("c")) == SendQueue::PushResult::Closed, TEST_NAME, "Push after close should fail");
+    verify(received.size() == 2 && received[0] == "a" && received[1] == "b", TEST_NAME, "Pending frames lost on close");
+}
+
+int main() {
+    std::cout << "\nStarting send queue tests...\n" << std::endl;
+
+    try {
+        testConflation();
+        testBoundedLossless();
+        testClose();
+
+        std::cout << "\nAll send queue tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,368 @@
+#include "../../include/mercuryTrade/websocket/WebSocketServer.hpp"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace mercuryTrade::websocket;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+// Minimal blocking client speaking just enough RFC 6455 for the tests
+class TestClient {
+public:
+    explicit TestClient(int port) {
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        if (connect(fd_, (struct sockaddr*)&address, sizeof(address)) < 0) {
+            throw std::runtime_error("connect failed");
+        }
+        struct timeval timeout{5, 0};
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+
+    ~TestClient() { close(fd_); }
+
+    std::string upgrade(const std::string& target = "/ws") {
+        std::string request =
+            "GET " + target + " HTTP/1.1\r\n"
+            "Host: localhost\r\n"
+            "Upgrade: websocket\r\n"
+            "Connection: keep-alive, Upgrade\r\n"
+            "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+            "Sec-WebSocket-Version: 13\r\n\r\n";
+        send(fd_, request.data(), request.size(), 0);
+
+        while (buffer_.find("\r\n\r\n") == std::string::npos) {
+            if (!fill()) break;
+        }
+        std::size_t end = buffer_.find("\r\n\r\n");
+        std::string head = buffer_.substr(0, end == std::string::npos ? buffer_.size() : end + 4);
+        buffer_.erase(0, head.size());
+        return head;
+    }
+
+    void sendText(const std::string& text) {
+        std::string frame = encodeFrame(Opcode::Text, text);
+        std::size_t header = frame.size() - text.size();
+        const char mask[4] = {0x01, 0x02, 0x03, 0x04};
+        frame[1] = static_cast<char>(frame[1] | 0x80);
+        frame.insert(header, mask, 4);
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            frame[header + 4 + i] ^= mask[i & 3];
+        }
+        send(fd_, frame.data(), frame.size(), 0);
+    }
+
+    void sendRaw(const std::string& data) {
+        send(fd_, data.data(), data.size(), 0);
+    }
+
+    // Reads until the server closes the connection
+    std::string readRaw() {
+        while (fill()) {}
+        return std::move(buffer_);
+    }
+
+    // Returns the next text or binary payload, or empty on close/timeout
+    std::string readMessage(Opcode* type = nullptr) {
+        while (true) {
+            if (buffer_.size() >= 2) {
+                std::size_t header = 2;
+                std::uint64_t length = static_cast<unsigned char>(buffer_[1]) & 0x7F;
+                if (length == 126 && buffer_.size() >= 4) {
+                    length = (static_cast<unsigned char>(buffer_[2]) << 8) | static_cast<unsigned char>(buffer_[3]);
+                    header = 4;
+                } else if (length == 127 && buffer_.size() >= 10) {
+                    length = 0;
+                    for (int i = 2; i < 10; ++i) length = (length << 8) | static_cast<unsigned char>(buffer_[i]);
+                    header = 10;
+                }
+                if ((length < 126 || header > 2) && buffer_.size() >= header + length) {
+                    auto opcode = static_cast<Opcode>(buffer_[0] & 0x0F);
+                    std::string payload = buffer_.substr(header, length);
+                    buffer_.erase(0, header + length);
+                    if (type) *type = opcode;
+                    if (opcode == Opcode::Text || opcode == Opcode::Binary) return payload;
+                    if (opcode == Opcode::Close) return "";
+                    continue;
+                }
+            }
+            if (!fill()) return "";
+        }
+    }
+
+private:
+    int fd_;
+    std::string buffer_;
+
+    bool fill() {
+        char chunk[65536];
+        ssize_t n = recv(fd_, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buffer_.append(chunk, n);
+        return true;
+    }
+};
+
+void waitFor(const std::function<bool()>& condition) {
+    for (int i = 0; i < 2000 && !condition(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Test handshake, subscription and fan-out of frontend message types
+void testSubscribeAndPublish(WebSocketServer& server) {
+    const char* TEST_NAME = "Subscribe And Publish Test";
+
+    TestClient book_client(server.port());
+    TestClient all_client(server.port());
+    TestClient orders_client(server.port());
+
+    std::string head = book_client.upgrade();
+    verify(head.find("101 Switching Protocols") != std::string::npos, TEST_NAME, "Upgrade rejected");
+    verify(head.find("Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=") != std::string::npos, TEST_NAME, "Accept key mismatch");
+    all_client.upgrade();
+    orders_client.upgrade();
+
+    book_client.sendText(R"({"action":"subscribe","channels":["ORDER_BOOK:BTC-USD","TRADE:BTC-USD"]})");
+    auto ack = nlohmann::json::parse(book_client.readMessage());
+    verify(ack["type"] == "SUBSCRIBED" && ack["payload"]["channels"].size() == 2, TEST_NAME, "Subscription ack mismatch");
+
+    all_client.sendText(R"({"action":"subscribe","channels":["*","TRADE:*"]})");
+    all_client.readMessage();
+    orders_client.sendText(R"({"action":"subscribe","channels":["ORDER_UPDATE:*","ORDER_UPDATE:ETH-USD"]})");
+    orders_client.readMessage();
+
+    server.publish("MARKET_DATA", "BTC-USD", {{"last", 50050.0}});
+    server.publish("ORDER_BOOK", "BTC-USD", {{"bids", nlohmann::json::array()}});
+    server.publish("TRADE", "BTC-USD", {{"price", 50000.0}, {"quantity", 1.0}}, Delivery::Lossless);
+    server.publish("ORDER_BOOK", "ETH-USD", {{"bids", nlohmann::json::array()}});
+    server.publish("ORDER_UPDATE", "ETH-USD", {{"id", "ORD-1"}}, Delivery::Lossless);
+
+    auto first = nlohmann::json::parse(book_client.readMessage());
+    auto second = nlohmann::json::parse(book_client.readMessage());
+    verify(first["type"] == "ORDER_BOOK" && first["symbol"] == "BTC-USD", TEST_NAME, "Order book message mismatch");
+    verify(second["type"] == "TRADE" && second["payload"]["price"] == 50000.0, TEST_NAME, "Trade message mismatch");
+
+    std::string types;
+    for (int i = 0; i < 5; ++i) {
+        auto message = nlohmann::json::parse(all_client.readMessage());
+        types += message["type"].get<std::string>() + ",";
+    }
+    verify(types == "MARKET_DATA,ORDER_BOOK,TRADE,ORDER_BOOK,ORDER_UPDATE,", TEST_NAME,
+           "Wildcard subscriber should see everything exactly once");
+
+    auto update = nlohmann::json::parse(orders_client.readMessage());
+    verify(update["type"] == "ORDER_UPDATE" && update["symbol"] == "ETH-USD", TEST_NAME, "Type wildcard mismatch");
+    server.publish("ORDER_UPDATE", "BTC-USD", {{"id", "ORD-2"}}, Delivery::Lossless);
+    update = nlohmann::json::parse(orders_client.readMessage());
+    verify(update["payload"]["id"] == "ORD-2", TEST_NAME, "Overlapping patterns should deliver once");
+
+    book_client.sendText(R"({"action":"unsubscribe","channels":["TRADE:BTC-USD"]})");
+    ack = nlohmann::json::parse(book_client.readMessage());
+    verify(ack["payload"]["channels"].size() == 1, TEST_NAME, "Unsubscribe ack mismatch");
+}
+
+// Test that binary-format clients get binary frames where an encoding exists
+void testBinaryFormat(WebSocketServer& server) {
+    const char* TEST_NAME = "Binary Format Test";
+
+    TestClient binary_client(server.port());
+    TestClient text_client(server.port());
+    binary_client.upgrade("/ws?format=binary");
+    text_client.upgrade();
+
+    binary_client.sendText(R"({"action":"subscribe","channels":["TRADE:BTC-USD","MARKET_DATA:BTC-USD"]})");
+    Opcode type = Opcode::Close;
+    binary_client.readMessage(&type);
+    verify(type == Opcode::Text, TEST_NAME, "Control replies should stay JSON");
+    text_client.sendText(R"({"action":"subscribe","channels":["TRADE:BTC-USD"]})");
+    text_client.readMessage();
+
+    std::string encoded("\x01\x02\x00\xFF", 4);
+    server.publishEncoded("TRADE", "BTC-USD", {{"price", 50000.0}}, encoded, Delivery::Lossless);
+    server.publish("MARKET_DATA", "BTC-USD", {{"last", 50050.0}});
+
+    std::string payload = binary_client.readMessage(&type);
+    verify(type == Opcode::Binary && payload == encoded, TEST_NAME, "Binary subscriber should get the encoding");
+    payload = binary_client.readMessage(&type);
+    verify(type == Opcode::Text && nlohmann::json::parse(payload)["type"] == "MARKET_DATA", TEST_NAME,
+           "Messages without an encoding should fall back to JSON");
+
+    payload = text_client.readMessage(&type);
+    verify(type == Opcode::Text && nlohmann::json::parse(payload)["payload"]["price"] == 50000.0, TEST_NAME,
+           "Text subscriber should get JSON");
+}
+
+// Test that a stalled reader gets the latest state instead of a backlog
+void testSlowConsumerConflation(WebSocketServer& server) {
+    const char* TEST_NAME = "Slow Consumer Conflation Test";
+
+    TestClient client(server.port());
+    client.upgrade();
+    client.sendText(R"({"action":"subscribe","channels":["ORDER_BOOK:SOL-USD"]})");
+    client.readMessage();
+
+    // Large updates fill the socket buffers while the client is not reading
+    const int updates = 2000;
+    std::string padding(8 * 1024, 'x');
+    for (int i = 0; i < updates; ++i) {
+        server.publish("ORDER_BOOK", "SOL-USD", {{"version", i}, {"padding", padding}});
+    }
+
+    int received = 0;
+    int last_version = -1;
+    while (last_version != updates - 1) {
+        std::string message = client.readMessage();
+        if (message.empty()) break;
+        last_version = nlohmann::json::parse(message)["payload"]["version"];
+        ++received;
+    }
+    verify(last_version == updates - 1, TEST_NAME, "Latest update not delivered");
+    verify(received < updates, TEST_NAME, "Stale updates should have been conflated");
+}
+
+// Test that quotes pushed faster than a reader drains them collapse to the latest
+void testMarketDataConflation(WebSocketServer& server) {
+    const char* TEST_NAME = "Market Data Conflation Test";
+
+    TestClient client(server.port());
+    client.upgrade();
+    client.sendText(R"({"action":"subscribe","channels":["MARKET_DATA:ETH-USD"]})");
+    client.readMessage();
+
+    // Small quotes, so it takes many to back up a reader that is not reading
+    const int quotes = 200000;
+    for (int i = 0; i < quotes; ++i) {
+        server.publishSerialized("MARKET_DATA", "ETH-USD",
+                                 R"({"symbol":"ETH-USD","bid":3000,"ask":3001,"last":3000.5,"volume":)" +
+                                 std::to_string(i) + R"(,"timestamp":)" + std::to_string(i) + "}");
+    }
+
+    int received = 0;
+    int last_volume = -1;
+    nlohmann::json last;
+    while (last_volume != quotes - 1) {
+        std::string message = client.readMessage();
+        if (message.empty()) break;
+        last = nlohmann::json::parse(message);
+        last_volume = last["payload"]["volume"];
+        ++received;
+    }
+    verify(last_volume == quotes - 1 && last["type"] == "MARKET_DATA" && last["symbol"] == "ETH-USD" &&
+           last["payload"]["bid"] == 3000.0, TEST_NAME, "Latest quote not delivered");
+    verify(received < quotes, TEST_NAME, "Superseded quotes should have been dropped");
+}
+
+// Test that a reader too slow for lossless traffic is dropped, not buffered forever
+void testSlowConsumerDisconnect() {
+    const char* TEST_NAME = "Slow Consumer Disconnect Test";
+
+    WebSocketOptions options;
+    options.max_queued_frames = 8;
+    WebSocketServer server(0, options);
+    std::thread acceptor([&]() { server.start(); });
+
+    {
+        TestClient client(server.port());
+        client.upgrade();
+        client.sendText(R"({"action":"subscribe","channels":["TRADE:BTC-USD"]})");
+        client.readMessage();
+
+        std::string padding(64 * 1024, 'x');
+        for (int i = 0; i < 500 && server.connectionCount() > 0; ++i) {
+            server.publish("TRADE", "BTC-USD", {{"id", i}, {"padding", padding}}, Delivery::Lossless);
+        }
+        waitFor([&]() { return server.connectionCount() == 0; });
+        verify(server.connectionCount() == 0, TEST_NAME, "Slow lossless consumer should be disconnected");
+    }
+
+    server.stop();
+    acceptor.join();
+}
+
+// Test that destroying the server waits out connections still being served
+void testShutdownWithClients() {
+    const char* TEST_NAME = "Shutdown With Clients Test";
+
+    std::unique_ptr<TestClient> subscriber;
+    std::unique_ptr<TestClient> pending;
+    {
+        WebSocketServer server(0);
+        std::thread acceptor([&]() { server.start(); });
+
+        subscriber = std::make_unique<TestClient>(server.port());
+        subscriber->upgrade();
+        subscriber->sendText(R"({"action":"subscribe","channels":["*"]})");
+        subscriber->readMessage();
+        pending = std::make_unique<TestClient>(server.port());  // Never finishes its handshake
+        waitFor([&]() { return server.connectionCount() == 2; });
+
+        std::thread publisher([&]() {
+            for (int i = 0; i < 1000; ++i) {
+                server.publish("TRADE", "BTC-USD", {{"id", i}}, Delivery::Lossless);
+            }
+        });
+        publisher.join();
+        server.stop();
+        acceptor.join();
+    }
+
+    // Both connections were closed before the destructor returned
+    subscriber->readRaw();
+    verify(pending->readRaw().empty(), TEST_NAME, "Destructor should close every connection");
+}
+
+// Test that non-upgrade requests are refused
+void testRejectedHandshake(WebSocketServer& server) {
+    const char* TEST_NAME = "Rejected Handshake Test";
+
+    TestClient client(server.port());
+    client.sendRaw("GET /ws HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    std::string response = client.readRaw();
+    verify(response.find("HTTP/1.1 400") == 0, TEST_NAME, "Plain request should get 400");
+    verify(response.find("Missing Upgrade") != std::string::npos, TEST_NAME, "Rejection reason missing");
+}
+
+int main() {
+    std::cout << "\nStarting WebSocket server tests...\n" << std::endl;
+
+    try {
+        WebSocketServer server(0);
+        std::thread acceptor([&]() { server.start(); });
+
+        testSubscribeAndPublish(server);
+        testBinaryFormat(server);
+        testSlowConsumerConflation(server);
+        testMarketDataConflation(server);
+        testRejectedHandshake(server);
+        testSlowConsumerDisconnect();
+        testShutdownWithClients();
+
+        server.stop();
+        acceptor.join();
+
+        std::cout << "\nAll WebSocket server tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}
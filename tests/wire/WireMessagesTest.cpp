@@ -0,0 +1,223 @@
+#include "../../include/mercuryTrade/wire/Messages.hpp"
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace mercuryTrade::wire;
+
+void verify(bool condition, const char* testName, const char* message) {
+    if (!condition) {
+        std::cerr << testName << ": FAILED - " << message << std::endl;
+        throw std::runtime_error(std::string(testName) + " failed: " + message);
+    }
+    std::cout << testName << ": PASSED" << std::endl;
+}
+
+// Test that every template survives an encode/decode round trip
+void testRoundTrip() {
+    const char* TEST_NAME = "Round Trip Test";
+
+    Quote quote;
+    quote.symbol.assign("BTC-USD");
+    quote.bid = 49999.5;
+    quote.ask = 50000.25;
+    quote.last = 50000.0;
+    quote.volume = 1234.5;
+    quote.timestamp = 1700000000123456789LL;
+
+    Trade trade;
+    trade.symbol.assign("ETH-USD");
+    trade.trade_id = 42;
+    trade.price = 3000.5;
+    trade.quantity = 0.25;
+    trade.timestamp = -1;
+    trade.aggressor = Side::Sell;
+
+    BookDelta delta;
+    delta.symbol.assign("SOL-USD");
+    delta.seq = 0xFFFFFFFFFFULL;
+    delta.price = 101.75;
+    delta.quantity = 0.0;
+    delta.orders = 7;
+    delta.side = Side::Buy;
+
+    OrderUpdate update;
+    update.order_id.assign("ORD-123456");
+    update.symbol.assign("BTC-USD");
+    update.price = 50000.0;
+    update.quantity = 2.0;
+    update.filled_quantity = 0.5;
+    update.timestamp = 1700000000LL;
+    update.side = Side::Buy;
+    update.type = 1;
+    update.status = 2;
+
+    std::string buffer;
+    encode(quote, buffer);
+    verify(buffer.size() == HEADER_SIZE + QUOTE_BLOCK, TEST_NAME, "Quote length mismatch");
+    encode(trade, buffer);
+    encode(delta, buffer);
+    encode(update, buffer);
+    verify(buffer.size() == 4 * HEADER_SIZE + QUOTE_BLOCK + TRADE_BLOCK + BOOK_DELTA_BLOCK + ORDER_UPDATE_BLOCK,
+           TEST_NAME, "Encoders should append");
+
+    std::string_view in(buffer);
+    std::size_t consumed = 0;
+
+    Quote quote_out;
+    verify(decode(in, quote_out, consumed) == DecodeResult::Ok, TEST_NAME, "Quote decode failed");
+    verify(quote_out.symbol.view() == "BTC-USD" && quote_out.bid == quote.bid && quote_out.ask == quote.ask &&
+           quote_out.last == quote.last && quote_out.volume == quote.volume &&
+           quote_out.timestamp == quote.timestamp, TEST_NAME, "Quote fields mismatch");
+    in.remove_prefix(consumed);
+
+    Trade trade_out;
+    verify(decode(in, trade_out, consumed) == DecodeResult::Ok, TEST_NAME, "Trade decode failed");
+    verify(trade_out.symbol.view() == "ETH-USD" && trade_out.trade_id == 42 && trade_out.price == 3000.5 &&
+           trade_out.quantity == 0.25 && trade_out.timestamp == -1 && trade_out.aggressor == Side::Sell,
+           TEST_NAME, "Trade fields mismatch");
+    in.remove_prefix(consumed);
+
+    BookDelta delta_out;
+    verify(decode(in, delta_out, consumed) == DecodeResult::Ok, TEST_NAME, "Book delta decode failed");
+    verify(delta_out.symbol.view() == "SOL-USD" && delta_out.seq == delta.seq && delta_out.price == 101.75 &&
+           delta_out.quantity == 0.0 && delta_out.orders == 7 && delta_out.side == Side::Buy,
+           TEST_NAME, "Book delta fields mismatch");
+    in.remove_prefix(consumed);
+
+    OrderUpdate update_out;
+    verify(decode(in, update_out, consumed) == DecodeResult::Ok, TEST_NAME, "Order update decode failed");
+    verify(update_out.order_id.view() == "ORD-123456" && update_out.symbol.view() == "BTC-USD" &&
+           update_out.filled_quantity == 0.5 && update_out.type == 1 && update_out.status == 2,
+           TEST_NAME, "Order update fields mismatch");
+    in.remove_prefix(consumed);
+    verify(in.empty(), TEST_NAME, "Whole buffer should be consumed");
+}
+
+// Test the header and field layout byte for byte
+void testByteLayout() {
+    const char* TEST_NAME = "Byte Layout Test";
+
+    BookDelta delta;
+    delta.symbol.assign("AB");
+    delta.seq = 0x0102030405060708ULL;
+    delta.price = 1.0;
+    delta.quantity = 0.0;
+    delta.orders = 0x0A0B0C0D;
+    delta.side = Side::Sell;
+
+    std::string buffer;
+    encode(delta, buffer);
+    auto byte = [&](std::size_t i) { return static_cast<unsigned char>(buffer[i]); };
+
+    verify(byte(0) == BOOK_DELTA_BLOCK && byte(1) == 0, TEST_NAME, "Block length should be little-endian");
+    verify(byte(2) == 3 && byte(3) == 0, TEST_NAME, "Template id mismatch");
+    verify(byte(4) == 0x54 && byte(5) == 0x4D, TEST_NAME, "Schema id mismatch");
+    verify(byte(6) == SCHEMA_VERSION && byte(7) == 0, TEST_NAME, "Version mismatch");
+
+    verify(buffer.compare(8, 3, std::string("AB\0", 3)) == 0 && byte(23) == 0, TEST_NAME,
+           "Symbol should be NUL-padded");
+    verify(byte(24) == 0x08 && byte(31) == 0x01, TEST_NAME, "Sequence should be little-endian");
+    // 1.0 is 0x3FF0000000000000
+    verify(byte(32) == 0 && byte(38) == 0xF0 && byte(39) == 0x3F, TEST_NAME, "Price should be IEEE-754 LE");
+    verify(byte(48) == 0x0D && byte(51) == 0x0A, TEST_NAME, "Order count mismatch");
+    verify(byte(52) == 1, TEST_NAME, "Side mismatch");
+
+    Symbol symbol;
+    verify(!symbol.assign("A-VERY-LONG-SYMBOL-NAME") && symbol.view().size() == 16, TEST_NAME,
+           "Long symbols should be truncated and reported");
+}
+
+// Test that malformed input is rejected with the right reason
+void testRejections() {
+    const char* TEST_NAME = "Rejection Test";
+
+    Quote quote{};
+    quote.symbol.assign("BTC-USD");
+    std::string buffer;
+    encode(quote, buffer);
+
+    std::size_t consumed = 0;
+    Quote quote_out;
+    Trade trade_out;
+    verify(decode(std::string_view(buffer).substr(0, 5), quote_out, consumed) == DecodeResult::Incomplete,
+           TEST_NAME, "Partial header should be incomplete");
+    verify(decode(std::string_view(buffer).substr(0, buffer.size() - 1), quote_out, consumed) ==
+           DecodeResult::Incomplete, TEST_NAME, "Partial block should be incomplete");
+    verify(decode(buffer, trade_out, consumed) == DecodeResult::WrongTemplate, TEST_NAME,
+           "Template mismatch not detected");
+
+    std::string wrong_schema = buffer;
+    wrong_schema[4] = 0x00;
+    verify(decode(wrong_schema, quote_out, consumed) == DecodeResult::WrongSchema, TEST_NAME,
+           "Schema mismatch not detected");
+
+    std::string short_block = buffer;
+    short_block[0] = static_cast<char>(QUOTE_BLOCK - 8);
+    verify(decode(short_block, quote_out, consumed) == DecodeResult::BlockTooShort, TEST_NAME,
+           "Short block not detected");
+
+    TemplateId id;
+    verify(peekTemplate(buffer, id) && id == TemplateId::Quote, TEST_NAME, "Peek mismatch");
+    verify(!peekTemplate(std::string_view(buffer).substr(0, 3), id), TEST_NAME, "Peek needs a full header");
+}
+
+// Test that a newer sender's longer block is still readable
+void testForwardCompatibility() {
+    const char* TEST_NAME = "Forward Compatibility Test";
+
+    Trade trade{};
+    trade.symbol.assign("BTC-USD");
+    trade.trade_id = 9;
+    trade.price = 50000.0;
+
+    // Simulate a v2 sender that appended an 8-byte field to the block
+    std::string buffer;
+    encode(trade, buffer);
+    buffer[0] = static_cast<char>(TRADE_BLOCK + 8);
+    buffer[6] = 2;
+    buffer.append(8, '\x7F');
+    encode(trade, buffer);
+
+    std::string_view in(buffer);
+    std::size_t consumed = 0;
+    Trade out;
+    verify(decode(in, out, consumed) == DecodeResult::Ok && out.trade_id == 9, TEST_NAME,
+           "Longer block should decode");
+    verify(consumed == HEADER_SIZE + TRADE_BLOCK + 8, TEST_NAME, "Unknown fields should be skipped");
+    in.remove_prefix(consumed);
+    verify(decode(in, out, consumed) == DecodeResult::Ok && consumed == in.size(), TEST_NAME,
+           "Following message should stay aligned");
+}
+
+// Test Accept header negotiation
+void testAcceptNegotiation() {
+    const char* TEST_NAME = "Accept Negotiation Test";
+
+    verify(acceptsBinary("application/x-mercury-sbe"), TEST_NAME, "Exact type should match");
+    verify(acceptsBinary("application/json;q=0.5, Application/X-Mercury-SBE; q=1"), TEST_NAME,
+           "Listed type with parameters should match");
+    verify(!acceptsBinary("application/json"), TEST_NAME, "JSON should not match");
+    verify(!acceptsBinary("*/*"), TEST_NAME, "Wildcards should keep the JSON default");
+    verify(!acceptsBinary(""), TEST_NAME, "Missing header should keep the JSON default");
+    verify(!acceptsBinary("application/x-mercury-sbe2"), TEST_NAME, "Prefix should not match");
+}
+
+int main() {
+    std::cout << "\nStarting wire message tests...\n" << std::endl;
+
+    try {
+        testRoundTrip();
+        testByteLayout();
+        testRejections();
+        testForwardCompatibility();
+        testAcceptNegotiation();
+
+        std::cout << "\nAll wire message tests completed successfully\n" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\nTest Failed: " << e.what() << "\n" << std::endl;
+        return 1;
+    }
+}